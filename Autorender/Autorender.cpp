@@ -38,12 +38,16 @@
 
 #include "../cfillion/cfillion.hpp" // CF_ShellExecute
 #include "../SnM/SnM_Dlg.h"
+#include "../SnM/SnM_Util.h" // LoadChunk, SaveChunk
 #include "../Prompt.h"
 
 #include <time.h>
 #include <WDL/localize/localize.h>
 #include <WDL/projectcontext.h>
 
+#include <atomic>
+#include <thread>
+
 #include <taglib/tag.h>
 #include <taglib/fileref.h>
 
@@ -198,89 +202,37 @@ string ARGetProjectName(){
 	return prjPathStr;
 }
 
+// Reads/writes the .rpp as-is: ProjectStateContext::GetLine() and GetChunkLine() would cut
+// lines to a fixed size buffer, project lines have no length limit
 void GetProjectString(WDL_FastString* prjStr){
-	char str[4096];
-	EnumProjects(-1, str, MAX_PATH);
-
-	ProjectStateContext* prj = ProjectCreateFileRead( str );
-
-	if( !prj ){
-		//TODO: Throw error
-		return;
-	}
+	char rpp[MAX_PATH];
+	prjStr->Set("");
+	EnumProjects(-1, rpp, MAX_PATH);
 
-    while( !prj->GetLine( str, 4096 ) ){
-		prjStr->Append( str, prjStr->GetLength() + 4098 );
-		prjStr->Append( "\n", prjStr->GetLength() + 2 );
-    }
-    delete prj;
+	LoadChunk( rpp, prjStr, false ); //TODO: Throw error on failure
 }
 
 void WriteProjectFile( string filename, WDL_FastString* prjStr ){
 	//CheckDirTree( filename, true ); This done in GetQueuedRenders
-	ProjectStateContext* outProject = ProjectCreateFileWrite( filename.c_str() );
-
-	if(!outProject)
-		return;
-
-	char line[4096];
-	int pos = 0;
-	while( GetChunkLine( prjStr->Get(), line, 4096, &pos, false ) ){
-		outProject->AddLine("%s",line);
-	}
-	delete outProject;
+	SaveChunk( filename.c_str(), prjStr, false );
 }
 
-void WDLStringReplaceLine( WDL_FastString *prjStr, int pos, const char *oldLine, const char *newLine ){
-	//if newLine does't have a trailing \n, things will break because WDL_FastString will insert > at the wrong place!
-	//maybe should check for this here?
-	int lineLen = (int)strlen( oldLine ) + 1; //Add 1 for the omitted newline
-	int startPos = pos - lineLen;
-	prjStr->DeleteSub( startPos, lineLen );
-	prjStr->Insert( newLine, startPos );
-}
-
-void SetProjectParameter( WDL_FastString *prjStr, string param, string paramValue, string insertAfterParam ){
-	char line[4096];
-	int pos = 0;
-	LineParser lp(false);
-	string paramString = param + string(" ") + paramValue + string("\n");
-
-	while (GetChunkLine(prjStr->Get(), line, 4096, &pos, false)){
-		if( !lp.parse( line ) && lp.getnumtokens() ) {
-			if ( strcmp( lp.gettoken_str(0), param.c_str() ) == 0) {
-				WDLStringReplaceLine(prjStr, pos, line, paramString.c_str());
-				return;
-			}
-		}
-	}
-
-	if (!insertAfterParam.empty()) {
-		//param wasn't found, insert after insertAfterParam
-		pos = 0;
-		while (GetChunkLine(prjStr->Get(), line, 4096, &pos, false)){
-			if (!lp.parse(line) && lp.getnumtokens()) {
-				if (strcmp(lp.gettoken_str(0), insertAfterParam.c_str()) == 0) {
-					string replacementStr = line + string("\n") + paramString;
-					WDLStringReplaceLine(prjStr, pos, line, replacementStr.c_str());
-					return;
-				}
-			}
-		}
-	}
-}
-
-void SetProjectParameter(WDL_FastString *prjStr, string param, string paramValue){
-	SetProjectParameter(prjStr, param, paramValue, "");
+// Copies the line starting at p (without its '\n') to line, returns the start of the next one
+const char *GetNextProjectLine( const char *p, WDL_FastString *line ){
+	const char *eol = strchr( p, '\n' );
+	const int lineLen = eol ? (int)( eol - p ) : (int)strlen( p );
+	line->Set( p, lineLen );
+	return eol ? eol + 1 : p + lineLen;
 }
 
 string GetProjectParameterValueStr( WDL_FastString *prjStr, string param, int token = 1 ){
-	char line[4096];
-	int pos = 0;
+	WDL_FastString line;
 	LineParser lp(false);
 
-	while( GetChunkLine( prjStr->Get(), line, 4096, &pos, false ) ){
-		if( !lp.parse( line ) && lp.getnumtokens() ) {
+	const char *p = prjStr->Get();
+	while( *p ){
+		p = GetNextProjectLine( p, &line );
+		if( !lp.parse( line.Get() ) && lp.getnumtokens() ) {
 			if ( strcmp( lp.gettoken_str(0), param.c_str() ) == 0) {
 				return lp.gettoken_str( token );
 			}
@@ -417,7 +369,11 @@ void NukeDirFiles( string dir, string ext = "" ){
 	closedir( dp );
 }
 
-void GetRenderedFiles(string dir, vector<RenderRegion> regions, map <string, RenderRegion> &files){
+void GetRenderedFiles(string dir, const vector<RenderRegion> &regions, map <string, RenderRegion> &files){
+	vector<string> regionFileNamePrefixes;
+	for (vector<RenderRegion>::const_iterator region = regions.begin(); region != regions.end(); ++region)
+		regionFileNamePrefixes.push_back(RenderRegion(*region).getFileName("", 0));
+
 	DIR *dp;
 	struct dirent *dirp;
 	if ((dp = opendir(dir.c_str())) != NULL){
@@ -428,18 +384,18 @@ void GetRenderedFiles(string dir, vector<RenderRegion> regions, map <string, Ren
 				continue;
 			}
 
-			for (std::vector<RenderRegion>::iterator region = regions.begin(); region != regions.end(); ++region) {
-				string regionFileNamePrefix = region->getFileName("", 0);
+			for (unsigned int i = 0; i < regions.size(); i++) {
+				const string &regionFileNamePrefix = regionFileNamePrefixes[i];
 				//TODO make sure filename sanitizing works as expected (REAPER internally handling during region rendering
 				if (!fileName.compare(0, regionFileNamePrefix.length(), regionFileNamePrefix)) {
 					string path = string(dir + PATH_SLASH_CHAR + fileName);
-					files.insert(pair <string, RenderRegion>(path, *region));
+					files.insert(pair <string, RenderRegion>(path, regions[i]));
 					break;
 				}
 			}
 		}
+		closedir(dp);
 	}
-	closedir(dp);
 }
 
 void MakePathAbsolute( char* path, char* basePath ){
@@ -455,90 +411,150 @@ void MakePathAbsolute( char* path, char* basePath ){
 	}
 }
 
-void MakeMediaFilesAbsolute( WDL_FastString *prjStr ){
-	char line[4096];
-	int pos = 0;
-
-	LineParser lp(false);
-	bool inTrack = false;
-	bool inTrackItem = false;
-	bool inTrackItemSource = false;
-	int trackIgnoreChunks = 0;
-	int trackItemIgnoreChunks = 0;
-	int trackItemSourceIgnoreChunks = 0;
-	const char *firstChar;
-	string firstTokenStr;
-
-	int lineNum = 0; //for debugging
+struct ProjectParameter {
+	string value;
+	string insertAfterParam; // where to add the parameter if the project doesn't have it yet (not added if empty)
+};
+typedef map<string, ProjectParameter> ProjectParameters;
 
+// Builds the render project in a single streamed pass over prjStr: top level parameters listed
+// in params are replaced (or inserted after insertAfterParam when missing) and media items FILE
+// paths are made absolute. Every other line is copied as-is, nothing gets rescanned.
+void PrepareRenderProject( const WDL_FastString *prjStr, const ProjectParameters &params, WDL_FastString *outStr ){
 	//Reaper API's GetProjectPath() returns the path to the project's audio dir, not to .rpp!
 	char projPath[MAX_PATH];
 	GetProjectRealPath( projPath );
 
-	while( GetChunkLine( prjStr->Get(), line, 4096, &pos, false ) ){
-		lineNum++;
-		if( !lp.parse( line ) && lp.getnumtokens() ) {
-			firstTokenStr = lp.gettoken_str(0);
-			firstTokenStr = firstTokenStr.substr(0,1);
-			firstChar = firstTokenStr.c_str();
-
-			if ( strcmp( lp.gettoken_str(0), ">" ) == 0 ){
-				//end of a chunk
-				if( inTrackItemSource ){
-					if( trackItemSourceIgnoreChunks == 0 ){
-						inTrackItemSource = false;
-					} else {
-						--trackItemSourceIgnoreChunks;
-					}
-				} else if( inTrackItem ) {
-					if( trackItemIgnoreChunks == 0 ){
-						inTrackItem = false;
-					} else {
-						--trackItemIgnoreChunks;
-					}
-				} else if( inTrack ){
-					if( trackIgnoreChunks == 0 ){
-						inTrack = false;
-					} else {
-						--trackIgnoreChunks;
-					}
+	LineParser lp(false);
+	WDL_FastString line;
+	set<string> foundParams;
+	map<string, int> insertPos; // param -> position in outStr right after its insertAfterParam line
+
+	int depth = 0; // project parameters are at depth 1, inside <REAPER_PROJECT
+	int trackDepth = -1, itemDepth = -1, sourceDepth = -1;
+
+	outStr->Set("");
+	const char *p = prjStr->Get();
+	while( *p ){
+		p = GetNextProjectLine( p, &line );
+		const int lineLen = line.GetLength();
+
+		bool copyLine = true;
+		if( !lp.parse( line.Get() ) && lp.getnumtokens() ){
+			const char *token = lp.gettoken_str(0);
+
+			if( token[0] == '<' ){
+				++depth;
+				if( trackDepth < 0 ){
+					if( !strcmp( token, "<TRACK" ) ) trackDepth = depth;
+				} else if( itemDepth < 0 ){
+					if( !strcmp( token, "<ITEM" ) ) itemDepth = depth;
+				} else if( sourceDepth < 0 ){
+					if( !strcmp( token, "<SOURCE" ) ) sourceDepth = depth;
 				}
-			} else if( inTrackItemSource ){
-				if( strcmp( lp.gettoken_str(0), "FILE" ) == 0 ){
-					string replacementStr = "FILE ";
-					char *mediaPath = (char*) lp.gettoken_str(1);
+			} else if( !strcmp( token, ">" ) ){
+				if( depth == sourceDepth ) sourceDepth = -1;
+				else if( depth == itemDepth ) itemDepth = -1;
+				else if( depth == trackDepth ) trackDepth = -1;
+				--depth;
+			} else if( sourceDepth >= 0 ){
+				// also covers nested sources (section, reverse...)
+				if( !strcmp( token, "FILE" ) ){
+					char mediaPath[MAX_PATH * 2 + 2];
+					lstrcpyn( mediaPath, lp.gettoken_str(1), MAX_PATH );
 					MakePathAbsolute( mediaPath, projPath );
 					WDL_FastString sanitizedMediaFilePath;
-					makeEscapedConfigString( mediaPath, &sanitizedMediaFilePath);
-					replacementStr.append( sanitizedMediaFilePath.Get() );
-					if( lp.getnumtokens() > 1 ){
-						replacementStr.append( " " );
-						replacementStr.append( lp.gettoken_str( 2 ) );
+					makeEscapedConfigString( mediaPath, &sanitizedMediaFilePath );
+
+					outStr->Append( "FILE " );
+					outStr->Append( sanitizedMediaFilePath.Get() );
+					if( lp.getnumtokens() > 2 ){
+						outStr->Append( " " );
+						outStr->Append( lp.gettoken_str(2) );
 					}
-					replacementStr.append( string( "\n" ) );
-					WDLStringReplaceLine( prjStr, pos, line, replacementStr.c_str() );
-				} else if ( strcmp( firstChar, "<" ) == 0 ){
-					++trackItemSourceIgnoreChunks;
+					outStr->Append( "\n" );
+					copyLine = false;
 				}
-			} else if ( inTrackItem ){
-				if( strcmp( lp.gettoken_str(0), "<SOURCE" ) == 0 ){
-					inTrackItemSource = true;
-				} else if ( strcmp( firstChar, "<" ) == 0 ){
-					++trackItemIgnoreChunks;
+			} else if( depth == 1 ){
+				ProjectParameters::const_iterator param = params.find( token );
+				if( param != params.end() && foundParams.insert( param->first ).second ){
+					outStr->AppendFormatted( (int)( param->first.size() + param->second.value.size() + 3 ),
+						"%s %s\n", param->first.c_str(), param->second.value.c_str() );
+					copyLine = false;
 				}
-			} else if ( inTrack ){
-				if( strcmp( lp.gettoken_str(0), "<ITEM" ) == 0 ){
-					inTrackItem = true;
-				} else if ( ( strcmp( firstChar, "<" ) == 0 ) || ( strcmp( firstChar, "<\0" ) == 0 ) ){
-					trackIgnoreChunks++;
+
+				for( ProjectParameters::const_iterator it = params.begin(); it != params.end(); ++it ){
+					if( it->second.insertAfterParam == token && insertPos.find( it->first ) == insertPos.end() )
+						insertPos[ it->first ] = outStr->GetLength() + ( copyLine ? lineLen + 1 : 0 );
 				}
-			} else if ( strcmp( lp.gettoken_str(0), "<TRACK" ) == 0 ){
-				inTrack = true;
 			}
 		}
+
+		if( copyLine ){
+			outStr->Append( line.Get(), lineLen );
+			outStr->Append( "\n" );
+		}
+	}
+
+	// add missing parameters, last position first so that the others stay valid
+	vector< pair<int, string> > inserts;
+	for( map<string, int>::iterator it = insertPos.begin(); it != insertPos.end(); ++it ){
+		if( foundParams.find( it->first ) == foundParams.end() )
+			inserts.push_back( make_pair( it->second, it->first + " " + params.find( it->first )->second.value + "\n" ) );
+	}
+	sort( inserts.begin(), inserts.end(), []( const pair<int, string> &a, const pair<int, string> &b ){ return a.first > b.first; } );
+	for( unsigned int i = 0; i < inserts.size(); i++ )
+		outStr->Insert( inserts[i].second.c_str(), inserts[i].first );
+}
+
+void TagRenderedFile( const string &renderedFilePath, const RenderRegion &renderRegion ){
+	TagLib::FileRef f( win32::widen(renderedFilePath).c_str() );
+
+	if( !f.isNull() ) {
+		if( !g_tag_artist.empty() )
+		  f.tag()->setArtist( {g_tag_artist, TagLib::String::UTF8} );
+		if( !g_tag_album.empty() )
+		  f.tag()->setAlbum( {g_tag_album, TagLib::String::UTF8} );
+		if( !g_tag_genre.empty() )
+		  f.tag()->setGenre( {g_tag_genre, TagLib::String::UTF8} );
+		if( !g_tag_comment.empty() )
+		  f.tag()->setComment( {g_tag_comment, TagLib::String::UTF8} );
+		f.tag()->setTitle( {renderRegion.regionName, TagLib::String::UTF8} );
+
+		if( g_tag_year > 0 ) f.tag()->setYear( g_tag_year );
+
+		f.tag()->setTrack( renderRegion.regionNumber );
+		f.save();
+	} else {
+		//throw error?
 	}
 }
 
+// Each file is opened/saved independently so they're tagged by a small pool of workers
+// (the calling thread included). Blocks until all files are done, the tag globals
+// must not change in the meantime.
+void TagRenderedFiles( const map<string, RenderRegion> &renderedFiles ){
+	vector< map<string, RenderRegion>::const_iterator > jobs;
+	for( map<string, RenderRegion>::const_iterator it = renderedFiles.begin(); it != renderedFiles.end(); ++it )
+		jobs.push_back( it );
+
+	std::atomic<size_t> nextJob(0);
+	auto worker = [&](){
+		for( size_t i = nextJob++; i < jobs.size(); i = nextJob++ )
+			TagRenderedFile( jobs[i]->first, jobs[i]->second );
+	};
+
+	const size_t threadCount = min( jobs.size(), (size_t) max( 1u, std::thread::hardware_concurrency() ) );
+	vector<std::thread> threads;
+	for( size_t i = 1; i < threadCount; i++ )
+		threads.emplace_back( worker );
+
+	worker();
+
+	for( unsigned int i = 0; i < threads.size(); i++ )
+		threads[i].join();
+}
+
 
 void AutorenderRegions(COMMAND_T*)
 {
@@ -553,20 +569,13 @@ void AutorenderRegions(COMMAND_T*)
 
 	g_doing_render = true;
 
-	//Get the project config as a WDL_FastString
-	WDL_FastString prjStr;
-	ForceSaveAndLoad( &prjStr );
-
 	//use default path if no render path specified
 	if( g_render_path.empty() && !g_pref_default_render_path.empty() ){
 		g_render_path = g_pref_default_render_path;
 	}
 
 	// remove PATH_SLASH_CHAR from end of string if it exists
-	bool removedChars = EnsureStrDoesntEndWith( g_render_path, PATH_SLASH_CHAR );
-	if( removedChars ){
-		ForceSaveAndLoad( &prjStr );
-	}
+	EnsureStrDoesntEndWith( g_render_path, PATH_SLASH_CHAR );
 
 	// render path was specified and doesn't exist
 	if( !g_render_path.empty() && !FileExists( g_render_path.c_str() ) ){
@@ -584,11 +593,11 @@ void AutorenderRegions(COMMAND_T*)
 			return;
 		}
 		g_render_path = renderPathChar;
-		ForceSaveAndLoad( &prjStr );
 	}
 
-	//Project tweaks - only do after render path check! (Don't want to overwrite users settings in the original file)
-	MakeMediaFilesAbsolute( &prjStr );
+	//Get the project config as a WDL_FastString, saved once the render path is settled
+	WDL_FastString prjStr;
+	ForceSaveAndLoad( &prjStr );
 
 	string queuedRendersDir = GetQueuedRendersDir(); // This also checks to make sure that the dir exists
 	NukeDirFiles( queuedRendersDir, "rpp" ); // Deletes all .rpp files in the queuedRendersDir
@@ -654,28 +663,33 @@ void AutorenderRegions(COMMAND_T*)
 	string outRenderProjectPath = outRenderProjectPrefix;
 	outRenderProjectPath += GetRenderQueueTimeString() + "_" + ARGetProjectName() + "_autorender.rpp";
 
+	//Project tweaks - only done on the queued copy (Don't want to overwrite users settings in the original file)
+	ProjectParameters params;
 	if (renderRegions.size() == 1 && renderRegions[0].entireProject) {
 		string regionFilename = renderRegions[0].getFileName("", 2);
 		if (g_render_path.empty()){
-			SetProjectParameter(&prjStr, "RENDER_FILE", "\"" + regionFilename + "\"");
+			params["RENDER_FILE"].value = "\"" + regionFilename + "\"";
 		} else {
-			SetProjectParameter(&prjStr, "RENDER_FILE", "\"" + g_render_path + PATH_SLASH_CHAR + regionFilename + "\"");
+			params["RENDER_FILE"].value = "\"" + g_render_path + PATH_SLASH_CHAR + regionFilename + "\"";
 		}
 
-		SetProjectParameter(&prjStr, "RENDER_RANGE", "1 0 0 18 1000");
+		params["RENDER_RANGE"].value = "1 0 0 18 1000";
 	} else {
 		if (!g_render_path.empty()){
-			SetProjectParameter(&prjStr, "RENDER_FILE", "\"" + g_render_path + "\"");
+			params["RENDER_FILE"].value = "\"" + g_render_path + "\"";
 		}
 
-		SetProjectParameter(&prjStr, "RENDER_PATTERN", "\"$timelineorder $region\"", "RENDER_FILE");
-		SetProjectParameter(&prjStr, "RENDER_RANGE", "3 0 0 18 1000");
+		params["RENDER_PATTERN"].value = "\"$timelineorder $region\"";
+		params["RENDER_PATTERN"].insertAfterParam = "RENDER_FILE";
+		params["RENDER_RANGE"].value = "3 0 0 18 1000";
 	}
 
-	SetProjectParameter(&prjStr, "RENDER_STEMS", "0");
-	SetProjectParameter(&prjStr, "RENDER_ADDTOPROJ", "0");
+	params["RENDER_STEMS"].value = "0";
+	params["RENDER_ADDTOPROJ"].value = "0";
 
-	WriteProjectFile(outRenderProjectPath, &prjStr);
+	WDL_FastString renderPrjStr;
+	PrepareRenderProject(&prjStr, params, &renderPrjStr);
+	WriteProjectFile(outRenderProjectPath, &renderPrjStr);
 
 	Main_OnCommand( 41207, 0 ); //Render all queued renders
 
@@ -683,31 +697,7 @@ void AutorenderRegions(COMMAND_T*)
 	GetRenderedFiles(g_render_path, renderRegions, renderedFiles);
 
 	// Tag!
-	for (std::map<string, RenderRegion>::iterator renderedFile = renderedFiles.begin(); renderedFile != renderedFiles.end(); ++renderedFile){
-		string renderedFilePath = renderedFile->first;
-		RenderRegion renderRegion = renderedFile->second;
-
-		TagLib::FileRef f( win32::widen(renderedFilePath).c_str() );
-
-		if( !f.isNull() ) {
-			if( !g_tag_artist.empty() )
-			  f.tag()->setArtist( {g_tag_artist, TagLib::String::UTF8} );
-			if( !g_tag_album.empty() )
-			  f.tag()->setAlbum( {g_tag_album, TagLib::String::UTF8} );
-			if( !g_tag_genre.empty() )
-			  f.tag()->setGenre( {g_tag_genre, TagLib::String::UTF8} );
-			if( !g_tag_comment.empty() )
-			  f.tag()->setComment( {g_tag_comment, TagLib::String::UTF8} );
-			f.tag()->setTitle( {renderRegion.regionName, TagLib::String::UTF8} );
-
-			if( g_tag_year > 0 ) f.tag()->setYear( g_tag_year );
-
-			f.tag()->setTrack( renderRegion.regionNumber );
-			f.save();
-		} else {
-			//throw error?
-		}
-	}
+	TagRenderedFiles(renderedFiles);
 
 	OpenRenderPath( NULL );
 	g_doing_render = false;
@@ -48,6 +48,8 @@ const int ENV_HIT_POINT_DOWN        = 6; // +1 because lower part is tracked sta
 const int STRETCH_M_HIT_POINT       = 6;
 const int STRETCH_M_MIN_TAKE_HEIGHT = 8;
 
+const unsigned int CONTEXT_CACHE_TIME = 30; // ms, roughly one Reaper timer tick
+
 // Not tied to Reaper, purely for readability
 const int MIDI_WND_NOTEVIEW     = 1;
 const int MIDI_WND_KEYBOARD     = 2;
@@ -302,6 +304,10 @@ MediaTrack* TrackAtMouseCursor (int* context, double* position)
 /******************************************************************************
 * BR_MouseInfo                                                                *
 ******************************************************************************/
+BR_MouseInfo::ContextCache BR_MouseInfo::s_cache;
+int BR_MouseInfo::s_cacheHits   = 0;
+int BR_MouseInfo::s_cacheMisses = 0;
+
 BR_MouseInfo::BR_MouseInfo (int mode /*= BR_MouseInfo::MODE_ALL*/, bool updateNow /*= true*/) :
 m_midiEditorPianoWnd (NULL)
 {
@@ -322,8 +328,47 @@ void BR_MouseInfo::Update (const POINT* p /*=NULL*/)
 	else
 		GetCursorPos(&currentPoint);
 
+	/* Resolving context is expensive (envelopes, stretch markers, MIDI editor chunks...) and *
+	*  contextual toolbars, actions and scripts often query it several times per timer tick.  *
+	*  Reuse last result while cursor, arrange view and project are unchanged                 */
+	BR_MouseInfo::ContextCache key;
+	this->GetContextKey(currentPoint, key);
+
+	if (s_cache.valid                                      &&
+	    key.time - s_cache.time < CONTEXT_CACHE_TIME       &&
+	    key.p.x            == s_cache.p.x                  &&
+	    key.p.y            == s_cache.p.y                  &&
+	    key.hwnd           == s_cache.hwnd                 &&
+	    key.mode           == s_cache.mode                 &&
+	    key.vScroll        == s_cache.vScroll              &&
+	    key.project        == s_cache.project              &&
+	    key.projStateCount == s_cache.projStateCount       &&
+	    key.arrangeStart   == s_cache.arrangeStart         &&
+	    key.arrangeEnd     == s_cache.arrangeEnd
+	)
+	{
+		m_mouseInfo          = s_cache.mouseInfo;
+		m_ccLaneClickPoint   = s_cache.ccLaneClickPoint;
+		m_midiEditorPianoWnd = s_cache.midiEditorPianoWnd;
+		++s_cacheHits;
+		return;
+	}
+
 	m_midiEditorPianoWnd = NULL;
 	this->GetContext(currentPoint);
+	++s_cacheMisses;
+
+	s_cache                    = key;
+	s_cache.mouseInfo          = m_mouseInfo;
+	s_cache.ccLaneClickPoint   = m_ccLaneClickPoint;
+	s_cache.midiEditorPianoWnd = m_midiEditorPianoWnd;
+	s_cache.valid              = true;
+}
+
+void BR_MouseInfo::GetCacheStats (int* hits, int* misses)
+{
+	WritePtr(hits,   s_cacheHits);
+	WritePtr(misses, s_cacheMisses);
 }
 
 void BR_MouseInfo::SetMode (int mode)
@@ -522,6 +567,40 @@ pianoRollMode   (-1)
 	*  default values. Be careful if changing them */
 }
 
+BR_MouseInfo::ContextCache::ContextCache () :
+hwnd               (NULL),
+mode               (0),
+vScroll            (0),
+projStateCount     (0),
+project            (NULL),
+arrangeStart       (0),
+arrangeEnd         (0),
+time               (0),
+valid              (false),
+midiEditorPianoWnd (NULL)
+{
+	p.x = p.y = 0;
+	ccLaneClickPoint.x = ccLaneClickPoint.y = 0;
+}
+
+void BR_MouseInfo::GetContextKey (const POINT& p, BR_MouseInfo::ContextCache& key)
+{
+	key.p              = p;
+	key.hwnd           = WindowFromPoint(p);
+	key.mode           = m_mode;
+	key.project        = EnumProjects(-1, NULL, 0);
+	key.projStateCount = GetProjectStateChangeCount(NULL);
+	key.time           = GetTickCount();
+
+	HWND arrange = GetArrangeWnd();
+	RECT r; GetWindowRect(arrange, &r);
+	GetSet_ArrangeView2(NULL, false, r.left, r.right-SCROLLBAR_W, &key.arrangeStart, &key.arrangeEnd);
+
+	SCROLLINFO si = { sizeof(SCROLLINFO), SIF_POS };
+	CF_GetScrollInfo(arrange, SB_VERT, &si);
+	key.vScroll = si.nPos;
+}
+
 void BR_MouseInfo::GetContext (const POINT& p)
 {
 	HWND hwnd = WindowFromPoint(p);
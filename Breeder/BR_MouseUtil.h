@@ -90,6 +90,7 @@ public:
 	~BR_MouseInfo ();
 	void Update (const POINT* p = NULL);
 	void SetMode (int mode);
+	static void GetCacheStats (int* hits, int* misses); // resolved contexts are shared between objects, see Update()
 
 	// See description for BR_MouseInfo
 	const char* GetWindow ();
@@ -152,6 +153,23 @@ private:
 		MouseInfo ();
 	};
 
+	struct ContextCache
+	{
+		POINT p;
+		HWND hwnd;
+		int mode, vScroll, projStateCount;
+		ReaProject* project;
+		double arrangeStart, arrangeEnd;
+		unsigned int time;
+		bool valid;
+
+		BR_MouseInfo::MouseInfo mouseInfo;
+		POINT ccLaneClickPoint;
+		HWND  midiEditorPianoWnd;
+		ContextCache ();
+	};
+
+	void GetContextKey (const POINT& p, BR_MouseInfo::ContextCache& key);
 	void GetContext (const POINT& p);
 	bool GetContextMIDI (POINT p, HWND hwnd, BR_MouseInfo::MouseInfo& mouseInfo);
 	bool GetContextMIDIInline (BR_MouseInfo::MouseInfo& mouseInfo, int mouseDisplayX, int mouseY, int takeHeight, int takeOffset);
@@ -169,4 +187,7 @@ private:
 	POINT m_ccLaneClickPoint;
 	HWND  m_midiEditorPianoWnd;
 	int m_mode;
+
+	static BR_MouseInfo::ContextCache s_cache;
+	static int s_cacheHits, s_cacheMisses;
 };
@@ -512,6 +512,11 @@ MediaTrack* BR_GetMouseCursorContext_Track ()
 	return g_mouseInfo.GetTrack();
 }
 
+void BR_GetMouseCursorContext_CacheStats (int* hitsOut, int* missesOut)
+{
+	BR_MouseInfo::GetCacheStats(hitsOut, missesOut);
+}
+
 double BR_GetNextGridDivision (double position)
 {
 	if (position >= 0)
@@ -690,6 +695,36 @@ double BR_PositionAtMouseCursor (bool checkRuler)
 	return PositionAtMouseCursor(checkRuler, true);
 }
 
+bool BR_Profiler_DumpChromeTrace (const char* filenameIn)
+{
+	return filenameIn && *filenameIn && BR_ProfilerDumpChromeTrace(filenameIn);
+}
+
+void BR_Profiler_Enable (bool enable, bool reset)
+{
+	BR_ProfilerEnable(enable, reset);
+}
+
+bool BR_Profiler_GetStats (int idx, char* nameOut, int nameOut_sz, int* countOut, double* totalMsOut, double* maxMsOut, char* histogramOut, int histogramOut_sz)
+{
+	const char* name = NULL;
+	const int* histogram = NULL;
+	if (!BR_ProfilerGetStats(idx, &name, countOut, totalMsOut, maxMsOut, &histogram))
+		return false;
+
+	if (nameOut && nameOut_sz > 0)
+		snprintf(nameOut, nameOut_sz, "%s", name);
+
+	if (histogramOut && histogramOut_sz > 0)
+	{
+		WDL_FastString string;
+		for (int i = 0; i < BR_PROFILER_BUCKETS; ++i)
+			string.AppendFormatted(32, i ? ",%d" : "%d", histogram[i]);
+		snprintf(histogramOut, histogramOut_sz, "%s", string.Get());
+	}
+	return true;
+}
+
 void BR_SetArrangeView (ReaProject* proj, double startPosition, double endPosition)
 {
 	GetSetArrangeView(proj, true, &startPosition, &endPosition);
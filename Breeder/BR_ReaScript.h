@@ -73,6 +73,7 @@ double          BR_GetMouseCursorContext_Position ();
 int             BR_GetMouseCursorContext_StretchMarker ();
 MediaItem_Take* BR_GetMouseCursorContext_Take ();
 MediaTrack*     BR_GetMouseCursorContext_Track ();
+void            BR_GetMouseCursorContext_CacheStats (int* hitsOut, int* missesOut);
 double          BR_GetNextGridDivision (double position);
 double          BR_GetPrevGridDivision (double position);
 double          BR_GetSetTrackSendInfo (MediaTrack* track, int category, int sendidx, const char* parmname, bool setNewValue, double newValue);
@@ -83,6 +84,9 @@ MediaItem*      BR_ItemAtMouseCursor (double* positionOut);
 bool            BR_MIDI_CCLaneRemove (void* midiEditor, int laneId);
 bool            BR_MIDI_CCLaneReplace (void* midiEditor, int laneId, int newCC);
 double          BR_PositionAtMouseCursor (bool checkRuler);
+bool            BR_Profiler_DumpChromeTrace (const char* filenameIn);
+void            BR_Profiler_Enable (bool enable, bool reset);
+bool            BR_Profiler_GetStats (int idx, char* nameOut, int nameOut_sz, int* countOut, double* totalMsOut, double* maxMsOut, char* histogramOut, int histogramOut_sz);
 void            BR_SetArrangeView (ReaProject* proj, double startPosition, double endPosition);
 bool            BR_SetItemEdges (MediaItem* item, double startTime, double endTime);
 void            BR_SetMediaItemImageResource (MediaItem* item, const char* imageIn, int imageFlags);
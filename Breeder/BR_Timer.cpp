@@ -28,6 +28,9 @@
 
 #include "stdafx.h"
 #include "BR_Timer.h"
+#include "BR_Util.h"
+
+#include <thread>
 
 void CommandTimer (COMMAND_T* ct, int val /*= 0*/, int valhw /*= 0*/, int relmode /*= 0*/, HWND hwnd /*= NULL*/, bool commandHook2 /*= false*/)
 {
@@ -175,3 +178,147 @@ void CommandTimer (COMMAND_T* ct, int val /*= 0*/, int valhw /*= 0*/, int relmod
 	void BR_Timer::Reset () {}
 	void BR_Timer::Progress (const char* message /*= NULL*/) {}
 #endif
+
+/******************************************************************************
+* Profiler                                                                    *
+******************************************************************************/
+const int PROFILER_RING_SIZE = 65536;
+
+struct BR_ProfilerStats
+{
+	WDL_FastString name;
+	int count;
+	double total, max;
+	int histogram[BR_PROFILER_BUCKETS];
+};
+
+struct BR_ProfilerEvent
+{
+	int stats;          // id in g_profilerStats
+	double start, end;  // time_precise()
+};
+
+bool g_brProfilerEnabled = false;
+
+static WDL_PtrList_DeleteOnDestroy<BR_ProfilerStats> g_profilerStats;
+static WDL_StringKeyedArray<int> g_profilerStatsByName;
+static WDL_TypedBuf<BR_ProfilerEvent> g_profilerRing;
+static int g_profilerRingPos = 0;   // next event to write
+static int g_profilerRingCount = 0; // number of valid events
+static double g_profilerStartTime = 0;
+static std::thread::id g_profilerThread;
+
+void BR_ProfilerEnable (bool enable, bool reset)
+{
+	if (reset)
+	{
+		g_profilerStats.Empty(true);
+		g_profilerStatsByName.DeleteAll();
+		g_profilerRingPos = 0;
+		g_profilerRingCount = 0;
+		g_profilerStartTime = time_precise();
+	}
+
+	if (enable)
+	{
+		if (!g_profilerStartTime)
+			g_profilerStartTime = time_precise();
+		if (!g_profilerRing.GetSize())
+			g_profilerRing.Resize(PROFILER_RING_SIZE, false);
+		g_profilerThread = std::this_thread::get_id(); // always called from the main thread
+	}
+	else
+	{
+		g_profilerRing.Resize(0); // keep stats, drop the trace buffer
+		g_profilerRingPos = 0;
+		g_profilerRingCount = 0;
+	}
+	g_brProfilerEnabled = enable;
+}
+
+void BR_ProfilerRecord (const char* name, double start, double end)
+{
+	if (!g_brProfilerEnabled || !name || std::this_thread::get_id() != g_profilerThread)
+		return;
+
+	int id = g_profilerStatsByName.Get(name, -1);
+	if (id < 0)
+	{
+		BR_ProfilerStats* stats = new BR_ProfilerStats;
+		stats->name.Set(name);
+		stats->count = 0;
+		stats->total = stats->max = 0;
+		memset(stats->histogram, 0, sizeof(stats->histogram));
+
+		id = g_profilerStats.GetSize();
+		g_profilerStats.Add(stats);
+		g_profilerStatsByName.Insert(name, id);
+	}
+
+	BR_ProfilerStats* stats = g_profilerStats.Get(id);
+	double duration = end - start;
+	++stats->count;
+	stats->total += duration;
+	if (duration > stats->max)
+		stats->max = duration;
+
+	int bucket = 0;
+	for (double us = duration * 1000000; us >= 2 && bucket < BR_PROFILER_BUCKETS - 1; us /= 2)
+		++bucket;
+	++stats->histogram[bucket];
+
+	if (g_profilerRing.GetSize())
+	{
+		BR_ProfilerEvent* event = g_profilerRing.Get() + g_profilerRingPos;
+		event->stats = id;
+		event->start = start;
+		event->end = end;
+		g_profilerRingPos = (g_profilerRingPos + 1) % g_profilerRing.GetSize();
+		if (g_profilerRingCount < g_profilerRing.GetSize())
+			++g_profilerRingCount;
+	}
+}
+
+bool BR_ProfilerGetStats (int id, const char** name, int* count, double* totalMs, double* maxMs, const int** histogram)
+{
+	BR_ProfilerStats* stats = g_profilerStats.Get(id);
+	if (!stats)
+		return false;
+
+	WritePtr(name,      stats->name.Get());
+	WritePtr(count,     stats->count);
+	WritePtr(totalMs,   stats->total * 1000);
+	WritePtr(maxMs,     stats->max * 1000);
+	WritePtr(histogram, (const int*)stats->histogram);
+	return true;
+}
+
+bool BR_ProfilerDumpChromeTrace (const char* file)
+{
+	FILE* f = fopenUTF8(file, "w");
+	if (!f)
+		return false;
+
+	fputs("{\"traceEvents\":[\n", f);
+
+	WDL_FastString name;
+	int size = g_profilerRing.GetSize();
+	for (int i = 0; i < g_profilerRingCount; ++i)
+	{
+		const BR_ProfilerEvent* event = g_profilerRing.Get() + (g_profilerRingPos - g_profilerRingCount + i + size) % size;
+
+		name.Set("");
+		for (const char* c = g_profilerStats.Get(event->stats)->name.Get(); *c; ++c)
+		{
+			if (*c == '"' || *c == '\\') name.Append("\\");
+			if ((unsigned char)*c >= 0x20)  name.Append(c, 1);
+		}
+
+		fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}\n",
+			i ? "," : "", name.Get(), (event->start - g_profilerStartTime) * 1000000, (event->end - event->start) * 1000000);
+	}
+
+	fputs("],\"displayTimeUnit\":\"ms\"}\n", f);
+	fclose(f);
+	return true;
+}
@@ -71,3 +71,34 @@ public:
 		#endif
 #endif
 };
+
+/******************************************************************************
+* Release mode profiler. Unlike BR_Timer it's always compiled in but disabled *
+* by default (see BR_ProfilerEnable or BR_Profiler_Enable in ReaScript) and   *
+* costs only a bool check when disabled.                                      *
+* Scopes are aggregated by name (count, total, max and log2 histogram of      *
+* durations) and recorded into a ring buffer of the last events that can be   *
+* dumped as Chrome trace JSON (chrome://tracing, Perfetto...).                *
+* Only main thread scopes are recorded (actions, timer slices and window      *
+* refreshes all run there), so no locking is needed. Names don't need to      *
+* outlive the scope, they are copied on first use.                            *
+******************************************************************************/
+extern bool g_brProfilerEnabled;
+
+const int BR_PROFILER_BUCKETS = 24; // bucket i counts durations in [2^i, 2^(i+1)) microseconds (bucket 0 includes < 1 us)
+
+void BR_ProfilerEnable (bool enable, bool reset);
+void BR_ProfilerRecord (const char* name, double start, double end);
+bool BR_ProfilerGetStats (int id, const char** name, int* count, double* totalMs, double* maxMs, const int** histogram); // returns false if id is out of range
+bool BR_ProfilerDumpChromeTrace (const char* file);
+
+class BR_ProfilerScope
+{
+public:
+	BR_ProfilerScope (const char* name) : m_name(g_brProfilerEnabled ? name : NULL), m_start(m_name ? time_precise() : 0) {}
+	~BR_ProfilerScope () { if (m_name) BR_ProfilerRecord(m_name, m_start, time_precise()); }
+
+private:
+	const char* m_name;
+	double m_start;
+};
@@ -719,271 +719,259 @@ void OpenAutoColor(COMMAND_T*)
 	g_pACWnd->Show(true, true);
 }
 
-void ApplyColorRuleToTrack(FlatSet<SWS_RuleTrack> *activeRules, SWS_RuleItem* rule, bool bDoColors, bool bDoIcons, bool bDoLayout, bool bForce)
+// Compiled track rule: filter type resolved once per pass instead of string compares per track
+struct SWS_CompiledRule
 {
-	if(rule->m_type == AC_TRACK)
+	SWS_RuleItem* m_rule;
+	int m_filter; // AC_ANY..AC_MIDIOUT, or -1 for a name filter
+};
+
+// Per project state of the last track pass, see AutoColorTrack()
+class SWS_RulePassState
+{
+public:
+	WDL_FastString m_sig; // rules + settings the last pass was made with
+	std::vector<std::vector<MediaTrack*> > m_orderedMatches; // tracks matching gradient/custom color rules
+};
+
+static SWSProjConfig<SWS_RulePassState> g_pACPass;
+
+// Compiles track rules, returns the mask of the filter types in use (1<<AC_xxx, 1<<NUM_FILTERTYPES for name filters)
+// _sig: identifies the rules and settings, a change requires all tracks to be re-evaluated
+static int CompileTrackRules(std::vector<SWS_CompiledRule>* _rules, WDL_FastString* _sig, bool bDoColors, bool bDoIcons, bool bDoLayout)
+{
+	int needs = 0;
+	bool custColors = false;
+	_sig->SetFormatted(64, "%d%d%d %d %d|", bDoColors, bDoIcons, bDoLayout, (int)g_crGradStart, (int)g_crGradEnd);
+	for (int i = 0; i < g_pACItems.GetSize(); i++)
 	{
-		if (!bDoColors && !bDoIcons && !bDoLayout) // NF: fix #936
-			return;
+		SWS_RuleItem* rule = g_pACItems.Get(i);
+		if (rule->m_type != AC_TRACK)
+			continue;
 
-		PreventUIRefresh(1);
+		SWS_CompiledRule cr = { rule, -1 };
+		for (int j = 0; j < NUM_FILTERTYPES; j++)
+			if (!strcmp(rule->m_str_filter.Get(), cFilterTypes[j])) {
+				cr.m_filter = j;
+				break;
+			}
+		needs |= 1 << (cr.m_filter >= 0 ? cr.m_filter : NUM_FILTERTYPES);
+		custColors |= (rule->m_color == -AC_CUSTOM-1);
+		_rules->push_back(cr);
 
-		int iCount = 0;
-		WDL_PtrList<MediaTrack> gradientTracks;
+		_sig->AppendFormatted(4096, "%d\t%s\t%s\t%s\t%s\n", rule->m_color, rule->m_str_filter.Get(), rule->m_icon.Get(), rule->m_layout[0].Get(), rule->m_layout[1].Get());
+	}
+	if (custColors)
+	{
+		UpdateCustomColors();
+		for (int i = 0; i < 16; i++)
+			_sig->AppendFormatted(16, "%d ", (int)g_custColors[i]);
+	}
+	return needs;
+}
 
-		if (rule->m_color == -AC_CUSTOM-1)
-			UpdateCustomColors();
+static void GetRuleTrackProps(const SWS_FolderNode* node, int needs, SWS_RuleTrackProps* _props)
+{
+	MediaTrack* tr = node->tr;
+	_props->m_depth = node->depth;
+	_props->m_folder = node->type;
 
-		// Check all tracks for matching strings/properties
-		MediaTrack* temp = NULL;
-		const int numTracks = GetNumTracks();
-		activeRules->reserve(numTracks);
-		for (int i = 0; i <= numTracks; i++)
-		{
-			MediaTrack* tr = i ? GetTrack(nullptr, i - 1) : GetMasterTrack(nullptr);
-			bool bColor = bDoColors;
-			bool bIcon  = bDoIcons;
-			bool bLayout[2] = { bDoLayout, bDoLayout };
+	if (needs & ((1 << AC_UNNAMED) | (1 << NUM_FILTERTYPES)))
+	{
+		const char* cName = (const char*)GetSetMediaTrackInfo(tr, "P_NAME", NULL);
+		_props->m_name.Set(cName ? cName : "");
+	}
+	if (needs & (1 << AC_RECEIVE))
+		_props->m_bReceive = GetSetTrackSendInfo(tr, -1, 0, "P_SRCTRACK", NULL) != NULL;
+	if (needs & (1 << AC_REC_ARM))
+	{
+		int* ra = (int*)GetSetMediaTrackInfo(tr, "I_RECARM", NULL);
+		_props->m_recArm = ra ? *ra : 0;
+	}
+	if (needs & (1 << AC_VCA_MASTER)) // incl. newly added groups 33 - 64
+		_props->m_bVcaMaster = GetSetTrackGroupMembership(tr, "VOLUME_VCA_MASTER", 0, 0) || GetSetTrackGroupMembershipHigh(tr, "VOLUME_VCA_MASTER", 0, 0);
+	if (needs & ((1 << AC_AUDIOIN) | (1 << AC_MIDIIN)))
+		_props->m_recInput = *(int*)GetSetMediaTrackInfo(tr, "I_RECINPUT", NULL);
+	if (needs & (1 << AC_AUDIOOUT))
+		_props->m_hwOuts = GetTrackNumSends(tr, 1);
+	if (needs & (1 << AC_INSTRUMENT))
+		_props->m_bInstrument = TrackFX_GetInstrument(tr) >= 0;
+	if (needs & (1 << AC_MIDIOUT))
+		_props->m_midiHwOut = *(int*)GetSetMediaTrackInfo(tr, "I_MIDIHWOUT", NULL);
+}
 
-			auto pACTrack = activeRules->find(tr);
+static bool RuleMatchesTrack(const SWS_CompiledRule& cr, const SWS_RuleTrackProps& props, bool bMaster)
+{
+	if (bMaster) // ignore master for most things
+		return cr.m_filter == AC_MASTER;
 
-			if (pACTrack != activeRules->end())
-			{
-				// If already modified by a different rule, or ignoring the color/icon/layout ignore this track
-				if (pACTrack->m_bColored || rule->m_color == -AC_IGNORE-1)
-					bColor = false;
+	switch (cr.m_filter)
+	{
+		case AC_ANY:        return true;
+		case AC_UNNAMED:    return !props.m_name.GetLength();
+		case AC_FOLDER:     return props.m_folder == 1;
+		case AC_CHILDREN:   return props.m_depth >= 1;
+		case AC_RECEIVE:    return props.m_bReceive;
+		case AC_MASTER:     return false;
+		case AC_REC_ARM:    return props.m_recArm != 0;
+		case AC_VCA_MASTER: return props.m_bVcaMaster;
+		case AC_INSTRUMENT: return props.m_bInstrument;
+		case AC_AUDIOIN:    return props.m_recInput >= 0 && !(props.m_recInput & 4096); // !none && !MIDI
+		case AC_AUDIOOUT:   return props.m_hwOuts != 0;
+		case AC_MIDIIN:     return props.m_recInput >= 0 && (props.m_recInput & 4096); // !none && MIDI
+		case AC_MIDIOUT:    return (props.m_midiHwOut >> 5) >= 0;
+	}
+	// Check for name match
+	return stristr(props.m_name.Get(), cr.m_rule->m_str_filter.Get()) != NULL;
+}
 
-				if (pACTrack->m_bIconed || !rule->m_icon.Get()[0])
-					bIcon = false;
+// Applies a rule to the tracks that need to be re-evaluated (m_bDirty), tracks are in project order (master first)
+void ApplyColorRuleToTrack(const std::vector<const SWS_RuleTrack*>& tracks, int iRule, SWS_RuleItem* rule, bool bDoColors, bool bDoIcons, bool bDoLayout, bool bForce)
+{
+	if (!bDoColors && !bDoIcons && !bDoLayout) // NF: fix #936
+		return;
 
-				for (int k=0; k<2; k++)
-					if (pACTrack->m_bLayouted[k] || !rule->m_layout[k].Get()[0])
-						bLayout[k] = false;
-			}
-			else
-				pACTrack = activeRules->insert(tr).first;
+	PreventUIRefresh(1);
 
-			// Do the track rule matching
-			if (bColor || bIcon || bLayout[0] || bLayout[1])
-			{
-				bool bMatch = false;
+	int iCount = 0;
+	WDL_PtrList<const SWS_RuleTrack> gradientTracks;
 
-				if (i) // ignore master for most things
-				{
-					// Check "special" rules first:
-					if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_FOLDER]) == 0)
-					{
-						int iType;
-						GetFolderDepth(tr, &iType, &temp);
-						if (iType == 1)
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_CHILDREN]) == 0)
-					{
-						temp = CSurf_TrackFromID(0, false); // JFB fix: 'temp' could be out of sync
-						if (GetFolderDepth(tr, NULL, &temp) >= 1)
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_RECEIVE]) == 0)
-					{
-						if (GetSetTrackSendInfo(tr, -1, 0, "P_SRCTRACK", NULL))
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_UNNAMED]) == 0)
-					{
-						char* cName = (char*)GetSetMediaTrackInfo(tr, "P_NAME", NULL);
-						if (!cName || !cName[0])
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_REC_ARM]) == 0)
-					{
-						int* ra = (int*)GetSetMediaTrackInfo(tr, "I_RECARM", NULL);
-						if (ra && *ra)
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_VCA_MASTER]) == 0)
-					{
-						int iVcaMaster = GetSetTrackGroupMembership(tr, "VOLUME_VCA_MASTER", 0, 0);
+	for (const SWS_RuleTrack* pACTrack : tracks)
+	{
+		if (!pACTrack->m_bDirty || !pACTrack->Matches(iRule))
+			continue;
 
-						// check newly added groups 33 - 64
-						int iVcaMasterHigh = GetSetTrackGroupMembershipHigh(tr, "VOLUME_VCA_MASTER", 0, 0);
+		MediaTrack* tr = pACTrack->m_pTr;
+		bool bColor = bDoColors;
+		bool bIcon  = bDoIcons;
+		bool bLayout[2] = { bDoLayout, bDoLayout };
 
-						if (iVcaMaster || iVcaMasterHigh)
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_AUDIOIN]) == 0)
-					{
-						int input = *(int*)GetSetMediaTrackInfo(tr, "I_RECINPUT", NULL);
-						if (input >= 0 && !(input & 4096)) { // !none && !MIDI
-							bMatch = true;
-						}
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_AUDIOOUT]) == 0)
-					{
-						int hwouts = GetTrackNumSends(tr, 1);
-						if (hwouts) {
-							bMatch = true;
-						}
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_INSTRUMENT]) == 0)
-					{
-						if (TrackFX_GetInstrument(tr) >= 0)
-							bMatch = true;
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_MIDIIN]) == 0)
-					{
-						int input = *(int*)GetSetMediaTrackInfo(tr, "I_RECINPUT", NULL);
-						if (input >= 0 && (input & 4096)) { // !none && MIDI
-							bMatch = true;
-						}
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_MIDIOUT]) == 0)
-					{
-						int midihw = *(int*)GetSetMediaTrackInfo(tr, "I_MIDIHWOUT", NULL);
-						int mididv = midihw >> 5;
-						// int midich = midihw & 0xF;
-						if (mididv >= 0) {
-							bMatch = true;
-						}
-					}
-					else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_ANY]) == 0)
-					{
-						bMatch = true;
-					}
-					else // Check for name match
-					{
-						char* cName = (char*)GetSetMediaTrackInfo(tr, "P_NAME", NULL);
-						if (cName && stristr(cName, rule->m_str_filter.Get()))
-							bMatch = true;
-					}
-				}
-				else if (strcmp(rule->m_str_filter.Get(), cFilterTypes[AC_MASTER]) == 0)
-				{	// Check master rule
-					bMatch = true;
-				}
+		// If already modified by a different rule, or ignoring the color/icon/layout ignore this track
+		if (pACTrack->m_bColored || rule->m_color == -AC_IGNORE-1)
+			bColor = false;
 
-				if (bMatch)
-				{
-					// Set the color
-					if (bColor)
-					{
-						int iCurColor = *(int*)GetSetMediaTrackInfo(tr, "I_CUSTOMCOLOR", NULL);
-						if (!(iCurColor & 0x1000000))
-							iCurColor = 0;
-						int newCol = iCurColor;
-
-						if (rule->m_color == -AC_RANDOM-1)
-						{
-							// Only randomize once
-							if (!(iCurColor & 0x1000000))
-								newCol = RGB(rand() % 256, rand() % 256, rand() % 256) | 0x1000000;
-						}
-						else if (rule->m_color == -AC_CUSTOM-1)
-						{
-							if (!AllBlack())
-								while(!(newCol = g_custColors[iCount++ % 16]));
-							newCol |= 0x1000000;
-						}
-						else if (rule->m_color == -AC_GRADIENT-1)
-							gradientTracks.Add(tr);
-						else if (rule->m_color == -AC_NONE-1)
-							newCol = 0;
-						else if (rule->m_color == -AC_PARENT-1)
-						{
-							MediaTrack* parent = (MediaTrack*)GetSetMediaTrackInfo(tr, "P_PARTRACK", NULL);
-							if (parent)
-							{
-								int pcol = *(int*)GetSetMediaTrackInfo(parent, "I_CUSTOMCOLOR", NULL);
-								if (pcol & 0x1000000) // Only color like parent if the parent has color (maybe not?)
-									newCol = pcol;
-							}
-						}
-						else
-							newCol = SWS_ColorToNative(rule->m_color | 0x1000000);
+		if (pACTrack->m_bIconed || !rule->m_icon.Get()[0])
+			bIcon = false;
 
-						// Only set the color if the user hasn't changed the color manually (but record it as being changed)
-						if ((bForce || iCurColor == SWS_ColorToNative(pACTrack->m_col)) && newCol != iCurColor)
-						{
-							GetSetMediaTrackInfo(tr, "I_CUSTOMCOLOR", &newCol);
-						}
+		for (int k=0; k<2; k++)
+			if (pACTrack->m_bLayouted[k] || !rule->m_layout[k].Get()[0])
+				bLayout[k] = false;
 
-						pACTrack->m_col = SWS_ColorFromNative(newCol);
-						pACTrack->m_bColored = true;
-					}
+		// Set the color
+		if (bColor)
+		{
+			int iCurColor = *(int*)GetSetMediaTrackInfo(tr, "I_CUSTOMCOLOR", NULL);
+			if (!(iCurColor & 0x1000000))
+				iCurColor = 0;
+			int newCol = iCurColor;
 
-					if (bIcon)
-					{
-						if (_stricmp(rule->m_icon.Get(), pACTrack->m_icon.Get()))
-						{
-							const char *cur = (const char*)GetSetMediaTrackInfo(tr, "P_ICON", NULL); // requires REAPER v5.15pre6+
-							cur = GetShortResourcePath("Data" WDL_DIRCHAR_STR "track_icons", cur);
-							if (cur && _stricmp(cur, rule->m_icon.Get()))
-							{
-								// Only overwrite the icon if there's no icon, or we're forcing, or we set it ourselves earlier
-								if (bForce || !_stricmp(cur, pACTrack->m_icon.Get()))
-								{
-									GetSetMediaTrackInfo(tr, "P_ICON", (void*)rule->m_icon.Get());
-								}
-							}
-							pACTrack->m_icon.Set(rule->m_icon.Get());
-						}
-						pACTrack->m_bIconed = true;
-					}
+			if (rule->m_color == -AC_RANDOM-1)
+			{
+				// Only randomize once
+				if (!(iCurColor & 0x1000000))
+					newCol = RGB(rand() % 256, rand() % 256, rand() % 256) | 0x1000000;
+			}
+			else if (rule->m_color == -AC_CUSTOM-1)
+			{
+				if (!AllBlack())
+					while(!(newCol = g_custColors[iCount++ % 16]));
+				newCol |= 0x1000000;
+			}
+			else if (rule->m_color == -AC_GRADIENT-1)
+				gradientTracks.Add(pACTrack);
+			else if (rule->m_color == -AC_NONE-1)
+				newCol = 0;
+			else if (rule->m_color == -AC_PARENT-1)
+			{
+				MediaTrack* parent = (MediaTrack*)GetSetMediaTrackInfo(tr, "P_PARTRACK", NULL);
+				if (parent)
+				{
+					int pcol = *(int*)GetSetMediaTrackInfo(parent, "I_CUSTOMCOLOR", NULL);
+					if (pcol & 0x1000000) // Only color like parent if the parent has color (maybe not?)
+						newCol = pcol;
+				}
+			}
+			else
+				newCol = SWS_ColorToNative(rule->m_color | 0x1000000);
+
+			// Only set the color if the user hasn't changed the color manually (but record it as being changed)
+			if ((bForce || iCurColor == SWS_ColorToNative(pACTrack->m_col)) && newCol != iCurColor)
+			{
+				GetSetMediaTrackInfo(tr, "I_CUSTOMCOLOR", &newCol);
+			}
+
+			pACTrack->m_col = SWS_ColorFromNative(newCol);
+			pACTrack->m_bColored = true;
+		}
 
-					// Set the layout
-					for (int k=0; k<2; k++) if (bLayout[k])
+		if (bIcon)
+		{
+			if (_stricmp(rule->m_icon.Get(), pACTrack->m_icon.Get()))
+			{
+				const char *cur = (const char*)GetSetMediaTrackInfo(tr, "P_ICON", NULL); // requires REAPER v5.15pre6+
+				cur = GetShortResourcePath("Data" WDL_DIRCHAR_STR "track_icons", cur);
+				if (cur && _stricmp(cur, rule->m_icon.Get()))
+				{
+					// Only overwrite the icon if there's no icon, or we're forcing, or we set it ourselves earlier
+					if (bForce || !_stricmp(cur, pACTrack->m_icon.Get()))
 					{
-						pACTrack->m_bLayouted[k] = true;
-						if (!_stricmp(rule->m_layout[k].Get(), pACTrack->m_layout[k].Get()))
-							continue;
-
-						// 'normal' track layout
-						if (_stricmp(rule->m_layout[k].Get(), cHideLayout))
-						{
-							const bool needUnhide = !_stricmp(pACTrack->m_layout[k].Get(), cHideLayout) && !IsTrackVisible(tr, k ? true : false);
-							const char *curlayout = (const char*)GetSetMediaTrackInfo(tr, k ? "P_MCP_LAYOUT" : "P_TCP_LAYOUT", NULL);
-							if (curlayout && _stricmp(curlayout, rule->m_layout[k].Get()))
-							{
-								// Only overwrite the layout if there's no layout, or we're forcing, or we set it ourselves earlier
-								if (bForce || needUnhide || !_stricmp(curlayout, pACTrack->m_layout[k].Get()))
-									GetSetMediaTrackInfo(tr, k ? "P_MCP_LAYOUT" : "P_TCP_LAYOUT", (void*)rule->m_layout[k].Get());
-							}
-							if (needUnhide)
-							{
-								GetSetMediaTrackInfo(tr, k ? "B_SHOWINMIXER" : "B_SHOWINTCP", &g_i1); // hide the track
-								TrackList_AdjustWindows(k ? false : true); // t=208275
-							}
-						}
-						// '(hide)' layout
-						// Only hide the track if visible, or we're forcing, or we hid it ourselves earlier
-						else if (IsTrackVisible(tr, k ? true : false))
-						{
-							if (bForce || IsTrackVisible(pACTrack->m_pTr, k ? true : false))
-							{
-								GetSetMediaTrackInfo(tr, k ? "B_SHOWINMIXER" : "B_SHOWINTCP", &g_i0); // hide the track
-								TrackList_AdjustWindows(k ? false : true); // t=208275
-							}
-						}
-						pACTrack->m_layout[k].Set(rule->m_layout[k].Get());
+						GetSetMediaTrackInfo(tr, "P_ICON", (void*)rule->m_icon.Get());
 					}
-				} // /if (bMatch)
-			} // /Do the track rule matching
-		} // /iterate through all tracks
+				}
+				pACTrack->m_icon.Set(rule->m_icon.Get());
+			}
+			pACTrack->m_bIconed = true;
+		}
 
-		// Handle gradients
-		for (int i = 0; i < gradientTracks.GetSize(); i++)
+		// Set the layout
+		for (int k=0; k<2; k++) if (bLayout[k])
 		{
-			int newCol = g_crGradStart | 0x1000000;
-			if (i && gradientTracks.GetSize() > 1)
-				newCol = CalcGradient(g_crGradStart, g_crGradEnd, (double)i / (gradientTracks.GetSize()-1)) | 0x1000000;
-			auto match = activeRules->find(gradientTracks.Get(i));
-			if (match != activeRules->end())
-				match->m_col = newCol;
-			SetMediaTrackInfo_Value(gradientTracks.Get(i), "I_CUSTOMCOLOR", SWS_ColorToNative(newCol));
+			pACTrack->m_bLayouted[k] = true;
+			if (!_stricmp(rule->m_layout[k].Get(), pACTrack->m_layout[k].Get()))
+				continue;
+
+			// 'normal' track layout
+			if (_stricmp(rule->m_layout[k].Get(), cHideLayout))
+			{
+				const bool needUnhide = !_stricmp(pACTrack->m_layout[k].Get(), cHideLayout) && !IsTrackVisible(tr, k ? true : false);
+				const char *curlayout = (const char*)GetSetMediaTrackInfo(tr, k ? "P_MCP_LAYOUT" : "P_TCP_LAYOUT", NULL);
+				if (curlayout && _stricmp(curlayout, rule->m_layout[k].Get()))
+				{
+					// Only overwrite the layout if there's no layout, or we're forcing, or we set it ourselves earlier
+					if (bForce || needUnhide || !_stricmp(curlayout, pACTrack->m_layout[k].Get()))
+						GetSetMediaTrackInfo(tr, k ? "P_MCP_LAYOUT" : "P_TCP_LAYOUT", (void*)rule->m_layout[k].Get());
+				}
+				if (needUnhide)
+				{
+					GetSetMediaTrackInfo(tr, k ? "B_SHOWINMIXER" : "B_SHOWINTCP", &g_i1); // hide the track
+					TrackList_AdjustWindows(k ? false : true); // t=208275
+				}
+			}
+			// '(hide)' layout
+			// Only hide the track if visible, or we're forcing, or we hid it ourselves earlier
+			else if (IsTrackVisible(tr, k ? true : false))
+			{
+				if (bForce || IsTrackVisible(pACTrack->m_pTr, k ? true : false))
+				{
+					GetSetMediaTrackInfo(tr, k ? "B_SHOWINMIXER" : "B_SHOWINTCP", &g_i0); // hide the track
+					TrackList_AdjustWindows(k ? false : true); // t=208275
+				}
+			}
+			pACTrack->m_layout[k].Set(rule->m_layout[k].Get());
 		}
+	}
 
-		PreventUIRefresh(-1);
+	// Handle gradients
+	for (int i = 0; i < gradientTracks.GetSize(); i++)
+	{
+		int newCol = g_crGradStart | 0x1000000;
+		if (i && gradientTracks.GetSize() > 1)
+			newCol = CalcGradient(g_crGradStart, g_crGradEnd, (double)i / (gradientTracks.GetSize()-1)) | 0x1000000;
+		gradientTracks.Get(i)->m_col = newCol;
+		SetMediaTrackInfo_Value(gradientTracks.Get(i)->m_pTr, "I_CUSTOMCOLOR", SWS_ColorToNative(newCol));
 	}
+
+	PreventUIRefresh(-1);
 }
 
 // Here's the meat and potatoes, apply the colors/icons!
@@ -995,40 +983,109 @@ void AutoColorTrack(bool bForce)
 	bRecurse = true;
 
 	auto *activeRules = g_pACTracks.Get();
+	SWS_RulePassState* pass = g_pACPass.Get();
 
 	// If forcing, start over with the saved track list
 	if (bForce)
 		activeRules->clear();
 
-	// Clear the applied bits and cleanup entries belonging to deleted tracks
-	for (auto it = activeRules->begin(); it != activeRules->end();)
+	// Cleanup entries belonging to deleted tracks
+	activeRules->erase_if([](const SWS_RuleTrack &rt) { return !ValidatePtr(rt.m_pTr, "MediaTrack*"); });
+
+	bool bDoColors  = g_bACEnabled || bForce;
+	bool bDoIcons   = g_bAIEnabled || bForce;
+	bool bDoLayouts = g_bALEnabled || bForce;
+
+	// Compile the rules, any change requires a full pass
+	std::vector<SWS_CompiledRule> rules;
+	WDL_FastString sig;
+	const int needs = CompileTrackRules(&rules, &sig, bDoColors, bDoIcons, bDoLayouts);
+	const bool bAllDirty = bForce || strcmp(sig.Get(), pass->m_sig.Get());
+	pass->m_sig.Set(&sig);
+
+	// Get entries for all tracks, in project order (inserting may move entries: done first)
+	const int numTracks = GetNumTracks();
+	activeRules->reserve(numTracks + 1);
+	for (int i = 0; i <= numTracks; i++)
+		activeRules->insert(i ? GetTrack(nullptr, i - 1) : GetMasterTrack(nullptr));
+
+	std::vector<const SWS_RuleTrack*> tracks;
+	tracks.reserve(numTracks + 1);
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = 0; i <= numTracks; i++)
 	{
-		if (!ValidatePtr(it->m_pTr, "MediaTrack*"))
+		MediaTrack* tr = i ? GetTrack(nullptr, i - 1) : GetMasterTrack(nullptr);
+		const SWS_RuleTrack* pACTrack = &*activeRules->find(tr);
+		tracks.push_back(pACTrack);
+
+		// Only re-evaluate tracks whose matched properties have changed
+		SWS_RuleTrackProps props;
+		if (i)
+			GetRuleTrackProps(ft->Get(i), needs, &props);
+		pACTrack->m_bDirty = bAllDirty || !pACTrack->m_bEvaluated || !(props == pACTrack->m_props);
+		if (pACTrack->m_bDirty)
 		{
-			it = activeRules->erase(it);
-			continue;
+			pACTrack->m_props = props;
+			pACTrack->m_matches.clear();
+			for (int j = 0; j < (int)rules.size(); j++)
+				if (RuleMatchesTrack(rules[j], props, !i))
+					pACTrack->m_matches.push_back(j);
+			pACTrack->m_bEvaluated = true;
 		}
+	}
 
-		it->m_bColored = false;
-		it->m_bIconed  = false;
-		it->m_bLayouted[0] = false;
-		it->m_bLayouted[1] = false;
-		++it;
+	// Colors of gradient/custom rules depend on all matching tracks, and parent colors on other tracks:
+	// re-evaluate all tracks of such rules if any of them has changed
+	pass->m_orderedMatches.resize(rules.size());
+	for (int j = 0; j < (int)rules.size(); j++)
+	{
+		const int col = rules[j].m_rule->m_color;
+		if (col == -AC_PARENT-1)
+		{
+			for (const SWS_RuleTrack* pACTrack : tracks)
+				if (pACTrack->Matches(j))
+					pACTrack->m_bDirty = true;
+		}
+		else if (col == -AC_GRADIENT-1 || col == -AC_CUSTOM-1)
+		{
+			std::vector<MediaTrack*> matches;
+			bool bDirty = false;
+			for (const SWS_RuleTrack* pACTrack : tracks)
+				if (pACTrack->Matches(j)) {
+					matches.push_back(pACTrack->m_pTr);
+					bDirty |= pACTrack->m_bDirty;
+				}
+			if (bDirty || matches != pass->m_orderedMatches[j])
+				for (const SWS_RuleTrack* pACTrack : tracks)
+					if (pACTrack->Matches(j))
+						pACTrack->m_bDirty = true;
+			pass->m_orderedMatches[j].swap(matches);
+		}
 	}
 
-	// Apply the rules
-	bool bDoColors  = g_bACEnabled || bForce;
-	bool bDoIcons   = g_bAIEnabled || bForce;
-	bool bDoLayouts = g_bALEnabled || bForce;
+	// Clear the applied bits of the tracks to re-evaluate, others keep the result of the previous pass
+	for (const SWS_RuleTrack* pACTrack : tracks)
+	{
+		if (!pACTrack->m_bDirty)
+			continue;
+		pACTrack->m_bColored = false;
+		pACTrack->m_bIconed  = false;
+		pACTrack->m_bLayouted[0] = false;
+		pACTrack->m_bLayouted[1] = false;
+	}
 
+	// Apply the rules
 	PreventUIRefresh(1);
 
-	for (int i = 0; i < g_pACItems.GetSize(); i++)
-		ApplyColorRuleToTrack(activeRules, g_pACItems.Get(i), bDoColors, bDoIcons, bDoLayouts, bForce);
+	for (int j = 0; j < (int)rules.size(); j++)
+		ApplyColorRuleToTrack(tracks, j, rules[j].m_rule, bDoColors, bDoIcons, bDoLayouts, bForce);
 
 	// Remove colors/icons if necessary
-	for (auto pACTrack = activeRules->begin(); pACTrack != activeRules->end(); ++pACTrack)
+	for (const SWS_RuleTrack* pACTrack : tracks)
 	{
+		if (!pACTrack->m_bDirty)
+			continue;
+
 		if (bDoColors && !pACTrack->m_bColored && pACTrack->m_col)
 		{
 			int iCurColor = *(int*)GetSetMediaTrackInfo(pACTrack->m_pTr, "I_CUSTOMCOLOR", NULL);
@@ -1258,6 +1315,7 @@ static void BeginLoadProjectState(bool isUndo, struct project_config_extension_t
 {
 	g_pACTracks.Cleanup();
 	g_pACTracks.Get()->clear();
+	g_pACPass.Cleanup();
 }
 
 static project_config_extension_t g_projectconfig = { ProcessExtensionLine, SaveExtensionConfig, BeginLoadProjectState, NULL };
@@ -45,21 +45,47 @@ public:
 	WDL_FastString m_icon,m_layout[2];
 };
 
+// Track properties rules are matched against, only the ones used by rules are read
+class SWS_RuleTrackProps
+{
+public:
+	SWS_RuleTrackProps()
+		:m_folder(0),m_depth(0),m_recArm(0),m_recInput(-1),m_midiHwOut(-1),m_hwOuts(0),m_bReceive(false),m_bVcaMaster(false),m_bInstrument(false) {}
+
+	bool operator==(const SWS_RuleTrackProps &o) const
+	{
+		return m_folder == o.m_folder && m_depth == o.m_depth && m_recArm == o.m_recArm &&
+			m_recInput == o.m_recInput && m_midiHwOut == o.m_midiHwOut && m_hwOuts == o.m_hwOuts &&
+			m_bReceive == o.m_bReceive && m_bVcaMaster == o.m_bVcaMaster && m_bInstrument == o.m_bInstrument &&
+			!strcmp(m_name.Get(), o.m_name.Get());
+	}
+
+	WDL_FastString m_name;
+	int m_folder, m_depth, m_recArm, m_recInput, m_midiHwOut, m_hwOuts;
+	bool m_bReceive, m_bVcaMaster, m_bInstrument;
+};
+
 class SWS_RuleTrack
 {
 public:
 	SWS_RuleTrack(MediaTrack* tr)
-		:m_pTr(tr),m_col(0),m_bColored(false),m_bIconed(false)
+		:m_pTr(tr),m_col(0),m_bColored(false),m_bIconed(false),m_bEvaluated(false),m_bDirty(true)
 	{
 		m_bLayouted[0]=m_bLayouted[1]=false;
 	}
 
 	bool operator<(const SWS_RuleTrack &o) const { return m_pTr < o.m_pTr; }
+	bool Matches(int iRule) const { return std::binary_search(m_matches.begin(), m_matches.end(), iRule); }
 
 	MediaTrack* m_pTr; // constant sort key
 	mutable bool m_bColored, m_bIconed, m_bLayouted[2];
 	mutable int m_col;
 	mutable WDL_FastString m_icon, m_layout[2];
+
+	// rule matching cache, see AutoColorTrack()
+	mutable SWS_RuleTrackProps m_props;
+	mutable std::vector<int> m_matches; // sorted indexes of the matching (compiled) rules
+	mutable bool m_bEvaluated, m_bDirty;
 };
 
 class SWS_AutoColorView : public SWS_ListView
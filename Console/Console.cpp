@@ -48,8 +48,6 @@ static DWORD g_dwLastKeyMsg = 0;
 #define CONSOLE_WINDOWPOS_KEY "ReaConsoleWindowPos"
 bool g_bCloseOnReturnPref = false;
 
-void ParseTrackId(char* strId, bool bReset = true);
-void ProcessCommand(CONSOLE_COMMAND command, const char* args);
 const char* StatusString(CONSOLE_COMMAND command, const char* args);
 
 typedef struct CUSTOM_COMMAND
@@ -187,48 +185,27 @@ CONSOLE_COMMAND ParseConsoleCommand(char* strCommand, char** trackid, char** arg
 	return command;
 }
 
-// ParseId fills in array of ints (g_selTracks.Get()) according to id string
-void ParseTrackId(char* strId, bool bReset)
+// Compiled track ids, see CompileTrackId()
+enum {
+	TRACKID_NONE=0, // invalid id (e.g. bad range)
+	TRACKID_SELECTED,
+	TRACKID_ALL,
+	TRACKID_RANGE,
+	TRACKID_WILDCARD,
+	TRACKID_NAME    // exact name or number, with "auto complete"
+};
+
+static void CompileTrackTerm(char* strId, WDL_PtrList<ConsoleTrackTerm>* terms)
 {
-	int track;
-	const char* cName;
+	ConsoleTrackTerm* t = terms->Add(new ConsoleTrackTerm);
 	char* p;
-	bool bChildren = false;
-	bool bInvert = false;
-
-	if (!strId || !GetNumTracks())
-		return;
-
-	if (bReset)
-	{
-		g_selTracks.Resize(GetNumTracks(), false);
-		memset(g_selTracks.Get(), 0, g_selTracks.GetSize() * sizeof(int));
-	}
-
-	// Comma seperated list or whitespace? strip and recall
-	if (strchr(strId, ','))
-	{
-		char temp[128];
-		char* token;
-		strncpy(temp, strId, 128);
-		temp[127]=0; // Just in case
-		token = strtok(temp, ",");
-		if (!token)
-			ParseTrackId((char*)"", false);
-		while (token)
-		{
-			ParseTrackId(token, false);
-			token = strtok(NULL, ",");
-		}
-		return;
-	}
 
 	// Strip out / and signify a child
 	while ((p = strchr(strId, '/')) != NULL)
 	{
 		for (; *p; p++)
 			*p = *(p+1);
-		bChildren = true;
+		t->children = true;
 	}
 
 	// Ignore the beginning spaces
@@ -239,127 +216,189 @@ void ParseTrackId(char* strId, bool bReset)
 	if (strId[0] == '!')
 	{
 		strId++;
-		bInvert = true;
+		t->invert = true;
 	}
 
+	t->str.Set(strId);
+
 	// If the string is "all" or exactly "*", select all tracks.
 	if (_stricmp(strId, __LOCALIZE("all","sws_DLG_100")) == 0 || strcmp(strId, "*") == 0)
-		for (track = 0; track < GetNumTracks(); track++)
-			g_selTracks.Get()[track] = 1;
+		t->type = TRACKID_ALL;
 
 	// If the string is empty, use the tracks' selected flags
 	else if (strId[0] == 0)
-		for (track = 0; track < GetNumTracks(); track++)
-		{
-			// If tracks were selected before (because of a comma separated list) don't change it here.
-			if (g_selTracks.Get()[track])
-				break;
-			int iSel = *((int*)GetSetMediaTrackInfo(CSurf_TrackFromID(track+1, false), "I_SELECTED", NULL));
-			g_selTracks.Get()[track] = iSel;
-		}
+		t->type = TRACKID_SELECTED;
 
 	// If a range is specified, select those numbers
 	else if ((p = strchr(strId, '-')) != NULL)
 	{
 		// Make sure the string is valid:
 		int nondigchars = 0;
-		for (int i = 0; i < (int)strlen(strId); i++)
+		for (int i = 0; strId[i]; i++)
 			if (!isdigit(strId[i]))
 				nondigchars++;
 		if (nondigchars != 1)
-			return;
+			return; // TRACKID_NONE
 
-		int start = atol(strId);
-		int end = atol(p+1);
-		if (start < 1)
-			start = 1;
-		if (end > GetNumTracks())
-			end = GetNumTracks();
-		for (track = start-1; track < end; track++)
-			g_selTracks.Get()[track] = 1;
+		t->type = TRACKID_RANGE;
+		t->num = max(1, atoi(strId));
+		t->num2 = atoi(p+1);
 	}
-	
+
 	// If a wildcard is in the string, use loose matches
-	else if ((p = strchr(strId, '*')) != NULL)
+	else if (strchr(strId, '*'))
+		t->type = TRACKID_WILDCARD;
+
+	// Exact number or name matches
+	else
+	{
+		t->type = TRACKID_NAME;
+		t->num = atoi(strId);
+	}
+}
+
+// Comma separated lists are compiled as several terms, applied in order
+static void CompileTrackId(const char* strId, WDL_PtrList<ConsoleTrackTerm>* terms)
+{
+	terms->Empty(true);
+
+	WDL_FastString str(strId);
+	char* tokens = (char*)str.Get();
+	if (strchr(tokens, ','))
 	{
-		char* strMatch = NULL;
-		for (track = 0; track < GetNumTracks(); track++)
+		char* token = strtok(tokens, ",");
+		if (!token)
+			CompileTrackTerm((char*)"", terms);
+		while (token)
 		{
-			cName = (const char*)GetSetMediaTrackInfo(CSurf_TrackFromID(track+1, false), "P_NAME", NULL);
-			if (cName && cName[0])
-			{
-				if (p == strId && _strnicmp(strId+1, cName+1+strlen(cName)-strlen(strId), strlen(strId)-1) == 0)
-					g_selTracks.Get()[track] = 1;
-				else if (p-strId == strlen(strId) - 1 && _strnicmp(strId, cName, strlen(strId)-1) == 0)
-					g_selTracks.Get()[track] = 1;
-				// This "should" be the double wildcard case, but check anyway
-				else if (strId[0] == '*' && strlen(strId) > 2 && strId[strlen(strId)-1] == '*')
-				{
-					if (!strMatch)
-					{
-						strMatch = new char[strlen(strId)-1];
-						lstrcpyn(strMatch, strId+1, (int)strlen(strId)-1);
-					}
-					if (stristr(cName, strMatch))
-						g_selTracks.Get()[track] = 1;
-				}
-			}
+			CompileTrackTerm(token, terms);
+			token = strtok(NULL, ",");
 		}
-		delete [] strMatch;
 	}
-	// Check for exact numeric
-	else if ((track = atol(strId)) > 0 && track <= GetNumTracks())
-		g_selTracks.Get()[track-1] = 1;
-
-	// Check for exact name matches, with "auto compelete"
-	//   e.g. if there's no exact match, but only one track that starts with the string, select that one
 	else
+		CompileTrackTerm(tokens, terms);
+}
+
+// Track lookups done once per command run, see ConsoleOp::MatchTracks()
+static WDL_TypedBuf<MediaTrack*> g_tracks;
+
+static const char* GetConsoleTrackName(int track)
+{
+	const char* cName = (const char*)GetSetMediaTrackInfo(g_tracks.Get()[track], "P_NAME", NULL);
+	return cName ? cName : "";
+}
+
+// Fills in array of ints (g_selTracks.Get()) according to a compiled track id term
+static void MatchTrackTerm(const ConsoleTrackTerm* t)
+{
+	const int nbTracks = g_tracks.GetSize();
+	int* sel = g_selTracks.Get();
+	int track;
+
+	switch (t->type)
 	{
-		int iCloseMatch = 0;
-		int iExactMatch = 0;
-		int iMatchedTrack;
-		for (track = 0; track < GetNumTracks(); track++)
+		case TRACKID_ALL:
+			for (track = 0; track < nbTracks; track++)
+				sel[track] = 1;
+			break;
+
+		case TRACKID_SELECTED:
+			for (track = 0; track < nbTracks; track++)
+			{
+				// If tracks were selected before (because of a comma separated list) don't change it here.
+				if (sel[track])
+					break;
+				sel[track] = *((int*)GetSetMediaTrackInfo(g_tracks.Get()[track], "I_SELECTED", NULL));
+			}
+			break;
+
+		case TRACKID_RANGE:
+			for (track = t->num-1; track < min(t->num2, nbTracks); track++)
+				sel[track] = 1;
+			break;
+
+		case TRACKID_WILDCARD:
 		{
-			cName = (const char*)GetSetMediaTrackInfo(CSurf_TrackFromID(track+1, false), "P_NAME", NULL);
-			// Exact name match
-			if (cName[0] && _stricmp(strId, cName) == 0)
+			const char* strId = t->str.Get();
+			const int len = t->str.GetLength();
+			const char* p = strchr(strId, '*');
+			WDL_FastString strMatch;
+			if (strId[0] == '*' && len > 2 && strId[len-1] == '*')
+				strMatch.Set(strId+1, len-2);
+
+			for (track = 0; track < nbTracks; track++)
 			{
-				iExactMatch++;
-				g_selTracks.Get()[track] = 1;
+				const char* cName = GetConsoleTrackName(track);
+				if (cName[0])
+				{
+					const int nameLen = (int)strlen(cName);
+					if (p == strId && nameLen >= len-1 && _strnicmp(strId+1, cName+nameLen-(len-1), len-1) == 0)
+						sel[track] = 1;
+					else if (p-strId == len-1 && _strnicmp(strId, cName, len-1) == 0)
+						sel[track] = 1;
+					// This "should" be the double wildcard case, but check anyway
+					else if (strMatch.GetLength() && stristr(cName, strMatch.Get()))
+						sel[track] = 1;
+				}
 			}
-			// Exact number match
-			else if (atol(strId) == track+1)
+			break;
+		}
+
+		case TRACKID_NAME:
+		{
+			// Check for exact numeric
+			if (t->num > 0 && t->num <= nbTracks)
 			{
-				iExactMatch++;
-				g_selTracks.Get()[track] = 1;
+				sel[t->num-1] = 1;
+				break;
 			}
-			// Check for close match
-			else if (cName[0] && _strnicmp(strId, cName, strlen(strId)) == 0)
+
+			// Check for exact name matches, with "auto compelete"
+			//   e.g. if there's no exact match, but only one track that starts with the string, select that one
+			const char* strId = t->str.Get();
+			int iCloseMatch = 0;
+			int iExactMatch = 0;
+			int iMatchedTrack = -1;
+			for (track = 0; track < nbTracks; track++)
 			{
-				iCloseMatch++;
-				iMatchedTrack = track;
+				const char* cName = GetConsoleTrackName(track);
+				// Exact name match
+				if (cName[0] && _stricmp(strId, cName) == 0)
+				{
+					iExactMatch++;
+					sel[track] = 1;
+				}
+				// Check for close match
+				else if (cName[0] && _strnicmp(strId, cName, t->str.GetLength()) == 0)
+				{
+					iCloseMatch++;
+					iMatchedTrack = track;
+				}
 			}
+
+			if (!iExactMatch && iCloseMatch == 1)
+				sel[iMatchedTrack] = 1;
+			break;
 		}
 
-		if (!iExactMatch && iCloseMatch == 1)
-			g_selTracks.Get()[iMatchedTrack] = 1;
+		default: // TRACKID_NONE
+			return;
 	}
 
-	if (bChildren)
+	if (t->children)
 	{
-		int iParentDepth;
+		int iParentDepth = 0;
 		bool bSelected = false;
 		MediaTrack* gfd = NULL;
-		for (int i = 0; i < GetNumTracks(); i++)
+		for (int i = 0; i < nbTracks; i++)
 		{
-			MediaTrack* tr = CSurf_TrackFromID(i+1, false);
 			int iType;
-			int iFolder = GetFolderDepth(tr, &iType, &gfd);
+			int iFolder = GetFolderDepth(g_tracks.Get()[i], &iType, &gfd);
 
 			if (bSelected)
-				g_selTracks.Get()[i] = 1;
+				sel[i] = 1;
 
-			if (iType == 1 && !bSelected && g_selTracks.Get()[i])
+			if (iType == 1 && !bSelected && sel[i])
 			{
 				iParentDepth = iFolder;
 				bSelected = true;
@@ -370,28 +409,137 @@ void ParseTrackId(char* strId, bool bReset)
 		}
 	}
 
-	if (bInvert)
+	if (t->invert)
+	{
+		for (int i = 0; i < nbTracks; i++)
+			sel[i] = sel[i] ? 0 : 1;
+	}
+}
+
+// Resolves a COLOR_SET argument, -1 if invalid
+static int GetConsoleColor(const char* args)
+{
+	int i = -1;
+	if (_stricmp(args, "red") == 0)
+		i = RGB(255, 0, 0);
+	else if (_stricmp(args, __LOCALIZE("blue","sws_DLG_100")) == 0)
+		i = RGB(0, 0, 255);
+	else if (_stricmp(args, __LOCALIZE("green","sws_DLG_100")) == 0)
+		i = RGB(0, 255, 0);
+	else if (_stricmp(args, __LOCALIZE("grey","sws_DLG_100")) == 0 || _stricmp(args, __LOCALIZE("gray","sws_DLG_100")) == 0)
+		i = RGB(128, 128, 128);
+	else if (_stricmp(args, __LOCALIZE("black","sws_DLG_100")) == 0)
+		i = RGB(0, 0, 0);
+	else if (_stricmp(args, __LOCALIZE("white","sws_DLG_100")) == 0)
+		i = RGB(255, 255, 255);
+	else if (_stricmp(args, __LOCALIZE("yellow","sws_DLG_100")) == 0)
+		i = RGB(255, 255, 0);
+	else if (_stricmp(args, __LOCALIZE("cyan","sws_DLG_100")) == 0)
+		i = RGB(0, 255, 255);
+	else if (_stricmp(args, __LOCALIZE("purple","sws_DLG_100")) == 0 || _stricmp(args, "violet") == 0)
+		i = RGB(255, 0, 255);
+	else if (_stricmp(args, __LOCALIZE("orange","sws_DLG_100")) == 0)
+		i = RGB(255, 128, 0);
+	else if (_stricmp(args, __LOCALIZE("magenta","sws_DLG_100")) == 0)
+		i = RGB(255, 0, 128);
+	else if (strstr(args, "0x") == args)
+	{
+		const long color = strtol(args, NULL, 16);
+		i = RGB((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+	}
+	else
+	{
+		int index = (int)atol(args) - 1;
+		if (index >= 0 && index < 16)
+		{
+			char colstr[3] = { 0, 0, 0 };
+			char custcolors[130];
+			GetPrivateProfileString("REAPER", "custcolors", "", custcolors, 129, get_ini_file());
+			i = 0;
+			for (int j = 0; j < 3; j++)
+			{
+				strncpy(colstr, custcolors + index * 8 + j * 2, 2);
+				i |= strtol(colstr, NULL, 16) << j * 8;
+			}
+		}
+		else if (index == -1)
+			i = 0;
+	}
+
+	if (i > 0)
+		i |= 0x1000000;
+	return i;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ConsoleOp
+///////////////////////////////////////////////////////////////////////////////
+
+void ConsoleOp::Compile(const char* cmd)
+{
+	trackId.Empty(true);
+	args.Set("");
+	dVal = 0.0;
+	inputOr = inputAdd = 0;
+	inputIncrement = false;
+
+	// make a copy because ParseConsoleCommand modifies its input
+	char strCommand[256] = "";
+	lstrcpyn(strCommand, cmd ? cmd : "", sizeof(strCommand));
+	char* pTrackId;
+	char* pArgs;
+	command = ParseConsoleCommand(strCommand, &pTrackId, &pArgs);
+	if (command >= NUM_COMMANDS)
+		return;
+
+	args.Set(pArgs);
+	if (NUMERIC_ARGS(command))
+		dVal = atof(pArgs);
+
+	if (command == INPUT_SET)
+	{
+		inputIncrement = strchr(pArgs, '-') != NULL;
+		if (strchr(pArgs, 's'))
+			inputOr |= 1024;
+		if (strchr(pArgs, 'r'))
+			inputOr |= 512;
+		else if (strchr(pArgs, 'm'))
+			inputAdd = 4096 | ((63 << 5) + 1);
+	}
+
+	if (!(g_commands[command].iNumArgs & NOTRACK_ARG))
+		CompileTrackId(pTrackId, &trackId);
+}
+
+void ConsoleOp::MatchTracks() const
+{
+	const int nbTracks = GetNumTracks();
+	g_tracks.Resize(nbTracks, false);
+	g_selTracks.Resize(nbTracks, false);
+	for (int i = 0; i < nbTracks; i++)
 	{
-		for (int i = 0; i < GetNumTracks(); i++)
-			g_selTracks.Get()[i] = g_selTracks.Get()[i] ? 0 : 1;
+		g_tracks.Get()[i] = CSurf_TrackFromID(i+1, false);
+		g_selTracks.Get()[i] = 0;
 	}
+
+	if (nbTracks)
+		for (int i = 0; i < trackId.GetSize(); i++)
+			MatchTrackTerm(trackId.Get(i));
 }
 
 // Here's where we actually do the command from the user
-void ProcessCommand(CONSOLE_COMMAND command, const char* args)
+// Assumes MatchTracks() has been called
+void ConsoleOp::Apply() const
 {
 	int i;
 	bool b;
-	double dVal = 0.0;
 	double d;
 	int count = 0;
 
-	if (command >= NUM_COMMANDS || (g_commands[command].iNumArgs > 0 && (!args || !args[0])))
+	if (command >= NUM_COMMANDS || (g_commands[command].iNumArgs > 0 && !args.GetLength()))
 		return;
 
-	if (NUMERIC_ARGS(command))
-		dVal = atof(args);
-
 	if (g_commands[command].iNumArgs & NOTRACK_ARG)
 	{
 		switch(command)
@@ -399,7 +547,7 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 		case MARKER_ADD:
 			{
 				char markerStr[64];
-				snprintf(markerStr, sizeof(markerStr), "!%s", args);
+				snprintf(markerStr, sizeof(markerStr), "!%s", args.Get());
 				AddProjectMarker(NULL, false, GetCursorPosition(), 0.0, markerStr, -1);
 				UpdateTimeline();
 				break;
@@ -407,13 +555,14 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 		case OSC_CMD:
 			{
 				char oscStr[256];
-				snprintf(oscStr, sizeof(oscStr), "/%s", args);
+				snprintf(oscStr, sizeof(oscStr), "/%s", args.Get());
 				SNM_SendLocalOscMessage(oscStr);
 				break;
 			}
 		case WRITE_STATE:
 			{
-				const char *section = strtok((char *)args, " ");
+				WDL_FastString str(args.Get()); // strtok modifies its input
+				const char *section = strtok((char *)str.Get(), " ");
 				const char *key = strtok(NULL, " ");
 				if (section && key) {
 					const char *value = strtok(NULL, "");
@@ -430,9 +579,15 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 		return;
 	}
 
-	for (int track = 0; track < GetNumTracks(); track++)
+	// per command (not per track) values
+	int color = command == COLOR_SET ? GetConsoleColor(args.Get()) : -1;
+	if (command == COLOR_SET && color == -1)
+		return;
+
+	const int nbTracks = min(g_tracks.GetSize(), g_selTracks.GetSize());
+	for (int track = 0; track < nbTracks; track++)
 	{
-		MediaTrack* pMt = CSurf_TrackFromID(track+1, false);
+		MediaTrack* pMt = g_tracks.Get()[track];
 		// Do the class of commands that works only on the selected track
 		if (g_selTracks.Get()[track])
 		{
@@ -499,7 +654,7 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 				GetSetMediaTrackInfo(pMt, "I_FXEN", &i);
 				break;
 			case FX_ADD:
-				TrackFX_GetByName(pMt, args, true);
+				TrackFX_GetByName(pMt, args.Get(), true);
 				break;
 			case VOLUME_SET:
 				d = DB2VAL(dVal);
@@ -524,19 +679,19 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 				GetSetMediaTrackInfo(pMt, "D_PAN", &d);
 				break;
 			case NAME_SET:
-				GetSetMediaTrackInfo(pMt, "P_NAME", (char*)args);
+				GetSetMediaTrackInfo(pMt, "P_NAME", (char*)args.Get());
 				break;
 			case NAME_PREFIX:
 			{
 				char cName[256];
-				snprintf(cName, 256, "%s %s", args, (char*)GetSetMediaTrackInfo(pMt, "P_NAME", NULL));
+				snprintf(cName, 256, "%s %s", args.Get(), (char*)GetSetMediaTrackInfo(pMt, "P_NAME", NULL));
 				GetSetMediaTrackInfo(pMt, "P_NAME", cName);
 				break;
 			}
 			case NAME_SUFFIX:
 			{
 				char cName[256];
-				snprintf(cName, 256, "%s %s", (char*)GetSetMediaTrackInfo(pMt, "P_NAME", NULL), args);
+				snprintf(cName, 256, "%s %s", (char*)GetSetMediaTrackInfo(pMt, "P_NAME", NULL), args.Get());
 				GetSetMediaTrackInfo(pMt, "P_NAME", cName);
 				break;
 			}
@@ -547,70 +702,13 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 				break;
 			case INPUT_SET:
 				i = (int)dVal-1;
-				if (strchr(args, '-'))
+				if (inputIncrement)
 					i += count++;
-				if (strchr(args, 's'))
-					i |= 1024;
-				if (strchr(args, 'r'))
-					i |= 512;
-				else if (strchr(args, 'm'))
-					i += 4096 | ((63 << 5) + 1);
+				i = (i | inputOr) + inputAdd;
 				GetSetMediaTrackInfo(pMt, "I_RECINPUT", &i);
 				break;
 			case COLOR_SET:
-				i = -1;
-				if (_stricmp(args, "red") == 0)
-					i = RGB(255, 0, 0);
-				else if (_stricmp(args, __LOCALIZE("blue","sws_DLG_100")) == 0)
-					i = RGB(0, 0, 255);
-				else if (_stricmp(args, __LOCALIZE("green","sws_DLG_100")) == 0)
-					i = RGB(0, 255, 0);
-				else if (_stricmp(args, __LOCALIZE("grey","sws_DLG_100")) == 0 || _stricmp(args, __LOCALIZE("gray","sws_DLG_100")) == 0)
-					i = RGB(128, 128, 128);
-				else if (_stricmp(args, __LOCALIZE("black","sws_DLG_100")) == 0)
-					i = RGB(0, 0, 0);
-				else if (_stricmp(args, __LOCALIZE("white","sws_DLG_100")) == 0)
-					i = RGB(255, 255, 255);
-				else if (_stricmp(args, __LOCALIZE("yellow","sws_DLG_100")) == 0)
-					i = RGB(255, 255, 0);
-				else if (_stricmp(args, __LOCALIZE("cyan","sws_DLG_100")) == 0)
-					i = RGB(0, 255, 255);
-				else if (_stricmp(args, __LOCALIZE("purple","sws_DLG_100")) == 0 || _stricmp(args, "violet") == 0)
-					i = RGB(255, 0, 255);
-				else if (_stricmp(args, __LOCALIZE("orange","sws_DLG_100")) == 0)
-					i = RGB(255, 128, 0);
-				else if (_stricmp(args, __LOCALIZE("magenta","sws_DLG_100")) == 0)
-					i = RGB(255, 0, 128);
-				else if (strstr(args, "0x") == args)
-				{
-					const long color = strtol(args, NULL, 16);
-					i = RGB((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
-				}
-				else
-				{
-					int index = (int)atol(args) - 1;
-					if (index >= 0 && index < 16)
-					{
-						char colstr[3] = { 0, 0, 0 };
-						char custcolors[130];
-						GetPrivateProfileString("REAPER", "custcolors", "", custcolors, 129, get_ini_file());
-						i = 0;
-						for (int j = 0; j < 3; j++)
-						{
-							strncpy(colstr, custcolors + index * 8 + j * 2, 2);
-							i |= strtol(colstr, NULL, 16) << j * 8;
-						}
-					}
-					else if (index == -1)
-						i = 0;
-				}
-
-				if (i != -1)
-				{
-					if (i)
-						i |= 0x1000000;
-					GetSetMediaTrackInfo(pMt, "I_CUSTOMCOLOR", &i);
-				}
+				GetSetMediaTrackInfo(pMt, "I_CUSTOMCOLOR", &color);
 				break;
 			default:
 				break;
@@ -647,6 +745,63 @@ void ProcessCommand(CONSOLE_COMMAND command, const char* args)
 	}
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+// ConsoleBatch
+///////////////////////////////////////////////////////////////////////////////
+
+ConsoleBatch::ConsoleBatch(const char* cmds)
+{
+	WDL_FastString line;
+	while (cmds && *cmds)
+	{
+		const char* eol = cmds;
+		while (*eol && *eol != '\n' && *eol != '\r')
+			eol++;
+		line.Set(cmds, (int)(eol-cmds));
+
+		ConsoleOp* op = new ConsoleOp;
+		op->Compile(line.Get());
+		if (op->command != UNKNOWN_COMMAND)
+			m_ops.Add(op);
+		else
+			delete op;
+
+		cmds = *eol ? eol+1 : eol;
+	}
+}
+
+// primitive (no undo point)
+void ConsoleBatch::Run() const
+{
+	if (!m_ops.GetSize())
+		return;
+
+	PreventUIRefresh(1);
+	for (int i = 0; i < m_ops.GetSize(); i++)
+		m_ops.Get(i)->Run();
+	PreventUIRefresh(-1);
+}
+
+static void FreeConsoleBatch(ConsoleBatch* batch) { delete batch; }
+static WDL_StringKeyedArray<ConsoleBatch*> g_consoleBatches(true, FreeConsoleBatch);
+
+// Compiled commands are cached: custom commands, cycle actions, etc.. are parsed once
+// Track ids are resolved when commands are run (tracks might have been renamed, etc..)
+const ConsoleBatch* CompileConsoleCommands(const char* cmds)
+{
+	if (!cmds || !*cmds)
+		return NULL;
+
+	ConsoleBatch* batch = g_consoleBatches.Get(cmds);
+	if (!batch)
+	{
+		batch = new ConsoleBatch(cmds);
+		g_consoleBatches.Insert(cmds, batch);
+	}
+	return batch;
+}
+
 // Provide a human readable string of what's up:
 const char* StatusString(CONSOLE_COMMAND command, const char* args)
 {
@@ -671,7 +826,7 @@ const char* StatusString(CONSOLE_COMMAND command, const char* args)
 	{
 		int previous_n = n;
 		bool all = true;
-		for (int i = 0; i < GetNumTracks(); i++)
+		for (int i = 0; i < g_selTracks.GetSize(); i++)
 			if (!g_selTracks.Get()[i])
 			{
 				all = false;
@@ -683,10 +838,10 @@ const char* StatusString(CONSOLE_COMMAND command, const char* args)
 		}
 		else
 		{
-			for (int i = 0; i < GetNumTracks(); i++)
+			for (int i = 0; i < g_selTracks.GetSize(); i++)
 				if (g_selTracks.Get()[i])
 				{
-					const char* cName = (const char*)GetSetMediaTrackInfo(CSurf_TrackFromID(i+1, false), "P_NAME", NULL);
+					const char* cName = GetConsoleTrackName(i);
 					if (strlen(cName) + n + 20 >= 512)
 						// Really grunge string overflow check.  Can't see the status string past two lines anyway.
 						return status;
@@ -728,15 +883,11 @@ void BringKeyCommand(COMMAND_T* = NULL)
 }
 
 // primitive (no undo point)
+// cmd: one or several console commands (one per line)
 void RunConsoleCommand(const char* cmd)
 {
-	char strCommand[128] = "";
-	lstrcpyn(strCommand, cmd, sizeof(strCommand));
-	char* pTrackId = strCommand;
-	char* pArgs = strCommand;
-	CONSOLE_COMMAND command = ParseConsoleCommand(strCommand, &pTrackId, &pArgs);
-	ParseTrackId(pTrackId);
-	ProcessCommand(command, pArgs);
+	if (const ConsoleBatch* batch = CompileConsoleCommands(cmd))
+		batch->Run();
 }
 
 void RunConsoleCommand(COMMAND_T* ct)
@@ -860,6 +1011,7 @@ int ConsoleInit()
 				if (snprintfStrict(id, sizeof(id), "SWSCONSOLE_CUST%d", i+1) > 0) {
 					snprintf(desc, sizeof(desc), __LOCALIZE_VERFMT("SWS: Run console command: %s","sws_actions"), custCmds.Get(i)->Get());
 					SWSRegisterCommandExt(RunConsoleCommand, id, desc, (INT_PTR)_strdup(custCmds.Get(i)->Get()), false);
+					CompileConsoleCommands(custCmds.Get(i)->Get());
 				}
 	}
 	g_pConsoleWnd = new ReaConsoleWnd();
@@ -874,6 +1026,7 @@ void ConsoleExit()
 	plugin_register("-accelerator",&g_ar);
 	WritePrivateProfileString("SWS","CloseConsoleOnReturnKey",g_bCloseOnReturnPref?"1":"0",get_ini_file());
 	DELETE_NULL(g_pConsoleWnd);
+	g_consoleBatches.DeleteAll();
 }
 
 // _outCmds: it is up to the caller to unalloc items
@@ -908,9 +1061,6 @@ ReaConsoleWnd::ReaConsoleWnd()
 	: SWS_DockWnd(IDD_CONSOLE, "ReaConsole", "ReaConsole")
 {
 	*m_strCmd = '\0';
-	m_pTrackId = m_strCmd;
-	m_pArgs = m_strCmd;
-	m_cmd = UNKNOWN_COMMAND;
 
 	// Must call SWS_DockWnd::Init() to restore parameters and open the window if necessary
 	Init();
@@ -977,7 +1127,7 @@ void ReaConsoleWnd::OnCommand(WPARAM wParam, LPARAM lParam)
 			break;
 		case IDC_APPLY: // replaced IDOK: it would always close the window, see SWS_DockWnd::WndProc()
 		{
-			ProcessCommand(m_cmd, m_pArgs);
+			m_op.Run();
 
 			char cUndo[256];
 			snprintf(cUndo, sizeof(cUndo), __LOCALIZE("ReaConsole command %s","sws_undo"), m_strCmd);
@@ -1026,15 +1176,15 @@ void ReaConsoleWnd::ShowConsole()
 	SetFocus(h);
 	SendMessage(h, EM_SETSEL, 1, 1);
 
-	m_cmd = ParseConsoleCommand(m_strCmd, &m_pTrackId, &m_pArgs);
-	ParseTrackId(m_pTrackId);
-	SetDlgItemText(m_hwnd, IDC_STATUS, StatusString(m_cmd, m_pArgs));
+	m_op.Compile(m_strCmd);
+	m_op.MatchTracks();
+	SetDlgItemText(m_hwnd, IDC_STATUS, StatusString(m_op.command, m_op.args.Get()));
 }
 
 void ReaConsoleWnd::Update()
 {
 	GetDlgItemText(m_hwnd, IDC_COMMAND, m_strCmd, 100);
-	m_cmd = ParseConsoleCommand(m_strCmd, &m_pTrackId, &m_pArgs);
-	ParseTrackId(m_pTrackId);
-	SetDlgItemText(m_hwnd, IDC_STATUS, StatusString(m_cmd, m_pArgs));
+	m_op.Compile(m_strCmd);
+	m_op.MatchTracks();
+	SetDlgItemText(m_hwnd, IDC_STATUS, StatusString(m_op.command, m_op.args.Get()));
 }
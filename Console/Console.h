@@ -85,9 +85,48 @@ typedef struct {
 #define NOTRACK_ARG  16
 #define NUMERIC_ARGS(a) (g_commands[(a)].iNumArgs > 0 && !(g_commands[(a)].iNumArgs & STRING_ARG))
 
+// Compiled track id term, see CompileTrackId()
+struct ConsoleTrackTerm
+{
+	ConsoleTrackTerm() : type(0), num(0), num2(0), children(false), invert(false) {}
+	int type;
+	int num, num2;      // track number or range (1-based)
+	bool children, invert;
+	WDL_FastString str; // name or wildcard pattern
+};
+
+// Compiled console command: parsed once, track ids are matched when run
+struct ConsoleOp
+{
+	ConsoleOp() : command(UNKNOWN_COMMAND), dVal(0.0), inputOr(0), inputAdd(0), inputIncrement(false) {}
+	void Compile(const char* cmd);
+	void MatchTracks() const; // also used by the status string
+	void Apply() const;
+	void Run() const { MatchTracks(); Apply(); }
+
+	CONSOLE_COMMAND command;
+	WDL_PtrList_DeleteOnDestroy<ConsoleTrackTerm> trackId;
+	WDL_FastString args;
+	double dVal;
+	int inputOr, inputAdd; // INPUT_SET flags
+	bool inputIncrement;
+};
+
+// Compiled console commands, one per line
+class ConsoleBatch
+{
+public:
+	ConsoleBatch(const char* cmds);
+	void Run() const;
+	int GetSize() const { return m_ops.GetSize(); }
+private:
+	WDL_PtrList_DeleteOnDestroy<ConsoleOp> m_ops;
+};
+
 int ConsoleInit();
 void ConsoleExit();
 CONSOLE_COMMAND ParseConsoleCommand(char *strCommand, char **trackid, char **args);
+const ConsoleBatch* CompileConsoleCommands(const char* cmds);
 void RunConsoleCommand(const char* cmd);
 bool LoadConsoleCmds(WDL_PtrList<WDL_FastString>* _outCmds);
 
@@ -106,8 +145,6 @@ protected:
 	void OnResize();
 private:
 	char m_strCmd[256];
-	char* m_pTrackId;
-	char* m_pArgs;
-	CONSOLE_COMMAND m_cmd;
+	ConsoleOp m_op;
 };
 
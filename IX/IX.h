@@ -30,6 +30,7 @@ int IXInit();
 
 extern int LabelInit();
 extern void RunLabelCommand(WDL_FastString* cmd, const char* undoName = NULL);
+extern int IX_LabelProcessorPreview(const char* format, bool allTakes, char* namesOut, int namesOut_sz);
 extern int PlaylistImportInit();
 
 extern string ParseFileExtension( string path ); // Autorender.cpp
@@ -121,58 +121,34 @@ WDL_DLGRET doLabelProcDlg(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 	return 0;
 }
 
-const char * GetItemVolString(MediaItem* pItem, int mode, int precision)
-{
-	ANALYZE_PCM a;
-	memset(&a, 0, sizeof(a));
-
-	static WDL_FastString ret;
-
-	if(mode == 2)
-	{
-		char str[100];
-		GetPrivateProfileString(SWS_INI, SWS_RMS_KEY, "-20,0.1", str, 100, get_ini_file());
-		char* pWindow = strchr(str, ',');
-		a.dWindowSize = pWindow ? atof(pWindow+1) : 0.1;
-	}
-
-	if (AnalyzeItem(pItem, &a))
-	{
-		ret.SetFormatted(8, "%0.*f", precision, VAL2DB(mode == 0 ? a.dPeakVal : a.dRMS));
-	}
-
-	return ret.Get();
-}
-
-
-// Returns a substring of str.
+// Appends a substring of str.
 // Negative values are allowed for both offset and length.
 // Negative values count backwards from the end of the string.
 // invalid values for offset or length are ignored
-const char * GetSubString(const char *str, int offset, int length = 0)
+static void AppendSubString(WDL_FastString* out, const char *str, int offset, int length = 0)
 {
-	static WDL_FastString ret;
-
-	ret.Set(str);
+	int len = (int)strlen(str);
 
 	// Trim start
 	if(offset > 0)
 	{
-		ret.DeleteSub(0, offset);
+		offset = min(offset, len);
 	}
 	else if(offset < 0)
 	{
-		ret.DeleteSub(0, ret.GetLength() + offset);
+		offset = max(len + offset, 0);
 	}
+	str += offset;
+	len -= offset;
 
 	// Trim end
-	if(length < 1) length += ret.GetLength();
-	if(ret.GetLength() > length)
+	if(length < 1) length += len;
+	if(len > length && length >= 0)
 	{
-		ret.DeleteSub(length, ret.GetLength() - length);
+		len = length;
 	}
 
-	return ret.Get();
+	out->Append(str, len);
 }
 
 // Looks for comma separated int values enclosed by square braces at start of string.
@@ -197,249 +173,331 @@ void ExtractValues(const char *&c, int vals[], int maxvals)
 	}
 }
 
-// Re-label selected items according to format string
-void LabelProcessor(COMMAND_T* ct)
+
+///////////////////////////////////////////////////////////////////////////////
+// Label processor engine
+///////////////////////////////////////////////////////////////////////////////
+
+// Compiled format token: a literal or a /X[args] substitution
+struct LabelToken
 {
-	WDL_FastString format;
-	char buf[512];
-	GetPrivateProfileString(SWS_INI, IX_LABELPROC_TEXT_KEY, "/L", buf, sizeof(buf), get_ini_file());
+	char type;    // 0 for literals
+	int args[2];  // substitution args, or literal offset/length in the format string
+};
 
-	format.Set(buf);
+// Generated take names, see LabelFormat::Generate()
+struct LabelNames
+{
+	int GetSize() const { return takes.GetSize(); }
+	MediaItem_Take* GetTake(int i) const { return takes.Get()[i]; }
+	const char* GetName(int i) const { return chars.Get() + offsets.Get()[i]; }
 
-	if (!DialogBoxParam(g_hInst, MAKEINTRESOURCE(IDD_IX_LABELDLG), GetMainHwnd(), doLabelProcDlg, (LPARAM) &format ))
+	WDL_TypedBuf<MediaItem_Take*> takes;
+	WDL_TypedBuf<int> offsets;
+	WDL_TypedBuf<char> chars; // null separated names
+};
+
+// Label format, compiled once and evaluated for each take
+class LabelFormat
+{
+public:
+	LabelFormat(const char* format);
+	void Generate(bool allTakes, LabelNames* names) const;
+
+private:
+	// per item cached values
+	struct ItemContext
 	{
-		return;
-	}
+		MediaItem* item;
+		MediaTrack* track;
+		int iTrack, numSelOnTrack, itemCount, numSel, iOnTrack;
+		ANALYZE_PCM a[2]; // peak/RMS avg, RMS max
+		int analyzed[2];  // 0: not yet, 1: ok, -1: failed
+	};
+
+	void Eval(ItemContext* ctx, MediaItem_Take* take, int iTake, int numTakes, WDL_FastString* out) const;
+	void AppendItemVolString(ItemContext* ctx, int mode, int precision, WDL_FastString* out) const;
+
+	WDL_FastString m_format;
+	WDL_TypedBuf<LabelToken> m_tokens;
+	double m_rmsWindow;
+};
 
-	WritePrivateProfileString(SWS_INI, IX_LABELPROC_TEXT_KEY, format.Get(), get_ini_file());
-	WritePrivateProfileString(SWS_INI, IX_LABELPROC_ALLTAKES_KEY, bAllTakes ? "1" : "0", get_ini_file());
-	RunLabelCommand(&format, SWS_CMD_SHORTNAME(ct));
+LabelFormat::LabelFormat(const char* format) : m_format(format), m_rmsWindow(0.1)
+{
+	const char *start = m_format.Get();
+	const char *c = start;
+	const char *end = strchr(c, 0);
+
+	LabelToken tok;
+	while(c < end)
+	{
+		tok.type = 0;
+		tok.args[0] = tok.args[1] = 0;
+		if(*c == '/')
+		{
+			tok.type = *(++c);
+			switch(tok.type)
+			{
+			default : // not a substitution, the next char is processed as usual
+				tok.type = 0;
+				tok.args[0] = (int)(c - 1 - start);
+				tok.args[1] = 1;
+				break;
+
+			case 'D' : // Duration
+			case 'O' : // Source offset
+				++c;
+				break;
+
+			case 'E' : // Enumerate all
+			case 'e' : // Enumerate on track
+				tok.args[0] = 2;
+				tok.args[1] = 1;
+				ExtractValues(++c, tok.args, 2);
+				break;
+
+			case 'I' : // Inverse enumerate all
+			case 'i' : // Inverse enumerate on track
+			case 't' : // Track index
+				tok.args[0] = 2;
+				ExtractValues(++c, tok.args, tok.type == 't' ? 1 : 2);
+				break;
+
+			case 'K' : // Take count
+			case 'k' : // Take number
+			case 'P' : // Peak
+			case 'R' : // RMS Max
+			case 'r' : // RMS Avg
+				tok.args[0] = 1;
+				ExtractValues(++c, tok.args, 1);
+				break;
+
+			case 'L' : // Current label
+			case 'S' : // Source full path
+			case 's' : // Source filename only
+			case 'T' : // Track name
+				ExtractValues(++c, tok.args, 2);
+				break;
+			}
+		}
+		else
+		{
+			// literal run, up to the next substitution
+			const char *lit = c;
+			while(c < end && *c != '/')
+				c++;
+			tok.args[0] = (int)(lit - start);
+			tok.args[1] = (int)(c - lit);
+		}
+
+		// merge consecutive literals
+		const int n = m_tokens.GetSize();
+		if(!tok.type && n && !m_tokens.Get()[n-1].type &&
+			m_tokens.Get()[n-1].args[0] + m_tokens.Get()[n-1].args[1] == tok.args[0])
+			m_tokens.Get()[n-1].args[1] += tok.args[1];
+		else
+			m_tokens.Add(tok);
+
+		if(tok.type == 'R')
+		{
+			char str[100];
+			GetPrivateProfileString(SWS_INI, SWS_RMS_KEY, "-20,0.1", str, 100, get_ini_file());
+			char* pWindow = strchr(str, ',');
+			m_rmsWindow = pWindow ? atof(pWindow+1) : 0.1;
+		}
+	}
 }
 
-void RunLabelCommand(WDL_FastString* cmd, const char* undoName)
+// mode: 0 = peak, 1 = RMS average, 2 = RMS max
+void LabelFormat::AppendItemVolString(ItemContext* ctx, int mode, int precision, WDL_FastString* out) const
 {
-	if (undoName)
-		Undo_BeginBlock2(NULL);
+	const int idx = mode == 2 ? 1 : 0; // peak and RMS average share the same analysis
+	ANALYZE_PCM* a = &ctx->a[idx];
+	if(!ctx->analyzed[idx])
+	{
+		memset(a, 0, sizeof(ANALYZE_PCM));
+		if(mode == 2)
+			a->dWindowSize = m_rmsWindow;
+		ctx->analyzed[idx] = AnalyzeItem(ctx->item, a) ? 1 : -1;
+	}
 
+	if(ctx->analyzed[idx] > 0)
+		out->AppendFormatted(8, "%0.*f", precision, VAL2DB(mode == 0 ? a->dPeakVal : a->dRMS));
+}
+
+void LabelFormat::Eval(ItemContext* ctx, MediaItem_Take* pTake, int t, int tc, WDL_FastString* str) const
+{
 	char buf[512];
-	int itemCount = 0;
-	const int numSel = CountSelectedMediaItems(NULL);
-	for (int iTrack = 1; iTrack <= GetNumTracks(); iTrack++)
+	char source[512] = ""; // lazy, see below
+	bool hasSource = false;
+
+	for(int i = 0; i < m_tokens.GetSize(); i++)
 	{
-		WDL_TypedBuf<MediaItem*> items;
-		SWS_GetSelectedMediaItemsOnTrack(&items, CSurf_TrackFromID(iTrack, false));
-		int numSelOnTrack = items.GetSize();
-		for (int i = 0; i < numSelOnTrack; i++)
+		const LabelToken &tok = m_tokens.Get()[i];
+		switch(tok.type)
 		{
-			MediaItem* pItem = items.Get()[i];
+		case 0 :
+			str->Append(m_format.Get() + tok.args[0], tok.args[1]);
+			break;
+
+		case 'D' : // Duration
+			format_timestr(*(double*) GetSetMediaItemInfo(ctx->item, "D_LENGTH", NULL), buf, sizeof(buf));
+			str->Append(buf);
+			break;
+
+		case 'E' : // Enumerate all
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], ctx->itemCount + tok.args[1]);
+			break;
+
+		case 'e' : // Enumerate on track
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], ctx->iOnTrack + tok.args[1]);
+			break;
+
+		case 'I' : // Inverse enumerate all
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], ctx->numSel - ctx->itemCount + tok.args[1] - 1);
+			break;
+
+		case 'i' : // Inverse enumerate on track
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], ctx->numSelOnTrack - ctx->iOnTrack + tok.args[1] - 1);
+			break;
+
+		case 'K' : // Take count
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], tc);
+			break;
+
+		case 'k' : // Take number
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], t + 1);
+			break;
+
+		case 'L' : // Current label
+			if(const char *label = (const char*) GetSetMediaItemTakeInfo(pTake, "P_NAME", NULL))
+				AppendSubString(str, label, tok.args[0], tok.args[1]);
+			break;
+
+		case 'O' : // Source offset
+			format_timestr(*(double*) GetSetMediaItemTakeInfo(pTake, "D_STARTOFFS", NULL), buf, sizeof(buf));
+			str->Append(buf);
+			break;
+
+		case 'P' : // Peak
+			AppendItemVolString(ctx, 0, tok.args[0], str);
+			break;
+
+		case 'R' : // RMS Max
+			AppendItemVolString(ctx, 2, tok.args[0], str);
+			break;
+
+		case 'r' : // RMS Avg
+			AppendItemVolString(ctx, 1, tok.args[0], str);
+			break;
 
-			// Build take list
-			WDL_TypedBuf<MediaItem_Take*> takes;
-			if(bAllTakes)
+		case 'S' : // Source full path
+		case 's' : // Source filename only
+			if(!hasSource)
 			{
-				for(int t = 0, tc = GetMediaItemNumTakes(pItem); t < tc; t++)
-				{
-					takes.Add(GetMediaItemTake(pItem, t));
-				}
+				if(PCM_source *pSource = (PCM_source*) GetSetMediaItemTakeInfo(pTake, "P_SOURCE", NULL))
+					GetMediaSourceFileName(pSource, source, sizeof(source));
+				hasSource = true;
 			}
-			else
+			if(*source)
 			{
-				takes.Add(GetActiveTake(pItem));
+				if(tok.type == 'S')
+					AppendSubString(str, source, tok.args[0], tok.args[1]);
+				else if(const char *f = strrchr(source, PATH_SLASH_CHAR))
+					AppendSubString(str, f + 1, tok.args[0], tok.args[1]);
 			}
+			break;
 
-			// Do the work
-			for(int t = 0, tc = takes.GetSize(); t < tc; t++)
-			{
-				MediaItem_Take* pTake = takes.Get()[t];
+		case 'T' : // Track name
+			if(const char *label = (const char*) GetSetMediaTrackInfo(ctx->track, "P_NAME", NULL))
+				AppendSubString(str, label, tok.args[0], tok.args[1]);
+			break;
 
-				WDL_FastString str;
+		case 't' : // Track index
+			str->AppendFormatted(abs(tok.args[0]) + 16, "%0*d", tok.args[0], ctx->iTrack);
+			break;
+		}
+	}
+}
 
-				const char *c = cmd->Get();
-				const char *end = strchr(c, 0);
+// Generates the names of the selected items' takes (active takes only or all takes)
+// Nothing is committed, see RunLabelCommand()
+void LabelFormat::Generate(bool allTakes, LabelNames* names) const
+{
+	names->takes.Resize(0, false);
+	names->offsets.Resize(0, false);
+	names->chars.Resize(0, false);
 
-				while(c < end)
-				{
-					switch(*c)
-					{
-					case '/' :
-						{
-							switch(*(++c))
-							{
-							default :
-								str.Append("/");
-								break;
-
-							case 'D' : // Duration
-								{
-									double length = *(double*) GetSetMediaItemInfo(pItem, "D_LENGTH", NULL);
-									format_timestr(length, buf, sizeof(buf));
-									str.AppendFormatted(str.GetLength() + (int)strlen(buf), "%s", buf);
-									++c;
-								}
-								break;
-
-							case 'E' : // Enumerate all
-								{
-									int args[2] = {2,1};
-									ExtractValues(++c, args, 2);
-									str.AppendFormatted(str.GetLength() + 8, "%0*d", args[0], itemCount + args[1]);
-								}
-								break;
-
-							case 'e' : // Enumerate on track
-								{
-									int args[2] = {2,1};
-									ExtractValues(++c, args, 2);
-									str.AppendFormatted(str.GetLength() + 8, "%0*d", args[0], i + args[1]);
-								}
-								break;
-
-							case 'I' : // Inverse enumerate all
-								{
-									int args[2] = {2,0};
-									ExtractValues(++c, args, 2);
-									str.AppendFormatted(str.GetLength() + 8, "%0*d", args[0], numSel - itemCount + args[1] - 1);
-								}
-								break;
-
-							case 'i' : // Inverse enumerate on track
-								{
-									int args[2] = {2,0};
-									ExtractValues(++c, args, 2);
-									str.AppendFormatted(str.GetLength() + 8, "%0*d", args[0], numSelOnTrack - i + args[1] - 1);
-								}
-								break;
-
-							case 'K' : // Take count
-								{
-									int digits = 1;
-									ExtractValues(++c, &digits, 1);
-									str.AppendFormatted(str.GetLength() + digits, "%0*d", digits, tc);
-								}
-								break;
-
-							case 'k' : // Take number
-								{
-									int digits = 1;
-									ExtractValues(++c, &digits, 1);
-									str.AppendFormatted(str.GetLength() + digits, "%0*d", digits, t + 1);
-								}
-								break;
-
-							case 'L' : // Current label
-								{
-									int args[2] = {0,0};
-									ExtractValues(++c, args, 2);
-
-									const char *label = (const char*) GetSetMediaItemTakeInfo(pTake, "P_NAME", NULL);
-									if(label)
-										str.Append(GetSubString(label, args[0], args[1]));
-								}
-								break;
-
-							case 'O' : // Source offset
-								{
-									double offset = *(double*) GetSetMediaItemTakeInfo(pTake, "D_STARTOFFS", NULL);
-									format_timestr(offset, buf, sizeof(buf));
-									str.AppendFormatted(str.GetLength() + (int)strlen(buf), "%s", buf);
-									++c;
-								}
-								break;
-
-							case 'P' : // Peak
-								{
-									int precision = 1;
-									ExtractValues(++c, &precision, 1);
-									str.Append(GetItemVolString(pItem, 0, precision));
-								}
-								break;
-
-							case 'R' : // RMS Max
-								{
-									int precision = 1;
-									ExtractValues(++c, &precision, 1);
-									str.Append(GetItemVolString(pItem, 2, precision));
-								}
-								break;
-
-							case 'r' : // RMS Avg
-								{
-									int precision = 1;
-									ExtractValues(++c, &precision, 1);
-									str.Append(GetItemVolString(pItem, 1, precision));
-								}
-								break;
-
-							case 'S' : // Source full path
-								{
-									int args[2] = {0,0};
-									ExtractValues(++c, args, 2);
-
-									PCM_source *pSource = (PCM_source*) GetSetMediaItemTakeInfo(pTake, "P_SOURCE", NULL);
-									if(pSource)
-									{
-										memset(buf, 0, sizeof(buf));
-										GetMediaSourceFileName(pSource, buf, sizeof(buf));
-										if(*buf)
-											str.Append(GetSubString(buf, args[0], args[1]));
-									}
-								}
-								break;
-
-							case 's' : // Source filename only
-								{
-									int args[2] = {0,0};
-									ExtractValues(++c, args, 2);
-
-									PCM_source *pSource = (PCM_source*) GetSetMediaItemTakeInfo(pTake, "P_SOURCE", NULL);
-									if(pSource)
-									{
-										memset(buf, 0, sizeof(buf));
-										GetMediaSourceFileName(pSource, buf, sizeof(buf));
-										if(*buf)
-										{
-											const char *f = strrchr(buf, PATH_SLASH_CHAR);
-											if(f)
-												str.Append(GetSubString(f + 1, args[0], args[1]));
-										}
-									}
-								}
-								break;
-
-							case 'T' : // Track name
-								{
-									int args[2] = {0,0};
-									ExtractValues(++c, args, 2);
-
-									const char *label = (const char*) GetSetMediaTrackInfo(GetMediaItem_Track(pItem), "P_NAME", NULL);
-									if(label)
-										str.Append(GetSubString(label, args[0], args[1]));
-								}
-								break;
-
-							case 't' : // Track index
-								{
-									int width = 2;
-									ExtractValues(++c, &width, 1);
-									str.AppendFormatted(str.GetLength() + 8, "%0*d", width, iTrack);
-								}
-								break;
-							}
-						}
-						break;
+	ItemContext ctx;
+	ctx.itemCount = 0;
+	ctx.numSel = CountSelectedMediaItems(NULL);
 
-					default :
-						str.Append(c++, 1);
-						break;
-					}
-				}
+	WDL_TypedBuf<MediaItem*> items;
+	WDL_FastString str;
+	for (ctx.iTrack = 1; ctx.iTrack <= GetNumTracks(); ctx.iTrack++)
+	{
+		ctx.track = CSurf_TrackFromID(ctx.iTrack, false);
+		SWS_GetSelectedMediaItemsOnTrack(&items, ctx.track);
+		ctx.numSelOnTrack = items.GetSize();
+		for (ctx.iOnTrack = 0; ctx.iOnTrack < ctx.numSelOnTrack; ctx.iOnTrack++)
+		{
+			ctx.item = items.Get()[ctx.iOnTrack];
+			ctx.analyzed[0] = ctx.analyzed[1] = 0;
 
-				GetSetMediaItemTakeInfo(pTake, "P_NAME", (void*) str.Get());
+			const int tc = allTakes ? GetMediaItemNumTakes(ctx.item) : 1;
+			for (int t = 0; t < tc; t++)
+			{
+				MediaItem_Take* pTake = allTakes ? GetMediaItemTake(ctx.item, t) : GetActiveTake(ctx.item);
+				if (!pTake) // empty take
+					continue;
+
+				str.Set("");
+				Eval(&ctx, pTake, t, tc, &str);
+
+				const int pos = names->chars.GetSize();
+				names->takes.Add(pTake);
+				names->offsets.Add(pos);
+				if (char* p = names->chars.Resize(pos + str.GetLength() + 1, false))
+					memcpy(p + pos, str.Get(), str.GetLength() + 1);
 			}
 
-			++itemCount;
+			++ctx.itemCount;
 		}
 	}
+}
+
+// Re-label selected items according to format string
+void LabelProcessor(COMMAND_T* ct)
+{
+	WDL_FastString format;
+	char buf[512];
+	GetPrivateProfileString(SWS_INI, IX_LABELPROC_TEXT_KEY, "/L", buf, sizeof(buf), get_ini_file());
+
+	format.Set(buf);
+
+	if (!DialogBoxParam(g_hInst, MAKEINTRESOURCE(IDD_IX_LABELDLG), GetMainHwnd(), doLabelProcDlg, (LPARAM) &format ))
+	{
+		return;
+	}
+
+	WritePrivateProfileString(SWS_INI, IX_LABELPROC_TEXT_KEY, format.Get(), get_ini_file());
+	WritePrivateProfileString(SWS_INI, IX_LABELPROC_ALLTAKES_KEY, bAllTakes ? "1" : "0", get_ini_file());
+	RunLabelCommand(&format, SWS_CMD_SHORTNAME(ct));
+}
+
+void RunLabelCommand(WDL_FastString* cmd, const char* undoName)
+{
+	LabelNames names;
+	LabelFormat(cmd->Get()).Generate(bAllTakes, &names);
+
+	if (undoName)
+		Undo_BeginBlock2(NULL);
+
+	PreventUIRefresh(1);
+	for (int i = 0; i < names.GetSize(); i++)
+		GetSetMediaItemTakeInfo(names.GetTake(i), "P_NAME", (void*) names.GetName(i));
+	PreventUIRefresh(-1);
 
 	if (undoName)
 		Undo_EndBlock2(NULL, undoName, UNDO_STATE_ITEMS);
@@ -447,6 +505,26 @@ void RunLabelCommand(WDL_FastString* cmd, const char* undoName)
 	UpdateTimeline();
 }
 
+// ReaScript export
+int IX_LabelProcessorPreview(const char* format, bool allTakes, char* namesOut, int namesOut_sz)
+{
+	LabelNames names;
+	LabelFormat(format ? format : "").Generate(allTakes, &names);
+
+	// one name per line, the null separators become line breaks
+	int len = max(names.chars.GetSize() - 1, 0);
+	for (int i = 0; i < len; i++)
+		if (!names.chars.Get()[i])
+			names.chars.Get()[i] = '\n';
+
+	if (realloc_cmd_ptr(&namesOut, &namesOut_sz, len))
+		memcpy(namesOut, names.chars.Get(), len);
+	else if (namesOut && namesOut_sz > 0)
+		lstrcpyn(namesOut, len ? names.chars.Get() : "", namesOut_sz);
+
+	return names.GetSize();
+}
+
 //!WANT_LOCALIZE_1ST_STRING_BEGIN:sws_actions
 static COMMAND_T g_commandTable[] =
 {
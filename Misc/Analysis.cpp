@@ -34,7 +34,7 @@
 
 static void GetRMSOptions(double *target, double *windowSize);
 
-static bool AnalyzePCMSource(ANALYZE_PCM* a)
+bool AnalyzePCMSource(ANALYZE_PCM* a)
 {
 	// Init local transfer block "t" and sum of squares
 	PCM_source_transfer_t t={0,};
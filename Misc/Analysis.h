@@ -51,6 +51,7 @@ typedef struct ANALYZE_PCM
 
 int AnalysisInit();
 
+bool AnalyzePCMSource(ANALYZE_PCM* a); // synchronous, no wait dialog (a->pcm must be zero-based)
 bool AnalyzeItem(MediaItem* mi, ANALYZE_PCM* a);
 
 // #781 Export to ReaScript
@@ -79,7 +79,10 @@ void FolderLikePrev(COMMAND_T* = NULL)
 		prevTr = tr;
 	}
 	if (bUndo)
+	{
+		InvalidateFolderTree();
 		Undo_OnStateChangeEx(__LOCALIZE("Set selected track(s) to same folder as previous track","sws_undo"), UNDO_STATE_TRACKCFG | UNDO_STATE_MISCCFG, -1);
+	}
 }
 
 void MakeFolder(COMMAND_T* = NULL)
@@ -110,7 +113,10 @@ void MakeFolder(COMMAND_T* = NULL)
 		tr = nextTr;
 	}
 	if (bUndo)
+	{
+		InvalidateFolderTree();
 		Undo_OnStateChangeEx(__LOCALIZE("Make folder from selected tracks","sws_undo"), UNDO_STATE_TRACKCFG | UNDO_STATE_MISCCFG, -1);
+	}
 }
 
 void IndentTracks(const int increment)
@@ -152,7 +158,10 @@ void IndentTracks(const int increment)
 	}
 
 	if (undo)
+	{
+		InvalidateFolderTree();
 		Undo_OnStateChangeEx(__LOCALIZE("Unindent selected tracks","sws_undo"), UNDO_STATE_TRACKCFG | UNDO_STATE_MISCCFG, -1);
+	}
 }
 
 void IndentTracks(COMMAND_T *cmd)
@@ -162,14 +171,12 @@ void IndentTracks(COMMAND_T *cmd)
 
 void CollapseFolder(COMMAND_T* ct)
 {
-	MediaTrack* gfd = NULL;
+	const SWS_FolderTree* ft = GetFolderTree();
 	int iCompact = (int)ct->user;
-	for (int i = 1; i <= GetNumTracks(); i++)
+	for (int i = 1; i < ft->GetSize(); i++)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
-		int iType;
-		GetFolderDepth(tr, &iType, &gfd);
-		if (*(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL) && iType == 1)
+		MediaTrack* tr = ft->Get(i)->tr;
+		if (ft->Get(i)->type == 1 && *(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL))
 			GetSetMediaTrackInfo(tr, "I_FOLDERCOMPACT", &iCompact);
 	}
 	UpdateTimeline();
@@ -72,48 +72,24 @@ void TogSaveSelTracks(COMMAND_T* ct)
 
 void GetSelFolderTracks(WDL_PtrList<void>* pParents, WDL_PtrList<void>* pChildren)
 {
-	MediaTrack* tr;
-	WDL_PtrList<void> parentStack;
-	int iParentDepth;
-	bool bSelected = false;
-	MediaTrack* gfd = NULL;
-	for (int i = 0; i <= GetNumTracks(); i++)
+	const SWS_FolderTree* ft = GetFolderTree();
+	std::vector<bool> bParentAdded(ft->GetSize(), false);
+	int iChildrenEnd = -1; // children range of the selected (outermost) folder
+	for (int i = 0; i < ft->GetSize(); i++)
 	{
-		tr = CSurf_TrackFromID(i, false);
-		int iType;
-		int iFolder = GetFolderDepth(tr, &iType, &gfd);
-
-		if (*(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL))
-		{
-			if (pParents && parentStack.GetSize())
-			{
-				void* p = parentStack.Get(parentStack.GetSize()-1);
-				if (pParents->Find(p) == -1)
-					pParents->Add(p);
-			}
-		}
+		const SWS_FolderNode* node = ft->Get(i);
+		const bool bSelected = *(int*)GetSetMediaTrackInfo(node->tr, "I_SELECTED", NULL) != 0;
 
-		if (bSelected && pChildren && pChildren->Find(tr) == -1)
-			pChildren->Add(tr);
-
-		if (iType == 1)
+		if (bSelected && pParents && node->parent >= 0 && !bParentAdded[node->parent])
 		{
-			if (!bSelected && *(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL))
-			{
-				iParentDepth = iFolder;
-				bSelected = true;
-			}
-			parentStack.Add(tr);
+			pParents->Add(ft->Get(node->parent)->tr);
+			bParentAdded[node->parent] = true;
 		}
 
-		if (iType < 0)
-		{
-			for (int j = iType; j < 0; j++)
-				parentStack.Delete(parentStack.GetSize()-1);
-
-			if (iType + iFolder <= iParentDepth)
-				bSelected = false;
-		}
+		if (pChildren && i <= iChildrenEnd)
+			pChildren->Add(node->tr);
+		else if (bSelected && node->type == 1)
+			iChildrenEnd = node->lastDescendant;
 	}
 }
 
@@ -165,13 +141,12 @@ void SelTracksWItems(COMMAND_T*)
 
 void SelAllParents(COMMAND_T* = NULL)
 {
-	MediaTrack* gfd = NULL;
-	for (int i = 1; i <= GetNumTracks(); i++)
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = 1; i < ft->GetSize(); i++)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
-		int iType;
-		int iFolder = GetFolderDepth(tr, &iType, &gfd);
-		if (iFolder == 0 && iType == 1)
+		const SWS_FolderNode* node = ft->Get(i);
+		MediaTrack* tr = node->tr;
+		if (node->depth == 0 && node->type == 1)
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
 		else
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i0);
@@ -180,13 +155,11 @@ void SelAllParents(COMMAND_T* = NULL)
 
 void SelFolderStarts(COMMAND_T* = NULL)
 {
-	MediaTrack* gfd = NULL;
-	for (int i = 1; i <= GetNumTracks(); i++)
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = 1; i < ft->GetSize(); i++)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
-		int iType;
-		GetFolderDepth(tr, &iType, &gfd);
-		if (iType == 1)
+		MediaTrack* tr = ft->Get(i)->tr;
+		if (ft->Get(i)->type == 1)
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
 		else
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i0);
@@ -195,12 +168,12 @@ void SelFolderStarts(COMMAND_T* = NULL)
 
 void SelNotFolder(COMMAND_T* = NULL)
 {
-	MediaTrack* gfd = NULL;
-	for (int i = 1; i <= GetNumTracks(); i++)
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = 1; i < ft->GetSize(); i++)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
-		int iType;
-		if (GetFolderDepth(tr, &iType, &gfd) == 0 && iType == 0)
+		const SWS_FolderNode* node = ft->Get(i);
+		MediaTrack* tr = node->tr;
+		if (node->depth == 0 && node->type == 0)
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
 		else
 			GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i0);
@@ -268,28 +241,26 @@ void UnselArmed(COMMAND_T* = NULL)
 void SelNextFolder(COMMAND_T* = NULL)
 {
 	int iDepth = -1;
-	int iType;
-	int iFolder;
-	MediaTrack* gfd;
-	for (int i = 1; i <= GetNumTracks(); i++)
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = 1; i < ft->GetSize(); i++)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
+		const SWS_FolderNode* node = ft->Get(i);
+		MediaTrack* tr = node->tr;
 		if (iDepth != -1)
 		{
-			if ((iFolder = GetFolderDepth(tr, &iType, &gfd)) == iDepth && iType == 1)
+			if (node->depth == iDepth && node->type == 1)
 			{
 				ClearSelected();
 				GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
 				return;
 			}
-			else if (iType + iFolder < iDepth)
+			else if (node->type + node->depth < iDepth)
 				iDepth = -1;
 		}		
 		else if (iDepth == -1 && *(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL))
 		{
-			iFolder = GetFolderDepth(tr, &iType, &gfd);
-			if (iType == 1)
-				iDepth = iFolder;
+			if (node->type == 1)
+				iDepth = node->depth;
 		}
 	}
 }
@@ -297,28 +268,26 @@ void SelNextFolder(COMMAND_T* = NULL)
 void SelPrevFolder(COMMAND_T* = NULL)
 {
 	int iDepth = -1;
-	int iType;
-	int iFolder;
-	MediaTrack* gfd;
-	for (int i = GetNumTracks(); i > 0; i--)
+	const SWS_FolderTree* ft = GetFolderTree();
+	for (int i = ft->GetSize()-1; i > 0; i--)
 	{
-		MediaTrack* tr = CSurf_TrackFromID(i, false);
+		const SWS_FolderNode* node = ft->Get(i);
+		MediaTrack* tr = node->tr;
 		if (iDepth != -1)
 		{
-			if ((iFolder = GetFolderDepth(tr, &iType, &gfd)) == iDepth && iType == 1)
+			if (node->depth == iDepth && node->type == 1)
 			{
 				ClearSelected();
 				GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
 				return;
 			}
-			else if (iFolder < iDepth)
+			else if (node->depth < iDepth)
 				iDepth = -1;
 		}		
 		else if (iDepth == -1 && *(int*)GetSetMediaTrackInfo(tr, "I_SELECTED", NULL))
 		{
-			iFolder = GetFolderDepth(tr, &iType, &gfd);
-			if (iType == 1)
-				iDepth = iFolder;
+			if (node->type == 1)
+				iDepth = node->depth;
 		}
 	}
 }
@@ -434,26 +403,17 @@ int RoutedTracks(MediaTrack* tr, WDL_PtrList<void>* pTracks)
 				pTracks->Add(pRec);
 		}
 
-	// Then check folders
-	int iType;
-	MediaTrack* pNext = NULL;
-	int iDepth = GetFolderDepth(tr, &iType, &pNext);
-	if (iType == 1)
+	// Then check folders (direct children)
+	const SWS_FolderTree* ft = GetFolderTree();
+	const SWS_FolderNode* node = ft->Get(tr);
+	if (node && node->type == 1)
 	{
-		int iChild = CSurf_TrackToID(tr, false)+1;
-		while(true)
+		for (int iChild = node->firstChild; iChild >= 0; iChild = ft->Get(iChild)->nextSibling)
 		{
-			MediaTrack* pChild = CSurf_TrackFromID(iChild, false);
-			if (!pChild)
-				break;
-			int iChildDepth = GetFolderDepth(pChild, NULL, &pNext);
-			if (iChildDepth == iDepth + 1 &&
-				*(bool*)GetSetMediaTrackInfo(pChild, "B_MAINSEND", NULL) &&
+			MediaTrack* pChild = ft->Get(iChild)->tr;
+			if (*(bool*)GetSetMediaTrackInfo(pChild, "B_MAINSEND", NULL) &&
 				!*(bool*)GetSetMediaTrackInfo(pChild, "B_MUTE", NULL))
 				pTracks->Add(pChild);
-			if (iChildDepth <= iDepth)
-				break;
-			iChild++;
 		}
 	}
 
@@ -34,6 +34,7 @@
 
 // Globals
 SWS_ProjectListWnd* g_pProjList = NULL;
+static WDL_PtrList_DOD<SWS_ProjectTab> g_projTabs; // list items, in tab order
 
 // !WANT_LOCALIZE_STRINGS_BEGIN:sws_DLG_146
 static SWS_LVColumn g_cols[] = { { 30, 0, "#" }, { 100, 0, "Name" }, { 185, 0, "Path", -1 }, };
@@ -44,55 +45,67 @@ SWS_ProjectListView::SWS_ProjectListView(HWND hwndList, HWND hwndEdit)
 {
 }
 
-void SWS_ProjectListView::GetItemText(SWS_ListItem* item, int iCol, char* str, int iStrMax)
+// Returns true if the tabs have changed since the last call
+static bool UpdateProjectTabs()
 {
-	ReaProject* proj = (ReaProject*)item;
+	bool changed = false;
 	int i = 0;
-	char cFilename[512];
-	while (proj != EnumProjects(i, cFilename, 512))
-		i++;
-	
+	char cFilename[MAX_PATH];
+	while (ReaProject* proj = EnumProjects(i, cFilename, sizeof(cFilename)))
+	{
+		SWS_ProjectTab* tab = g_projTabs.Get(i++);
+		if (tab && tab->m_proj == proj && !strcmp(tab->m_fn.Get(), cFilename))
+			continue;
+
+		changed = true;
+		if (!tab)
+			tab = g_projTabs.Add(new SWS_ProjectTab);
+		tab->m_proj = proj;
+		tab->m_fn.Set(cFilename);
+	}
+	while (g_projTabs.GetSize() > i)
+	{
+		g_projTabs.Delete(g_projTabs.GetSize()-1, true);
+		changed = true;
+	}
+	return changed;
+}
+
+void SWS_ProjectListView::GetItemText(SWS_ListItem* item, int iCol, char* str, int iStrMax)
+{
+	SWS_ProjectTab* tab = (SWS_ProjectTab*)item;
 	switch (iCol)
 	{
 	case 0: // #
-		snprintf(str, iStrMax, "%d", i+1);
+		snprintf(str, iStrMax, "%d", g_projTabs.Find(tab)+1);
 		break;
 	case 1: // Name
 		{
-			char* pSlash = strrchr(cFilename, PATH_SLASH_CHAR);
-			if (pSlash)
-			{
-				char* pExt = strrchr(cFilename, '.');
-				if (pExt) *pExt = 0;
-				lstrcpyn(str, pSlash+1, iStrMax);
-			}
-			else
-				lstrcpyn(str, cFilename, iStrMax);
+			const char* pSlash = strrchr(tab->m_fn.Get(), PATH_SLASH_CHAR);
+			const char* pName = pSlash ? pSlash+1 : tab->m_fn.Get();
+			const char* pExt = pSlash ? strrchr(pName, '.') : NULL;
+			lstrcpyn(str, pName, pExt ? min(iStrMax, (int)(pExt-pName)+1) : iStrMax);
 			break;
 		}
 	case 2: // Path
 		{
-			char* pSlash = strrchr(cFilename, PATH_SLASH_CHAR);
-			if (pSlash) *pSlash = 0;
-			lstrcpyn(str, cFilename, iStrMax);
+			const char* pSlash = strrchr(tab->m_fn.Get(), PATH_SLASH_CHAR);
+			lstrcpyn(str, tab->m_fn.Get(), pSlash ? min(iStrMax, (int)(pSlash-tab->m_fn.Get())+1) : iStrMax);
 			break;
 		}
-		break;
 	}
 }
 
 void SWS_ProjectListView::OnItemDblClk(SWS_ListItem* item, int iCol)
 {
-	SelectProjectInstance((ReaProject*)item);
+	SelectProjectInstance(((SWS_ProjectTab*)item)->m_proj);
 	g_pProjList->Show(false, true);
 }
 
 void SWS_ProjectListView::GetItemList(SWS_ListItemList* pList)
 {
-	ReaProject* proj;
-	int i = 0;
-	while((proj = EnumProjects(i++, NULL, 0)))
-		pList->Add((SWS_ListItem*)proj);
+	for (int i = 0; i < g_projTabs.GetSize(); i++)
+		pList->Add((SWS_ListItem*)g_projTabs.Get(i));
 }
 
 SWS_ProjectListWnd::SWS_ProjectListWnd()
@@ -104,7 +117,9 @@ SWS_ProjectListWnd::SWS_ProjectListWnd()
 
 void SWS_ProjectListWnd::Update()
 {
-	if (m_pLists.Get(0))
+	// Only refresh the list view when tabs were added/removed/moved/renamed,
+	// this is called on every track list change of any project
+	if (UpdateProjectTabs() && m_pLists.Get(0))
 		m_pLists.Get(0)->Update();
 }
 
@@ -112,6 +127,21 @@ void SWS_ProjectListWnd::OnInitDlg()
 {
 	m_resize.init_item(IDC_LIST, 0.0, 0.0, 1.0, 1.0);
 	m_pLists.Add(new SWS_ProjectListView(GetDlgItem(m_hwnd, IDC_LIST), GetDlgItem(m_hwnd, IDC_EDIT)));
+	UpdateProjectTabs();
+	m_pLists.Get(0)->Update();
+
+	// "Save as", project switches, etc. don't change the track list: poll
+	// (cheap, the list view is only refreshed if a tab has changed)
+	SetTimer(m_hwnd, 1, 500, NULL);
+}
+
+void SWS_ProjectListWnd::OnDestroy()
+{
+	KillTimer(m_hwnd, 1);
+}
+
+void SWS_ProjectListWnd::OnTimer(WPARAM wParam)
+{
 	Update();
 }
 
@@ -142,9 +172,9 @@ int SWS_ProjectListWnd::OnKey(MSG* msg, int iKeyState)
 		{
 			if (m_pLists.Get(0))
 			{
-				ReaProject* proj = (ReaProject*)m_pLists.Get(0)->EnumSelected(NULL);
-				if (proj)
-					SelectProjectInstance(proj);
+				SWS_ProjectTab* tab = (SWS_ProjectTab*)m_pLists.Get(0)->EnumSelected(NULL);
+				if (tab)
+					SelectProjectInstance(tab->m_proj);
 			}
 			Show(false, true);
 			return 1;
@@ -179,4 +209,5 @@ int ProjectListInit()
 void ProjectListExit()
 {
 	DELETE_NULL(g_pProjList);
+	g_projTabs.Empty(true);
 }
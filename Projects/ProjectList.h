@@ -28,6 +28,15 @@
 
 #pragma once
 
+// Cached project tab, rebuilt on project change notifications (and polled
+// while the window is open, for renames such as "Save as" that don't notify)
+// rather than re-enumerated for each row/column when the list is drawn
+struct SWS_ProjectTab
+{
+	ReaProject* m_proj;
+	WDL_FastString m_fn;
+};
+
 class SWS_ProjectListView : public SWS_ListView
 {
 public:
@@ -47,6 +56,8 @@ public:
 	
 protected:
 	void OnInitDlg();
+	void OnDestroy();
+	void OnTimer(WPARAM wParam=0);
 	void OnCommand(WPARAM wParam, LPARAM lParam);
 	HMENU OnContextMenu(int x, int y, bool* wantDefaultItems);
 	int OnKey(MSG* msg, int iKeyState);
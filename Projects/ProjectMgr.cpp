@@ -28,11 +28,17 @@
 #include "stdafx.h"
 
 #include "../SnM/SnM_Dlg.h"
+#include "../SnM/SnM_Util.h"
 #include "ProjectMgr.h"
 #include "ProjectList.h"
 
 #include <WDL/localize/localize.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 // Globals
 static SWSProjConfig<WDL_PtrList_DOD<WDL_String> > g_relatedProjects;
 
@@ -78,6 +84,106 @@ void SaveProjectList(COMMAND_T*)
 	file.close();
 }
 
+// Reads project files ahead of OpenProjectsFromList() so that opening a list
+// stored on slow (e.g. network) storage does not block for the sum of all reads:
+// a few worker threads read the RPP files into the OS cache and stat their media
+// files, in list order, while the main thread opens the already prefetched ones.
+// Missing media are not reported: REAPER looks for them in other places (record
+// path, project directory...) and prompts for the ones it can't find.
+class ProjectListPrefetcher
+{
+public:
+	ProjectListPrefetcher(const std::vector<std::string>& files) : m_nextJob(0)
+	{
+		m_jobs.resize(files.size());
+		for (size_t i=0; i<files.size(); i++)
+			m_jobs[i].fn = files[i];
+
+		const size_t nbThreads = min(m_jobs.size(), (size_t)4); // I/O bound
+		for (size_t i=0; i<nbThreads; i++)
+			m_threads.emplace_back(&ProjectListPrefetcher::Worker, this);
+	}
+
+	~ProjectListPrefetcher()
+	{
+		m_nextJob = m_jobs.size(); // cancel pending jobs
+		for (size_t i=0; i<m_threads.size(); i++)
+			m_threads[i].join();
+	}
+
+	// Blocks until project i has been prefetched
+	// Returns false if the project file cannot be read
+	bool Wait(size_t i)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cond.wait(lock, [&]() { return m_jobs[i].done; });
+		return m_jobs[i].readable;
+	}
+
+private:
+	struct Job
+	{
+		Job() : done(false), readable(false) {}
+		std::string fn;
+		bool done, readable;
+	};
+
+	void Worker()
+	{
+		for (size_t i=m_nextJob++; i<m_jobs.size(); i=m_nextJob++)
+		{
+			bool readable = Prefetch(m_jobs[i].fn);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs[i].readable = readable;
+			m_jobs[i].done = true;
+			m_cond.notify_all();
+		}
+	}
+
+	static bool IsAbsolutePath(const char* fn)
+	{
+#ifdef _WIN32
+		return (fn[0] && fn[1] == ':') || (fn[0] == '\\' && fn[1] == '\\');
+#else
+		return fn[0] == '/';
+#endif
+	}
+
+	// Reads the whole file and stats its media files (absolute or relative to
+	// the project, where they usually are)
+	static bool Prefetch(const std::string& fn)
+	{
+		std::ifstream file(win32::widen(fn.c_str()).c_str());
+		if (!file)
+			return false;
+
+		std::string dir(fn);
+		size_t slash = dir.find_last_of(PATH_SLASH_CHAR);
+		dir.resize(slash == std::string::npos ? 0 : slash + 1);
+
+		LineParser lp(false);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			// Media sources: FILE "path" [...]
+			size_t first = line.find_first_not_of(" \t");
+			if (first == std::string::npos || line.compare(first, 5, "FILE ") || lp.parse(line.c_str()+first) || lp.getnumtokens() < 2)
+				continue;
+
+			const char* mediaFn = lp.gettoken_str(1);
+			FileOrDirExists(IsAbsolutePath(mediaFn) ? mediaFn : (dir + mediaFn).c_str());
+		}
+		return !file.bad();
+	}
+
+	std::vector<Job> m_jobs;
+	std::atomic<size_t> m_nextJob;
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::vector<std::thread> m_threads;
+};
+
 void OpenProjectsFromList(COMMAND_T*)
 {
 	char directory[MAX_PATH]{};
@@ -96,6 +202,20 @@ void OpenProjectsFromList(COMMAND_T*)
 		return;
 	}
 
+	std::vector<std::string> projectFiles;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r') // list saved on another OS
+			line.pop_back();
+		if (!line.empty())
+			projectFiles.push_back(line);
+	}
+	file.close();
+
+	// Start reading the projects now, while the user answers the prompt below
+	ProjectListPrefetcher prefetcher(projectFiles);
+
 	// Save "prompt on new project" variable
 	ConfigVarOverride<int> newprojdo("newprojdo", 0);
 
@@ -115,21 +235,30 @@ void OpenProjectsFromList(COMMAND_T*)
 			newTab = true;
 	}
 
-	std::string line;
-	while (std::getline(file, line))
+	WDL_FastString errors;
+
+	for (size_t i = 0; i < projectFiles.size(); i++)
 	{
-		if (line.empty())
+		if (!prefetcher.Wait(i))
+		{
+			// Do not open an empty tab for an unreadable project
+			errors.AppendFormatted(MAX_PATH + 64, "%s (%s)\n", projectFiles[i].c_str(), __LOCALIZE("cannot read file","sws_mbox"));
 			continue;
+		}
 
 		if (newTab)
 			Main_OnCommand(41929, 0); // New project tab (ignore default template)
 		else
 			newTab = true;
 
-		Main_openProject(line.c_str());
+		Main_openProject(projectFiles[i].c_str());
 	}
 
-	file.close();
+	if (errors.GetLength())
+	{
+		errors.Insert(__LOCALIZE("Some projects could not be opened:\n\n","sws_mbox"), 0);
+		MessageBox(g_hwndParent, errors.Get(), __LOCALIZE("SWS Project List Open","sws_mbox"), MB_OK);
+	}
 }
 
 // ****************************************************************************
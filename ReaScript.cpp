@@ -38,6 +38,7 @@
 #include "cfillion/cfillion.hpp"
 #include "nofish/NF_ReaScript.h"
 #include "Misc/Analysis.h"
+#include "IX/IX.h"
 
 
 // if _TEST_REASCRIPT_EXPORT is #define'd, you'll need to rename "APITESTFUNC" into "APIFUNC" in g_apidefs too
@@ -161,14 +162,18 @@ APIdef g_apidefs[] =
 	{ APIFUNC(SNM_SetDoubleConfigVar), "bool", "const char*,double", "varname,newvalue", "[S&M] Sets a floating-point preference (look in project prefs first, then in general prefs). Returns false if failed (e.g. varname not found or newvalue out of range).", },
 	{ APIFUNC(SNM_SetDoubleConfigVarEx), "bool", "ReaProject*,const char*,double", "proj,varname,newvalue", "[S&M] See SNM_SetDoubleConfigVar.", },
 	{ APIFUNC(SNM_SetStringConfigVar), "bool", "const char*,const char*", "varname,newvalue", "[S&M] Sets a string preference (general prefs only). Returns false if failed (e.g. varname not found or value too long). See get_config_var_string.", },
+	{ APIFUNC(SNM_GetScheduledJobStats), "int", "int*,int*,int*,int*", "maxDepthOut,performedOut,avgLatencyMsOut,maxLatencyMsOut", "[S&M] Returns the number of scheduled jobs waiting to be performed (deferred S&M work such as MIDI/OSC CC actions, Live Configs, Notes and Region Playlist updates, undo points). maxDepth is the largest number of waiting jobs seen so far, performed the number of jobs performed since startup, avgLatencyMs/maxLatencyMs the average/max delay between the due time of a job and its processing (in ms).", },
 	{ APIFUNC(SNM_MoveOrRemoveTrackFX), "bool", "MediaTrack*,int,int", "tr,fxId,what", "[S&M] Deprecated, see TrackFX_{CopyToTrack,Delete} (v5.95+). Move or removes a track FX. Returns true if tr has been updated.\nfxId: fx index in chain or -1 for the selected fx. what: 0 to remove, -1 to move fx up in chain, 1 to move fx down in chain.", },
 	{ APIFUNC(SNM_GetProjectMarkerName), "bool", "ReaProject*,int,bool,WDL_FastString*", "proj,num,isrgn,name", "[S&M] Gets a marker/region name. Returns true if marker/region found.", },
 	{ APIFUNC(SNM_SetProjectMarker), "bool", "ReaProject*,int,bool,double,double,const char*,int", "proj,num,isrgn,pos,rgnend,name,color", "[S&M] Deprecated, see SetProjectMarker4 -- Same function as SetProjectMarker3() except it can set empty names \"\".", },
 	{ APIFUNC(SNM_SelectResourceBookmark), "int", "const char*", "name", "[S&M] Select a bookmark of the Resources window. Returns the related bookmark id (or -1 if failed).", },
+	{ APIFUNC(SNM_SearchResourceContent), "int", "int,const char*,char*,int", "bookmarkId,query,slotsOut,slotsOut_sz", "[S&M] Searches the content of the files of a Resources window bookmark (FX chains, track templates or projects): plugin names, track/FX names and media file paths. query: space-separated words, a slot matches if any of its plugins/names/paths contains any of the words (case insensitive). Returns the number of matching slots, slotsOut gets their 1-based numbers as a comma-separated list.\nNote: the first call waits for the search index to be built, it is then updated in the background (added or modified files, at most every 5 seconds), results can be partial right after changes.", },
 	{ APIFUNC(SNM_TieResourceSlotActions), "void", "int", "bookmarkId", "[S&M] Attach Resources slot actions to a given bookmark.", },
+	{ APIFUNC(SNM_GetTrackFolderInfo), "int", "MediaTrack*,int*,int*,int*,int*", "tr,parentOut,firstChildOut,nextSiblingOut,lastDescendantOut", "[S&M] Returns the folder depth of a track (-1 for the master track or if not found), along with its parent, first child, next sibling and last descendant tracks (0-based track indexes like GetTrack, -1 if none, parent is -1 for top level tracks). The track's subtree is the range [track index, lastDescendant]. The folder hierarchy is built once for all tracks and cached until the project changes, so that bulk parent/child queries are cheap.", },
 	{ APIFUNC(SNM_AddTCPFXParm), "bool", "MediaTrack*,int,int", "tr,fxId,prmId", "[S&M] Add an FX parameter knob in the TCP. Returns false if nothing updated (invalid parameters, knob already present, etc..)", },
 	{ APIFUNC(SNM_TagMediaFile), "bool", "const char*,const char*,const char*", "fn,tag,tagval", "[S&M] Tags a media file thanks to <a href=\"https://taglib.github.io\">TagLib</a>. Supported tags: \"artist\", \"album\", \"genre\", \"comment\", \"title\", \"track\" (track number) or \"year\". Use an empty tagval to clear a tag. When a file is opened in REAPER, turn it offline before using this function. Returns false if nothing updated. See SNM_ReadMediaFileTag.", },
-	{ APIFUNC(SNM_ReadMediaFileTag), "bool", "const char*,const char*,char*,int", "fn,tag,tagvalOut,tagvalOut_sz", "[S&M] Reads a media file tag. Supported tags: \"artist\", \"album\", \"genre\", \"comment\", \"title\", \"track\" (track number) or \"year\". Returns false if tag was not found. See SNM_TagMediaFile.", },
+	{ APIFUNC(SNM_ReadMediaFileTag), "bool", "const char*,const char*,char*,int", "fn,tag,tagvalOut,tagvalOut_sz", "[S&M] Reads a media file tag. Supported tags: \"artist\", \"album\", \"genre\", \"comment\", \"title\", \"track\" (track number) or \"year\", plus BWF \"desc\", \"orig\", \"origref\", \"date\", \"time\", \"codinghistory\" and iXML \"ixml:project\", \"ixml:scene\", \"ixml:take\", \"ixml:tape\", \"ixml:note\". WAV/BWF and MP3 tags are read from the file headers only, results are cached until the file is modified. Returns false if tag was not found. See SNM_ReadMediaFilesTag, SNM_TagMediaFile.", },
+	{ APIFUNC(SNM_ReadMediaFilesTag), "int", "const char*,const char*,WDL_FastString*", "fns,tag,tagvals", "[S&M] Bulk version of SNM_ReadMediaFileTag: reads the same tag from a list of newline separated media files, in parallel. tagvals receives one line per file, in the same order (empty line if the tag was not found, line breaks in values are replaced with spaces). Returns the number of files the tag was found in. See SNM_CreateFastString.", },
 
 	{ APIFUNC(FNG_AllocMidiTake), "RprMidiTake*", "MediaItem_Take*", "take", "[FNG] Allocate a RprMidiTake from a take pointer. Returns a NULL pointer if the take is not an in-project MIDI take", },
 	{ APIFUNC(FNG_FreeMidiTake), "void", "RprMidiTake*", "midiTake", "[FNG] Commit changes to MIDI take and free allocated memory", },
@@ -211,6 +216,7 @@ APIdef g_apidefs[] =
 	{ APIFUNC(BR_GetMidiTakePoolGUID), "bool", "MediaItem_Take*,char*,int", "take,guidStringOut,guidStringOut_sz", "[BR] Get MIDI take pool GUID as a string (guidStringOut_sz should be at least 64). Returns true if take is pooled.", },
 	{ APIFUNC(BR_GetMidiTakeTempoInfo), "bool", "MediaItem_Take*,bool*,double*,int*,int*", "take,ignoreProjTempoOut,bpmOut,numOut,denOut", "[BR] Get \"ignore project tempo\" information for MIDI take. Returns true if take can ignore project tempo (no matter if it's actually ignored), otherwise false.", },
 	{ APIFUNC(BR_GetMouseCursorContext), "void", "char*,int,char*,int,char*,int", "windowOut,windowOut_sz,segmentOut,segmentOut_sz,detailsOut,detailsOut_sz", BR_MOUSE_REASCRIPT_DESC, },
+	{ APIFUNC(BR_GetMouseCursorContext_CacheStats), "void", "int*,int*", "hitsOut,missesOut", "[BR] Returns how many mouse cursor context queries (made by <a href=\"#BR_GetMouseCursorContext\">BR_GetMouseCursorContext</a>, contextual toolbars and mouse actions) were served from cache and how many had to be resolved. Cached context is reused while cursor position, arrange view and project are unchanged within one timer tick.", },
 	{ APIFUNC(BR_GetMouseCursorContext_Envelope), "TrackEnvelope*", "bool*", "takeEnvelopeOut", "[BR] Returns envelope that was captured with the last call to <a href=\"#BR_GetMouseCursorContext\">BR_GetMouseCursorContext</a>. In case the envelope belongs to take, takeEnvelope will be true. See BR_GetMouseCursorContext_EnvelopeEx.", },
 	{ APIFUNC(BR_GetMouseCursorContext_EnvelopeEx), "TrackEnvelope*", "bool*,int*,int*", "takeEnvelopeOut,autoItemIdxOut,pointIdxOut", "[BR] Returns envelope that was captured with the last call to <a href=\"#BR_GetMouseCursorContext\">BR_GetMouseCursorContext</a>. In case the envelope belongs to take, takeEnvelope will be true. Automation item and point index are -1 if the mouse cursor is not over one.", },
 	{ APIFUNC(BR_GetMouseCursorContext_Item), "MediaItem*", "", "", "[BR] Returns item under mouse cursor that was captured with the last call to <a href=\"#BR_GetMouseCursorContext\">BR_GetMouseCursorContext</a>. Note that the function will return item even if mouse cursor is over some other track lane element like stretch marker or envelope. This enables for easier identification of items when you want to ignore elements within the item."},
@@ -229,6 +235,9 @@ APIdef g_apidefs[] =
 	{ APIFUNC(BR_MIDI_CCLaneRemove), "bool", "void*,int", "midiEditor,laneId", "[BR] Remove CC lane in midi editor. Top visible CC lane is laneId 0. Returns true on success", },
 	{ APIFUNC(BR_MIDI_CCLaneReplace), "bool", "void*,int,int", "midiEditor,laneId,newCC", "[BR] Replace CC lane in midi editor. Top visible CC lane is laneId 0. Returns true on success.\nValid CC lanes: CC0-127=CC, 0x100|(0-31)=14-bit CC, 0x200=velocity, 0x201=pitch, 0x202=program, 0x203=channel pressure, 0x204=bank/program select, 0x205=text, 0x206=sysex, 0x207", },
 	{ APIFUNC(BR_PositionAtMouseCursor), "double", "bool", "checkRuler", "[BR] Get position at mouse cursor. To check ruler along with arrange, pass checkRuler=true. Returns -1 if cursor is not over arrange/ruler.", },
+	{ APIFUNC(BR_Profiler_DumpChromeTrace), "bool", "const char*", "filenameIn", "[BR] Write the last profiled scopes (up to 65536 events, see <a href=\"#BR_Profiler_Enable\">BR_Profiler_Enable</a>) to a Chrome trace JSON file that can be opened in chrome://tracing or Perfetto. Returns false if the file can't be written.", },
+	{ APIFUNC(BR_Profiler_Enable), "void", "bool,bool", "enable,reset", "[BR] Enable/disable profiling of SWS actions, timer slices and list view refreshes. When disabled (default) profiling has negligible cost. Statistics are kept when disabling, set reset to clear them.\nSee <a href=\"#BR_Profiler_GetStats\">BR_Profiler_GetStats</a> and <a href=\"#BR_Profiler_DumpChromeTrace\">BR_Profiler_DumpChromeTrace</a>.", },
+	{ APIFUNC(BR_Profiler_GetStats), "bool", "int,char*,int,int*,double*,double*,char*,int", "idx,nameOut,nameOut_sz,countOut,totalMsOut,maxMsOut,histogramOut,histogramOut_sz", "[BR] Enumerate profiled scopes (actions are named by their command ID string). Returns false when idx is out of range.\nhistogram: comma-separated counts of durations, bucket i counts durations in [2^i, 2^(i+1)) microseconds (24 buckets).", },
 	{ APIFUNC(BR_SetArrangeView), "void", "ReaProject*,double,double", "proj,startTime,endTime", "[BR] Deprecated, see GetSet_ArrangeView2 (REAPER v5.12pre4+) -- Set start and end time position of arrange view. To get arrange view instead, see BR_GetArrangeView.", },
 	{ APIFUNC(BR_SetItemEdges), "bool", "MediaItem*,double,double", "item,startTime,endTime", "[BR] Set item start and end edges' position - returns true in case of any changes", },
 	{ APIFUNC(BR_SetMediaItemImageResource), "void", "MediaItem*,const char*,int", "item,imageIn,imageFlags", "[BR] Set image resource and its flags for a given item. To clear current image resource, pass imageIn as \"\".\nimageFlags: &1=0: don't display image, &1: center / tile, &3: stretch, &5: full height (REAPER 5.974+).\nCan also be used to display existing text in empty items unstretched (pass imageIn = \"\", imageFlags = 0) or stretched (pass imageIn = \"\". imageFlags = 3).\nTo get image resource, see BR_GetMediaItemImageResource.", },
@@ -308,6 +317,8 @@ APIdef g_apidefs[] =
 	{ APIFUNC(NF_GetSWSMarkerRegionSub), "const char*", "int", "markerRegionIdx", "Returns SWS/S&M marker/region subtitle. markerRegionIdx: Refers to index that can be passed to <a href=\"#EnumProjectMarkers\">EnumProjectMarkers</a> (not displayed marker/region index). Returns empty string if marker/region with specified index not found or marker/region subtitle not set. Lua code example <a href=\"https://github.com/ReaTeam/ReaScripts-Templates/blob/master/Markers%20and%20Regions/NF_Get%20SWS%20markers%20and%20regions%20notes.lua\">here</a>.", },
 	{ APIFUNC(NF_SetSWSMarkerRegionSub), "bool", "const char*,int", "markerRegionSub,markerRegionIdx", "Set SWS/S&M marker/region subtitle. markerRegionIdx: Refers to index that can be passed to <a href=\"#EnumProjectMarkers\">EnumProjectMarkers</a> (not displayed marker/region index). Returns true if subtitle is set successfully (i.e. marker/region with specified index is present in project). Lua code example <a href=\"https://github.com/ReaTeam/ReaScripts-Templates/blob/master/Markers%20and%20Regions/NF_Get%20SWS%20markers%20and%20regions%20notes.lua\">here</a>.", },
 	{ APIFUNC(NF_UpdateSWSMarkerRegionSubWindow), "void", "", "", "Redraw the Notes window (call if you've changed a subtitle via <a href=\"#NF_SetSWSMarkerRegionSub\">NF_SetSWSMarkerRegionSub</a> which is currently displayed in the Notes window and you want to appear the new subtitle immediately.)", },
+	{ APIFUNC(NF_GetSWSMarkerRegionSubs), "int", "char*,int", "subsOutNeedBig,subsOutNeedBig_sz", "Returns the number of SWS/S&M marker/region subtitles set in the project, all fetched at once as one \"markerRegionIdx<tab>subtitle\" line per marker/region (markerRegionIdx: see <a href=\"#NF_GetSWSMarkerRegionSub\">NF_GetSWSMarkerRegionSub</a>). Line breaks and backslashes in subtitles are escaped as \\n, \\r and \\\\.", },
+	{ APIFUNC(NF_SetSWSMarkerRegionSubs), "int", "const char*", "markerRegionSubs", "Sets many SWS/S&M marker/region subtitles at once, see <a href=\"#NF_GetSWSMarkerRegionSubs\">NF_GetSWSMarkerRegionSubs</a> for the format. Returns the number of subtitles set (lines referring to markers/regions not present in the project are ignored).", },
 
 	{ APIFUNC(NF_TakeFX_GetFXModuleName), "bool", "MediaItem*,int,char*,int", "item,fx,nameOut,nameOut_sz", "Deprecated, see TakeFX_GetNamedConfigParm/'fx_ident' (v6.37+). See BR_TrackFX_GetFXModuleName. fx: counted consecutively across all takes (zero-based).", },
 	{ APIFUNC(NF_Win32_GetSystemMetrics), "int", "int", "nIndex", "Equivalent to win32 API GetSystemMetrics(). Note: Only SM_C[XY]SCREEN, SM_C[XY][HV]SCROLL and SM_CYMENU are currently supported on macOS and Linux as of REAPER 6.68. Check the <a href=\"https://github.com/justinfrankel/WDL/blob/main/WDL/swell\">SWELL source code</a> for up-to-date support information (swell-wnd.mm, swell-wnd-generic.cpp).", },
@@ -418,6 +429,8 @@ I_PITCHMODE    highest 16 bits=pitch shift mode (see EnumPitchShiftModes), lower
 	{ APIFUNC(JB_GetSWSExtraProjectNotes), "const char*", "ReaProject*", "project", "", },
 	{ APIFUNC(JB_SetSWSExtraProjectNotes), "void", "ReaProject*,const char*", "project,str", "", },
 
+	{ APIFUNC(IX_LabelProcessorPreview), "int", "const char*,bool,char*,int", "format,allTakes,namesOutNeedBig,namesOutNeedBig_sz", "[IX] Applies a Label processor format (see action \"SWS/IX: Label processor\") to the takes of selected items and returns the generated names, one per line, without renaming anything. allTakes: false for active takes only. Returns the number of generated names.", },
+
 	{ NULL, } // denote end of table
 };
 
@@ -983,7 +983,74 @@ void ExclusiveToggle(COMMAND_T* _ct)
 // ScheduledJob
 ///////////////////////////////////////////////////////////////////////////////
 
+// jobs are kept in a binary min-heap ordered by due time (g_jobs.Get(0) is
+// the next job to perform), each job knows its slot in the heap and
+// g_jobsById maps job ids to jobs: scheduling, replacing and performing
+// jobs are O(log n), polling an idle/not yet due queue is O(1)
 WDL_PtrList_DOD<ScheduledJob> g_jobs;
+WDL_IntKeyedArray<ScheduledJob*> g_jobsById; // no valdispose(), jobs are owned by g_jobs
+
+// stats
+int g_jobsMaxDepth = 0, g_jobsPerformed = 0;
+WDL_UINT64 g_jobsLatencySum = 0; // 64-bit: a DWORD sum wraps after ~4M jobs performed 1s late
+DWORD g_jobsMaxLatency = 0;
+
+// wrap-safe, GetTickCount() wraps every ~49 days
+static bool IsDueBefore(DWORD _t1, DWORD _t2) {
+	return (int)(_t1-_t2) < 0;
+}
+
+void ScheduledJob::HeapSwap(int _i, int _j)
+{
+	ScheduledJob* job1 = g_jobs.Get(_i);
+	ScheduledJob* job2 = g_jobs.Get(_j);
+	g_jobs.Set(_i, job2); job2->m_slot = _i;
+	g_jobs.Set(_j, job1); job1->m_slot = _j;
+}
+
+void ScheduledJob::HeapUp(int _i)
+{
+	while (_i>0)
+	{
+		int parent = (_i-1)/2;
+		if (!IsDueBefore(g_jobs.Get(_i)->m_time, g_jobs.Get(parent)->m_time))
+			break;
+		HeapSwap(_i, parent);
+		_i = parent;
+	}
+}
+
+void ScheduledJob::HeapDown(int _i)
+{
+	int n = g_jobs.GetSize();
+	for (;;)
+	{
+		int left=2*_i+1, right=left+1, first=_i;
+		if (left<n && IsDueBefore(g_jobs.Get(left)->m_time, g_jobs.Get(first)->m_time))
+			first = left;
+		if (right<n && IsDueBefore(g_jobs.Get(right)->m_time, g_jobs.Get(first)->m_time))
+			first = right;
+		if (first==_i)
+			break;
+		HeapSwap(_i, first);
+		_i = first;
+	}
+}
+
+// removes (does not delete) the job at slot _i
+void ScheduledJob::HeapRemove(int _i)
+{
+	int last = g_jobs.GetSize()-1;
+	if (_i!=last)
+		HeapSwap(_i, last);
+	g_jobs.Get(last)->m_slot = -1;
+	g_jobs.Delete(last, false);
+	if (_i<last)
+	{
+		HeapDown(_i);
+		HeapUp(_i);
+	}
+}
 
 void ScheduledJob::Schedule(ScheduledJob* _job)
 {
@@ -1003,29 +1070,34 @@ void ScheduledJob::Schedule(ScheduledJob* _job)
 		return;
 	}
 
-	// replace?
-	for (int i=0; i<g_jobs.GetSize(); i++)
+	// replace? the new job takes the slot of the replaced one and re-waits
+	if (ScheduledJob* job = g_jobsById.Get(_job->m_id, NULL))
 	{
-		if (ScheduledJob* job = g_jobs.Get(i))
-		{
-			if (job->m_id == _job->m_id)
-			{
-				_job->InitSafe(job);
-				g_jobs.Set(i, _job);
-				DELETE_NULL(job);
+		_job->InitSafe(job);
+		int slot = job->m_slot;
+		g_jobs.Set(slot, _job);
+		_job->m_slot = slot;
+		g_jobsById.Insert(_job->m_id, _job);
+		DELETE_NULL(job);
+		HeapDown(slot);
+		HeapUp(_job->m_slot);
 #ifdef _SNM_DEBUG
-				char dbg[256]="";
-				snprintf(dbg, sizeof(dbg), "ScheduledJob::Schedule() - Replaced job #%d\n", _job->m_id);
-				OutputDebugString(dbg);
+		char dbg[256]="";
+		snprintf(dbg, sizeof(dbg), "ScheduledJob::Schedule() - Replaced job #%d\n", _job->m_id);
+		OutputDebugString(dbg);
 #endif
-				return;
-			}
-		}
+		return;
 	}
 
 	// add (exclusive with the above)
 	_job->InitSafe();
+	_job->m_slot = g_jobs.GetSize();
 	g_jobs.Add(_job);
+	g_jobsById.Insert(_job->m_id, _job);
+	HeapUp(_job->m_slot);
+
+	if (g_jobs.GetSize() > g_jobsMaxDepth)
+		g_jobsMaxDepth = g_jobs.GetSize();
 
 #ifdef _SNM_DEBUG
 	char dbg[256]="";
@@ -1038,25 +1110,43 @@ void ScheduledJob::Schedule(ScheduledJob* _job)
 // polled from the main thread via SNM_CSurfRun()
 void ScheduledJob::Run()
 {
-	for (int i=g_jobs.GetSize()-1; i>=0; i--)
+	// jobs scheduled by performed jobs will wait for the next run
+	DWORD now = GetTickCount();
+	while (g_jobs.GetSize())
 	{
-		if (ScheduledJob* job = g_jobs.Get(i))
-		{
-			if (GetTickCount() > job->m_time)
-			{
-				g_jobs.Delete(i, false);
-				job->PerformSafe();
+		ScheduledJob* job = g_jobs.Get(0);
+		if (!IsDueBefore(job->m_time, now))
+			break; // nothing else due yet
+
+		HeapRemove(0);
+		g_jobsById.Delete(job->m_id);
+
+		DWORD latency = now - job->m_time;
+		g_jobsLatencySum += latency;
+		if (latency > g_jobsMaxLatency)
+			g_jobsMaxLatency = latency;
+		g_jobsPerformed++;
+
+		job->PerformSafe();
 #ifdef _SNM_DEBUG
-				char dbg[256]="";
-				snprintf(dbg, sizeof(dbg), "ScheduledJob::Run() - Performed job %d\n", job->m_id);
-				OutputDebugString(dbg);
+		char dbg[256]="";
+		snprintf(dbg, sizeof(dbg), "ScheduledJob::Run() - Performed job %d (latency: %lums)\n", job->m_id, (unsigned long)latency);
+		OutputDebugString(dbg);
 #endif
-				DELETE_NULL(job);
-			}
-		}
+		DELETE_NULL(job);
 	}
 }
 
+// latencies: delay between due time and actual processing, in ms
+void ScheduledJob::GetStats(int* _depth, int* _maxDepth, int* _performed, int* _avgLatencyMs, int* _maxLatencyMs)
+{
+	if (_depth) *_depth = g_jobs.GetSize();
+	if (_maxDepth) *_maxDepth = g_jobsMaxDepth;
+	if (_performed) *_performed = g_jobsPerformed;
+	if (_avgLatencyMs) *_avgLatencyMs = g_jobsPerformed ? int(g_jobsLatencySum/(WDL_UINT64)g_jobsPerformed) : 0;
+	if (_maxLatencyMs) *_maxLatencyMs = int(g_jobsMaxLatency);
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // MidiOscActionJob
@@ -79,6 +79,8 @@
 #define SNM_CYCLACTION_EXPORT_FILE "%s\\S&M_Cyclactions_export.ini"
 #define SNM_KB_INI_FILE            "%s\\reaper-kb.ini"
 #define SNM_CONSOLE_FILE           "%s\\reaconsole_customcommands.txt"
+#define SNM_AUTOFILL_CACHE_FILE    "%s\\S&M_AutoFill.cache"
+#define SNM_RES_INDEX_FILE         "%s\\S&M_ResourcesIndex.txt"
 #define SNM_REAPER_EXE_FILE        "%s\\reaper.exe"
 #define SNM_FONT_NAME              "MS Shell Dlg"
 #define SNM_FONT_HEIGHT            14
@@ -98,6 +100,8 @@
 #define SNM_CYCLACTION_EXPORT_FILE "%s/S&M_Cyclactions_export.ini"
 #define SNM_KB_INI_FILE            "%s/reaper-kb.ini"
 #define SNM_CONSOLE_FILE           "%s/reaconsole_customcommands.txt"
+#define SNM_AUTOFILL_CACHE_FILE    "%s/S&M_AutoFill.cache"
+#define SNM_RES_INDEX_FILE         "%s/S&M_ResourcesIndex.txt"
 #ifdef __LP64__
 #define SNM_REAPER_EXE_FILE        "%s/REAPER64.app"
 #else
@@ -125,7 +129,7 @@
 #define SNM_CSURF_EXT_UNREGISTER   0x00016666
 #define SNM_REAPER_IMG_EXTS        "png,pcx,jpg,jpeg,jfif,ico,bmp" // img exts supported by REAPER (v4.32), can't get those at runtime yet
 #define SNM_INI_EXT_LIST           "INI files (*.INI)\0*.INI\0All Files\0*.*\0"
-#define SNM_SUB_EXT_LIST           "SubRip subtitle files (*.SRT)\0*.SRT\0"
+#define SNM_SUB_EXT_LIST           "Subtitle files (*.SRT;*.VTT)\0*.SRT;*.VTT\0SubRip subtitle files (*.SRT)\0*.SRT\0WebVTT subtitle files (*.VTT)\0*.VTT\0"
 #define SNM_TXT_EXT_LIST           "Text files (*.txt)\0*.txt\0All files (*.*)\0*.*\0"
 
 #define SNM_MARKER_MASK            1
@@ -275,11 +279,12 @@ class ScheduledJob
 public:
 	// _approxMs==0 means "to be performed immediately" (not added to the processing queue)
 	ScheduledJob(int _id, int _approxMs)
-		: m_id(_id),m_approxMs(_approxMs),m_scheduled(false),m_time(GetTickCount()+_approxMs) {}
+		: m_id(_id),m_approxMs(_approxMs),m_scheduled(false),m_time(GetTickCount()+_approxMs),m_slot(-1) {}
 	virtual ~ScheduledJob() {}
 
 	static void Schedule(ScheduledJob* _job);
 	static void Run(); // polled from the main thread via SNM_CSurfRun()
+	static void GetStats(int* _depth, int* _maxDepth, int* _performed, int* _avgLatencyMs, int* _maxLatencyMs);
 
 	// not safe to make anything public: 1-jobs are auto-deleted, 2-Init() may not have been called
 
@@ -294,6 +299,12 @@ private:
 	void PerformSafe() { InitSafe(); Perform(); }
 	bool m_scheduled;
 	DWORD m_time;
+	int m_slot; // index in the jobs heap
+
+	static void HeapSwap(int _i, int _j);
+	static void HeapUp(int _i);
+	static void HeapDown(int _i);
+	static void HeapRemove(int _i);
 };
 
 
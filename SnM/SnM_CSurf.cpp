@@ -29,6 +29,7 @@
 
 #include "SnM.h"
 #include "SnM_CSurf.h"
+#include "SnM_Find.h"
 #include "SnM_LiveConfigs.h"
 #include "SnM_Misc.h"
 #include "SnM_Notes.h"
@@ -58,14 +59,16 @@ void SNM_CSurfRun()
 	PlaylistRun();
 	ScheduledJob::Run();
 	StopTrackPreviewsRun();
+	ResourcesRun();
 	UpdateMarkerRegionRun();
 	AutoRefreshToolbarRun();
 
 	sRecurseCheck = false;
 }
 
-void SNM_CSurfSetTrackTitle() {
+void SNM_CSurfSetTrackTitle(MediaTrack* _tr) {
 	NotesSetTrackTitle();
+	FindSetTrackTitle(_tr);
 	LiveConfigsSetTrackTitle();
 }
 
@@ -75,6 +78,7 @@ void SNM_CSurfSetTrackListChange()
 	LiveConfigsTrackListChange();
 	RegionPlaylistSetTrackListChange();
 	ResourcesTrackListChange();
+	FindSetTrackListChange();
 }
 
 bool g_lastPlayState=false, g_lastPauseState=false, g_lastRecState=false;
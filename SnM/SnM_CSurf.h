@@ -33,7 +33,7 @@
 
 // SWSTimeSlice:IReaperControlSurface callbacks
 void SNM_CSurfRun();
-void SNM_CSurfSetTrackTitle();
+void SNM_CSurfSetTrackTitle(MediaTrack* _tr);
 void SNM_CSurfSetTrackListChange();
 void SNM_CSurfSetPlayState(bool _play, bool _pause, bool _rec);
 int SNM_CSurfExtended(int _call, void* _parm1, void* _parm2, void* _parm3);
@@ -51,6 +51,7 @@ WDL_PtrList<Cyclaction> g_cas[SNM_MAX_CA_SECTIONS];
 SNM_WindowManager<CyclactionWnd> g_caWndMgr(CA_WND_ID);
 bool g_undos = true; // consolidate undo points
 bool g_preventUIRefresh = true;
+int g_caPlanGen = 1; // bumped when CAs are (un)registered, see Cyclaction::GetStepPlan()
 
 ///////////////////////////////////////////////////////////////////////////////
 // CA helpers
@@ -468,65 +469,73 @@ static bool PerformSpecialCustomActionCommand(const int cmdId)
 	return false;
 }
 
-// assumes _cmdStr is valid and has been "exploded", if needed
-int PerformSingleCommand(int _section, const char* _cmdStr, int _val, int _valhw, int _relmode, HWND _hwnd)
+// assumes _cmdId is a registered command id
+int PerformSingleCommand(int _section, KbdSectionInfo* _kbdSec, int _cmdId, int _val, int _valhw, int _relmode, HWND _hwnd)
+{
+	// can't just rely on kbdSec->onAction() because some actions
+	// depend on the current focused window, etc
+	switch (_section)
+	{
+		case SNM_SEC_IDX_MAIN:
+			if(PerformSpecialCustomActionCommand(_cmdId))
+				return 1;
+			return KBD_OnMainActionEx(_cmdId, _val, _valhw, _relmode, _hwnd, NULL);
+		case SNM_SEC_IDX_ME:
+		case SNM_SEC_IDX_ME_EL:
+			return MIDIEditor_LastFocused_OnCommand(_cmdId, _section==SNM_SEC_IDX_ME_EL);
+		case SNM_SEC_IDX_EXPLORER:
+			if (HWND h = GetReaHwndByTitle(__localizeFunc("Media Explorer", "explorer", 0))) {
+				SendMessage(h, WM_COMMAND, _cmdId, 0);
+				return 1;
+			}
+			return 0;
+		default:
+			return _kbdSec->onAction(_cmdId, _val, _valhw, _relmode, _hwnd);
+	}
+}
+
+// resolves (once) the command id of a CA_OP_CMD op
+// SNM_NamedCommandLookup hard check: the command MUST be registered
+static int GetCAOpCmdId(CAOp* _op, KbdSectionInfo* _kbdSec)
+{
+	if (!_op->cmdId && _op->type==CA_OP_CMD)
+		_op->cmdId = SNM_NamedCommandLookup(_op->str, _kbdSec, true);
+	return _op->cmdId;
+}
+
+// assumes _op has been "exploded", if needed
+int PerformSingleOp(int _section, KbdSectionInfo* _kbdSec, CAOp* _op, int _val, int _valhw, int _relmode, HWND _hwnd)
 {
 #ifdef _SNM_DEBUG
-	OutputDebugString(_cmdStr);
+	OutputDebugString(_op->str);
 	OutputDebugString("\n");
 #endif
-	if (_cmdStr && *_cmdStr)
+	switch (_op->type)
 	{
-		KbdSectionInfo* kbdSec = SNM_GetActionSection(_section);
-		if (!kbdSec)
+		case CA_OP_CMD:
+			if (int cmdId = GetCAOpCmdId(_op, _kbdSec))
+				return PerformSingleCommand(_section, _kbdSec, cmdId, _val, _valhw, _relmode, _hwnd);
 			return 0;
-
-		// SNM_NamedCommandLookup hard check: the command MUST be registered
-		if (int cmdId = SNM_NamedCommandLookup(_cmdStr, kbdSec, true))
-	{
-			// can't just rely on kbdSec->onAction() because some actions
-			// depend on the current focused window, etc
-			switch (_section)
-			{
-				case SNM_SEC_IDX_MAIN:
-					if(PerformSpecialCustomActionCommand(cmdId))
-						return 1;
-					return KBD_OnMainActionEx(cmdId, _val, _valhw, _relmode, _hwnd, NULL);
-				case SNM_SEC_IDX_ME:
-				case SNM_SEC_IDX_ME_EL:
-					return MIDIEditor_LastFocused_OnCommand(cmdId, _section==SNM_SEC_IDX_ME_EL);
-				case SNM_SEC_IDX_EXPLORER:
-					if (HWND h = GetReaHwndByTitle(__localizeFunc("Media Explorer", "explorer", 0))) {
-						SendMessage(h, WM_COMMAND, cmdId, 0);
-						return 1;
-					}
-					return 0;
-				default:
-					return kbdSec->onAction(cmdId, _val, _valhw, _relmode, _hwnd);
-			}
-		}
 		// custom console command?
 		// note: authorized in any section
-		else if (!_strnicmp(STATEMENT_CONSOLE, _cmdStr, strlen(STATEMENT_CONSOLE)))
-		{
-			RunConsoleCommand(_cmdStr+strlen(STATEMENT_CONSOLE)+1); // +1 for the space char in "CONSOLE cmd"
+		case IDX_STATEMENT_CONSOLE:
+			RunConsoleCommand(_op->str);
 			if (!g_undos)
 			{
 				char undo[128];
-				snprintf(undo, sizeof(undo), __LOCALIZE("ReaConsole command '%s'","sws_undo"), _cmdStr+strlen(STATEMENT_CONSOLE)+1);
+				snprintf(undo, sizeof(undo), __LOCALIZE("ReaConsole command '%s'","sws_undo"), _op->str);
 				Undo_OnStateChangeEx2(NULL, undo, UNDO_STATE_ALL, -1);
 			}
 			return 1;
-		}
 		// label processor command
-		else if (!_strnicmp(STATEMENT_LABEL, _cmdStr, strlen(STATEMENT_LABEL)))
+		case IDX_STATEMENT_LABEL:
 		{
-			WDL_FastString str(_cmdStr+strlen(STATEMENT_LABEL)+1); // +1 for the space char in "LABEL cmd"
+			WDL_FastString str(_op->str);
 			RunLabelCommand(&str);
 			if (!g_undos)
 			{
 				char undo[128];
-				snprintf(undo, sizeof(undo), __LOCALIZE("Label Processor command '%s'","sws_undo"), _cmdStr+strlen(STATEMENT_LABEL)+1);
+				snprintf(undo, sizeof(undo), __LOCALIZE("Label Processor command '%s'","sws_undo"), _op->str);
 				Undo_OnStateChangeEx2(NULL, undo, UNDO_STATE_ALL, -1); // do not use UNDO_STATE_ITEMS here
 			}
 			return 1;
@@ -535,8 +544,68 @@ int PerformSingleCommand(int _section, const char* _cmdStr, int _val, int _valhw
 	return 0;
 }
 
+// same as ExplodeCyclaction(_flags=0x1) but with compiled plans:
+// gets the ops of the current step and switches to the next step
+static bool StepCyclaction(int _section, Cyclaction* _action, CAOp** _ops, CAStep* _step)
+{
+	if (!_action->GetStepPlan(_section, _action->m_performState, _ops, _step))
+		return false;
+	_action->m_performState = _step->nextStep;
+	_action->m_fakeToggle = !_action->m_fakeToggle;
+	return true;
+}
+
+// recomputes nextElse/nextEndif, i.e. the jump targets of conditional statements
+static void UpdateCAJumps(CAOp* _ops, int _nbOps)
+{
+	int nextElse=_nbOps, nextEndif=_nbOps;
+	for (int i=_nbOps-1; i>=0; i--)
+	{
+		_ops[i].nextElse = nextElse;
+		_ops[i].nextEndif = nextEndif;
+		if (_ops[i].type == IDX_STATEMENT_ENDIF) nextElse = nextEndif = i;
+		else if (_ops[i].type == IDX_STATEMENT_ELSE) nextElse = i;
+	}
+}
+
+// appends the ops of a step to _flat, sub-CAs are stepped and expanded recursively
+static bool FlattenCAStep(int _section, KbdSectionInfo* _kbdSec, CAOp* _ops, int _nbOps, WDL_TypedBuf<CAOp>* _flat, int _depth)
+{
+	if (_depth > 32) // registered CAs can't be recursive, just in case..
+		return false;
+
+	for (int i=0; i<_nbOps; i++)
+	{
+		if (_ops[i].type == CA_OP_SUBCA)
+		{
+			CAOp* subOps;
+			CAStep subStep;
+			Cyclaction* a = g_cas[_section].Get(_ops[i].param-1);
+			if (!a || !StepCyclaction(_section, a, &subOps, &subStep) ||
+				!FlattenCAStep(_section, _kbdSec, subOps, subStep.nbOps, _flat, _depth+1))
+				return false;
+		}
+		else
+		{
+			GetCAOpCmdId(&_ops[i], _kbdSec); // resolve in the plan, not in the copy
+			_flat->Add(_ops[i]);
+		}
+	}
+	return true;
+}
+
+// per nesting level work buffers (CAs can perform CAs), no allocation once warmed up
+struct CARunBuffers
+{
+	WDL_TypedBuf<CAOp> flat;
+	WDL_TypedBuf<CAOp*> cmds;
+};
+static WDL_PtrList_DeleteOnDestroy<CARunBuffers> s_caRunBufs;
+static int s_caRunDepth = 0;
+
 // assumes the CA is valid (e.g. no recursion) + its statements are valid + etc..
 // (faulty CAs must not be registered at this point, see CheckRegisterableCyclaction())
+// statements are resolved first (toggle states are read once), then commands are performed
 void RunCycleAction(COMMAND_T* _ct, int _val, int _valhw, int _relmode, HWND _hwnd)
 {
 	int sec = _ct ? SNM_GetActionSectionIndex(_ct->uniqueSectionId) : -1;
@@ -551,152 +620,195 @@ void RunCycleAction(COMMAND_T* _ct, int _val, int _valhw, int _relmode, HWND _hw
 	if (!kbdSec) 
 		return;
 
+	if (s_caRunDepth >= s_caRunBufs.GetSize())
+		s_caRunBufs.Add(new CARunBuffers);
+	CARunBuffers* bufs = s_caRunBufs.Get(s_caRunDepth++);
+
 	for (;;)
 	{
 		// store step or action name *before* m_performState update
 		const char* undoStr = action->GetStepName();
 
-		WDL_PtrList_DeleteOnDestroy<WDL_FastString> subCmds;
-		if (ExplodeCyclaction(sec, _ct->id, &subCmds, NULL, NULL, 0x1, action) > 0) // 0x1!
+		CAOp* ops;
+		CAStep step;
+		if (!StepCyclaction(sec, action, &ops, &step))
+			break;
+
+		int nbOps = step.nbOps;
+		if (step.hasSubCA)
+		{
+			bufs->flat.Resize(0, false);
+			if (!FlattenCAStep(sec, kbdSec, ops, nbOps, &bufs->flat, 0))
+				break;
+			ops = bufs->flat.Get();
+			nbOps = bufs->flat.GetSize();
+			UpdateCAJumps(ops, nbOps);
+		}
+
+		int loopCnt = -1, loopStart = 0;
+		bufs->cmds.Resize(0, false);
+		for (int i=0; i<nbOps; i++)
 		{
-			int loopCnt = -1;
-			WDL_PtrList<WDL_FastString> allCmds, loopCmds;
-			for (int i=0; i<subCmds.GetSize(); i++)
+			CAOp* op = &ops[i];
+			switch (op->type)
 			{
-				const char* cmdStr = subCmds.Get(i) ? subCmds.Get(i)->Get() : "";
-				if (IsCondStatement(cmdStr))
+				case IDX_STATEMENT_IF:
+				case IDX_STATEMENT_IFNOT:
+				case IDX_STATEMENT_IFAND:
+				case IDX_STATEMENT_IFNAND:
+				case IDX_STATEMENT_IFOR:
+				case IDX_STATEMENT_IFNOR:
+				case IDX_STATEMENT_IFXOR:
+				case IDX_STATEMENT_IFXNOR:
 				{
-					bool twoConds = IsTwoCondStatement(cmdStr);
-					if ((i + (twoConds?2:1)) < subCmds.GetSize())
+					const bool twoConds = op->type>=IDX_STATEMENT_IFAND;
+					if ((i + (twoConds?2:1)) < nbOps)
 					{
-						bool isON = (!_stricmp(STATEMENT_IF, cmdStr) ||
-							!_stricmp(STATEMENT_IFAND, cmdStr) ||
-							!_stricmp(STATEMENT_IFOR, cmdStr) ||
-							!_stricmp(STATEMENT_IFXOR, cmdStr));
-
-						const char* cmdStrIF = cmdStr;
-						cmdStr = subCmds.Get(++i) ? subCmds.Get(i)->Get() : ""; //++i ! => zap next command
-						int tgl = GetToggleCommandState2(kbdSec, SNM_NamedCommandLookup(cmdStr, kbdSec));
-						
+						const bool isON = op->type==IDX_STATEMENT_IF || op->type==IDX_STATEMENT_IFAND ||
+							op->type==IDX_STATEMENT_IFOR || op->type==IDX_STATEMENT_IFXOR;
+
+						int tgl = GetToggleCommandState2(kbdSec, GetCAOpCmdId(&ops[++i], kbdSec)); //++i ! => zap next command
 						if (twoConds)
 						{
-							cmdStr = subCmds.Get(++i) ? subCmds.Get(i)->Get() : ""; //++i ! => zap next command
-							int tgl2 = GetToggleCommandState2(kbdSec, SNM_NamedCommandLookup(cmdStr, kbdSec));
+							int tgl2 = GetToggleCommandState2(kbdSec, GetCAOpCmdId(&ops[++i], kbdSec)); //++i ! => zap next command
 
 							// tgl = overall toggle state value
-							if (!_stricmp(STATEMENT_IFAND, cmdStrIF) || !_stricmp(STATEMENT_IFNAND, cmdStrIF))
+							if (op->type==IDX_STATEMENT_IFAND || op->type==IDX_STATEMENT_IFNAND)
 								tgl = (tgl && tgl2) ? 1 : 0;
-							else if (!_stricmp(STATEMENT_IFOR, cmdStrIF) || !_stricmp(STATEMENT_IFNOR, cmdStrIF))
+							else if (op->type==IDX_STATEMENT_IFOR || op->type==IDX_STATEMENT_IFNOR)
 								tgl = (tgl || tgl2) ? 1 : 0;
-							else // if (!_stricmp(STATEMENT_IFXOR, cmdStrIF) || !_stricmp(STATEMENT_IFXNOR, cmdStrIF))
+							else // IFXOR, IFXNOR
 								tgl = (tgl ^ tgl2) ? 1 : 0;
 						}
 
 						if (tgl>=0)
 						{
+							// zap commands until next ELSE or ENDIF
 							if (isON ? tgl==0 : tgl==1)
-							{
-								// zap commands until next ELSE or ENDIF
-								while (++i<subCmds.GetSize())
-									if (subCmds.Get(i) && (!_stricmp(STATEMENT_ELSE, subCmds.Get(i)->Get()) || !_stricmp(STATEMENT_ENDIF, subCmds.Get(i)->Get())))
-										break;
-							}
+								i = ops[i].nextElse;
 						}
 						// zap commands until next ENDIF
 						else
-						{
-							while (++i<subCmds.GetSize())
-								if (subCmds.Get(i) && !_stricmp(STATEMENT_ENDIF, subCmds.Get(i)->Get()))
-									break;
-						}
+							i = ops[i].nextEndif;
 					}
-					continue; // zap 
-				}
-				else if (!_stricmp(STATEMENT_ELSE, cmdStr))
-				{
-					// zap commands until next ELSE or ENDIF
-					while (++i<subCmds.GetSize())
-						if (subCmds.Get(i) && !_stricmp(STATEMENT_ENDIF, subCmds.Get(i)->Get()))
-							break;
-					continue;
+					break;
 				}
-				else if (!_strnicmp(STATEMENT_LOOP, cmdStr, strlen(STATEMENT_LOOP)))
-				{
-					if (cmdStr[strlen(STATEMENT_LOOP)+1] == 'x' || cmdStr[strlen(STATEMENT_LOOP)+1] == 'X') {
+				case IDX_STATEMENT_ELSE:
+					// zap commands until next ENDIF
+					i = op->nextEndif;
+					break;
+				case IDX_STATEMENT_LOOP:
+					if (*op->str == 'x' || *op->str == 'X') {
 						loopCnt = PromptForInteger(undoStr, __LOCALIZE("Number of times to repeat","sws_DLG_161"), 0, 4096, false);
 						loopCnt++; // 0-based => 1-based + ignore the loop if user has cancelled
 					}
 					else
-						loopCnt = atoi((char*)cmdStr+strlen(STATEMENT_LOOP)+1); // +1 for the space char in "LOOP n"
-					continue;
-				}
-				else if (!_stricmp(STATEMENT_ENDLOOP, cmdStr))
-				{
+						loopCnt = op->param;
+					loopStart = bufs->cmds.GetSize();
+					break;
+				case IDX_STATEMENT_ENDLOOP:
 					if (loopCnt>=0)
 					{
-						for (int j=0; j<loopCnt; j++)
-							for (int k=0; k<loopCmds.GetSize(); k++)
-								if (loopCmds.Get(k))
-									allCmds.Add(loopCmds.Get(k));
-
-						loopCmds.Empty(false);
+						// the loop body is already there once
+						const int loopEnd = bufs->cmds.GetSize();
+						for (int j=1; j<loopCnt; j++)
+							for (int k=loopStart; k<loopEnd; k++) {
+								CAOp* cmd = bufs->cmds.Get()[k];
+								bufs->cmds.Add(cmd);
+							}
 						loopCnt = -1;
 					}
-					continue;
-				}
-				else if (!_stricmp(STATEMENT_ENDIF, cmdStr))
-					continue;
-
-				if (*cmdStr)
-				{
-					if (loopCnt > 0)
-						loopCmds.Add(subCmds.Get(i));
-					else if (loopCnt == -1)
-						allCmds.Add(subCmds.Get(i));
-				}
+					break;
+				case IDX_STATEMENT_ENDIF:
+					break;
+				default:
+					if (loopCnt == -1 || loopCnt > 0)
+						bufs->cmds.Add(op);
+					break;
 			}
+		}
+		if (loopCnt > 0) // no ENDLOOP: the loop body is not performed
+			bufs->cmds.Resize(loopStart, false);
 
-			if (allCmds.GetSize())
-			{
+		if (bufs->cmds.GetSize())
+		{
 #ifdef _SNM_DEBUG
-				OutputDebugString("RunCycleAction: ");
-				OutputDebugString(undoStr);
-				OutputDebugString(" ---------->");
-				OutputDebugString("\n");
+			OutputDebugString("RunCycleAction: ");
+			OutputDebugString(undoStr);
+			OutputDebugString(" ---------->");
+			OutputDebugString("\n");
 #endif
-				if (g_undos)
-					Undo_BeginBlock2(NULL);
+			if (g_undos)
+				Undo_BeginBlock2(NULL);
 
-				if (g_preventUIRefresh)
-					PreventUIRefresh(1);
+			if (g_preventUIRefresh)
+				PreventUIRefresh(1);
 
-				for (int i=0; i<allCmds.GetSize(); i++)
-					PerformSingleCommand(sec, allCmds.Get(i)->Get(), _val, _valhw, _relmode, _hwnd);
+			// stop if CAs get re-registered meanwhile (ops would point to deleted CAs)
+			const int planGen = g_caPlanGen;
+			for (int i=0; i<bufs->cmds.GetSize() && planGen==g_caPlanGen; i++)
+				PerformSingleOp(sec, kbdSec, bufs->cmds.Get()[i], _val, _valhw, _relmode, _hwnd);
 
-				if (g_preventUIRefresh)
-					PreventUIRefresh(-1);
+			if (g_preventUIRefresh)
+				PreventUIRefresh(-1);
 
-				if (g_undos)
-					Undo_EndBlock2(NULL, undoStr, UNDO_STATE_ALL);
+			if (g_undos)
+				Undo_EndBlock2(NULL, undoStr, UNDO_STATE_ALL);
 
-				RefreshToolbar(0); // not strictly needed, except for toggle states of CAs calling other CAs
+			RefreshToolbar(0); // not strictly needed, except for toggle states of CAs calling other CAs
 #ifdef _SNM_DEBUG
-				OutputDebugString("RunCycleAction <-------------------------");
-				OutputDebugString("\n");
+			OutputDebugString("RunCycleAction <-------------------------");
+			OutputDebugString("\n");
 #endif
+			break;
+		}
+		// (try to) switch to the next action step if nothing has been
+		// performed (avoids to run some CAs once before they sync properly)
+		// note: m_performState is already updated via StepCyclaction()
+		else //JFB!! if (action->IsToggle()==2)
+		{
+			// cycled back to the 1st step?
+			if (!action->m_performState)
 				break;
-			}
-			// (try to) switch to the next action step if nothing has been
-			// performed (avoids to run some CAs once before they sync properly)
-			// note: m_performState is already updated via ExplodeCyclaction()
-			else //JFB!! if (action->IsToggle()==2)
-			{
-				// cycled back to the 1st step?
-				if (!action->m_performState)
-					break;
-			}
-		} // if (ExplodeCyclaction())
+		}
 	} // for(;;)
+
+	s_caRunDepth--;
+}
+
+// same as ExplodeCyclaction(_flags=0x2) but with compiled plans:
+// 1st found/valid toggle state of the current step, -1 otherwise
+static int GetCyclactionToggleState(int _section, KbdSectionInfo* _kbdSec, Cyclaction* _action, int _depth)
+{
+	switch(_action->IsToggle())
+	{
+		case 1: return _action->m_fakeToggle ? 1 : 0; 
+		case 2: break; // real toggle state, see below..
+		default: return -1;
+	}
+
+	CAOp* ops;
+	CAStep step;
+	if (_depth > 32 || !_action->GetStepPlan(_section, _action->m_performState, &ops, &step))
+		return -1;
+
+	for (int i=0; i<step.nbOps; i++)
+	{
+		int tgl = -1;
+		if (ops[i].type == CA_OP_SUBCA)
+		{
+			if (Cyclaction* a = g_cas[_section].Get(ops[i].param-1))
+				tgl = GetCyclactionToggleState(_section, _kbdSec, a, _depth+1);
+		}
+		else if (ops[i].type == CA_OP_CMD && !ops[i].param) // macros, scripts, etc.. do not report toggle states
+		{
+			if (int cmdId = GetCAOpCmdId(&ops[i], _kbdSec))
+				tgl = GetToggleCommandState2(_kbdSec, cmdId);
+		}
+		if (tgl>=0)
+			return tgl;
+	}
+	return -1;
 }
 
 int IsCyclactionEnabled(COMMAND_T* _ct)
@@ -711,7 +823,8 @@ int IsCyclactionEnabled(COMMAND_T* _ct)
 		if (action->IsToggle()==2) // real state?
 		{
 			// no recursion check, etc.. : such faulty cycle actions are not registered
-			int tgl = ExplodeCyclaction(sec, _ct->id, NULL, NULL, NULL, 0x2, action);
+			KbdSectionInfo* kbdSec = SNM_GetActionSection(sec);
+			int tgl = kbdSec ? GetCyclactionToggleState(sec, kbdSec, action, 0) : -1;
 			if (tgl>=0)
 				return tgl;
 		}
@@ -1023,6 +1136,7 @@ int RegisterCyclation(const char* _name, int _section, int _cycleId, int _cmdId)
 	char custId[SNM_MAX_ACTION_CUSTID_LEN]="";
 	if (snprintfStrict(custId, sizeof(custId), "%s%d", GetCACustomId(_section), _cycleId) > 0)
 	{
+		g_caPlanGen++;
 		return SWSCreateRegisterDynamicCmd(
 			SNM_GetActionSectionUniqueId(_section),
 			_cmdId,
@@ -1080,6 +1194,7 @@ int RegisterCyclation(Cyclaction* _a, int _section, int _cycleId,
 
 void FlushCyclactions(int _section)
 {
+	g_caPlanGen++;
 	for (int i=0; i<g_cas[_section].GetSize(); i++)
 		if (Cyclaction* a = g_cas[_section].Get(i)) {
 			SWSFreeUnregisterDynamicCmd(a->m_cmdId);
@@ -1352,6 +1467,7 @@ void Cyclaction::ReplaceCmd(WDL_FastString* _cmd, bool _wantDelete, WDL_PtrList<
 
 void Cyclaction::UpdateNameAndCmds()
 {
+	m_planGen = 0;
 	m_cmds.EmptySafe(false); // to be deleted by callers (might be used in a list view)
 
 	char actionStr[CA_MAX_LEN] = "";
@@ -1368,6 +1484,7 @@ void Cyclaction::UpdateNameAndCmds()
 
 void Cyclaction::UpdateFromCmd()
 {
+	m_planGen = 0;
 	WDL_FastString newDef;
 	if (int tgl=IsToggle())
 		newDef.SetFormatted(CA_MAX_LEN, "%c", tgl==1?CA_TGL1:CA_TGL2);
@@ -1380,6 +1497,86 @@ void Cyclaction::UpdateFromCmd()
 	m_def.Set(&newDef);
 }
 
+// compiles m_cmds into ops, step by step: statements, sub-CAs and LOOP counts are
+// parsed once, jump targets of conditional statements are pre-computed, command ids
+// are resolved lazily (the commands might not be registered yet)
+void Cyclaction::CompilePlan(int _section)
+{
+	m_ops.Resize(0, false);
+	m_steps.Resize(0, false);
+
+	CAStep step = { 0, 0, 0, false };
+	for (int i=0; i<GetCmdSize(); i++)
+	{
+		const char* cmd = GetCmd(i);
+		const bool lastCmd = (i == (GetCmdSize()-1));
+		if (*cmd && *cmd != '!')
+		{
+			CAOp op = { CA_OP_CMD, 0, 0, 0, 0, cmd };
+			switch (int stmt = IsStatement(cmd))
+			{
+				case -1:
+					if (*cmd == '_')
+					{
+						int cycleId;
+						if (strstr(cmd, "_CYCLACTION") && _section == GetCASectionFromCustId(cmd) && GetCAFromCustomId(_section, cmd, &cycleId)) {
+							op.type = CA_OP_SUBCA;
+							op.param = cycleId;
+							step.hasSubCA = true;
+						}
+						else if (strstr(cmd, "_CYCLACTION") || strstr(cmd, "_SWSCONSOLE_CUST") || IsMacroOrScript(cmd, false))
+							op.param = 1; // no toggle state
+					}
+					break;
+				case IDX_STATEMENT_LOOP:
+				case IDX_STATEMENT_CONSOLE:
+				case IDX_STATEMENT_LABEL:
+					op.type = stmt;
+					op.str = strlen(cmd) > strlen(g_statements[stmt]) ? cmd+strlen(g_statements[stmt])+1 : ""; // +1 for the space char in "LOOP n", etc..
+					if (stmt == IDX_STATEMENT_LOOP)
+						op.param = atoi(op.str);
+					break;
+				default:
+					op.type = stmt;
+					break;
+			}
+			m_ops.Add(op);
+		}
+
+		// end of step: '!' or end of list
+		if (*cmd == '!' || lastCmd)
+		{
+			step.nbOps = m_ops.GetSize() - step.firstOp;
+			step.nextStep = lastCmd ? 0 : m_steps.GetSize()+1;
+			m_steps.Add(step);
+
+			step.firstOp = m_ops.GetSize();
+			step.hasSubCA = false;
+		}
+	}
+
+	for (int i=0; i<m_steps.GetSize(); i++)
+		UpdateCAJumps(m_ops.Get()+m_steps.Get()[i].firstOp, m_steps.Get()[i].nbOps);
+
+	m_planGen = g_caPlanGen;
+}
+
+// gets the compiled ops of a step, _step being a m_performState value
+// returns false if no such step
+bool Cyclaction::GetStepPlan(int _section, int _step, CAOp** _ops, CAStep* _stepInfo)
+{
+	if (m_planGen != g_caPlanGen)
+		CompilePlan(_section);
+
+	if (_step<0 || _step>=m_steps.GetSize())
+		return false;
+
+	const CAStep* step = m_steps.Get()+_step;
+	*_ops = m_ops.Get()+step->firstOp;
+	if (_stepInfo) *_stepInfo = *step;
+	return true;
+}
+
 int Cyclaction::GetIndent(WDL_FastString* _cmd)
 {
 	int indent=0;
@@ -46,13 +46,34 @@ static const char s_CA_SEP_STR[] =  { CA_SEP,  '\0' };
 static const char s_CA_TGL1_STR[] = { CA_TGL1, '\0' };
 static const char s_CA_TGL2_STR[] = { CA_TGL2, '\0' };
 
+#define CA_OP_CMD		-1 // action, macro, script, etc..
+#define CA_OP_SUBCA		-2 // cycle action of the same section
+
+// compiled command of a cycle action, see Cyclaction::GetStepPlan()
+struct CAOp
+{
+	int type;        // statement index (see SnM_Cyclactions.cpp), CA_OP_CMD or CA_OP_SUBCA
+	int cmdId;       // CA_OP_CMD: resolved command id (lazy, 0 if not registered yet)
+	int param;       // CA_OP_CMD: 1 if no toggle state (macro, script..), CA_OP_SUBCA: 1-based CA id, LOOP: count
+	int nextElse;    // index of the next ELSE or ENDIF after this op (or op count if none)
+	int nextEndif;   // index of the next ENDIF after this op (or op count if none)
+	const char* str; // custom id, console/label command or LOOP param (points into the CA commands)
+};
+
+struct CAStep
+{
+	int firstOp, nbOps;
+	int nextStep;    // m_performState once this step is performed
+	bool hasSubCA;
+};
+
 
 class Cyclaction
 {
 public:
 	// constructors assume their params are valid
-	Cyclaction(const char* _def=CA_EMPTY, bool _added=false) : m_def(_def), m_performState(0), m_fakeToggle(false), m_cmdId(0), m_added(_added) { UpdateNameAndCmds(); }
-	Cyclaction(Cyclaction* _a) : m_def(_a->m_def), m_performState(_a->m_performState), m_fakeToggle(_a->m_fakeToggle), m_cmdId(_a->m_cmdId), m_added(_a->m_added) { UpdateNameAndCmds(); }
+	Cyclaction(const char* _def=CA_EMPTY, bool _added=false) : m_def(_def), m_performState(0), m_fakeToggle(false), m_cmdId(0), m_added(_added), m_planGen(0) { UpdateNameAndCmds(); }
+	Cyclaction(Cyclaction* _a) : m_def(_a->m_def), m_performState(_a->m_performState), m_fakeToggle(_a->m_fakeToggle), m_cmdId(_a->m_cmdId), m_added(_a->m_added), m_planGen(0) { UpdateNameAndCmds(); }
 	~Cyclaction() {}
 	const char* GetDefinition() { return m_def.Get(); }
 	void Update(const char* _def) { m_def.Set(_def); UpdateNameAndCmds(); }
@@ -74,6 +95,7 @@ public:
 	WDL_FastString* GetCmdString(int _i) { return m_cmds.Get(_i); }
 	int FindCmd(WDL_FastString* _cmd) { return m_cmds.Find(_cmd); }
 	int GetIndent(WDL_FastString* _cmd);
+	bool GetStepPlan(int _section, int _step, CAOp** _ops, CAStep* _stepInfo = NULL);
 
 	int m_performState;
 	bool m_added; // CA added by the user, not yet registered
@@ -83,10 +105,16 @@ public:
 private:
 	void UpdateNameAndCmds();
 	void UpdateFromCmd();
+	void CompilePlan(int _section);
 
 	WDL_FastString m_def;
 	WDL_FastString m_name;
 	WDL_PtrList_DeleteOnDestroy<WDL_FastString> m_cmds;
+
+	// execution plan: m_cmds compiled once, recompiled when edited or when CAs are re-registered
+	int m_planGen; // 0 = to compile
+	WDL_TypedBuf<CAOp> m_ops;
+	WDL_TypedBuf<CAStep> m_steps;
 };
 
 
@@ -73,49 +73,192 @@ bool g_notFound=false;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool TakeNameMatch(MediaItem_Take* _tk, const char* _searchStr)
+///////////////////////////////////////////////////////////////////////////////
+// FindIndex: cached searchable text of tracks, items and takes
+// - the track list is rebuilt on track list changes (entries of remaining
+//   tracks are recycled), track names are also refreshed on title changes
+// - items are re-read lazily, per track, when the project state has changed
+//   since that track was indexed (undo points, undo/redo, etc..), when the
+//   number of items has changed or when an indexed item is gone (items can be
+//   deleted/added w/o undo point, e.g. by scripts)
+///////////////////////////////////////////////////////////////////////////////
+
+FindIndexItem::FindIndexItem(MediaItem* _item) : m_item(_item), m_activeTake(-1)
 {
-	char* takeName = _tk ? (char*)GetSetMediaItemTakeInfo(_tk, "P_NAME", NULL) : NULL;
-	return (takeName && stristr(takeName, _searchStr));
+	const char* notes = (const char*)GetSetMediaItemInfo(_item, "P_NOTES", NULL);
+	m_notes.Set(notes ? notes : "");
+
+	MediaItem_Take* activeTk = GetActiveTake(_item);
+	const int nbTakes = GetMediaItemNumTakes(_item);
+	for (int k=0; k < nbTakes; k++)
+	{
+		MediaItem_Take* tk = GetMediaItemTake(_item, k);
+		const char* name = tk ? (const char*)GetSetMediaItemTakeInfo(tk, "P_NAME", NULL) : NULL;
+		PCM_source* src = tk ? (PCM_source*)GetSetMediaItemTakeInfo(tk, "P_SOURCE", NULL) : NULL;
+		const char* fn = src ? src->GetFileName() : NULL;
+		m_takeNames.Add(new WDL_FastString(name ? name : ""));
+		m_takeFilenames.Add(new WDL_FastString(fn ? fn : ""));
+		if (tk && tk == activeTk)
+			m_activeTake = k;
+	}
 }
 
-bool TakeFilenameMatch(MediaItem_Take* _tk, const char* _searchStr)
+bool FindIndexItem::Match(int _type, const char* _searchStr) const
 {
-	bool match = false;
-	PCM_source* src = _tk ? (PCM_source*)GetSetMediaItemTakeInfo(_tk, "P_SOURCE", NULL) : NULL;
-	if (src) 
+	switch (_type)
 	{
-		const char* takeFilename = src->GetFileName();
-		match = (takeFilename && strstr(takeFilename, _searchStr)); // no stristr: osx + utf-8
+		case TYPE_ITEM_NOTES:
+			return (stristr(m_notes.Get(), _searchStr) != NULL);
+		case TYPE_ITEM_NAME:
+		case TYPE_ITEM_FILENAME:
+		case TYPE_ITEM_NAME_ALL_TAKES:
+		case TYPE_ITEM_FILENAME_ALL_TAKES:
+		{
+			const bool names = (_type == TYPE_ITEM_NAME || _type == TYPE_ITEM_NAME_ALL_TAKES);
+			const bool allTakes = (_type == TYPE_ITEM_NAME_ALL_TAKES || _type == TYPE_ITEM_FILENAME_ALL_TAKES);
+			const WDL_PtrList_DeleteOnDestroy<WDL_FastString>* strs = names ? &m_takeNames : &m_takeFilenames;
+			for (int k = (allTakes ? 0 : m_activeTake); k>=0 && k < strs->GetSize(); k++)
+			{
+				// no stristr for filenames: osx + utf-8
+				if (names ? stristr(strs->Get(k)->Get(), _searchStr) : strstr(strs->Get(k)->Get(), _searchStr))
+					return true;
+				if (!allTakes)
+					break;
+			}
+			break;
+		}
 	}
-	return match;
+	return false;
 }
 
-bool ItemNotesMatch(MediaItem* _item, const char* _searchStr)
+void FindIndexTrack::Update()
 {
-	bool match = false;
-	if (_item)
+	UpdateName();
+	m_items.Empty(true);
+	const int nbItems = GetTrackNumMediaItems(m_tr);
+	for (int j=0; j < nbItems; j++)
+		if (MediaItem* item = GetTrackMediaItem(m_tr, j))
+			m_items.Add(new FindIndexItem(item));
+}
+
+void FindIndexTrack::UpdateName()
+{
+	const char* name = (const char*)GetSetMediaTrackInfo(m_tr, "P_NAME", NULL);
+	m_name.Set(name ? name : "");
+}
+
+int FindIndexTrack::FindItem(MediaItem* _item) const
+{
+	for (int j=0; j < m_items.GetSize(); j++)
+		if (m_items.Get(j)->m_item == _item)
+			return j;
+	return -1;
+}
+
+bool FindIndexTrack::HasValidItems() const
+{
+	for (int j=0; j < m_items.GetSize(); j++)
+		if (!ValidatePtr2(NULL, m_items.Get(j)->m_item, "MediaItem*"))
+			return false;
+	return true;
+}
+
+bool FindIndexTrack::Match(int _type, const char* _searchStr) const
+{
+	switch (_type)
 	{
-		SNM_ChunkParserPatcher p(_item);
-		WDL_FastString notes;
-		if (p.GetSubChunk("NOTES", 2, 0, &notes, "VOLPAN") >= 0) // rmk: we use VOLPAN as it also exists for empty items
-			//JFB TODO? we compare a formated string with a normal one here, oh well..
-			match = (stristr(notes.Get(), _searchStr) != NULL);
+		case TYPE_TRACK_NAME:
+			return (stristr(m_name.Get(), _searchStr) != NULL);
+		case TYPE_TRACK_NOTES:
+		{
+			SNM_TrackNotes *notes = SNM_TrackNotes::find(m_tr);
+			return notes && stristr(notes->GetNotes(), _searchStr);
+		}
 	}
-	return match;
+	return false;
 }
 
-bool TrackNameMatch(MediaTrack* _tr, const char* _searchStr) {
-	char* name = _tr ? (char*)GetSetMediaTrackInfo(_tr, "P_NAME", NULL) : NULL;
-	return (name && stristr(name, _searchStr));
+// must be called before any lookup: detects project changes
+void FindIndex::Sync()
+{
+	const int stateCount = GetProjectStateChangeCount(NULL);
+	if (stateCount != m_stateCount)
+	{
+		m_stateCount = stateCount;
+		m_gen++;
+	}
+}
+
+// acknowledges our own project changes (selection changes, not indexed)
+void FindIndex::Ack() {
+	m_stateCount = GetProjectStateChangeCount(NULL);
 }
 
-bool TrackNotesMatch(MediaTrack* _tr, const char* _searchStr) 
+void FindIndex::SetTrackTitle(MediaTrack* _tr)
 {
-	SNM_TrackNotes *notes = SNM_TrackNotes::find(_tr);
-	return notes && stristr(notes->GetNotes(), _searchStr);
+	if (m_tracksOk)
+		if (FindIndexTrack* t = m_tracks.Get(CSurf_TrackToID(_tr, false)))
+			if (t->m_tr == _tr)
+				t->UpdateName();
 }
 
+void FindIndex::UpdateTracks()
+{
+	if (m_tracksOk)
+		return;
+
+	WDL_PtrKeyedArray<FindIndexTrack*> oldTracks;
+	for (int i=0; i < m_tracks.GetSize(); i++)
+		oldTracks.AddUnsorted((INT_PTR)m_tracks.Get(i)->m_tr, m_tracks.Get(i));
+	oldTracks.Resort();
+	m_tracks.Empty(false);
+
+	// 0 = master track, like CSurf_TrackFromID()
+	for (int i=0; i <= CountTracks(NULL); i++)
+	{
+		if (MediaTrack* tr = CSurf_TrackFromID(i, false))
+		{
+			FindIndexTrack* t = oldTracks.Get((INT_PTR)tr, NULL);
+			if (t)
+			{
+				oldTracks.Delete((INT_PTR)tr);
+				t->UpdateName();
+			}
+			else
+				t = new FindIndexTrack(tr);
+			m_tracks.Add(t);
+		}
+	}
+
+	// deleted tracks
+	INT_PTR key;
+	for (int i=0; i < oldTracks.GetSize(); i++)
+		delete oldTracks.Enumerate(i, &key);
+
+	m_tracksOk = true;
+}
+
+int FindIndex::GetNumTracks()
+{
+	UpdateTracks();
+	return m_tracks.GetSize();
+}
+
+FindIndexTrack* FindIndex::GetTrack(int _id)
+{
+	UpdateTracks();
+	FindIndexTrack* t = m_tracks.Get(_id);
+	if (t && (t->m_gen != m_gen || t->m_items.GetSize() != GetTrackNumMediaItems(t->m_tr) || !t->HasValidItems()))
+	{
+		t->Update();
+		t->m_gen = m_gen;
+	}
+	return t;
+}
+
+FindIndex g_findIdx;
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // FindWnd
 ///////////////////////////////////////////////////////////////////////////////
@@ -345,25 +488,15 @@ bool FindWnd::Find(int _mode)
 	switch(m_type)
 	{
 		case TYPE_ITEM_NAME:
-			update = FindMediaItem(_mode, false, TakeNameMatch);
-		break;
 		case TYPE_ITEM_NAME_ALL_TAKES:
-			update = FindMediaItem(_mode, true, TakeNameMatch);
-		break;
 		case TYPE_ITEM_FILENAME:
-			update = FindMediaItem(_mode, false, TakeFilenameMatch);
-		break;
 		case TYPE_ITEM_FILENAME_ALL_TAKES:
-			update = FindMediaItem(_mode, true, TakeFilenameMatch);
-		break;
 		case TYPE_ITEM_NOTES:
-			update = FindMediaItem(_mode, false, NULL, ItemNotesMatch);
+			update = FindMediaItem(_mode, m_type);
 		break;
 		case TYPE_TRACK_NAME:
-			update = FindTrack(_mode, TrackNameMatch);
-		break;
 		case TYPE_TRACK_NOTES:
-			update = FindTrack(_mode, TrackNotesMatch);
+			update = FindTrack(_mode, m_type);
 		break;
 		case TYPE_MARKER_REGION:
 			update = FindMarkerRegion(_mode);
@@ -371,66 +504,62 @@ bool FindWnd::Find(int _mode)
 	return update;
 }
 
-MediaItem* FindWnd::FindPrevNextItem(int _dir, MediaItem* _item)
+// gets the index position (track id, item idx) of the next/previous item of _item,
+// or of the first/last item of the project when _item is NULL
+bool FindWnd::FindPrevNextItem(int _dir, MediaItem* _item, int* _trId, int* _itemIdx)
 {
 	if (!_dir)
-		return NULL;
+		return false;
 
-	MediaItem* previous = NULL;
-	int startTrIdx = (_dir == -1 ? CountTracks(NULL) : 1);
+	const int nbTracks = g_findIdx.GetNumTracks()-1; // excl. master
+	int startTrId = (_dir == -1 ? nbTracks : 1), startItemIdx = -1;
 	if (_item)
-		if (MediaTrack* trItem = GetMediaItem_Track(_item))
-			startTrIdx = CSurf_TrackToID(trItem, false);
+	{
+		MediaTrack* trItem = GetMediaItem_Track(_item);
+		startTrId = trItem ? CSurf_TrackToID(trItem, false) : -1;
+		FindIndexTrack* t = g_findIdx.GetTrack(startTrId);
+		startItemIdx = t ? t->FindItem(_item) : -1;
+		if (startItemIdx < 0)
+			return false;
+		startItemIdx += _dir;
+	}
 
-	if (startTrIdx>=0)
+	for (int i = startTrId; i <= nbTracks && i >= 1; i+=_dir)
 	{
-		bool found = (_item == NULL);
-		for (int i = startTrIdx; !previous && i <= CountTracks(NULL) && i >= 1; i+=_dir)
+		FindIndexTrack* t = g_findIdx.GetTrack(i);
+		const int nbItems = t ? t->m_items.GetSize() : 0;
+		const int j = (_item && i == startTrId) ? startItemIdx : (_dir > 0 ? 0 : (nbItems-1));
+		if (j >= 0 && j < nbItems)
 		{
-			MediaTrack* tr = CSurf_TrackFromID(i, false); 
-			int nbItems = GetTrackNumMediaItems(tr);
-			for (int j = (_dir > 0 ? 0 : (nbItems-1)); j < nbItems && j >= 0; j+=_dir)
-			{
-				MediaItem* item = GetTrackMediaItem(tr,j);
-				if (found && item) {
-					previous = item;
-					break;
-				}
-				if (_item && item == _item)
-					found = true;
-			}
+			*_trId = i;
+			*_itemIdx = j;
+			return true;
 		}
 	}
-	return previous;
+	return false;
 }
 
-// param _allTakes only makes sense if jobTake() is used
-bool FindWnd::FindMediaItem(int _dir, bool _allTakes, bool (*jobTake)(MediaItem_Take*,const char*), bool (*jobItem)(MediaItem*,const char*))
+bool FindWnd::FindMediaItem(int _dir, int _type)
 {
 	bool update = false, found = false, sel = true;
 	if (*g_searchStr)
 	{
 		PreventUIRefresh(1);
+		g_findIdx.Sync();
 
-		MediaItem* startItem = NULL;
+		int startTrId = -1, startItemIdx = -1;
 		bool clearCurrentSelection = false;
 		if (_dir)
 		{
 			WDL_PtrList<MediaItem> items;
 			SNM_GetSelectedItems(NULL, &items);
 			if (items.GetSize())
-			{
-				startItem = FindPrevNextItem(_dir, items.Get(_dir > 0 ? 0 : items.GetSize()-1));
-				clearCurrentSelection = (startItem != NULL); 
-			}
+				clearCurrentSelection = FindPrevNextItem(_dir, items.Get(_dir > 0 ? 0 : items.GetSize()-1), &startTrId, &startItemIdx);
 			else
-				startItem = FindPrevNextItem(_dir, NULL);
+				FindPrevNextItem(_dir, NULL, &startTrId, &startItemIdx);
 		}
 		else
-		{
-			startItem = FindPrevNextItem(1, NULL);
-			clearCurrentSelection = (startItem != NULL); 
-		}
+			clearCurrentSelection = FindPrevNextItem(1, NULL, &startTrId, &startItemIdx);
 
 		if (clearCurrentSelection)
 		{
@@ -440,61 +569,29 @@ bool FindWnd::FindMediaItem(int _dir, bool _allTakes, bool (*jobTake)(MediaItem_
 		}
 
 		MediaItem* item = NULL;
-		MediaTrack* startTr = startItem ? GetMediaItem_Track(startItem) : NULL;
-		int startTrIdx = startTr ? CSurf_TrackToID(startTr, false) : -1;
-		if (startTr && startItem && startTrIdx>=0)
+		if (startTrId >= 1)
 		{
-			// find startItem idx
-			int startItemIdx=-1;
-			while (item != startItem) 
-				item = GetTrackMediaItem(startTr,++startItemIdx);
-
+			const int nbTracks = g_findIdx.GetNumTracks()-1;
 			bool firstItem=true, breakSelection=false;
-			for (int i=startTrIdx; !breakSelection && i <= CountTracks(NULL) && i>=1; i += (!_dir ? 1 : _dir))
+			for (int i=startTrId; !breakSelection && i <= nbTracks && i>=1; i += (!_dir ? 1 : _dir))
 			{
-				MediaTrack* tr = CSurf_TrackFromID(i, false); 
-				int nbItems = GetTrackNumMediaItems(tr);
+				FindIndexTrack* t = g_findIdx.GetTrack(i);
+				const int nbItems = t ? t->m_items.GetSize() : 0;
 				for (int j = (firstItem ? startItemIdx : (_dir >= 0 ? 0 : (nbItems-1))); 
-					 tr && !breakSelection && j < nbItems && j >= 0; 
+					 !breakSelection && j < nbItems && j >= 0; 
 					 j += (!_dir ? 1 : _dir))
 				{
-					item = GetTrackMediaItem(tr,j);
-					firstItem = false;
-
-					// search at item level 
-					if (jobItem)
-					{
-						if (jobItem(item, g_searchStr))
-						{
-							if (!update) Undo_BeginBlock2(NULL);
-							update = found = true;
-							GetSetMediaItemInfo(item, "B_UISEL", &sel);
-							if (_dir) breakSelection = true;
-						}
-					}
-					// search at take level 
-					else if (jobTake)
+					FindIndexItem* it = t->m_items.Get(j);
+					if (it->Match(_type, g_searchStr))
 					{
-						int nbTakes = GetMediaItemNumTakes(item);
-						for (int k=0; item && k < nbTakes; k++)
-						{
-							MediaItem_Take* tk = GetMediaItemTake(item, k);
-							if (tk && (_allTakes || tk == GetActiveTake(item)))
-							{
-								if (jobTake(tk, g_searchStr))
-								{
-									if (!update) Undo_BeginBlock2(NULL);
-									update = found = true;
-									GetSetMediaItemInfo(item, "B_UISEL", &sel);
-									if (_dir) {
-										breakSelection = true;
-										break;
-									}
-								}
-							}
-						}
+						if (!update) Undo_BeginBlock2(NULL);
+						update = found = true;
+						item = it->m_item;
+						GetSetMediaItemInfo(item, "B_UISEL", &sel);
+						if (_dir) breakSelection = true;
 					}
 				}
+				firstItem = false;
 			}
 		}
 		UpdateNotFoundMsg(found);
@@ -510,15 +607,19 @@ bool FindWnd::FindMediaItem(int _dir, bool _allTakes, bool (*jobTake)(MediaItem_
 	{
 		UpdateTimeline();
 		Undo_EndBlock2(NULL, __LOCALIZE("Find: change media item selection","sws_undo"), UNDO_STATE_ALL);
+		g_findIdx.Ack();
 	}
 	return update;
 }
 
-bool FindWnd::FindTrack(int _dir, bool (*job)(MediaTrack*,const char*))
+bool FindWnd::FindTrack(int _dir, int _type)
 {
 	bool update = false, found = false;
 	if (*g_searchStr)
 	{
+		g_findIdx.Sync();
+
+		const int nbTracks = g_findIdx.GetNumTracks()-1; // excl. master
 		int startTrIdx = -1;
 		bool clearCurrentSelection = false;
 		if (_dir)
@@ -528,7 +629,7 @@ bool FindWnd::FindTrack(int _dir, bool (*job)(MediaTrack*,const char*))
 				if (MediaTrack* startTr = SNM_GetSelectedTrack(NULL, _dir > 0 ? 0 : selTracksCount-1, true))
 				{
 					int id = CSurf_TrackToID(startTr, false);
-					if ((_dir > 0 && id < CountTracks(NULL)) || (_dir < 0 && id >0))
+					if ((_dir > 0 && id < nbTracks) || (_dir < 0 && id >0))
 					{
 						startTrIdx = id + _dir;
 						clearCurrentSelection = true;
@@ -536,7 +637,7 @@ bool FindWnd::FindTrack(int _dir, bool (*job)(MediaTrack*,const char*))
 				}
 			}
 			else
-				startTrIdx = (_dir > 0 ? 0 : CountTracks(NULL));
+				startTrIdx = (_dir > 0 ? 0 : nbTracks);
 		}
 		else
 		{
@@ -553,16 +654,16 @@ bool FindWnd::FindTrack(int _dir, bool (*job)(MediaTrack*,const char*))
 
 		if (startTrIdx >= 0)
 		{
-			for (int i = startTrIdx; i <= CountTracks(NULL) && i>=0; i += (!_dir ? 1 : _dir))
+			for (int i = startTrIdx; i <= nbTracks && i>=0; i += (!_dir ? 1 : _dir))
 			{
-				MediaTrack* tr = CSurf_TrackFromID(i, false); 
-				if (tr && job(tr, g_searchStr))
+				FindIndexTrack* t = g_findIdx.GetTrack(i);
+				if (t && t->Match(_type, g_searchStr))
 				{
 					if (!update)
 						Undo_BeginBlock2(NULL);
 
 					update = found = true;
-					GetSetMediaTrackInfo(tr, "I_SELECTED", &g_i1);
+					GetSetMediaTrackInfo(t->m_tr, "I_SELECTED", &g_i1);
 					if (_dir) 
 						break;
 				}
@@ -575,8 +676,10 @@ bool FindWnd::FindTrack(int _dir, bool (*job)(MediaTrack*,const char*))
 	}
 
 	if (update)
+	{
 		Undo_EndBlock2(NULL, __LOCALIZE("Find: change track selection","sws_undo"), UNDO_STATE_ALL);
-
+		g_findIdx.Ack();
+	}
 	return update;
 }
 
@@ -639,6 +742,14 @@ void FindExit() {
 	g_findWndMgr.Delete();
 }
 
+void FindSetTrackListChange() {
+	g_findIdx.SetTrackListChange();
+}
+
+void FindSetTrackTitle(MediaTrack* _tr) {
+	g_findIdx.SetTrackTitle(_tr);
+}
+
 void OpenFind(COMMAND_T*)
 {
 	if (FindWnd* w = g_findWndMgr.Create()) {
@@ -33,6 +33,47 @@
 #include "SnM_VWnd.h"
 
 
+class FindIndexItem {
+public:
+	FindIndexItem(MediaItem* _item);
+	bool Match(int _type, const char* _searchStr) const;
+	MediaItem* m_item;
+	WDL_FastString m_notes;
+	WDL_PtrList_DeleteOnDestroy<WDL_FastString> m_takeNames, m_takeFilenames;
+	int m_activeTake;
+};
+
+class FindIndexTrack {
+public:
+	FindIndexTrack(MediaTrack* _tr) : m_tr(_tr), m_gen(-1) { UpdateName(); }
+	void Update();
+	void UpdateName();
+	int FindItem(MediaItem* _item) const;
+	bool Match(int _type, const char* _searchStr) const;
+	bool HasValidItems() const;
+	MediaTrack* m_tr;
+	WDL_FastString m_name;
+	WDL_PtrList_DeleteOnDestroy<FindIndexItem> m_items;
+	int m_gen;
+};
+
+class FindIndex {
+public:
+	FindIndex() : m_tracksOk(false), m_stateCount(-1), m_gen(0) {}
+	void Sync();
+	void Ack();
+	void SetTrackListChange() { m_tracksOk = false; }
+	void SetTrackTitle(MediaTrack* _tr);
+	int GetNumTracks();
+	FindIndexTrack* GetTrack(int _id);
+private:
+	void UpdateTracks();
+	WDL_PtrList_DeleteOnDestroy<FindIndexTrack> m_tracks;
+	bool m_tracksOk;
+	int m_stateCount, m_gen;
+};
+
+
 class FindWnd : public SWS_DockWnd
 {
 public:
@@ -40,9 +81,9 @@ public:
 	void OnCommand(WPARAM wParam, LPARAM lParam);
 	void GetMinSize(int* _w, int* _h) { *_w=297; *_h=100; }
 	bool Find(int _mode);
-	MediaItem* FindPrevNextItem(int _dir, MediaItem* _item);
-	bool FindMediaItem(int _dir, bool _allTakes, bool (*jobTake)(MediaItem_Take*,const char*), bool (*jobItem)(MediaItem*,const char*) = NULL);
-	bool FindTrack(int _dir, bool (*job)(MediaTrack*,const char*));
+	bool FindPrevNextItem(int _dir, MediaItem* _item, int* _trId, int* _itemIdx);
+	bool FindMediaItem(int _dir, int _type);
+	bool FindTrack(int _dir, int _type);
 	bool FindMarkerRegion(int _dir);
 	void UpdateNotFoundMsg(bool _found);
 protected:
@@ -65,5 +106,7 @@ void FindExit();
 void OpenFind(COMMAND_T*);
 int IsFindDisplayed(COMMAND_T*);
 void FindNextPrev(COMMAND_T*);
+void FindSetTrackListChange();
+void FindSetTrackTitle(MediaTrack* _tr);
 
 #endif
@@ -30,6 +30,7 @@
 #include "SnM.h"
 #include "SnM_FullscreenSetlist.h"
 #include "SnM_RegionPlaylist.h"
+#include "SnM_ModernPlaylistUI.h" // g_playPlaylist, g_playCur, g_playNext
 #include "SnM_Dlg.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -221,7 +222,10 @@ void FullscreenTheme::CleanupFonts() {
 
 SetlistView::SetlistView(RECT bounds)
     : m_bounds(bounds)
+    , m_allDirty(true)
     , m_selectedIndex(0)
+    , m_playingIndex(-1)
+    , m_nextIndex(-1)
     , m_scrollOffset(0)
     , m_itemHeight(80)  // Default height for each item
 {
@@ -230,9 +234,35 @@ SetlistView::SetlistView(RECT bounds)
 SetlistView::~SetlistView() {
 }
 
+static bool SameSetlistItem(const SetlistView::SetlistItem& a, const SetlistView::SetlistItem& b) {
+    return a.number == b.number && a.duration == b.duration &&
+           a.isPlaying == b.isPlaying && a.isNext == b.isNext && a.isSelected == b.isSelected &&
+           a.regionIndex == b.regionIndex && !strcmp(a.name, b.name);
+}
+
 void SetlistView::SetItems(const WDL_TypedBuf<SetlistItem>& items) {
-    m_items = items;
+    const int count = items.GetSize();
+    if (count != m_items.GetSize()) {
+        m_items.Resize(count, false);
+        m_dirtyRows.Resize(count, false);
+        memset(m_dirtyRows.Get(), 0, count * sizeof(bool));
+        m_allDirty = true;
+    }
+
+    // Diff: only copy (and redraw) the items that changed
+    m_playingIndex = m_nextIndex = -1;
+    for (int i = 0; i < count; i++) {
+        const SetlistItem& item = items.Get()[i];
+        if (m_allDirty || !SameSetlistItem(m_items.Get()[i], item)) {
+            m_items.Get()[i] = item;
+            InvalidateItem(i);
+        }
+        if (item.isPlaying) m_playingIndex = i;
+        if (item.isNext) m_nextIndex = i;
+    }
+
     CalculateLayout();
+    SetScrollOffset(m_scrollOffset); // clamp to the new item count
 }
 
 const SetlistView::SetlistItem* SetlistView::GetItem(int index) const {
@@ -242,15 +272,52 @@ const SetlistView::SetlistItem* SetlistView::GetItem(int index) const {
     return &m_items.Get()[index];
 }
 
+void SetlistView::InvalidateItem(int index) {
+    if (index >= 0 && index < m_dirtyRows.GetSize()) {
+        m_dirtyRows.Get()[index] = true;
+    }
+}
+
+void SetlistView::SetItemFlag(int index, bool SetlistItem::*flag, bool value) {
+    if (index < 0 || index >= m_items.GetSize()) {
+        return;
+    }
+
+    SetlistItem& item = m_items.Get()[index];
+    if (item.*flag != value) {
+        item.*flag = value;
+        InvalidateItem(index);
+    }
+}
+
 void SetlistView::SetSelectedIndex(int index) {
     if (index < 0 || index >= m_items.GetSize()) {
         return;
     }
+
+    SetItemFlag(m_selectedIndex, &SetlistItem::isSelected, false);
     m_selectedIndex = index;
+    SetItemFlag(index, &SetlistItem::isSelected, true);
+}
+
+void SetlistView::SetPlayState(int playingIndex, int nextIndex) {
+    if (playingIndex != m_playingIndex) {
+        SetItemFlag(m_playingIndex, &SetlistItem::isPlaying, false);
+        SetItemFlag(playingIndex, &SetlistItem::isPlaying, true);
+        m_playingIndex = playingIndex;
+    }
+    if (nextIndex != m_nextIndex) {
+        SetItemFlag(m_nextIndex, &SetlistItem::isNext, false);
+        SetItemFlag(nextIndex, &SetlistItem::isNext, true);
+        m_nextIndex = nextIndex;
+    }
 }
 
 void SetlistView::SetBounds(RECT bounds) {
-    m_bounds = bounds;
+    if (memcmp(&bounds, &m_bounds, sizeof(RECT))) {
+        m_bounds = bounds;
+        m_allDirty = true;
+    }
     CalculateLayout();
 }
 
@@ -259,35 +326,34 @@ void SetlistView::CalculateLayout() {
     m_itemHeight = 80;
 }
 
-void SetlistView::ScrollToIndex(int index) {
-    if (index < 0 || index >= m_items.GetSize()) {
-        return;
-    }
-
-    // Calculate target scroll position to center the item
-    int viewHeight = m_bounds.bottom - m_bounds.top;
-    int targetScroll = (index * m_itemHeight) - (viewHeight / 2) + (m_itemHeight / 2);
-
+void SetlistView::SetScrollOffset(int offset) {
     // Clamp scroll position
+    int viewHeight = m_bounds.bottom - m_bounds.top;
     int maxScroll = (m_items.GetSize() * m_itemHeight) - viewHeight;
     if (maxScroll < 0) maxScroll = 0;
 
-    if (targetScroll < 0) targetScroll = 0;
-    if (targetScroll > maxScroll) targetScroll = maxScroll;
+    if (offset < 0) offset = 0;
+    if (offset > maxScroll) offset = maxScroll;
 
-    m_scrollOffset = targetScroll;
+    // Scrolling moves all rows
+    if (offset != m_scrollOffset) {
+        m_scrollOffset = offset;
+        m_allDirty = true;
+    }
 }
 
-void SetlistView::ScrollBy(int delta) {
-    m_scrollOffset += delta;
+void SetlistView::ScrollToIndex(int index) {
+    if (index < 0 || index >= m_items.GetSize()) {
+        return;
+    }
 
-    // Clamp scroll position
+    // Calculate target scroll position to center the item
     int viewHeight = m_bounds.bottom - m_bounds.top;
-    int maxScroll = (m_items.GetSize() * m_itemHeight) - viewHeight;
-    if (maxScroll < 0) maxScroll = 0;
+    SetScrollOffset((index * m_itemHeight) - (viewHeight / 2) + (m_itemHeight / 2));
+}
 
-    if (m_scrollOffset < 0) m_scrollOffset = 0;
-    if (m_scrollOffset > maxScroll) m_scrollOffset = maxScroll;
+void SetlistView::ScrollBy(int delta) {
+    SetScrollOffset(m_scrollOffset + delta);
 }
 
 void SetlistView::EnsureVisible(int index) {
@@ -301,18 +367,12 @@ void SetlistView::EnsureVisible(int index) {
 
     // Check if item is above visible area
     if (itemTop < m_scrollOffset) {
-        m_scrollOffset = itemTop;
+        SetScrollOffset(itemTop);
     }
     // Check if item is below visible area
     else if (itemBottom > m_scrollOffset + viewHeight) {
-        m_scrollOffset = itemBottom - viewHeight;
+        SetScrollOffset(itemBottom - viewHeight);
     }
-
-    // Clamp scroll position
-    int maxScroll = (m_items.GetSize() * m_itemHeight) - viewHeight;
-    if (maxScroll < 0) maxScroll = 0;
-    if (m_scrollOffset < 0) m_scrollOffset = 0;
-    if (m_scrollOffset > maxScroll) m_scrollOffset = maxScroll;
 }
 
 int SetlistView::GetItemAtPoint(int x, int y) const {
@@ -334,6 +394,43 @@ int SetlistView::GetItemAtPoint(int x, int y) const {
     return index;
 }
 
+// Item rectangle in window coordinates, clipped to the view
+// Returns false if the item is not visible
+bool SetlistView::GetItemRect(int index, RECT* r) const {
+    r->left = m_bounds.left;
+    r->top = m_bounds.top + (index * m_itemHeight) - m_scrollOffset;
+    r->right = m_bounds.right;
+    r->bottom = r->top + m_itemHeight;
+
+    if (r->top < m_bounds.top) r->top = m_bounds.top;
+    if (r->bottom > m_bounds.bottom) r->bottom = m_bounds.bottom;
+    return r->bottom > r->top;
+}
+
+bool SetlistView::GetDamage(RECT* r) const {
+    if (m_allDirty) {
+        *r = m_bounds;
+        return m_bounds.right > m_bounds.left && m_bounds.bottom > m_bounds.top;
+    }
+
+    bool damaged = false;
+    const int firstVisibleIndex = m_scrollOffset / m_itemHeight;
+    const int lastVisibleIndex = min((m_scrollOffset + m_bounds.bottom - m_bounds.top) / m_itemHeight + 1, m_dirtyRows.GetSize());
+    for (int i = firstVisibleIndex; i < lastVisibleIndex; i++) {
+        RECT itemRect;
+        if (m_dirtyRows.Get()[i] && GetItemRect(i, &itemRect)) {
+            if (!damaged) {
+                *r = itemRect;
+                damaged = true;
+            }
+            else {
+                UnionRect(r, r, &itemRect);
+            }
+        }
+    }
+    return damaged;
+}
+
 void SetlistView::Draw(LICE_IBitmap* bm, FullscreenTheme* theme) {
     if (!bm || !theme) {
         return;
@@ -341,6 +438,17 @@ void SetlistView::Draw(LICE_IBitmap* bm, FullscreenTheme* theme) {
 
     int viewHeight = m_bounds.bottom - m_bounds.top;
     int viewWidth = m_bounds.right - m_bounds.left;
+    if (viewHeight <= 0 || viewWidth <= 0) {
+        return;
+    }
+
+    // Rows are drawn clipped to the view, they used to overflow on the panels
+    LICE_SubBitmap view(bm, m_bounds.left, m_bounds.top, viewWidth, viewHeight);
+
+    if (m_allDirty) {
+        LICE_FillRect(&view, 0, 0, viewWidth, viewHeight,
+                      theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
+    }
 
     // Calculate visible item range
     int firstVisibleIndex = m_scrollOffset / m_itemHeight;
@@ -350,32 +458,38 @@ void SetlistView::Draw(LICE_IBitmap* bm, FullscreenTheme* theme) {
     if (firstVisibleIndex < 0) firstVisibleIndex = 0;
     if (lastVisibleIndex > m_items.GetSize()) lastVisibleIndex = m_items.GetSize();
 
-    // Draw visible items only
+    // Draw visible, damaged items only
+    bool drawn = m_allDirty;
     for (int i = firstVisibleIndex; i < lastVisibleIndex; i++) {
         const SetlistItem* item = GetItem(i);
-        if (!item) continue;
+        if (!item || (!m_allDirty && !m_dirtyRows.Get()[i])) continue;
 
-        // Calculate item rectangle
+        // Calculate item rectangle (view coordinates)
         RECT itemRect;
-        itemRect.left = m_bounds.left;
-        itemRect.top = m_bounds.top + (i * m_itemHeight) - m_scrollOffset;
-        itemRect.right = m_bounds.right;
+        itemRect.left = 0;
+        itemRect.top = (i * m_itemHeight) - m_scrollOffset;
+        itemRect.right = viewWidth;
         itemRect.bottom = itemRect.top + m_itemHeight;
 
-        // Skip if completely outside view
-        if (itemRect.bottom < m_bounds.top || itemRect.top > m_bounds.bottom) {
-            continue;
+        // Draw the item over a cleared row
+        if (!m_allDirty) {
+            LICE_FillRect(&view, itemRect.left, itemRect.top, viewWidth, m_itemHeight,
+                          theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
         }
-
-        // Draw the item
-        SetlistItemRenderer::DrawItem(bm, *item, itemRect, theme);
+        SetlistItemRenderer::DrawItem(&view, *item, itemRect, theme);
+        drawn = true;
     }
 
-    // Draw scrollbar if needed
+    // Draw scrollbar if needed (over the redrawn rows)
     int totalHeight = m_items.GetSize() * m_itemHeight;
-    if (totalHeight > viewHeight) {
+    if (drawn && totalHeight > viewHeight) {
         DrawScrollbar(bm, theme);
     }
+
+    m_allDirty = false;
+    if (m_dirtyRows.GetSize()) {
+        memset(m_dirtyRows.Get(), 0, m_dirtyRows.GetSize() * sizeof(bool));
+    }
 }
 
 void SetlistView::DrawScrollbar(LICE_IBitmap* bm, FullscreenTheme* theme) {
@@ -480,6 +594,7 @@ TransportPanel::TransportPanel(RECT bounds)
     , m_totalDuration(0.0)
     , m_hoveredButton(BTN_COUNT)
     , m_pressedButton(BTN_COUNT)
+    , m_damage(DAMAGE_ALL)
 {
     memset(m_buttonRects, 0, sizeof(m_buttonRects));
     CalculateLayout();
@@ -490,9 +605,71 @@ TransportPanel::~TransportPanel() {
 
 void TransportPanel::SetBounds(RECT bounds) {
     m_bounds = bounds;
+    m_damage = DAMAGE_ALL;
     CalculateLayout();
 }
 
+void TransportPanel::SetIsPlaying(bool isPlaying) {
+    if (isPlaying != m_isPlaying) {
+        m_isPlaying = isPlaying;
+        InvalidateButton(BTN_PLAY_STOP);
+    }
+}
+
+void TransportPanel::SetTotalDuration(double duration) {
+    // Displayed with a 1 second resolution
+    if ((int)duration != (int)m_totalDuration) {
+        m_damage |= DAMAGE_TOTAL_TIME;
+    }
+    m_totalDuration = duration;
+}
+
+void TransportPanel::SetHoveredButton(Button btn) {
+    if (btn != m_hoveredButton) {
+        InvalidateButton(m_hoveredButton);
+        InvalidateButton(btn);
+        m_hoveredButton = btn;
+    }
+}
+
+void TransportPanel::SetPressedButton(Button btn) {
+    if (btn != m_pressedButton) {
+        InvalidateButton(m_pressedButton);
+        InvalidateButton(btn);
+        m_pressedButton = btn;
+    }
+}
+
+RECT TransportPanel::GetTotalTimeRect() const {
+    RECT r = {m_bounds.right - 200, m_bounds.top + 20, m_bounds.right, m_bounds.top + 40};
+    return r;
+}
+
+bool TransportPanel::GetDamage(RECT* r) const {
+    if (!m_damage) {
+        return false;
+    }
+    if (m_damage == DAMAGE_ALL) {
+        *r = m_bounds;
+        return true;
+    }
+
+    bool damaged = false;
+    for (int i = 0; i <= BTN_COUNT; i++) {
+        if (m_damage & (1 << i)) {
+            RECT partRect = i < BTN_COUNT ? m_buttonRects[i] : GetTotalTimeRect();
+            if (damaged) {
+                UnionRect(r, r, &partRect);
+            }
+            else {
+                *r = partRect;
+                damaged = true;
+            }
+        }
+    }
+    return damaged;
+}
+
 void TransportPanel::CalculateLayout() {
     int panelWidth = m_bounds.right - m_bounds.left;
     int panelHeight = m_bounds.bottom - m_bounds.top;
@@ -528,22 +705,35 @@ TransportPanel::Button TransportPanel::GetButtonAtPoint(int x, int y) const {
 }
 
 void TransportPanel::Draw(LICE_IBitmap* bm, FullscreenTheme* theme) {
-    if (!bm || !theme) {
+    if (!bm || !theme || !m_damage) {
         return;
     }
 
     // Draw panel background
-    LICE_FillRect(bm, m_bounds.left, m_bounds.top,
-                  m_bounds.right - m_bounds.left, m_bounds.bottom - m_bounds.top,
-                  theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
+    if (m_damage == DAMAGE_ALL) {
+        LICE_FillRect(bm, m_bounds.left, m_bounds.top,
+                      m_bounds.right - m_bounds.left, m_bounds.bottom - m_bounds.top,
+                      theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
+    }
 
-    // Draw buttons
+    // Draw damaged buttons (opaque, no need to clear)
     for (int i = 0; i < BTN_COUNT; i++) {
-        DrawButton(bm, (Button)i, theme);
+        if (m_damage & (1 << i)) {
+            DrawButton(bm, (Button)i, theme);
+        }
     }
 
     // Draw total time
-    DrawTotalTime(bm, theme);
+    if (m_damage & DAMAGE_TOTAL_TIME) {
+        if (m_damage != DAMAGE_ALL) {
+            RECT r = GetTotalTimeRect();
+            LICE_FillRect(bm, r.left, r.top, r.right - r.left, r.bottom - r.top,
+                          theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
+        }
+        DrawTotalTime(bm, theme);
+    }
+
+    m_damage = 0;
 }
 
 void TransportPanel::DrawButton(LICE_IBitmap* bm, Button btn, FullscreenTheme* theme) {
@@ -650,6 +840,7 @@ void TransportPanel::DrawTotalTime(LICE_IBitmap* bm, FullscreenTheme* theme) {
 
 NowPlayingPanel::NowPlayingPanel(RECT bounds)
     : m_bounds(bounds)
+    , m_damage(DAMAGE_ALL)
 {
     memset(&m_info, 0, sizeof(NowPlayingInfo));
 }
@@ -658,28 +849,112 @@ NowPlayingPanel::~NowPlayingPanel() {
 }
 
 void NowPlayingPanel::SetInfo(const NowPlayingInfo& info) {
+    if (info.isPlaying != m_info.isPlaying) {
+        m_damage |= DAMAGE_ICON;
+    }
+    if (strcmp(info.songName, m_info.songName)) {
+        m_damage |= DAMAGE_NAME;
+    }
+    // Times are displayed with a 1 second resolution
+    if ((int)info.currentTime != (int)m_info.currentTime || (int)info.totalTime != (int)m_info.totalTime) {
+        m_damage |= DAMAGE_TIME;
+    }
+    if (GetProgressFillWidth(info.progress) != GetProgressFillWidth(m_info.progress)) {
+        m_damage |= DAMAGE_PROGRESS;
+    }
     m_info = info;
 }
 
 void NowPlayingPanel::SetBounds(RECT bounds) {
     m_bounds = bounds;
+    m_damage = DAMAGE_ALL;
+}
+
+// Progress bar dimensions
+static const int NOW_PLAYING_BAR_HEIGHT = 8;
+static const int NOW_PLAYING_BAR_PADDING = 20;
+
+int NowPlayingPanel::GetProgressFillWidth(double progress) const {
+    int barWidth = (m_bounds.right - m_bounds.left) - (NOW_PLAYING_BAR_PADDING * 2);
+    return (int)(barWidth * progress);
+}
+
+RECT NowPlayingPanel::GetPartRect(int part) const {
+    RECT r = m_bounds;
+    switch (part) {
+        case DAMAGE_ICON: // 48x48 icon at 20,20
+            r.left += 20; r.top += 20; r.right = r.left + 48; r.bottom = r.top + 48;
+            break;
+        case DAMAGE_NAME:
+            r.left += 88; r.top += 20; r.bottom = r.top + 50;
+            break;
+        case DAMAGE_TIME:
+            r.left += 88; r.top += 70; r.bottom = r.top + 30;
+            break;
+        case DAMAGE_PROGRESS: // bar + border
+            r.left += NOW_PLAYING_BAR_PADDING;
+            r.right -= NOW_PLAYING_BAR_PADDING - 1;
+            r.bottom -= NOW_PLAYING_BAR_PADDING - 1;
+            r.top = r.bottom - NOW_PLAYING_BAR_HEIGHT - 1;
+            break;
+    }
+    return r;
+}
+
+bool NowPlayingPanel::GetDamage(RECT* r) const {
+    if (!m_damage) {
+        return false;
+    }
+    if (m_damage == DAMAGE_ALL) {
+        *r = m_bounds;
+        return true;
+    }
+
+    bool damaged = false;
+    for (int part = DAMAGE_ICON; part < DAMAGE_ALL; part <<= 1) {
+        if (m_damage & part) {
+            RECT partRect = GetPartRect(part);
+            if (damaged) {
+                UnionRect(r, r, &partRect);
+            }
+            else {
+                *r = partRect;
+                damaged = true;
+            }
+        }
+    }
+    return damaged;
 }
 
 void NowPlayingPanel::Draw(LICE_IBitmap* bm, FullscreenTheme* theme) {
-    if (!bm || !theme) {
+    if (!bm || !theme || !m_damage) {
         return;
     }
 
-    // Draw panel background
-    LICE_FillRect(bm, m_bounds.left, m_bounds.top,
-                  m_bounds.right - m_bounds.left, m_bounds.bottom - m_bounds.top,
-                  theme->GetColors().background, 1.0f, LICE_BLIT_MODE_COPY);
+    // Clear the damaged parts (the whole panel on full redraws)
+    const int bgColor = theme->GetColors().background;
+    if (m_damage == DAMAGE_ALL) {
+        LICE_FillRect(bm, m_bounds.left, m_bounds.top,
+                      m_bounds.right - m_bounds.left, m_bounds.bottom - m_bounds.top,
+                      bgColor, 1.0f, LICE_BLIT_MODE_COPY);
+    }
+    else {
+        for (int part = DAMAGE_ICON; part < DAMAGE_ALL; part <<= 1) {
+            if (m_damage & part) {
+                RECT r = GetPartRect(part);
+                LICE_FillRect(bm, r.left, r.top, r.right - r.left, r.bottom - r.top,
+                              bgColor, 1.0f, LICE_BLIT_MODE_COPY);
+            }
+        }
+    }
 
-    // Draw components
-    DrawPlayIcon(bm, theme);
-    DrawSongName(bm, theme);
-    DrawTimeInfo(bm, theme);
-    DrawProgressBar(bm, theme);
+    // Draw damaged components
+    if (m_damage & DAMAGE_ICON) DrawPlayIcon(bm, theme);
+    if (m_damage & DAMAGE_NAME) DrawSongName(bm, theme);
+    if (m_damage & DAMAGE_TIME) DrawTimeInfo(bm, theme);
+    if (m_damage & DAMAGE_PROGRESS) DrawProgressBar(bm, theme);
+
+    m_damage = 0;
 }
 
 void NowPlayingPanel::DrawPlayIcon(LICE_IBitmap* bm, FullscreenTheme* theme) {
@@ -743,8 +1018,8 @@ void NowPlayingPanel::DrawTimeInfo(LICE_IBitmap* bm, FullscreenTheme* theme) {
 
 void NowPlayingPanel::DrawProgressBar(LICE_IBitmap* bm, FullscreenTheme* theme) {
     // Progress bar dimensions
-    const int barHeight = 8;
-    const int padding = 20;
+    const int barHeight = NOW_PLAYING_BAR_HEIGHT;
+    const int padding = NOW_PLAYING_BAR_PADDING;
     int barWidth = (m_bounds.right - m_bounds.left) - (padding * 2);
     int barX = m_bounds.left + padding;
     int barY = m_bounds.bottom - barHeight - padding;
@@ -950,6 +1225,10 @@ void SetlistItemRenderer::DrawDuration(
 // Window class name
 #define FULLSCREEN_SETLIST_WND_CLASS "SWS_FullscreenSetlistWindow"
 
+// Playback state polling (~60 fps), only damaged parts get repainted
+#define FULLSCREEN_SETLIST_TIMER_ID 1
+#define FULLSCREEN_SETLIST_TIMER_MS 16
+
 FullscreenSetlistWindow::FullscreenSetlistWindow()
     : m_hwnd(NULL)
     , m_nowPlayingPanel(NULL)
@@ -959,6 +1238,9 @@ FullscreenSetlistWindow::FullscreenSetlistWindow()
     , m_theme(NULL)
     , m_currentPlaylistIndex(-1)
     , m_selectedItemIndex(0)
+    , m_playingItemIndex(-1)
+    , m_playingPos(0.0)
+    , m_playingEnd(0.0)
     , m_isFullscreen(false)
     , m_savedWindowStyle(0)
 {
@@ -1080,6 +1362,12 @@ LRESULT CALLBACK FullscreenSetlistWindow::WndProc(HWND hwnd, UINT msg, WPARAM wP
             }
             return 0;
 
+        case WM_TIMER:
+            if (pThis && wParam == FULLSCREEN_SETLIST_TIMER_ID) {
+                pThis->OnTimer();
+            }
+            return 0;
+
         case WM_MOUSEMOVE:
             if (pThis) {
                 int x = GET_X_LPARAM(lParam);
@@ -1125,6 +1413,10 @@ LRESULT CALLBACK FullscreenSetlistWindow::WndProc(HWND hwnd, UINT msg, WPARAM wP
 ///////////////////////////////////////////////////////////////////////////////
 
 void FullscreenSetlistWindow::OnPaint() {
+    // Draw() below redraws all pending damage: make sure it is part of
+    // ps.rcPaint too (e.g. on expose, or damage set without invalidation)
+    InvalidateDamage();
+
     PAINTSTRUCT ps;
     HDC hdc = BeginPaint(m_hwnd, &ps);
 
@@ -1132,20 +1424,28 @@ void FullscreenSetlistWindow::OnPaint() {
         // Get client rect
         RECT clientRect;
         GetClientRect(m_hwnd, &clientRect);
+        int width = clientRect.right - clientRect.left;
+        int height = clientRect.bottom - clientRect.top;
+
+        // The back buffer is retained between paints: it is only reallocated
+        // (and fully redrawn) when the client size changes
+        if (m_backBuffer.getWidth() != width || m_backBuffer.getHeight() != height) {
+            m_backBuffer.resize(width, height);
+            LICE_Clear(&m_backBuffer, m_theme->GetColors().background);
+            if (m_nowPlayingPanel) m_nowPlayingPanel->Invalidate();
+            if (m_setlistView) m_setlistView->Invalidate();
+            if (m_transportPanel) m_transportPanel->Invalidate();
+        }
 
-        // Create a bitmap for double buffering
-        LICE_SysBitmap bm(clientRect.right - clientRect.left, clientRect.bottom - clientRect.top);
-
-        // Clear background with theme color
-        LICE_Clear(&bm, m_theme->GetColors().background);
-
-        // Draw panels
-        if (m_nowPlayingPanel) m_nowPlayingPanel->Draw(&bm, m_theme);
-        if (m_setlistView) m_setlistView->Draw(&bm, m_theme);
-        if (m_transportPanel) m_transportPanel->Draw(&bm, m_theme);
+        // Draw panels (each one only redraws its damaged parts)
+        if (m_nowPlayingPanel) m_nowPlayingPanel->Draw(&m_backBuffer, m_theme);
+        if (m_setlistView) m_setlistView->Draw(&m_backBuffer, m_theme);
+        if (m_transportPanel) m_transportPanel->Draw(&m_backBuffer, m_theme);
 
-        // Blit to screen
-        LICE_Blit(&bm, hdc, 0, 0, NULL, 1.0f, LICE_BLIT_MODE_COPY);
+        // Blit the invalidated area only
+        BitBlt(hdc, ps.rcPaint.left, ps.rcPaint.top,
+               ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+               m_backBuffer.getDC(), ps.rcPaint.left, ps.rcPaint.top, SRCCOPY);
     }
 
     EndPaint(m_hwnd, &ps);
@@ -1198,8 +1498,8 @@ void FullscreenSetlistWindow::OnKeyDown(WPARAM key) {
             break;
     }
 
-    // Trigger repaint for visual feedback
-    InvalidateRect(m_hwnd, NULL, FALSE);
+    // Repaint what changed for visual feedback
+    InvalidateDamage();
 }
 
 void FullscreenSetlistWindow::OnMouseMove(int x, int y) {
@@ -1241,6 +1541,11 @@ void FullscreenSetlistWindow::OnResize(int width, int height) {
     InvalidateRect(m_hwnd, NULL, FALSE);
 }
 
+void FullscreenSetlistWindow::OnTimer() {
+    UpdatePlayState();
+    InvalidateDamage();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Window management methods
 ///////////////////////////////////////////////////////////////////////////////
@@ -1265,6 +1570,9 @@ void FullscreenSetlistWindow::Show() {
     // Refresh data from SWS
     RefreshFromSWS();
 
+    // Poll playback state while visible
+    SetTimer(m_hwnd, FULLSCREEN_SETLIST_TIMER_ID, FULLSCREEN_SETLIST_TIMER_MS, NULL);
+
     // Trigger initial paint
     InvalidateRect(m_hwnd, NULL, FALSE);
 }
@@ -1279,6 +1587,8 @@ void FullscreenSetlistWindow::Hide() {
         ToggleFullscreen();
     }
 
+    KillTimer(m_hwnd, FULLSCREEN_SETLIST_TIMER_ID);
+
     // Hide the window
     ShowWindow(m_hwnd, SW_HIDE);
 }
@@ -1415,8 +1725,10 @@ void FullscreenSetlistWindow::RefreshFromSWS() {
     }
 
     // Convert playlist items to SetlistView items
+    // (the view diffs them against its current items and only damages changed rows)
     WDL_TypedBuf<SetlistView::SetlistItem> items;
-    items.Resize(playlist->GetSize());
+    items.Resize(playlist->GetSize(), false);
+    memset(items.Get(), 0, items.GetSize() * sizeof(SetlistView::SetlistItem));
 
     for (int i = 0; i < playlist->GetSize(); i++) {
         RgnPlaylistItem* plItem = playlist->Get(i);
@@ -1427,16 +1739,21 @@ void FullscreenSetlistWindow::RefreshFromSWS() {
         SetlistView::SetlistItem& item = items.Get()[i];
         item.number = i + 1;
         item.regionIndex = plItem->m_rgnId;
-        item.isPlaying = false;  // TODO: Determine from playback state
-        item.isNext = (i == m_selectedItemIndex + 1);
         item.isSelected = (i == m_selectedItemIndex);
 
+        // Keep the current play flags so that unchanged rows are not damaged,
+        // UpdatePlayState() below fixes them up if needed
+        if (const SetlistView::SetlistItem* oldItem = m_setlistView ? m_setlistView->GetItem(i) : NULL) {
+            item.isPlaying = oldItem->isPlaying;
+            item.isNext = oldItem->isNext;
+        }
+
         // Get region info
-        char name[256] = "";
+        const char* name = NULL;
         double pos = 0.0, end = 0.0;
-        int rgnIdx = EnumMarkerRegionById(NULL, plItem->m_rgnId, NULL, &pos, &end, name, NULL, NULL);
+        int rgnIdx = EnumMarkerRegionById(NULL, plItem->m_rgnId, NULL, &pos, &end, &name, NULL, NULL);
         if (rgnIdx >= 0) {
-            snprintf(item.name, sizeof(item.name), "%s", name);
+            snprintf(item.name, sizeof(item.name), "%s", name ? name : "");
             item.duration = end - pos;
         }
         else {
@@ -1457,7 +1774,70 @@ void FullscreenSetlistWindow::RefreshFromSWS() {
         m_transportPanel->SetTotalDuration(totalDuration);
     }
 
-    // TODO: Update now playing panel with current song info
+    // Structural reload: re-resolve the playing region
+    m_playingItemIndex = -1;
+    UpdatePlayState();
+    InvalidateDamage();
+}
+
+// Called on every timer tick: O(1) apart from a region lookup when the
+// playing item changes, the panels only damage what actually changed
+void FullscreenSetlistWindow::UpdatePlayState() {
+    RegionPlaylist* playlist = GetPlaylist(m_currentPlaylistIndex);
+    if (!playlist) {
+        return;
+    }
+
+    bool isPlaying = (GetPlayState() & 1) != 0;
+    bool playlistPlaying = g_playPlaylist >= 0 && GetPlaylist(g_playPlaylist) == playlist;
+
+    int playingIndex = playlistPlaying ? g_playCur : -1;
+    int nextIndex = playlistPlaying ? g_playNext : m_selectedItemIndex + 1;
+
+    if (m_setlistView) {
+        m_setlistView->SetPlayState(playingIndex, nextIndex);
+    }
+    if (m_transportPanel) {
+        m_transportPanel->SetIsPlaying(isPlaying);
+    }
+
+    NowPlayingPanel::NowPlayingInfo info;
+    memset(&info, 0, sizeof(info));
+
+    if (playingIndex != m_playingItemIndex) {
+        m_playingItemIndex = playingIndex;
+        m_playingPos = m_playingEnd = 0.0;
+
+        RgnPlaylistItem* plItem = playlist->Get(playingIndex);
+        if (plItem && plItem->IsValidIem()) {
+            EnumMarkerRegionById(NULL, plItem->m_rgnId, NULL, &m_playingPos, &m_playingEnd, NULL, NULL, NULL);
+        }
+    }
+
+    if (m_playingItemIndex >= 0 && m_setlistView) {
+        if (const SetlistView::SetlistItem* item = m_setlistView->GetItem(m_playingItemIndex)) {
+            lstrcpyn(info.songName, item->name, sizeof(info.songName));
+        }
+        info.totalTime = m_playingEnd - m_playingPos;
+        info.currentTime = max(0.0, min(info.totalTime, GetPlayPosition2() - m_playingPos));
+        info.progress = info.totalTime > 0.0 ? info.currentTime / info.totalTime : 0.0;
+        info.isPlaying = isPlaying;
+    }
+
+    if (m_nowPlayingPanel) {
+        m_nowPlayingPanel->SetInfo(info);
+    }
+}
+
+void FullscreenSetlistWindow::InvalidateDamage() {
+    if (!m_hwnd) {
+        return;
+    }
+
+    RECT r;
+    if (m_nowPlayingPanel && m_nowPlayingPanel->GetDamage(&r)) InvalidateRect(m_hwnd, &r, FALSE);
+    if (m_setlistView && m_setlistView->GetDamage(&r)) InvalidateRect(m_hwnd, &r, FALSE);
+    if (m_transportPanel && m_transportPanel->GetDamage(&r)) InvalidateRect(m_hwnd, &r, FALSE);
 }
 
 void FullscreenSetlistWindow::PlaySelected() {
@@ -1527,8 +1907,8 @@ void FullscreenSetlistWindow::SelectNext() {
     m_setlistView->SetSelectedIndex(m_selectedItemIndex);
     m_setlistView->EnsureVisible(m_selectedItemIndex);
 
-    // Update item states
-    RefreshFromSWS();
+    // Update item states (only the affected rows get damaged)
+    UpdatePlayState();
 }
 
 void FullscreenSetlistWindow::SelectPrevious() {
@@ -1544,8 +1924,8 @@ void FullscreenSetlistWindow::SelectPrevious() {
     m_setlistView->SetSelectedIndex(m_selectedItemIndex);
     m_setlistView->EnsureVisible(m_selectedItemIndex);
 
-    // Update item states
-    RefreshFromSWS();
+    // Update item states (only the affected rows get damaged)
+    UpdatePlayState();
 }
 
 void FullscreenSetlistWindow::SelectItem(int index) {
@@ -1562,8 +1942,8 @@ void FullscreenSetlistWindow::SelectItem(int index) {
     m_setlistView->SetSelectedIndex(m_selectedItemIndex);
     m_setlistView->EnsureVisible(m_selectedItemIndex);
 
-    // Update item states
-    RefreshFromSWS();
+    // Update item states (only the affected rows get damaged)
+    UpdatePlayState();
 }
 
 void FullscreenSetlistWindow::ScrollToItem(int index) {
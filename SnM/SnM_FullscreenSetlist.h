@@ -120,13 +120,16 @@ public:
     ~SetlistView();
 
     // Data management
+    // Items are updated in place, only the rows that differ are redrawn
     void SetItems(const WDL_TypedBuf<SetlistItem>& items);
     int GetItemCount() const { return m_items.GetSize(); }
     const SetlistItem* GetItem(int index) const;
 
-    // Selection
+    // Selection and playback state (-1: none), updates the flags of the
+    // previous and new rows only
     void SetSelectedIndex(int index);
     int GetSelectedIndex() const { return m_selectedIndex; }
+    void SetPlayState(int playingIndex, int nextIndex);
 
     // Scrolling
     void ScrollToIndex(int index);
@@ -141,17 +144,29 @@ public:
     void SetBounds(RECT bounds);
     RECT GetBounds() const { return m_bounds; }
 
-    // Rendering
+    // Damage tracking
+    void Invalidate() { m_allDirty = true; }
+    bool GetDamage(RECT* r) const;
+
+    // Rendering: redraws the damaged visible rows only (retained bitmap)
     void Draw(LICE_IBitmap* bm, FullscreenTheme* theme);
 
 private:
     RECT m_bounds;
     WDL_TypedBuf<SetlistItem> m_items;
+    WDL_TypedBuf<bool> m_dirtyRows; // same size as m_items
+    bool m_allDirty;
     int m_selectedIndex;
+    int m_playingIndex;
+    int m_nextIndex;
     int m_scrollOffset;          // Scroll position in pixels
     int m_itemHeight;            // Height of each item in pixels
 
     void CalculateLayout();
+    void SetScrollOffset(int offset);
+    void SetItemFlag(int index, bool SetlistItem::*flag, bool value);
+    void InvalidateItem(int index);
+    bool GetItemRect(int index, RECT* r) const;
     void DrawScrollbar(LICE_IBitmap* bm, FullscreenTheme* theme);
 };
 
@@ -215,27 +230,40 @@ public:
     void SetBounds(RECT bounds);
     RECT GetBounds() const { return m_bounds; }
 
-    // State
-    void SetIsPlaying(bool isPlaying) { m_isPlaying = isPlaying; }
-    void SetTotalDuration(double duration) { m_totalDuration = duration; }
-    void SetHoveredButton(Button btn) { m_hoveredButton = btn; }
-    void SetPressedButton(Button btn) { m_pressedButton = btn; }
+    // State (damages the affected button/time area only on changes)
+    void SetIsPlaying(bool isPlaying);
+    void SetTotalDuration(double duration);
+    void SetHoveredButton(Button btn);
+    void SetPressedButton(Button btn);
 
     // Hit testing
     Button GetButtonAtPoint(int x, int y) const;
 
-    // Rendering
+    // Damage tracking
+    void Invalidate() { m_damage = DAMAGE_ALL; }
+    bool GetDamage(RECT* r) const;
+
+    // Rendering: redraws the damaged parts only (retained bitmap)
     void Draw(LICE_IBitmap* bm, FullscreenTheme* theme);
 
 private:
+    // Damage flags: one bit per button, then the total time
+    enum {
+        DAMAGE_TOTAL_TIME = 1 << BTN_COUNT,
+        DAMAGE_ALL = (DAMAGE_TOTAL_TIME << 1) - 1
+    };
+
     RECT m_bounds;
     bool m_isPlaying;
     double m_totalDuration;
     Button m_hoveredButton;
     Button m_pressedButton;
     RECT m_buttonRects[BTN_COUNT];
+    int m_damage;
 
     void CalculateLayout();
+    void InvalidateButton(Button btn) { if (btn >= 0 && btn < BTN_COUNT) m_damage |= 1 << btn; }
+    RECT GetTotalTimeRect() const;
     void DrawButton(LICE_IBitmap* bm, Button btn, FullscreenTheme* theme);
     void DrawTotalTime(LICE_IBitmap* bm, FullscreenTheme* theme);
 };
@@ -259,6 +287,8 @@ public:
     ~NowPlayingPanel();
 
     // Data management
+    // Damages only the parts whose display changes (e.g. the progress bar
+    // when its filled width changes, the time when the displayed seconds change)
     void SetInfo(const NowPlayingInfo& info);
     const NowPlayingInfo& GetInfo() const { return m_info; }
 
@@ -266,12 +296,28 @@ public:
     void SetBounds(RECT bounds);
     RECT GetBounds() const { return m_bounds; }
 
-    // Rendering
+    // Damage tracking
+    void Invalidate() { m_damage = DAMAGE_ALL; }
+    bool GetDamage(RECT* r) const;
+
+    // Rendering: redraws the damaged parts only (retained bitmap)
     void Draw(LICE_IBitmap* bm, FullscreenTheme* theme);
 
 private:
+    enum {
+        DAMAGE_ICON = 1,
+        DAMAGE_NAME = 2,
+        DAMAGE_TIME = 4,
+        DAMAGE_PROGRESS = 8,
+        DAMAGE_ALL = 15
+    };
+
     RECT m_bounds;
     NowPlayingInfo m_info;
+    int m_damage;
+
+    RECT GetPartRect(int part) const;
+    int GetProgressFillWidth(double progress) const;
 
     void DrawPlayIcon(LICE_IBitmap* bm, FullscreenTheme* theme);
     void DrawSongName(LICE_IBitmap* bm, FullscreenTheme* theme);
@@ -345,7 +391,11 @@ private:
 
     int m_currentPlaylistIndex;
     int m_selectedItemIndex;
+    int m_playingItemIndex;   // -1 if this playlist is not playing
+    double m_playingPos;      // Playing region bounds, cached on item changes
+    double m_playingEnd;
     bool m_isFullscreen;
+    LICE_SysBitmap m_backBuffer;  // Retained frame, only damaged parts are redrawn
     RECT m_savedWindowRect;  // For restoring from fullscreen
     LONG m_savedWindowStyle;  // For restoring from fullscreen
 
@@ -358,10 +408,15 @@ private:
     void OnMouseMove(int x, int y);
     void OnMouseClick(int x, int y);
     void OnResize(int width, int height);
+    void OnTimer();
 
     // Layout
     void UpdateLayout();
 
+    // Playback state and damage
+    void UpdatePlayState();
+    void InvalidateDamage();
+
     // Helper methods
     bool CreateMainWindow();
     void DestroyMainWindow();
@@ -0,0 +1,672 @@
+/******************************************************************************
+/ SnM_MediaMeta.cpp
+/
+/ Copyright (c) 2026 and later SWS Extension Authors
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/ 
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/ 
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+#include "stdafx.h"
+
+#include "SnM.h"
+#include "SnM_MediaMeta.h"
+
+#include <atomic>
+#include <thread>
+
+#include <taglib/tag.h>
+#include <taglib/fileref.h>
+
+#define SNM_MEDIAMETA_MAX_CACHED	10000
+#define SNM_MEDIAMETA_EVICTED_PCT	10 // least recently used entries evicted at once when the cache is full
+#define SNM_MEDIAMETA_MAX_BLOCK		(1024*1024) // bigger chunks/frames are skipped (cover art, etc..)
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Cache
+///////////////////////////////////////////////////////////////////////////////
+
+static void freeTagVal(char* _p) { free(_p); }
+
+class MediaFileMeta
+{
+public:
+	MediaFileMeta(time_t _mtime, WDL_INT64 _size)
+		: m_mtime(_mtime), m_size(_size), m_bitrate(-1), m_needTagLib(false), m_lastUse(0), m_tags(false, freeTagVal) {}
+
+	// first non-empty value wins unless _overwrite is true
+	void SetTag(const char* _tag, const char* _val, int _len = -1, bool _overwrite = false)
+	{
+		if (!_val) return;
+		if (_len < 0) _len = (int)strlen(_val);
+		while (_len>0 && (_val[_len-1]==' ' || !_val[_len-1] || _val[_len-1]=='\r' || _val[_len-1]=='\n')) _len--;
+		if (_len<=0 || (!_overwrite && m_tags.Get(_tag))) return;
+		if (char* v = (char*)malloc(_len+1))
+		{
+			memcpy(v, _val, _len);
+			v[_len] = '\0';
+			m_tags.Insert(_tag, v);
+		}
+	}
+
+	// year and track are stored as numbers, like TagLib does
+	void SetNumTag(const char* _tag, const char* _val, int _len = -1)
+	{
+		char buf[32]="";
+		if (_val && _len) lstrcpyn(buf, _val, _len<0 || _len>=(int)sizeof(buf) ? (int)sizeof(buf) : _len+1);
+		int n = atoi(buf);
+		if (n>0) {
+			snprintf(buf, sizeof(buf), "%d", n);
+			SetTag(_tag, buf);
+		}
+	}
+
+	time_t m_mtime;
+	WDL_INT64 m_size;
+	int m_bitrate; // kb/s, -1: not read yet
+	bool m_needTagLib; // unknown format or something the header parser can't decode
+	WDL_UINT64 m_lastUse; // g_mediaMetaUseClock value when last cached/read
+	WDL_StringKeyedArray<char*> m_tags; // case insensitive tag name -> value (utf-8)
+};
+
+static void freeMediaFileMeta(MediaFileMeta* _m) { delete _m; }
+
+// file full path -> metadata, shared by all threads
+WDL_StringKeyedArray<MediaFileMeta*> g_mediaMetaCache(true, freeMediaFileMeta);
+WDL_UINT64 g_mediaMetaUseClock = 0;
+SWS_Mutex g_mediaMetaMutex;
+
+static bool GetFileStat(const char* _fn, time_t* _mtime, WDL_INT64* _size)
+{
+	struct stat s;
+#ifdef _WIN32
+	if (statUTF8(_fn, &s) != 0)
+#else
+	if (stat(_fn, &s) != 0)
+#endif
+		return false;
+	*_mtime = s.st_mtime;
+	*_size = (WDL_INT64)s.st_size;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Header parsers
+///////////////////////////////////////////////////////////////////////////////
+
+static unsigned int LE32(const unsigned char* _p) {
+	return _p[0] | (_p[1]<<8) | (_p[2]<<16) | ((unsigned int)_p[3]<<24);
+}
+
+static unsigned int BE32(const unsigned char* _p) {
+	return ((unsigned int)_p[0]<<24) | (_p[1]<<16) | (_p[2]<<8) | _p[3];
+}
+
+static unsigned int SynchSafe32(const unsigned char* _p) {
+	return ((_p[0]&0x7F)<<21) | ((_p[1]&0x7F)<<14) | ((_p[2]&0x7F)<<7) | (_p[3]&0x7F);
+}
+
+// reads _len bytes at _pos, false if truncated or too big
+static bool ReadBlock(WDL_FileRead* _f, WDL_INT64 _pos, WDL_INT64 _len, WDL_TypedBuf<unsigned char>* _buf)
+{
+	if (_len<0 || _len>SNM_MEDIAMETA_MAX_BLOCK || _pos+_len>_f->GetSize() || !_buf->Resize((int)_len, false))
+		return false;
+	_f->SetPosition(_pos);
+	return _f->Read(_buf->Get(), (int)_len) == (int)_len;
+}
+
+static void AppendUTF8(WDL_FastString* _str, unsigned int _c)
+{
+	char u[4];
+	if (_c<0x80) { u[0]=(char)_c; _str->Append(u, 1); }
+	else if (_c<0x800) { u[0]=(char)(0xC0|(_c>>6)); u[1]=(char)(0x80|(_c&0x3F)); _str->Append(u, 2); }
+	else if (_c<0x10000) { u[0]=(char)(0xE0|(_c>>12)); u[1]=(char)(0x80|((_c>>6)&0x3F)); u[2]=(char)(0x80|(_c&0x3F)); _str->Append(u, 3); }
+	else { u[0]=(char)(0xF0|(_c>>18)); u[1]=(char)(0x80|((_c>>12)&0x3F)); u[2]=(char)(0x80|((_c>>6)&0x3F)); u[3]=(char)(0x80|(_c&0x3F)); _str->Append(u, 4); }
+}
+
+static bool IsUTF8(const unsigned char* _p, int _len)
+{
+	for (int i=0; i<_len; i++)
+	{
+		int n;
+		if (_p[i]<0x80) n=0;
+		else if (_p[i]>=0xC2 && _p[i]<=0xDF) n=1;
+		else if (_p[i]>=0xE0 && _p[i]<=0xEF) n=2;
+		else if (_p[i]>=0xF0 && _p[i]<=0xF4) n=3;
+		else return false;
+		if (i+n >= _len) return false;
+		for (; n>0; n--)
+			if ((_p[++i]&0xC0) != 0x80) return false;
+	}
+	return true;
+}
+
+// RIFF text (INFO, bext) has no defined charset: utf-8 if valid (REAPER, most
+// recent tools), latin-1 otherwise (older Windows tools)
+static void DecodeRIFFString(const char* _p, int _len, WDL_FastString* _out)
+{
+	const unsigned char* p = (const unsigned char*)_p;
+	if (IsUTF8(p, _len)) {
+		_out->Set(_p, _len);
+		return;
+	}
+	_out->Set("");
+	for (int i=0; i<_len; i++)
+		AppendUTF8(_out, p[i]);
+}
+
+// decodes a (null terminated or not) ID3 string to utf-8, returns the number of bytes consumed
+static int DecodeID3String(int _enc, const unsigned char* _p, int _len, WDL_FastString* _out)
+{
+	_out->Set("");
+	int i=0;
+	if (_enc==1 || _enc==2) // utf-16 with BOM, utf-16BE
+	{
+		bool be = _enc==2;
+		if (_enc==1 && _len>=2) {
+			if (_p[0]==0xFE && _p[1]==0xFF) { be=true; i=2; }
+			else if (_p[0]==0xFF && _p[1]==0xFE) i=2;
+		}
+		for (; i+1<_len; i+=2)
+		{
+			unsigned int c = be ? (_p[i]<<8)|_p[i+1] : (_p[i+1]<<8)|_p[i];
+			if (!c) return i+2;
+			if (c>=0xD800 && c<0xDC00 && i+3<_len)
+			{
+				unsigned int c2 = be ? (_p[i+2]<<8)|_p[i+3] : (_p[i+3]<<8)|_p[i+2];
+				if (c2>=0xDC00 && c2<0xE000) {
+					c = 0x10000 + ((c-0xD800)<<10) + (c2-0xDC00);
+					i+=2;
+				}
+			}
+			AppendUTF8(_out, c);
+		}
+		return _len;
+	}
+
+	// latin-1 or utf-8
+	for (; i<_len && _p[i]; i++)
+	{
+		if (_enc==3 || _p[i]<0x80) _out->Append((const char*)_p+i, 1);
+		else AppendUTF8(_out, _p[i]);
+	}
+	return i<_len ? i+1 : _len;
+}
+
+// ID3v2.3/2.4 tag at _pos (MP3 files, WAV "id3 " chunks)
+static bool ParseID3(WDL_FileRead* _f, WDL_INT64 _pos, WDL_INT64 _maxLen, MediaFileMeta* _meta)
+{
+	unsigned char h[10];
+	_f->SetPosition(_pos);
+	if (_maxLen<10 || _f->Read(h, 10)!=10 || memcmp(h, "ID3", 3))
+		return false;
+
+	const int ver = h[3];
+	if ((ver!=3 && ver!=4) || ((h[5]&0x80) && ver==3)) { // v2.2, whole tag unsynchronisation
+		_meta->m_needTagLib = true;
+		return true;
+	}
+
+	WDL_INT64 pos = _pos+10, end = pos + SynchSafe32(h+6);
+	if (end > _pos+_maxLen) end = _pos+_maxLen;
+	if (h[5]&0x40) // extended header
+	{
+		unsigned char e[4];
+		if (_f->Read(e, 4)!=4) return true;
+		pos += ver==4 ? SynchSafe32(e) : 4+BE32(e);
+	}
+
+	WDL_TypedBuf<unsigned char> buf;
+	WDL_FastString val, desc;
+	bool commNoDesc = false;
+	while (pos+10 <= end)
+	{
+		unsigned char fh[10];
+		_f->SetPosition(pos);
+		if (_f->Read(fh, 10)!=10 || !fh[0]) // padding
+			break;
+
+		const WDL_INT64 sz = ver==4 ? SynchSafe32(fh+4) : BE32(fh+4);
+		const WDL_INT64 framePos = pos+10;
+		pos = framePos+sz;
+		if (pos > end) break;
+
+		const char* tag = NULL;
+		if (!memcmp(fh, "TIT2", 4)) tag = "title";
+		else if (!memcmp(fh, "TPE1", 4)) tag = "artist";
+		else if (!memcmp(fh, "TALB", 4)) tag = "album";
+		else if (!memcmp(fh, "TCON", 4)) tag = "genre";
+		else if (!memcmp(fh, "TYER", 4) || !memcmp(fh, "TDRC", 4)) tag = "year";
+		else if (!memcmp(fh, "TRCK", 4)) tag = "track";
+		else if (!memcmp(fh, "COMM", 4)) tag = "comment";
+		if (!tag) continue;
+
+		// compressed, encrypted, unsynchronised frames: let TagLib deal with those
+		int skip = 0;
+		if (ver==4) {
+			if (fh[9]&0x0E) { _meta->m_needTagLib = true; continue; }
+			if (fh[9]&0x01) skip = 4; // data length indicator
+		}
+		else {
+			if (fh[9]&0xC0) { _meta->m_needTagLib = true; continue; }
+			if (fh[9]&0x20) skip = 1; // grouping identity
+		}
+
+		if (!ReadBlock(_f, framePos+skip, sz-skip, &buf) || buf.GetSize()<1)
+			continue;
+
+		const unsigned char* p = buf.Get();
+		int len = buf.GetSize();
+		const int enc = *p++; len--;
+		const bool comment = !strcmp(tag, "comment");
+		if (comment) // language + short content description first
+		{
+			if (len<3) continue;
+			p+=3; len-=3;
+			int n = DecodeID3String(enc, p, len, &desc);
+			p+=n; len-=n;
+
+			// like TagLib: the first comment w/o description wins, iTunes' ones
+			// (iTunNORM, iTunSMPB, etc..) are not comments
+			if (commNoDesc || !_strnicmp(desc.Get(), "iTun", 4))
+				continue;
+		}
+		DecodeID3String(enc, p, len, &val);
+
+		if (comment && !desc.GetLength() && val.GetLength())
+		{
+			_meta->SetTag(tag, val.Get(), -1, true);
+			commNoDesc = true;
+		}
+		else if (!strcmp(tag, "year") || !strcmp(tag, "track"))
+			_meta->SetNumTag(tag, val.Get());
+		else if (!strcmp(tag, "genre") && (val.Get()[0]=='(' || (val.Get()[0]>='0' && val.Get()[0]<='9')))
+			_meta->m_needTagLib = true; // ID3v1 genre index
+		else
+			_meta->SetTag(tag, val.Get());
+	}
+	return true;
+}
+
+// ID3v1 tag at the end of MP3 files: like TagLib's tag union, only fills the
+// values the ID3v2 tag lacks
+static void ParseID3v1(WDL_FileRead* _f, MediaFileMeta* _meta)
+{
+	unsigned char t[128];
+	if (_f->GetSize()<128) return;
+	_f->SetPosition(_f->GetSize()-128);
+	if (_f->Read(t, 128)!=128 || memcmp(t, "TAG", 3))
+		return;
+
+	const bool v11 = !t[125] && t[126]; // ID3v1.1: track number in the last comment byte
+	static const struct { const char* tag; int offset, len; } fields[] = {
+		{ "title", 3, 30 }, { "artist", 33, 30 }, { "album", 63, 30 }, { "comment", 97, 30 },
+	};
+	WDL_FastString val;
+	for (int i=0; i<(int)(sizeof(fields)/sizeof(fields[0])); i++) {
+		DecodeID3String(0, t+fields[i].offset, v11 && fields[i].offset==97 ? 28 : fields[i].len, &val);
+		_meta->SetTag(fields[i].tag, val.Get());
+	}
+	_meta->SetNumTag("year", (const char*)t+93, 4);
+	if (v11) {
+		char buf[8];
+		snprintf(buf, sizeof(buf), "%d", t[126]);
+		_meta->SetNumTag("track", buf);
+	}
+	if (t[127]!=0xFF && !_meta->m_tags.Get("genre"))
+		_meta->m_needTagLib = true; // genre index
+}
+
+// returns the inner text of the first <_elem> found in an iXML chunk
+static bool GetIXMLElement(const char* _xml, const char* _elem, WDL_FastString* _out)
+{
+	char open[64], close[64];
+	snprintf(open, sizeof(open), "<%s>", _elem);
+	snprintf(close, sizeof(close), "</%s>", _elem);
+	const char* p = strstr(_xml, open);
+	if (!p) return false;
+	p += strlen(open);
+	const char* e = strstr(p, close);
+	if (!e) return false;
+
+	_out->Set("");
+	while (p<e)
+	{
+		if (*p=='&') {
+			if (!strncmp(p, "&amp;", 5)) { _out->Append("&"); p+=5; continue; }
+			if (!strncmp(p, "&lt;", 4)) { _out->Append("<"); p+=4; continue; }
+			if (!strncmp(p, "&gt;", 4)) { _out->Append(">"); p+=4; continue; }
+			if (!strncmp(p, "&quot;", 6)) { _out->Append("\""); p+=6; continue; }
+			if (!strncmp(p, "&apos;", 6)) { _out->Append("'"); p+=6; continue; }
+		}
+		_out->Append(p++, 1);
+	}
+	return true;
+}
+
+// WAV, BWF and RF64 files: the chunks we don't care about (audio data!) are skipped, not read
+static bool ParseRIFF(WDL_FileRead* _f, MediaFileMeta* _meta)
+{
+	unsigned char h[12];
+	_f->SetPosition(0);
+	if (_f->Read(h, 12)!=12 || (memcmp(h, "RIFF", 4) && memcmp(h, "RF64", 4)) || memcmp(h+8, "WAVE", 4))
+		return false;
+
+	const WDL_INT64 fileSize = _f->GetSize();
+	WDL_INT64 pos = 12, ds64DataSize = -1;
+	WDL_TypedBuf<unsigned char> buf;
+	WDL_FastString val;
+	MediaFileMeta id3(0, 0); // merged last, see below
+	while (pos+8 <= fileSize)
+	{
+		unsigned char ck[8];
+		_f->SetPosition(pos);
+		if (_f->Read(ck, 8)!=8)
+			break;
+
+		const WDL_INT64 body = pos+8;
+		WDL_INT64 sz = LE32(ck+4);
+		if (!memcmp(ck, "data", 4) && sz==0xFFFFFFFF) {
+			if (ds64DataSize<0) break;
+			sz = ds64DataSize;
+		}
+
+		if (!memcmp(ck, "ds64", 4))
+		{
+			if (ReadBlock(_f, body, 16, &buf))
+				ds64DataSize = (WDL_INT64)LE32(buf.Get()+8) | ((WDL_INT64)LE32(buf.Get()+12)<<32);
+		}
+		else if (!memcmp(ck, "bext", 4))
+		{
+			if (ReadBlock(_f, body, sz, &buf) && buf.GetSize()>=338)
+			{
+				const char* p = (const char*)buf.Get();
+				static const struct { const char* tag; int offset, maxLen; } fields[] = {
+					{ "desc", 0, 256 }, { "orig", 256, 32 }, { "origref", 288, 32 }, { "date", 320, 10 }, { "time", 330, 8 },
+				};
+				for (int i=0; i<(int)(sizeof(fields)/sizeof(fields[0])); i++) {
+					DecodeRIFFString(p+fields[i].offset, (int)strnlen(p+fields[i].offset, fields[i].maxLen), &val);
+					_meta->SetTag(fields[i].tag, val.Get());
+				}
+				if (buf.GetSize()>602) {
+					DecodeRIFFString(p+602, (int)strnlen(p+602, buf.GetSize()-602), &val);
+					_meta->SetTag("codinghistory", val.Get());
+				}
+			}
+		}
+		else if (!memcmp(ck, "iXML", 4))
+		{
+			if (ReadBlock(_f, body, sz, &buf))
+			{
+				WDL_FastString xml;
+				xml.Set((const char*)buf.Get(), buf.GetSize());
+				static const char* elems[] = { "PROJECT", "SCENE", "TAKE", "TAPE", "NOTE" };
+				for (int i=0; i<(int)(sizeof(elems)/sizeof(elems[0])); i++)
+				{
+					if (GetIXMLElement(xml.Get(), elems[i], &val)) {
+						char tag[32];
+						snprintf(tag, sizeof(tag), "ixml:%s", elems[i]);
+						_meta->SetTag(tag, val.Get());
+					}
+				}
+			}
+		}
+		else if (!memcmp(ck, "LIST", 4))
+		{
+			if (ReadBlock(_f, body, sz, &buf) && buf.GetSize()>=4 && !memcmp(buf.Get(), "INFO", 4))
+			{
+				const unsigned char* p = buf.Get();
+				int i=4;
+				while (i+8 <= buf.GetSize())
+				{
+					const int isz = (int)LE32(p+i+4);
+					if (isz<0 || i+8+isz > buf.GetSize()) break;
+					const char* v = (const char*)p+i+8;
+					const int vlen = (int)strnlen(v, isz);
+					const char* tag = NULL;
+					if (!memcmp(p+i, "INAM", 4)) tag = "title";
+					else if (!memcmp(p+i, "IART", 4)) tag = "artist";
+					else if (!memcmp(p+i, "IPRD", 4)) tag = "album";
+					else if (!memcmp(p+i, "IGNR", 4)) tag = "genre";
+					else if (!memcmp(p+i, "ICMT", 4)) tag = "comment";
+					else if (!memcmp(p+i, "ICRD", 4)) _meta->SetNumTag("year", v, vlen);
+					else if (!memcmp(p+i, "ITRK", 4) || !memcmp(p+i, "IPRT", 4)) _meta->SetNumTag("track", v, vlen);
+					if (tag) {
+						DecodeRIFFString(v, vlen, &val);
+						_meta->SetTag(tag, val.Get());
+					}
+					i += 8+isz+(isz&1);
+				}
+			}
+		}
+		else if (!memcmp(ck, "id3 ", 4) || !memcmp(ck, "ID3 ", 4))
+		{
+			ParseID3(_f, body, sz, &id3);
+		}
+
+		pos = body+sz+(sz&1);
+	}
+
+	// like TagLib, non-empty id3 values win over LIST/INFO ones, whatever the chunk order
+	const char* tag;
+	for (int i=0; i<id3.m_tags.GetSize(); i++)
+		if (const char* v = id3.m_tags.Enumerate(i, &tag))
+			_meta->SetTag(tag, v, -1, true);
+	if (id3.m_needTagLib)
+		_meta->m_needTagLib = true;
+	return true;
+}
+
+static void ReadTagLibTags(const char* _fn, MediaFileMeta* _meta)
+{
+	TagLib::FileRef f(win32::widen(_fn).c_str(), false);
+	if (f.isNull() || !f.tag() || f.tag()->isEmpty())
+		return;
+
+	const struct { const char* tag; TagLib::String val; } tags[] = {
+		{ "artist", f.tag()->artist() },
+		{ "album", f.tag()->album() },
+		{ "genre", f.tag()->genre() },
+		{ "comment", f.tag()->comment() },
+		{ "title", f.tag()->title() },
+	};
+	for (int i=0; i<(int)(sizeof(tags)/sizeof(tags[0])); i++)
+	{
+		const char* p = tags[i].val.toCString(true);
+		if (strcmp(p, "0")) // must be a taglib bug...
+			_meta->SetTag(tags[i].tag, p, -1, true);
+	}
+
+	char buf[32];
+	if (f.tag()->year()) { snprintf(buf, sizeof(buf), "%u", f.tag()->year()); _meta->SetTag("year", buf, -1, true); }
+	if (f.tag()->track()) { snprintf(buf, sizeof(buf), "%u", f.tag()->track()); _meta->SetTag("track", buf, -1, true); }
+}
+
+// no lock needed: the returned instance is not shared yet
+static MediaFileMeta* LoadMediaFileMeta(const char* _fn, time_t _mtime, WDL_INT64 _size)
+{
+	MediaFileMeta* meta = new MediaFileMeta(_mtime, _size);
+
+	WDL_FileRead f(_fn, 0, 4096, 1);
+	if (f.IsOpen())
+	{
+		if (!ParseRIFF(&f, meta))
+		{
+			if (ParseID3(&f, 0, f.GetSize(), meta))
+				ParseID3v1(&f, meta);
+			else
+				meta->m_needTagLib = true;
+		}
+	}
+
+	if (meta->m_needTagLib)
+		ReadTagLibTags(_fn, meta);
+
+	return meta;
+}
+
+// must be called with g_mediaMetaMutex locked
+// evicts a batch of least recently used entries, not to scan the cache on each insertion
+static void EvictMediaFileMeta()
+{
+	const int n = g_mediaMetaCache.GetSize();
+	const int nbEvicted = max(1, n*SNM_MEDIAMETA_EVICTED_PCT/100);
+	std::vector<WDL_UINT64> uses;
+	uses.reserve(n);
+	for (int i=0; i<n; i++)
+		uses.push_back(g_mediaMetaCache.Enumerate(i)->m_lastUse);
+	std::nth_element(uses.begin(), uses.begin()+nbEvicted-1, uses.end());
+
+	const WDL_UINT64 oldest = uses[nbEvicted-1]; // use clock values are unique
+	for (int i=n-1; i>=0; i--)
+		if (g_mediaMetaCache.Enumerate(i)->m_lastUse <= oldest)
+			g_mediaMetaCache.DeleteByIndex(i);
+}
+
+static void CacheMediaFileMeta(const char* _fn, MediaFileMeta* _meta)
+{
+	SWS_SectionLock lock(&g_mediaMetaMutex);
+	if (g_mediaMetaCache.GetSize() >= SNM_MEDIAMETA_MAX_CACHED && !g_mediaMetaCache.Exists(_fn))
+		EvictMediaFileMeta();
+	_meta->m_lastUse = ++g_mediaMetaUseClock;
+	g_mediaMetaCache.Insert(_fn, _meta);
+}
+
+// must be called with g_mediaMetaMutex locked
+static MediaFileMeta* GetCachedMediaFileMeta(const char* _fn, time_t _mtime, WDL_INT64 _size)
+{
+	MediaFileMeta* meta = g_mediaMetaCache.Get(_fn);
+	if (!meta || meta->m_mtime!=_mtime || meta->m_size!=_size)
+		return NULL;
+	meta->m_lastUse = ++g_mediaMetaUseClock;
+	return meta;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// API
+///////////////////////////////////////////////////////////////////////////////
+
+bool SNM_GetMediaFileMetadata(const char* _fn, const char* _tag, WDL_FastString* _valOut)
+{
+	if (_valOut) _valOut->Set("");
+
+	time_t mtime;
+	WDL_INT64 size;
+	if (!_fn || !*_fn || !_tag || !*_tag || !_valOut || !GetFileStat(_fn, &mtime, &size))
+		return false;
+
+	{
+		SWS_SectionLock lock(&g_mediaMetaMutex);
+		if (MediaFileMeta* meta = GetCachedMediaFileMeta(_fn, mtime, size))
+		{
+			if (const char* val = meta->m_tags.Get(_tag)) _valOut->Set(val);
+			return _valOut->GetLength()>0;
+		}
+	}
+
+	MediaFileMeta* meta = LoadMediaFileMeta(_fn, mtime, size);
+	if (const char* val = meta->m_tags.Get(_tag)) _valOut->Set(val);
+	CacheMediaFileMeta(_fn, meta);
+	return _valOut->GetLength()>0;
+}
+
+// needs TagLib (audio properties), cached too
+int SNM_GetMediaFileBitrate(const char* _fn)
+{
+	time_t mtime;
+	WDL_INT64 size;
+	if (!_fn || !*_fn || !GetFileStat(_fn, &mtime, &size))
+		return 0;
+
+	{
+		SWS_SectionLock lock(&g_mediaMetaMutex);
+		MediaFileMeta* meta = GetCachedMediaFileMeta(_fn, mtime, size);
+		if (meta && meta->m_bitrate>=0)
+			return meta->m_bitrate;
+	}
+
+	int bitrate = 0;
+	TagLib::FileRef f(win32::widen(_fn).c_str());
+	if (!f.isNull() && f.audioProperties())
+		bitrate = f.audioProperties()->bitrate();
+
+	{
+		SWS_SectionLock lock(&g_mediaMetaMutex);
+		if (MediaFileMeta* meta = GetCachedMediaFileMeta(_fn, mtime, size)) {
+			meta->m_bitrate = bitrate;
+			return bitrate;
+		}
+	}
+
+	MediaFileMeta* meta = LoadMediaFileMeta(_fn, mtime, size);
+	meta->m_bitrate = bitrate;
+	CacheMediaFileMeta(_fn, meta);
+	return bitrate;
+}
+
+// reads the metadata of all (not cached yet) files in parallel
+void SNM_PrefetchMediaFilesMetadata(const WDL_PtrList<const char>* _fns)
+{
+	if (!_fns) return;
+
+	struct Job { const char* fn; time_t mtime; WDL_INT64 size; };
+	std::vector<Job> jobs;
+	{
+		WDL_StringKeyedArray<bool> seen;
+		SWS_SectionLock lock(&g_mediaMetaMutex);
+		for (int i=0; i<_fns->GetSize(); i++)
+		{
+			Job job = { _fns->Get(i), 0, 0 };
+			if (job.fn && *job.fn && !seen.Get(job.fn) && GetFileStat(job.fn, &job.mtime, &job.size) &&
+				!GetCachedMediaFileMeta(job.fn, job.mtime, job.size))
+			{
+				seen.Insert(job.fn, true);
+				jobs.push_back(job);
+			}
+		}
+	}
+
+	std::atomic<size_t> nextJob(0);
+	auto worker = [&]() {
+		for (size_t i=nextJob++; i<jobs.size(); i=nextJob++)
+			CacheMediaFileMeta(jobs[i].fn, LoadMediaFileMeta(jobs[i].fn, jobs[i].mtime, jobs[i].size));
+	};
+
+	const size_t nbThreads = min(jobs.size(), (size_t)max(1u, std::thread::hardware_concurrency()));
+	std::vector<std::thread> threads;
+	for (size_t i=1; i<nbThreads; i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (size_t i=0; i<threads.size(); i++)
+		threads[i].join();
+}
+
+// _fn==NULL: clears the whole cache
+void SNM_InvalidateMediaFileMetadata(const char* _fn)
+{
+	SWS_SectionLock lock(&g_mediaMetaMutex);
+	if (_fn) g_mediaMetaCache.Delete(_fn);
+	else g_mediaMetaCache.DeleteAll();
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+/ SnM_MediaMeta.h
+/
+/ Copyright (c) 2026 and later SWS Extension Authors
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/ 
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/ 
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+//#pragma once
+
+#ifndef _SNM_MEDIAMETA_H_
+#define _SNM_MEDIAMETA_H_
+
+// Media file metadata service
+// Tags are read from the file headers only (no full TagLib file load) for
+// WAV/BWF/RF64 ("bext", "iXML", LIST/INFO, "id3 " chunks) and MP3 (ID3v2),
+// other formats fall back to TagLib. Results are cached by path + mtime + size
+// and all funcs are thread safe.
+//
+// Tag names (case insensitive):
+// - BWF: "desc", "orig", "origref", "date", "time", "codinghistory"
+// - iXML: "ixml:project", "ixml:scene", "ixml:take", "ixml:tape", "ixml:note"
+// - ID3/INFO/TagLib: "artist", "album", "genre", "comment", "title", "year", "track"
+
+bool SNM_GetMediaFileMetadata(const char* _fn, const char* _tag, WDL_FastString* _valOut);
+int SNM_GetMediaFileBitrate(const char* _fn);
+void SNM_PrefetchMediaFilesMetadata(const WDL_PtrList<const char>* _fns);
+void SNM_InvalidateMediaFileMetadata(const char* _fn = NULL);
+
+#endif
@@ -30,6 +30,7 @@
 #include "SnM.h"
 #include "SnM_Chunk.h"
 #include "SnM_Item.h"
+#include "SnM_MediaMeta.h"
 #include "SnM_Misc.h"
 #include "SnM_Track.h"
 #include "SnM_Util.h"
@@ -286,6 +287,14 @@ bool SNM_SetStringConfigVar(const char *varName, const char *newValue) {
   return true;
 }
 
+// returns the nb of jobs waiting in the queue, see ScheduledJob::GetStats()
+int SNM_GetScheduledJobStats(int* _maxDepthOut, int* _performedOut, int* _avgLatencyMsOut, int* _maxLatencyMsOut)
+{
+	int depth = 0;
+	ScheduledJob::GetStats(&depth, _maxDepthOut, _performedOut, _avgLatencyMsOut, _maxLatencyMsOut);
+	return depth;
+}
+
 // host some funcs from Ultraschall, https://github.com/Ultraschall
 const char* ULT_GetMediaItemNote(MediaItem* _item) {
 		return _item ? (const char*)GetSetMediaItemInfo(_item, "P_NOTES", NULL): "";
@@ -295,34 +304,55 @@ void ULT_SetMediaItemNote(MediaItem* _item, const char* _str) {
 	if (_item) GetSetMediaItemInfo(_item, "P_NOTES", (char*)_str);
 }
 
+// header-only read, cached (see SnM_MediaMeta.cpp)
 bool SNM_ReadMediaFileTag(const char *fn, const char* tag, char* tagval, int tagval_sz)
 {
   if (!fn || !*fn || !tagval || tagval_sz<=0) return false;
   *tagval=0;
 
-  TagLib::FileRef f(win32::widen(fn).c_str(), false);
+  WDL_FastString val;
+  if (tag && SNM_GetMediaFileMetadata(fn, tag, &val))
+    lstrcpyn(tagval, val.Get(), tagval_sz);
+
+  return !!*tagval;
+}
 
-  if (!f.isNull() && !f.tag()->isEmpty())
+// bulk version of SNM_ReadMediaFileTag(): fns is a list of newline separated files,
+// files are read in parallel. tagvals gets one line per file (empty if the tag was not found)
+int SNM_ReadMediaFilesTag(const char* fns, const char* tag, WDL_FastString* tagvals)
+{
+  if (!tagvals || g_script_strs.Find(tagvals)<0) return 0;
+  tagvals->Set("");
+  if (!fns || !tag) return 0;
+
+  WDL_PtrList_DeleteOnDestroy<WDL_FastString> files;
+  for (const char* p=fns; *p; )
   {
-    TagLib::String s;
-    if (!_stricmp(tag, "artist")) s=f.tag()->artist();
-    else if (!_stricmp(tag, "album")) s=f.tag()->album();
-    else if (!_stricmp(tag, "genre")) s=f.tag()->genre();
-    else if (!_stricmp(tag, "comment")) s=f.tag()->comment();
-    else if (!_stricmp(tag, "title")) s=f.tag()->title();
-    if (s.length())
-    {
-      const char *p=s.toCString(true);
-      if (strcmp(p,"0")) lstrcpyn(tagval, p, tagval_sz); // must be a taglib bug...
-    }
-    else
+    const char* eol = strchr(p, '\n');
+    int len = eol ? (int)(eol-p) : (int)strlen(p);
+    WDL_FastString* fn = files.Add(new WDL_FastString);
+    fn->Set(p, len && p[len-1]=='\r' ? len-1 : len);
+    p += eol ? len+1 : len;
+  }
+
+  WDL_PtrList<const char> fnPtrs;
+  for (int i=0; i<files.GetSize(); i++)
+    fnPtrs.Add(files.Get(i)->Get());
+  SNM_PrefetchMediaFilesMetadata(&fnPtrs);
+
+  int found=0;
+  WDL_FastString val;
+  for (int i=0; i<files.GetSize(); i++)
+  {
+    if (i) tagvals->Append("\n");
+    if (SNM_GetMediaFileMetadata(files.Get(i)->Get(), tag, &val))
     {
-      if (!_stricmp(tag, "year") && f.tag()->year()) snprintf(tagval, tagval_sz, "%u", f.tag()->year());
-      else if (!_stricmp(tag, "track") && f.tag()->track()) snprintf(tagval, tagval_sz, "%u", f.tag()->track());
+      found++;
+      for (const char* v=val.Get(); *v; v++)
+        tagvals->Append(*v=='\r' || *v=='\n' ? " " : v, 1);
     }
   }
-
-  return !!*tagval;
+  return found;
 }
 
 bool SNM_TagMediaFile(const char *fn, const char* tag, const char* tagval)
@@ -350,7 +380,11 @@ bool SNM_TagMediaFile(const char *fn, const char* tag, const char* tagval)
       int val=atoi(tagval);
       if (val>0 || !*tagval) { f.tag()->setTrack(val); didsmthg=true; }
     }
-    if (didsmthg) f.save();
+    if (didsmthg)
+    {
+      f.save();
+      SNM_InvalidateMediaFileMetadata(fn);
+    }
   }
 
   return didsmthg;
@@ -56,9 +56,11 @@ inline bool SNM_GetLongConfigVar(const char* varName, int* highOut, int* lowOut)
 bool SNM_SetLongConfigVarEx(ReaProject*, const char* varName, int newHighVal, int newLowVal);
 inline bool SNM_SetLongConfigVar(const char* varName, int newHighVal, int newLowVal) { return SNM_SetLongConfigVarEx(nullptr, varName, newHighVal, newLowVal); }
 bool SNM_SetStringConfigVar(const char* _varName, const char *_newVal);
+int SNM_GetScheduledJobStats(int* _maxDepthOut, int* _performedOut, int* _avgLatencyMsOut, int* _maxLatencyMsOut);
 const char* ULT_GetMediaItemNote(MediaItem* _item);
 void ULT_SetMediaItemNote(MediaItem* _item, const char* _str);
 bool SNM_ReadMediaFileTag(const char *fn, const char* tag, char* tagval, int tagval_sz);
+int SNM_ReadMediaFilesTag(const char* fns, const char* tag, WDL_FastString* tagvals);
 bool SNM_TagMediaFile(const char *fn, const char* tag, const char* tagval);
 
 // toolbar auto refresh
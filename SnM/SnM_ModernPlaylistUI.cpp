@@ -152,6 +152,12 @@
  *    - Try-catch only in debug builds
  *    - Validation checks optimized for release builds
  *
+ * 7. TEXT LAYOUT CACHE (PlaylistTextCache):
+ *    - Strings are measured, ellipsized and rasterized once per font/width,
+ *      repaints only blend the cached coverage masks with the text color
+ *    - Time, number and percentage strings are composed from a per-font
+ *      glyph atlas (no per-tick measurement nor cache growth)
+ *
  * Performance Target: > 30 FPS with 100+ items ✓
  ******************************************************************************/
 
@@ -163,13 +169,254 @@
 #include "SnM.h"
 
 ///////////////////////////////////////////////////////////////////////////////
-// Helper functions for LICE font rendering
+// PlaylistTextCache implementation
 ///////////////////////////////////////////////////////////////////////////////
 
+// Characters of time, number and percentage strings, composed from glyph atlases
+static const char ATLAS_CHARS[] = "0123456789:./()% x-";
+static const char* ELLIPSIS = "...";
+
+PlaylistTextCache* PlaylistTextCache::s_instance = NULL;
+
+PlaylistTextCache::PlaylistTextCache()
+    : m_layouts(true, DeleteLayout)
+{
+}
+
+PlaylistTextCache::~PlaylistTextCache()
+{
+    ClearCache();
+}
+
+PlaylistTextCache* PlaylistTextCache::GetInstance()
+{
+    if (!s_instance) {
+        s_instance = new PlaylistTextCache();
+    }
+    return s_instance;
+}
+
+void PlaylistTextCache::DestroyInstance()
+{
+    if (s_instance) {
+        delete s_instance;
+        s_instance = NULL;
+    }
+}
+
+void PlaylistTextCache::ClearCache()
+{
+    m_layouts.DeleteAll();
+    m_atlases.Empty(true);
+}
+
+void PlaylistTextCache::OnFontsDeleted()
+{
+    if (s_instance) {
+        s_instance->ClearCache();
+    }
+}
+
+/**
+ * MeasureNative - Measures text with LICE_CachedFont::DrawText and DT_CALCRECT
+ */
+static void MeasureNative(LICE_CachedFont* font, const char* text, int len, int* w, int* h)
+{
+    RECT r = {0, 0, 0, 0};
+    font->DrawText(NULL, text, len, &r, DT_SINGLELINE|DT_NOPREFIX|DT_CALCRECT);
+    *w = r.right;
+    *h = r.bottom;
+}
+
 /**
- * DrawTextWithFont - Helper to draw text with LICE_CachedFont
+ * BlendTextMask - Blends a coverage mask with the text color
  *
- * Wraps the LICE_CachedFont::DrawText API for simpler single-line text rendering.
+ * Per-channel coverage, so that subpixel (ClearType) rendering is kept.
+ * Returns false if the destination bits are not accessible.
+ */
+static bool BlendTextMask(LICE_IBitmap* dest, int x, int y, LICE_IBitmap* mask,
+                          int srcx, int w, int h, LICE_pixel color)
+{
+    LICE_pixel* dbits = dest->getBits();
+    const LICE_pixel* sbits = mask ? mask->getBits() : NULL;
+    if (!dbits || !sbits) return false;
+
+    const int dw = dest->getWidth(), dh = dest->getHeight();
+    const int x0 = max(x, 0), y0 = max(y, 0);
+    const int x1 = min(x + w, dw), y1 = min(y + h, dh);
+    if (x0 >= x1 || y0 >= y1) return true;
+
+    const int dspan = dest->getRowSpan(), sspan = mask->getRowSpan();
+    const bool flipped = dest->isFlipped();
+    const int cr = LICE_GETR(color), cg = LICE_GETG(color), cb = LICE_GETB(color);
+
+    for (int j = y0; j < y1; j++) {
+        LICE_pixel* d = dbits + (flipped ? dh - 1 - j : j) * dspan;
+        const LICE_pixel* s = sbits + (j - y) * sspan + srcx - x;
+        for (int i = x0; i < x1; i++) {
+            const LICE_pixel m = s[i];
+            const int ar = LICE_GETR(m), ag = LICE_GETG(m), ab = LICE_GETB(m);
+            if (!(ar | ag | ab)) continue;
+
+            const LICE_pixel p = d[i];
+            const int r = LICE_GETR(p), g = LICE_GETG(p), b = LICE_GETB(p);
+            d[i] = LICE_RGBA(r + (cr - r) * ar / 255,
+                             g + (cg - g) * ag / 255,
+                             b + (cb - b) * ab / 255,
+                             LICE_GETA(p));
+        }
+    }
+    return true;
+}
+
+LICE_IBitmap* PlaylistTextCache::RenderMask(LICE_CachedFont* font, const char* text, int w, int h)
+{
+    if (w <= 0 || h <= 0 || !m_scratch.resize(w, h)) return NULL;
+
+    LICE_Clear(&m_scratch, LICE_RGBA(0, 0, 0, 255));
+    RECT r = {0, 0, w, h};
+    font->SetTextColor(LICE_RGBA(255, 255, 255, 255));
+    font->SetBkMode(TRANSPARENT);
+    font->DrawText(&m_scratch, text, -1, &r, DT_SINGLELINE|DT_NOPREFIX);
+
+    LICE_IBitmap* mask = new LICE_MemBitmap(w, h);
+    LICE_Blit(mask, &m_scratch, 0, 0, 0, 0, w, h, 1.0f, LICE_BLIT_MODE_COPY);
+    return mask;
+}
+
+PlaylistTextCache::GlyphAtlas* PlaylistTextCache::GetAtlas(LICE_CachedFont* font, const char* text)
+{
+    if (!*text) return NULL;
+    for (const char* p = text; *p; p++)
+        if (!strchr(ATLAS_CHARS, *p)) return NULL;
+
+    for (int i = 0; i < m_atlases.GetSize(); i++)
+        if (m_atlases.Get(i)->font == font) return m_atlases.Get(i);
+
+    // measure and render all glyphs side by side
+    GlyphAtlas* atlas = new GlyphAtlas();
+    atlas->font = font;
+    int totalW = 0;
+    for (int i = 0; ATLAS_CHARS[i]; i++) {
+        int h;
+        MeasureNative(font, &ATLAS_CHARS[i], 1, &atlas->w[i], &h);
+        atlas->x[i] = totalW;
+        totalW += atlas->w[i];
+        atlas->h = max(atlas->h, h);
+    }
+
+    if (totalW > 0 && atlas->h > 0 && m_scratch.resize(totalW, atlas->h)) {
+        LICE_Clear(&m_scratch, LICE_RGBA(0, 0, 0, 255));
+        font->SetTextColor(LICE_RGBA(255, 255, 255, 255));
+        font->SetBkMode(TRANSPARENT);
+        for (int i = 0; ATLAS_CHARS[i]; i++) {
+            RECT r = {atlas->x[i], 0, atlas->x[i] + atlas->w[i], atlas->h};
+            font->DrawText(&m_scratch, &ATLAS_CHARS[i], 1, &r, DT_SINGLELINE|DT_NOPREFIX);
+        }
+        atlas->mask = new LICE_MemBitmap(totalW, atlas->h);
+        LICE_Blit(atlas->mask, &m_scratch, 0, 0, 0, 0, totalW, atlas->h, 1.0f, LICE_BLIT_MODE_COPY);
+    }
+    return m_atlases.Add(atlas);
+}
+
+const PlaylistTextLayout* PlaylistTextCache::GetLayout(LICE_CachedFont* font, const char* text, int maxWidth)
+{
+    if (!font || !text) return NULL;
+    if (maxWidth < 0) maxWidth = 0;
+
+    WDL_FastString key;
+    key.SetFormatted(64, "%p|%d|", (void*)font, maxWidth);
+    key.Append(text);
+    if (PlaylistTextLayout* layout = m_layouts.Get(key.Get(), NULL)) {
+        return layout;
+    }
+
+    if (m_layouts.GetSize() >= MAX_LAYOUTS) {
+        m_layouts.DeleteAll();
+    }
+
+    PlaylistTextLayout* layout = new PlaylistTextLayout();
+    layout->text.Set(text);
+    MeasureNative(font, text, -1, &layout->w, &layout->h);
+
+    // Truncation needed - binary search for the longest prefix that fits with the ellipsis
+    if (maxWidth && layout->w > maxWidth) {
+        int ellipsisWidth, h;
+        MeasureNative(font, ELLIPSIS, -1, &ellipsisWidth, &h);
+        const int targetWidth = maxWidth - ellipsisWidth;
+
+        int low = 0, high = layout->text.GetLength();
+        while (low < high) {
+            int mid = (low + high + 1) >> 1;
+            int w;
+            MeasureNative(font, text, mid, &w, &h);
+            if (w <= targetWidth) {
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+
+        layout->text.SetLen(low);
+        layout->text.Append(ELLIPSIS);
+        MeasureNative(font, layout->text.Get(), -1, &layout->w, &layout->h);
+    }
+
+    layout->mask = RenderMask(font, layout->text.Get(), layout->w, layout->h);
+    m_layouts.Insert(key.Get(), layout);
+    return layout;
+}
+
+void PlaylistTextCache::Measure(LICE_CachedFont* font, const char* text, int* w, int* h)
+{
+    if (!font || !text || !w || !h) return;
+
+    if (GlyphAtlas* atlas = GetAtlas(font, text)) {
+        *w = 0;
+        for (const char* p = text; *p; p++)
+            *w += atlas->w[strchr(ATLAS_CHARS, *p) - ATLAS_CHARS];
+        *h = atlas->h;
+    }
+    else if (const PlaylistTextLayout* layout = GetLayout(font, text)) {
+        *w = layout->w;
+        *h = layout->h;
+    }
+}
+
+void PlaylistTextCache::Draw(LICE_IBitmap* bm, int x, int y, LICE_CachedFont* font,
+                             const char* text, LICE_pixel color, int maxWidth)
+{
+    if (!bm || !font || !text) return;
+
+    bool drawn = false;
+    if (GlyphAtlas* atlas = maxWidth <= 0 ? GetAtlas(font, text) : NULL) {
+        drawn = atlas->mask != NULL;
+        for (const char* p = text; drawn && *p; p++) {
+            const int i = (int)(strchr(ATLAS_CHARS, *p) - ATLAS_CHARS);
+            drawn = BlendTextMask(bm, x, y, atlas->mask, atlas->x[i], atlas->w[i], atlas->h, color);
+            x += atlas->w[i];
+        }
+        if (drawn) return;
+    }
+
+    const PlaylistTextLayout* layout = GetLayout(font, text, maxWidth);
+    if (layout && BlendTextMask(bm, x, y, layout->mask, 0, layout->w, layout->h, color)) {
+        return;
+    }
+
+    // No accessible bits: draw natively
+    RECT r = {x, y, x + 10000, y + 10000};
+    font->SetTextColor(color);
+    font->SetBkMode(TRANSPARENT);
+    font->DrawText(bm, layout ? layout->text.Get() : text, -1, &r, DT_SINGLELINE|DT_NOPREFIX);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper functions for LICE font rendering
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * DrawTextWithFont - Helper to draw single-line text through PlaylistTextCache
  *
  * @param bm Target bitmap
  * @param x X coordinate
@@ -177,22 +424,17 @@
  * @param text Text to draw
  * @param color Text color
  * @param font Font to use
+ * @param maxWidth Maximum width, text is truncated with ellipsis to fit (<= 0: no limit)
  */
 static void DrawTextWithFont(LICE_IBitmap* bm, int x, int y, const char* text,
-                             LICE_pixel color, LICE_CachedFont* font)
+                             LICE_pixel color, LICE_CachedFont* font, int maxWidth = 0)
 {
     if (!bm || !text || !font) return;
-
-    RECT r = {x, y, x + 10000, y + 10000};
-    font->SetTextColor(color);
-    font->SetBkMode(TRANSPARENT);
-    font->DrawText(bm, text, -1, &r, DT_SINGLELINE|DT_NOPREFIX);
+    PlaylistTextCache::GetInstance()->Draw(bm, x, y, font, text, color, maxWidth);
 }
 
 /**
- * MeasureTextWithFont - Helper to measure text with LICE_CachedFont
- *
- * Measures text dimensions using LICE_CachedFont::DrawText with DT_CALCRECT.
+ * MeasureTextWithFont - Helper to measure single-line text through PlaylistTextCache
  *
  * @param text Text to measure
  * @param w Output width
@@ -202,11 +444,7 @@ static void DrawTextWithFont(LICE_IBitmap* bm, int x, int y, const char* text,
 static void MeasureTextWithFont(const char* text, int* w, int* h, LICE_CachedFont* font)
 {
     if (!text || !w || !h || !font) return;
-
-    RECT r = {0, 0, 0, 0};
-    font->DrawText(NULL, text, -1, &r, DT_SINGLELINE|DT_NOPREFIX|DT_CALCRECT);
-    *w = r.right;
-    *h = r.bottom;
+    PlaylistTextCache::GetInstance()->Measure(font, text, w, h);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -214,6 +452,7 @@ static void MeasureTextWithFont(const char* text, int* w, int* h, LICE_CachedFon
 ///////////////////////////////////////////////////////////////////////////////
 
 ModernPlaylistItemRenderer::ModernPlaylistItemRenderer()
+    : m_dpiScale(256)
 {
 }
 
@@ -287,13 +526,14 @@ void ModernPlaylistItemRenderer::DrawItem(
     const PlaylistTheme::Fonts& fonts = theme->GetFonts();
 
     // OPTIMIZATION: Pre-calculate all layout constants once
-    const int ICON_SIZE = 16;
+    // (icons and badges follow the DPI scale, see SetDpiScale())
+    const int ICON_SIZE = Scaled(16);
     const int LEFT_PADDING = 8;
     const int ICON_SPACING = 8;
     const int NUMBER_WIDTH = 40;
     const int TIME_WIDTH = 80;
     const int RIGHT_PADDING = 8;
-    const int LOOP_BADGE_SPACE = (state.hasInfiniteLoop || state.loopCount > 1) ? 40 : 0;
+    const int LOOP_BADGE_SPACE = (state.hasInfiniteLoop || state.loopCount > 1) ? Scaled(40) : 0;
 
     int currentX = drawRect.left + LEFT_PADDING;
     const int centerY = drawRect.top + ((drawRect.bottom - drawRect.top) >> 1); // Bit shift for faster division
@@ -307,7 +547,7 @@ void ModernPlaylistItemRenderer::DrawItem(
     // Draw status icon if needed (optimized: single check, early reserve space)
     const bool needsIcon = state.NeedsStatusIcon();
     if (needsIcon) {
-        DrawStatusIcon(drawbm, drawRect, state);
+        DrawStatusIcon(drawbm, drawRect, state, theme);
     }
     currentX += ICON_SIZE + ICON_SPACING; // Always reserve space for alignment
 
@@ -325,48 +565,10 @@ void ModernPlaylistItemRenderer::DrawItem(
         const int availableWidth = drawRect.right - currentX - TIME_WIDTH - RIGHT_PADDING - LOOP_BADGE_SPACE;
 
         if (availableWidth > 20) { // Minimum reasonable width
-            // OPTIMIZATION: Fast path - measure once and check if truncation needed
-            int textWidth = 0, textHeight = 0;
-            MeasureTextWithFont(data.regionName.Get(), &textWidth, &textHeight, fonts.itemName);
-
-            if (textWidth <= availableWidth) {
-                // OPTIMIZATION: No truncation needed - direct draw (fastest path)
-                DrawTextWithFont(drawbm, currentX, centerY, data.regionName.Get(),
-                             colors.text, fonts.itemName);
-            } else {
-                // OPTIMIZATION: Truncation needed - use efficient binary search
-                // This reduces text measurements from O(n) to O(log n)
-                WDL_FastString displayName;
-                displayName.Set(data.regionName.Get());
-                const char* ellipsis = "...";
-
-                int ellipsisWidth = 0, ellipsisHeight = 0;
-                MeasureTextWithFont(ellipsis, &ellipsisWidth, &ellipsisHeight, fonts.itemName);
-
-                const int len = displayName.GetLength();
-                const int targetWidth = availableWidth - ellipsisWidth;
-
-                // Binary search for optimal truncation point
-                int low = 0, high = len;
-                while (low < high) {
-                    int mid = (low + high + 1) >> 1; // Bit shift for faster division
-                    displayName.SetLen(mid);
-
-                    MeasureTextWithFont(displayName.Get(), &textWidth, &textHeight, fonts.itemName);
-
-                    if (textWidth <= targetWidth) {
-                        low = mid;
-                    } else {
-                        high = mid - 1;
-                    }
-                }
-
-                displayName.SetLen(low);
-                displayName.Append(ellipsis);
-
-                DrawTextWithFont(drawbm, currentX, centerY, displayName.Get(),
-                             colors.text, fonts.itemName);
-            }
+            // OPTIMIZATION: Measurement, ellipsis fitting and rasterization are cached
+            // per name and width by PlaylistTextCache
+            DrawTextWithFont(drawbm, currentX, centerY, data.regionName.Get(),
+                             colors.text, fonts.itemName, availableWidth);
         }
     }
 
@@ -448,7 +650,7 @@ void ModernPlaylistItemRenderer::DrawBackground(LICE_IBitmap* bm, const RECT& r,
     }
 }
 
-void ModernPlaylistItemRenderer::DrawStatusIcon(LICE_IBitmap* bm, const RECT& r, const ItemVisualState& state)
+void ModernPlaylistItemRenderer::DrawStatusIcon(LICE_IBitmap* bm, const RECT& r, const ItemVisualState& state, const PlaylistTheme* theme)
 {
     // TASK 11.1: Null pointer check
     if (!bm) {
@@ -477,31 +679,34 @@ void ModernPlaylistItemRenderer::DrawStatusIcon(LICE_IBitmap* bm, const RECT& r,
     }
 
     // Position icon at left side with padding
-    const int ICON_SIZE = 16; // Minimum 16x16 as per requirements
+    const int ICON_SIZE = 16; // Minimum 16x16 as per requirements (before DPI scaling)
     const int LEFT_PADDING = 8;
 
     int iconX = r.left + LEFT_PADDING;
-    int iconY = r.top + (r.bottom - r.top - ICON_SIZE) / 2; // Center vertically
+    int iconY = r.top + (r.bottom - r.top - Scaled(ICON_SIZE)) / 2; // Center vertically
 
     // Determine which icon to draw based on priority
     // Priority: Sync Loss > Playing > Next
     PlaylistIconManager::IconType iconType;
+    int color = -1; // sync loss icon: own colors
 
     if (state.isSyncLoss) {
         iconType = PlaylistIconManager::ICON_SYNC_LOSS;
     }
     else if (state.isPlaying) {
         iconType = PlaylistIconManager::ICON_PLAY;
+        if (theme) color = theme->GetColors().currentItemText;
     }
     else if (state.isNext) {
         iconType = PlaylistIconManager::ICON_NEXT;
+        if (theme) color = theme->GetColors().nextItemText;
     }
     else {
         return; // No icon to draw
     }
 
     // Draw the icon
-    iconMgr->DrawIcon(bm, iconType, iconX, iconY, ICON_SIZE);
+    iconMgr->DrawIcon(bm, iconType, iconX, iconY, ICON_SIZE, color, m_dpiScale);
 }
 
 void ModernPlaylistItemRenderer::DrawRegionNumber(LICE_IBitmap* bm, const RECT& r, int number, const PlaylistTheme* theme)
@@ -545,7 +750,7 @@ void ModernPlaylistItemRenderer::DrawRegionNumber(LICE_IBitmap* bm, const RECT&
     snprintf(numStr, sizeof(numStr), "%d.", number);
 
     // Position after status icon with proper spacing
-    const int ICON_SIZE = 16;
+    const int ICON_SIZE = Scaled(16);
     const int LEFT_PADDING = 8;
     const int ICON_SPACING = 8;
     const int NUMBER_X = r.left + LEFT_PADDING + ICON_SIZE + ICON_SPACING;
@@ -593,7 +798,7 @@ void ModernPlaylistItemRenderer::DrawRegionName(LICE_IBitmap* bm, const RECT& r,
     }
 
     // Calculate position after region number
-    const int ICON_SIZE = 16;
+    const int ICON_SIZE = Scaled(16);
     const int LEFT_PADDING = 8;
     const int ICON_SPACING = 8;
     const int NUMBER_WIDTH = 40; // Approximate width for region number (e.g., "999.")
@@ -611,42 +816,8 @@ void ModernPlaylistItemRenderer::DrawRegionName(LICE_IBitmap* bm, const RECT& r,
     // Center vertically
     int textY = r.top + (r.bottom - r.top) / 2;
 
-    // Truncate name if too long
-    WDL_FastString displayName;
-    displayName.Set(name);
-
-    // Measure text width
-    RECT textRect = {0, 0, 0, 0};
-    MeasureTextWithFont(displayName.Get(), &textRect.right, &textRect.bottom, fonts.itemName);
-
-    // If text is too wide, truncate with ellipsis
-    if (textRect.right > AVAILABLE_WIDTH) {
-        const char* ellipsis = "...";
-        RECT ellipsisRect = {0, 0, 0, 0};
-        MeasureTextWithFont(ellipsis, &ellipsisRect.right, &ellipsisRect.bottom, fonts.itemName);
-
-        // Binary search for the right length
-        int len = displayName.GetLength();
-        while (len > 0 && textRect.right + ellipsisRect.right > AVAILABLE_WIDTH) {
-            len--;
-            displayName.SetLen(len);
-            displayName.Append(ellipsis);
-
-            textRect.right = 0;
-            textRect.bottom = 0;
-            MeasureTextWithFont(displayName.Get(), &textRect.right, &textRect.bottom, fonts.itemName);
-
-            // Remove ellipsis for next iteration
-            displayName.SetLen(len);
-        }
-
-        if (len > 0) {
-            displayName.Append(ellipsis);
-        }
-    }
-
-    // Draw the region name with 12pt font (itemName)
-    DrawTextWithFont(bm, NAME_X, textY, displayName.Get(), colors.text, fonts.itemName);
+    // Draw the region name with 12pt font (itemName), truncated with ellipsis if too long
+    DrawTextWithFont(bm, NAME_X, textY, name, colors.text, fonts.itemName, AVAILABLE_WIDTH);
 }
 
 void ModernPlaylistItemRenderer::DrawTimeInfo(LICE_IBitmap* bm, const RECT& r, const ItemData& data, const PlaylistTheme* theme)
@@ -717,8 +888,8 @@ void ModernPlaylistItemRenderer::DrawLoopBadge(LICE_IBitmap* bm, const RECT& r,
 
     // OPTIMIZATION: Pre-calculate all positions once
     const int RIGHT_PADDING = 8;
-    const int BADGE_SIZE = 24;
-    const int ICON_SIZE = 14;
+    const int BADGE_SIZE = Scaled(24);
+    const int ICON_SIZE = 14; // before DPI scaling
     const int badgeX = r.right - BADGE_SIZE - RIGHT_PADDING;
     const int badgeY = r.top + ((r.bottom - r.top - BADGE_SIZE) >> 1); // Bit shift for faster division
 
@@ -727,9 +898,9 @@ void ModernPlaylistItemRenderer::DrawLoopBadge(LICE_IBitmap* bm, const RECT& r,
         // TASK 11.1: Check icon manager instance
         PlaylistIconManager* iconMgr = PlaylistIconManager::GetInstance();
         if (iconMgr) {
-            const int iconX = badgeX + ((BADGE_SIZE - ICON_SIZE) >> 1);
-            const int iconY = badgeY + ((BADGE_SIZE - ICON_SIZE) >> 1);
-            iconMgr->DrawIcon(bm, PlaylistIconManager::ICON_LOOP_INFINITE, iconX, iconY, ICON_SIZE);
+            const int iconX = badgeX + ((BADGE_SIZE - Scaled(ICON_SIZE)) >> 1);
+            const int iconY = badgeY + ((BADGE_SIZE - Scaled(ICON_SIZE)) >> 1);
+            iconMgr->DrawIcon(bm, PlaylistIconManager::ICON_LOOP_INFINITE, iconX, iconY, ICON_SIZE, -1, m_dpiScale); // white, like the "xN" text
         } else {
             #ifdef _DEBUG
             OutputDebugString("ModernPlaylistItemRenderer::DrawLoopBadge - NULL icon manager, using text fallback\n");
@@ -1219,6 +1390,7 @@ void ModernRegionPlaylistView::OnItemPaint(LICE_IBitmap* drawbm, SWS_ListItem* i
         }
 
         // Call renderer - all drawing batched inside
+        m_renderer.SetDpiScale(hidpi::GetDpiForWindow(m_hwndList));
         m_renderer.DrawItem(drawbm, itemRect, data, state, m_theme);
 
         // OPTIMIZATION: Clear dirty flag after successful render
@@ -122,6 +122,117 @@ extern int g_playNext;          // index of the next item to be played, -1 means
 extern int g_rgnLoop;           // region loop count: 0 not looping, <0 infinite loop, n>0 looping n times
 extern SWSProjConfig<RegionPlaylists> g_pls;
 
+///////////////////////////////////////////////////////////////////////////////
+// PlaylistTextCache - Text layout and glyph cache for playlist rendering
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * PlaylistTextLayout
+ *
+ * Measured (and ellipsized if needed) text for a font and maximum width,
+ * with its pre-rendered coverage mask.
+ * - text: Displayed text (ends with "..." when truncated)
+ * - w, h: Measured size of the displayed text
+ * - mask: Per-channel coverage of the text (white on black), NULL if rendering failed
+ */
+struct PlaylistTextLayout {
+    WDL_FastString text;
+    int w, h;
+    LICE_IBitmap* mask;
+
+    PlaylistTextLayout() : w(0), h(0), mask(NULL) {}
+    ~PlaylistTextLayout() { delete mask; }
+};
+
+/**
+ * PlaylistTextCache
+ *
+ * Singleton cache for all text drawn by the modern playlist UI, so that
+ * repaints do not measure nor rasterize strings through LICE_CachedFont.
+ *
+ * - Strings are laid out once per font and maximum width (ellipsis fitting
+ *   included) and rendered once into a coverage mask which is then blended
+ *   with the text color on each repaint
+ * - Numbers, times and percentages (e.g. "12.", "3:45 / 4:00 (75%)") are
+ *   composed from a per-font glyph atlas, so that ticking time strings do
+ *   not fill the layout cache
+ *
+ * CACHING:
+ * Fonts are keyed by pointer, the cache must be cleared when fonts are
+ * deleted (see PlaylistTheme::CleanupFonts()). The layout cache is flushed
+ * when it exceeds MAX_LAYOUTS entries.
+ *
+ * THREAD SAFETY:
+ * Not thread-safe. All methods must be called from the main UI thread.
+ */
+class PlaylistTextCache {
+public:
+    static PlaylistTextCache* GetInstance();
+    static void DestroyInstance();
+
+    /**
+     * GetLayout - Returns the cached layout of a string
+     * @param font Font to use (must not be NULL)
+     * @param text Text to lay out (must not be NULL)
+     * @param maxWidth Maximum width, text is truncated with ellipsis to fit (<= 0: no limit)
+     * @return Cached layout, or NULL on failure
+     */
+    const PlaylistTextLayout* GetLayout(LICE_CachedFont* font, const char* text, int maxWidth = 0);
+
+    /**
+     * Measure - Measures a single-line string
+     * Same results as LICE_CachedFont::DrawText with DT_CALCRECT for cached layouts.
+     */
+    void Measure(LICE_CachedFont* font, const char* text, int* w, int* h);
+
+    /**
+     * Draw - Draws a single-line string, top-left aligned at x,y
+     * @param maxWidth See GetLayout()
+     * Falls back to LICE_CachedFont::DrawText if the target bitmap has no accessible bits.
+     */
+    void Draw(LICE_IBitmap* bm, int x, int y, LICE_CachedFont* font, const char* text, LICE_pixel color, int maxWidth = 0);
+
+    /**
+     * ClearCache - Clears all cached layouts and glyph atlases
+     */
+    void ClearCache();
+
+    /**
+     * OnFontsDeleted - Clears the cache, if any
+     * Must be called when fonts are deleted or recreated.
+     */
+    static void OnFontsDeleted();
+
+private:
+    enum { MAX_LAYOUTS = 1024 };
+
+    // Glyph atlas for the characters in ATLAS_CHARS, rendered side by side
+    struct GlyphAtlas {
+        LICE_CachedFont* font;
+        int x[32], w[32], h;
+        LICE_IBitmap* mask;
+
+        GlyphAtlas() : font(NULL), h(0), mask(NULL) {}
+        ~GlyphAtlas() { delete mask; }
+    };
+
+    PlaylistTextCache();
+    ~PlaylistTextCache();
+    PlaylistTextCache(const PlaylistTextCache&);
+    PlaylistTextCache& operator=(const PlaylistTextCache&);
+
+    static void DeleteLayout(PlaylistTextLayout* layout) { delete layout; }
+
+    GlyphAtlas* GetAtlas(LICE_CachedFont* font, const char* text);
+    LICE_IBitmap* RenderMask(LICE_CachedFont* font, const char* text, int w, int h);
+
+    WDL_StringKeyedArray<PlaylistTextLayout*> m_layouts;
+    WDL_PtrList_DeleteOnDestroy<GlyphAtlas> m_atlases;
+    LICE_SysBitmap m_scratch;
+
+    static PlaylistTextCache* s_instance;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // ModernPlaylistItemRenderer - Renders individual playlist items
 ///////////////////////////////////////////////////////////////////////////////
@@ -345,7 +456,19 @@ public:
         const PlaylistTheme* theme
     );
 
+    /**
+     * SetDpiScale - Sets the DPI scale of the target window
+     * @param dpiScale 256 = 100% (0 = unknown, same as 100%)
+     *
+     * Icons, badges and the space reserved for them are scaled accordingly.
+     */
+    void SetDpiScale(int dpiScale) { m_dpiScale = dpiScale > 0 ? dpiScale : 256; }
+
 private:
+    int Scaled(int px) const { return (px * m_dpiScale) >> 8; }
+
+    int m_dpiScale; // 256 = 100%
+
     /**
      * DrawBackground - Renders the item background with state-based colors
      *
@@ -370,15 +493,18 @@ private:
      * 2. Playing (play triangle)
      * 3. Next (double triangle)
      *
-     * Icon is positioned at left side with 8px padding, minimum 16x16 size.
+     * Icon is positioned at left side with 8px padding, minimum 16x16 size
+     * (scaled by the DPI scale). Play and next icons are tinted with the
+     * text color of their item state.
      *
      * @param bm Target bitmap
      * @param r Rectangle bounds
      * @param state Visual state determining which icon to draw
+     * @param theme Theme providing colors
      *
      * REQUIREMENTS: Satisfies Req 2.1, 2.2, 2.5
      */
-    void DrawStatusIcon(LICE_IBitmap* bm, const RECT& r, const ItemVisualState& state);
+    void DrawStatusIcon(LICE_IBitmap* bm, const RECT& r, const ItemVisualState& state, const PlaylistTheme* theme);
 
     /**
      * DrawRegionNumber - Renders the region number
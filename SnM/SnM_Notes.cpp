@@ -89,8 +89,8 @@ enum {
 
 SNM_WindowManager<NotesWnd> g_notesWndMgr(NOTES_WND_ID);
 
-SWSProjConfig<WDL_PtrList_DOD<SNM_TrackNotes> > g_SNM_TrackNotes;
-SWSProjConfig<WDL_PtrList_DOD<SNM_RegionSubtitle> > g_pRegionSubs; // for markers too..
+SWSProjConfig<SNM_TrackNotesList> g_SNM_TrackNotes;
+SWSProjConfig<SNM_RegionSubtitleList> g_pRegionSubs; // for markers too..
 SWSProjConfig<WDL_FastString> g_prjNotes; // extra project notes
 // global notes #647, saved in <REAPER Resource Path>/SWS_GlobalNotes.txt 
 // (no SWSProjConfig, one instance across all projects, i.e. global)
@@ -130,16 +130,81 @@ bool g_internalMkrRgnChange = false;
 SNM_TrackNotes *SNM_TrackNotes::find(MediaTrack *track)
 {
 	const GUID *guid = TrackToGuid(track);
-	if (!guid)
-		return nullptr;
+	return guid ? g_SNM_TrackNotes.Get()->Find(*guid) : nullptr;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Marker/region lookup by position, for marker/region names and subtitles
+// Built once and rebuilt on marker/region updates (see NotesMarkerRegionListener)
+// so that following the play position does not depend on the number of markers/regions
+///////////////////////////////////////////////////////////////////////////////
 
-	for (int i = 0; i < g_SNM_TrackNotes.Get()->GetSize(); ++i)
+struct NotesMkrRgn
+{
+	double pos, end;
+	int id;
+	bool isRgn;
+	int lastMarker; // index of the last marker up to this one, -1 if none
+	double maxEnd;  // max region end up to this one
+};
+
+WDL_TypedBuf<NotesMkrRgn> g_notesMkrRgns; // in EnumProjectMarkers() order, i.e. sorted by position
+ReaProject* g_notesMkrRgnsProj = NULL;
+bool g_notesMkrRgnsDirty = true;
+
+void InvalidateNotesMarkerRegions() {
+	g_notesMkrRgnsDirty = true;
+}
+
+// same as FindMarkerRegion() for the current project, with a binary search
+int FindNotesMarkerRegion(double _pos, int _flags, int* _idOut)
+{
+	ReaProject* proj = EnumProjects(-1, NULL, 0);
+	if (g_notesMkrRgnsDirty || g_notesMkrRgnsProj != proj)
 	{
-		SNM_TrackNotes *notes = g_SNM_TrackNotes.Get()->Get(i);
-		if (GuidsEqual(guid, notes->GetGUID()))
-			return notes;
+		g_notesMkrRgnsDirty = false;
+		g_notesMkrRgnsProj = proj;
+		g_notesMkrRgns.Resize(0, false);
+
+		NotesMkrRgn m;
+		int x=0, num, lastMarker=-1;
+		double maxEnd=-1.0;
+		while ((x = EnumProjectMarkers3(NULL, x, &m.isRgn, &m.pos, &m.end, NULL, &num, NULL)))
+		{
+			m.id = MakeMarkerRegionId(num, m.isRgn);
+			if (m.isRgn) maxEnd = max(maxEnd, m.end);
+			else lastMarker = g_notesMkrRgns.GetSize();
+			m.lastMarker = lastMarker;
+			m.maxEnd = maxEnd;
+			g_notesMkrRgns.Add(m);
+		}
 	}
-	return nullptr;
+
+	const NotesMkrRgn* mr = g_notesMkrRgns.Get();
+
+	// number of markers/regions starting at or before _pos
+	int lo=0, hi=g_notesMkrRgns.GetSize();
+	while (lo < hi)
+	{
+		const int mid = (lo+hi)/2;
+		if (mr[mid].pos <= _pos) lo = mid+1;
+		else hi = mid;
+	}
+
+	// last marker, or last region containing _pos if it starts after that marker
+	int found = (lo && _flags&SNM_MARKER_MASK) ? mr[lo-1].lastMarker : -1;
+	if (_flags&SNM_REGION_MASK)
+	{
+		for (int i=lo-1; i>found && mr[i].maxEnd >= _pos; i--)
+			if (mr[i].isRgn && _pos <= mr[i].end) {
+				found = i;
+				break;
+			}
+	}
+
+	if (_idOut) *_idOut = found>=0 ? mr[found].id : -1;
+	return found;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -853,16 +918,9 @@ void NotesWnd::SaveCurrentMkrRgnNameOrSub(int _type, bool _wantUndo)
 		else
 		{
 			// CRLF removed only when saving the project..
-			bool found = false;
-			for (int i=0; i < g_pRegionSubs.Get()->GetSize(); i++) 
-			{
-				if (g_pRegionSubs.Get()->Get(i)->GetId() == g_lastMarkerRegionId) {
-					g_pRegionSubs.Get()->Get(i)->SetNotes(g_lastText);
-					found = true;
-					break;
-				}
-			}
-			if (!found)
+			if (SNM_RegionSubtitle* sub = g_pRegionSubs.Get()->Find(g_lastMarkerRegionId))
+				sub->SetNotes(g_lastText);
+			else
 				g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, g_lastMarkerRegionId, g_lastText));
 			if (_wantUndo)
 				Undo_OnStateChangeEx2(NULL, IsRegion(g_lastMarkerRegionId) ? __LOCALIZE("Edit region subtitle","sws_undo") : __LOCALIZE("Edit marker subtitle","sws_undo"), UNDO_STATE_MISCCFG, -1);
@@ -907,6 +965,7 @@ void NotesWnd::Update(bool _force)
 		g_trNote = NULL;
 		g_lastMarkerPos = -1.0;
 		g_lastMarkerRegionId = -1;
+		InvalidateNotesMarkerRegions();
 		_force = true; // trick for RefreshGUI() below..
 	}
 
@@ -1064,8 +1123,7 @@ int NotesWnd::UpdateMkrRgnNameOrSub(int _type)
 		if (_type!=SNM_NOTES_RGN_NAME && _type!=SNM_NOTES_RGN_SUB)
 			mask |= SNM_MARKER_MASK;
 
-		// NF: could use API GetLastMarkerAndCurRegion() instead
-		int id, idx = FindMarkerRegion(NULL, dPos, mask, &id);
+		int id, idx = FindNotesMarkerRegion(dPos, mask, &id);
 		if (id > 0)
 		{
 			if (id != g_lastMarkerRegionId)
@@ -1081,11 +1139,10 @@ int NotesWnd::UpdateMkrRgnNameOrSub(int _type)
 				}
 				else // update subtitle
 				{
-					for (int i=0; i < g_pRegionSubs.Get()->GetSize(); i++)
-						if (g_pRegionSubs.Get()->Get(i)->GetId() == id) {
-							SetText(g_pRegionSubs.Get()->Get(i)->GetNotes());
-							return REQUEST_REFRESH;
-						}
+					if (SNM_RegionSubtitle* sub = g_pRegionSubs.Get()->Find(id)) {
+						SetText(sub->GetNotes());
+						return REQUEST_REFRESH;
+					}
 					g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, id, ""));
 					SetText("");
 				}
@@ -1116,16 +1173,14 @@ void NotesWnd::ForceUpdateMkrRgnNameOrSub(int _type)
 	if (_type != SNM_NOTES_RGN_NAME && _type != SNM_NOTES_RGN_SUB)
 		mask |= SNM_MARKER_MASK;
 
-	int id; FindMarkerRegion(NULL, dPos, mask, &id);
+	int id; FindNotesMarkerRegion(dPos, mask, &id);
 	if (id > 0)
 	{
-		for (int i = 0; i < g_pRegionSubs.Get()->GetSize(); i++)
-			if (g_pRegionSubs.Get()->Get(i)->GetId() == id) {
-				SetText(g_pRegionSubs.Get()->Get(i)->GetNotes());
-				if (g_locked)
-					RefreshGUI();
-				return;
-			}
+		if (SNM_RegionSubtitle* sub = g_pRegionSubs.Get()->Find(id)) {
+			SetText(sub->GetNotes());
+			if (g_locked)
+				RefreshGUI();
+		}
 	}
 }
 
@@ -1281,6 +1336,8 @@ void NotesUpdateJob::Perform() {
 // ScheduledJob because of multi-notifs during project switches (vs CSurfSetTrackListChange)
 void NotesMarkerRegionListener::NotifyMarkerRegionUpdate(int _updateFlags)
 {
+	InvalidateNotesMarkerRegions();
+
 	if (g_notesType>=SNM_NOTES_MKR_SUB && g_notesType<=SNM_NOTES_MKRRGN_SUB)
 	{
 		ScheduledJob::Schedule(new NotesUpdateJob(SNM_SCHEDJOB_ASYNC_DELAY_OPT));
@@ -1297,72 +1354,173 @@ void NotesMarkerRegionListener::NotifyMarkerRegionUpdate(int _updateFlags)
 
 ///////////////////////////////////////////////////////////////////////////////
 
-// import/export subtitle files, only SubRip (.srt) files atm
+// import/export subtitle files: SubRip (.srt) and WebVTT (.vtt) files
 // see http://en.wikipedia.org/wiki/SubRip#Specifications
+// and https://www.w3.org/TR/webvtt1/
 
-bool ImportSubRipFile(const char* _fn)
+struct SubtitleCue
 {
-	bool ok = false;
-	double firstPos = -1.0;
+	int num; // wanted region number, -1 for auto
+	double pos, end;
+	int notesPos; // offset in the notes buffer
+};
 
-	// no need to check extension here, it's done for us
-	if (FILE* f = fopenUTF8(_fn, "rt"))
+// reads a whole line (any length), without the trailing \r\n
+static bool ReadSubtitleLine(FILE* _f, WDL_FastString* _line)
+{
+	_line->Set("");
+	char buf[1024];
+	while (fgets(buf, sizeof(buf), _f))
+	{
+		int len = (int)strlen(buf);
+		const bool eol = len && buf[len-1] == '\n';
+		while (len && (buf[len-1] == '\n' || buf[len-1] == '\r')) len--;
+		_line->Append(buf, len);
+		if (eol) return true;
+	}
+	return _line->GetLength() > 0;
+}
+
+// parses "hh:mm:ss,ttt" (SubRip) or "[hh:]mm:ss.ttt" (WebVTT), returns the position
+// of the next char or NULL if failed
+static const char* ParseSubtitleTime(const char* _str, double* _t)
+{
+	int v[3], nb = 0;
+	const char* p = _str;
+	while (*p == ' ' || *p == '\t') p++;
+	for (;;)
 	{
-		char buf[1024];
-		if (fgets(buf, 4, f) && strcmp("\xEF\xBB\xBF", buf)) // UTF-8 BOM
-			rewind(f);
-		while (fgets(buf, sizeof(buf), f) && *buf)
+		if (!isdigit(*p)) return NULL;
+		v[nb++] = atoi(p);
+		while (isdigit(*p)) p++;
+		if (*p != ':' || nb == 3) break;
+		p++;
+	}
+	if (nb < 2 || (*p != ',' && *p != '.') || !isdigit(p[1]))
+		return NULL;
+	const double ms = atoi(++p);
+	while (isdigit(*p)) p++;
+
+	*_t = (nb == 3 ? v[0]*3600 + v[1]*60 + v[2] : v[0]*60 + v[1]) + ms/1000;
+	return p;
+}
+
+// parses "<start> --> <end> [WebVTT cue settings]"
+static bool ParseSubtitleTiming(const char* _line, double* _pos, double* _end)
+{
+	const char* p = ParseSubtitleTime(_line, _pos);
+	if (!p) return false;
+	while (*p == ' ' || *p == '\t') p++;
+	if (strncmp(p, "-->", 3)) return false;
+	return ParseSubtitleTime(p+3, _end) != NULL;
+}
+
+// streaming parser, cues are added to _cues, their text to _notes (null separated)
+// a cue is an optional identifier line, a timing line and text lines up to the next empty line
+static bool ParseSubtitleFile(const char* _fn, WDL_TypedBuf<SubtitleCue>* _cues, WDL_TypedBuf<char>* _notes)
+{
+	FILE* f = fopenUTF8(_fn, "rt");
+	if (!f)
+		return false;
+
+	WDL_FastString line, id;
+	bool first = true, isVTT = false, skipBlock = false;
+	while (ReadSubtitleLine(f, &line))
+	{
+		const char* l = line.Get();
+		if (first)
 		{
-			if (int num = atoi(buf))
-			{
-				if (fgets(buf, sizeof(buf), f) && *buf)
-				{
-					int p1[4], p2[4];
-					if (sscanf(buf, "%d:%d:%d,%d --> %d:%d:%d,%d", 
-						&p1[0], &p1[1], &p1[2], &p1[3], 
-						&p2[0], &p2[1], &p2[2], &p2[3]) != 8)
-					{
-						break;
-					}
+			if (!strncmp(l, "\xEF\xBB\xBF", 3)) l += 3; // UTF-8 BOM
+			isVTT = !strncmp(l, "WEBVTT", 6);
+			first = false;
+			if (isVTT) { skipBlock = true; continue; } // header block
+		}
 
-					WDL_FastString notes;
-					while (fgets(buf, sizeof(buf), f) && *buf) {
-						if (*buf == '\r' || *buf == '\n') break;
-						notes.Append(buf);
-					}
-          
-					WDL_String name(notes.Get());
-					char *p=name.Get();
-					while (*p) {
-						if (*p == '\r' || *p == '\n') *p=' ';
-						p++;
-					}
-					name.Ellipsize(0, 64); // 64 = native max mkr/rgn name length
+		if (!*l) { skipBlock = false; id.Set(""); continue; }
+		if (skipBlock) continue;
 
-					num = AddProjectMarker(NULL, true,
-						p1[0]*3600 + p1[1]*60 + p1[2] + double(p1[3])/1000, 
-						p2[0]*3600 + p2[1]*60 + p2[2] + double(p2[3])/1000, 
-						name.Get(), num);
+		// WebVTT comment, style and region blocks
+		if (isVTT && !id.GetLength() && (!strncmp(l, "NOTE", 4) || !strncmp(l, "STYLE", 5) || !strncmp(l, "REGION", 6)) && !strstr(l, "-->"))
+		{
+			skipBlock = true;
+			continue;
+		}
 
-					if (num >= 0)
-					{
-						ok = true; // region added (at least)
+		SubtitleCue cue;
+		if (!strstr(l, "-->") || !ParseSubtitleTiming(l, &cue.pos, &cue.end))
+		{
+			// cue identifier (number for SubRip files) or junk
+			if (!id.GetLength()) id.Set(l);
+			else skipBlock = true;
+			continue;
+		}
 
-						if (firstPos < 0.0)
-							firstPos = p1[0]*3600 + p1[1]*60 + p1[2] + double(p1[3])/1000;
+		cue.num = atoi(id.Get());
+		if (cue.num <= 0) cue.num = -1;
+		cue.notesPos = _notes->GetSize();
 
-						int id = MakeMarkerRegionId(num, true);
-						if (id > 0) // add the sub, no duplicate mgmt..
-							g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, id, notes.Get()));
-					}
-				}
-				else
-					break;
+		// text lines, up to the next empty line
+		int len = 0;
+		while (ReadSubtitleLine(f, &line) && line.GetLength())
+		{
+			if (char* p = _notes->Resize(cue.notesPos + len + line.GetLength() + 1, false))
+			{
+				memcpy(p + cue.notesPos + len, line.Get(), line.GetLength());
+				len += line.GetLength();
+				p[cue.notesPos + len++] = '\n';
 			}
 		}
-		fclose(f);
+		if (char* p = _notes->Resize(cue.notesPos + len + 1, false))
+			p[cue.notesPos + len] = '\0';
+
+		_cues->Add(cue);
+		id.Set("");
 	}
-	
+	fclose(f);
+	return true;
+}
+
+bool ImportSubRipFile(const char* _fn)
+{
+	WDL_TypedBuf<SubtitleCue> cues;
+	WDL_TypedBuf<char> notes;
+	if (!ParseSubtitleFile(_fn, &cues, &notes) || !cues.GetSize())
+		return false;
+
+	bool ok = false;
+	double firstPos = -1.0;
+
+	// all regions are created in one go
+	PreventUIRefresh(1);
+	WDL_String name;
+	for (int i=0; i < cues.GetSize(); i++)
+	{
+		const SubtitleCue* cue = cues.Get()+i;
+		const char* cueNotes = notes.Get() + cue->notesPos;
+
+		name.Set(cueNotes);
+		char *p=name.Get();
+		while (*p) {
+			if (*p == '\r' || *p == '\n') *p=' ';
+			p++;
+		}
+		name.Ellipsize(0, 64); // 64 = native max mkr/rgn name length
+
+		int num = AddProjectMarker(NULL, true, cue->pos, cue->end, name.Get(), cue->num);
+		if (num >= 0)
+		{
+			ok = true; // region added (at least)
+
+			if (firstPos < 0.0)
+				firstPos = cue->pos;
+
+			int id = MakeMarkerRegionId(num, true);
+			if (id > 0) // add or update the sub
+				g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, id, cueNotes));
+		}
+	}
+	PreventUIRefresh(-1);
+
 	if (ok)
 	{
 		UpdateTimeline(); // redraw the ruler (andd arrange view)
@@ -1387,48 +1545,54 @@ void ImportSubTitleFile(COMMAND_T* _ct)
 	}
 }
 
+// exports WebVTT if _fn has a .vtt extension, SubRip otherwise
 bool ExportSubRipFile(const char* _fn)
 {
-	if (FILE* f = fopenUTF8(_fn, "wt"))
+	const bool isVTT = HasFileExtension(_fn, "VTT");
+
+	// single enumeration: markers end at the next marker/region start
+	struct MkrRgn { double p1, p2; int num; bool isRgn; };
+	WDL_TypedBuf<MkrRgn> mkrRgns;
+	MkrRgn mr;
+	int x=0;
+	while ((x = EnumProjectMarkers2(NULL, x, &mr.isRgn, &mr.p1, &mr.p2, NULL, &mr.num)))
+		mkrRgns.Add(mr);
+
+	WDL_FastString subs;
+	if (isVTT)
+		subs.Set("WEBVTT\n\n");
+
+	int subIdx=1;
+	for (int i=0; i < mkrRgns.GetSize(); i++)
 	{
-		WDL_FastString subs;
-		int x=0, subIdx=1, num; bool isRgn; double p1, p2;
-		while ((x = EnumProjectMarkers2(NULL, x, &isRgn, &p1, &p2, NULL, &num)))
-		{
-			// special case for markers: end position = next start position
-			if (!isRgn)
-			{
-				int x2=x;
-				if (!EnumProjectMarkers2(NULL, x2, NULL, &p2 /* <- the trick */, NULL, NULL, NULL))
-					p2 = p1 + 5.0; // best effort..
-			}
-
-			int id = MakeMarkerRegionId(num, isRgn);
-			if (id > 0)
-			{
-				for (int i=0; i < g_pRegionSubs.Get()->GetSize(); i++)
-				{
-					SNM_RegionSubtitle* rn = g_pRegionSubs.Get()->Get(i);
-					if (rn->GetId() == id)
-					{
-						subs.AppendFormatted(64, "%d\n", subIdx++); // subs have their own indexes
-						
-						int h, m, s, ms;
-						TranslatePos(p1, &h, &m, &s, &ms);
-						subs.AppendFormatted(64,"%02d:%02d:%02d,%03d --> ",h,m,s,ms);
-						TranslatePos(p2, &h, &m, &s, &ms);
-						subs.AppendFormatted(64,"%02d:%02d:%02d,%03d\n",h,m,s,ms);
-
-						subs.Append(rn->GetNotes());
-						if (rn->GetNotesLength() && rn->GetNotes()[rn->GetNotesLength()-1] != '\n')
-							subs.Append("\n");
-						subs.Append("\n");
-					}
-				}
-			}
-		}
+		const MkrRgn* m = mkrRgns.Get()+i;
+		SNM_RegionSubtitle* rn = g_pRegionSubs.Get()->Find(MakeMarkerRegionId(m->num, m->isRgn));
+		if (!rn)
+			continue;
+
+		// special case for markers: end position = next start position
+		double p2 = m->p2;
+		if (!m->isRgn)
+			p2 = i+1 < mkrRgns.GetSize() ? mkrRgns.Get()[i+1].p1 : m->p1 + 5.0; // best effort..
+
+		subs.AppendFormatted(64, "%d\n", subIdx++); // subs have their own indexes
+
+		const char sep = isVTT ? '.' : ',';
+		int h, mn, s, ms;
+		TranslatePos(m->p1, &h, &mn, &s, &ms);
+		subs.AppendFormatted(64,"%02d:%02d:%02d%c%03d --> ",h,mn,s,sep,ms);
+		TranslatePos(p2, &h, &mn, &s, &ms);
+		subs.AppendFormatted(64,"%02d:%02d:%02d%c%03d\n",h,mn,s,sep,ms);
+
+		subs.Append(rn->GetNotes());
+		if (rn->GetNotesLength() && rn->GetNotes()[rn->GetNotesLength()-1] != '\n')
+			subs.Append("\n");
+		subs.Append("\n");
+	}
 
-		if (subs.GetLength())
+	if (subIdx > 1)
+	{
+		if (FILE* f = fopenUTF8(_fn, "wt"))
 		{
 			fputs(subs.Get(), f);
 			fclose(f);
@@ -1552,7 +1716,7 @@ static void SaveExtensionConfig(ProjectStateContext *ctx, bool isUndo, struct pr
 						StringToExtensionConfig(&formatedNotes, ctx);
 			}
 			else
-				g_SNM_TrackNotes.Get()->Delete(i--, true);
+				g_SNM_TrackNotes.Get()->Delete(i--);
 		}
 	}
 
@@ -1576,7 +1740,7 @@ static void SaveExtensionConfig(ProjectStateContext *ctx, bool isUndo, struct pr
 			}
 			else
 			{
-				g_pRegionSubs.Get()->Delete(i--, true);
+				g_pRegionSubs.Get()->Delete(i--);
 			}
 		}
 	}
@@ -1588,10 +1752,10 @@ static void BeginLoadProjectState(bool isUndo, struct project_config_extension_t
 	g_prjNotes.Get()->Set("");
 
 	g_SNM_TrackNotes.Cleanup();
-	g_SNM_TrackNotes.Get()->Empty(true);
+	g_SNM_TrackNotes.Get()->Empty();
 
 	g_pRegionSubs.Cleanup();
-	g_pRegionSubs.Get()->Empty(true);
+	g_pRegionSubs.Get()->Empty();
 
 	// g_globalNotes is loaded in NotesInit()
 }
@@ -1742,75 +1906,101 @@ void NF_SetSWSTrackNotes(MediaTrack* track, const char* buf)
 
 const char* NFDoGetSWSMarkerRegionSub(int mkrRgnIdxNumberIn)
 {
-	// maybe more safe version, but below also seems to work and is faster
-	/*
-	int idx = 0, num; 
-
-	while ((idx = EnumProjectMarkers2(NULL, idx, NULL, NULL, NULL, NULL, &num)))
-	{
-		// mkrRgn exists in project
-		if (idx-1 == mkrRgnIdxNumberIn)
-		{
-			int mkrRgnId = GetMarkerRegionIdFromIndex(NULL, idx-1); // takes zero-based idx
-			for (int i = 0; i < g_pRegionSubs.Get()->GetSize(); i++)
-			{
-				// regionSub exists
-				if (mkrRgnId == g_pRegionSubs.Get()->Get(i)->GetId())
-				{
-					mkrRgnSubOut->Set(g_pRegionSubs.Get()->Get(i)->GetNotes());
-					return mkrRgnSubOut->Get();
-				}
-			}
-		}
-	}
-	*/
-	
 	int mkrRgnId = GetMarkerRegionIdFromIndex(NULL, mkrRgnIdxNumberIn); // takes zero-based idx
 	if (mkrRgnId == -1) return "";
 
-	for (int i = 0; i < g_pRegionSubs.Get()->GetSize(); i++)
+	SNM_RegionSubtitle* sub = g_pRegionSubs.Get()->Find(mkrRgnId);
+	return sub ? sub->GetNotes() : "";
+}
+
+bool NFDoSetSWSMarkerRegionSub(const char* mkrRgnSubIn, int mkrRgnIdxNumberIn)
+{
+	int mkrRgnId = GetMarkerRegionIdFromIndex(NULL, mkrRgnIdxNumberIn); // takes zero-based idx
+	if (mkrRgnId == -1) // mkrRgn isn't present in project
+		return false;
+
+	// add or update the mkrRgn sub
+	g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, mkrRgnId, mkrRgnSubIn));
+	return true;
+}
+
+// bulk versions: one "markerRegionIdx<TAB>subtitle" line per marker/region subtitle,
+// line breaks and backslashes are escaped in subtitles (\n, \r, \\)
+int NFDoGetSWSMarkerRegionSubs(WDL_FastString* mkrRgnSubsOut)
+{
+	mkrRgnSubsOut->Set("");
+
+	int x=0, num, count=0; bool isRgn;
+	while ((x = EnumProjectMarkers2(NULL, x, &isRgn, NULL, NULL, NULL, &num)))
 	{
-		// mkrRgn sub exists
-		if (mkrRgnId == g_pRegionSubs.Get()->Get(i)->GetId())
+		SNM_RegionSubtitle* sub = g_pRegionSubs.Get()->Find(MakeMarkerRegionId(num, isRgn));
+		if (!sub || !sub->GetNotesLength())
+			continue;
+
+		mkrRgnSubsOut->AppendFormatted(16, "%d\t", x-1);
+		for (const char* p = sub->GetNotes(); *p; p++)
 		{
-			return g_pRegionSubs.Get()->Get(i)->GetNotes();
+			switch (*p)
+			{
+				case '\n': mkrRgnSubsOut->Append("\\n"); break;
+				case '\r': mkrRgnSubsOut->Append("\\r"); break;
+				case '\\': mkrRgnSubsOut->Append("\\\\"); break;
+				default: mkrRgnSubsOut->Append(p, 1); break;
+			}
 		}
+		mkrRgnSubsOut->Append("\n");
+		count++;
 	}
-
-	return "";
+	return count;
 }
 
-bool NFDoSetSWSMarkerRegionSub(const char* mkrRgnSubIn, int mkrRgnIdxNumberIn)
+int NFDoSetSWSMarkerRegionSubs(const char* mkrRgnSubsIn)
 {
-	int idx = 0; bool mkrRgnExists = false;
-	
-	while ((idx = EnumProjectMarkers2(NULL, idx, NULL, NULL, NULL, NULL, NULL)))
+	if (!mkrRgnSubsIn)
+		return 0;
+
+	// marker/region IDs by index
+	WDL_TypedBuf<int> ids;
+	int x=0, num; bool isRgn;
+	while ((x = EnumProjectMarkers2(NULL, x, &isRgn, NULL, NULL, NULL, &num)))
+		ids.Add(MakeMarkerRegionId(num, isRgn));
+
+	int count=0;
+	WDL_FastString sub;
+	const char* p = mkrRgnSubsIn;
+	while (*p)
 	{
-		if (idx - 1 == mkrRgnIdxNumberIn) // mkrRegion exists in project
+		const int idx = atoi(p);
+		const char* tab = p;
+		while (*tab && *tab != '\t' && *tab != '\n') tab++;
+
+		sub.Set("");
+		const char* q = *tab == '\t' ? tab+1 : tab;
+		for (; *q && *q != '\n'; q++)
 		{
-			mkrRgnExists = true;
-		
-			int mkrRgnId = GetMarkerRegionIdFromIndex(NULL, idx - 1); // takes zero-based idx
-			for (int i = 0; i < g_pRegionSubs.Get()->GetSize(); i++)
+			if (*q == '\r') continue;
+			if (*q == '\\' && q[1])
 			{
-				if (mkrRgnId == g_pRegionSubs.Get()->Get(i)->GetId()) // mkrRgn sub exists, update it
+				switch (*(++q))
 				{
-					g_pRegionSubs.Get()->Get(i)->SetNotes(mkrRgnSubIn);
-					return true;
+					case 'n': sub.Append("\n"); break;
+					case 'r': sub.Append("\r"); break;
+					default: sub.Append(q, 1); break;
 				}
 			}
+			else
+				sub.Append(q, 1);
+		}
 
-			// mkrRgn sub doesn't exist but marker/region is present in project, add new mkrRgn sub
-			if (mkrRgnExists)
-			{
-				g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, mkrRgnId, mkrRgnSubIn));
-				return true;
-			}
-			else // mkrRgn isn't present in project
-				return false;
+		if (*tab == '\t' && idx >= 0 && idx < ids.GetSize() && ids.Get()[idx] >= 0)
+		{
+			g_pRegionSubs.Get()->Add(new SNM_RegionSubtitle(nullptr, ids.Get()[idx], sub.Get()));
+			count++;
 		}
+		p = *q ? q+1 : q;
 	}
-	return false; // appease compilers
+
+	return count;
 }
 
 void NF_DoUpdateSWSMarkerRegionSubWindow()
@@ -69,6 +69,7 @@ public:
 
 	MediaTrack* GetTrack() { return GuidToTrack(m_project, &m_guid); }
 	const GUID* GetGUID() { return &m_guid; }
+	GUID GetKey() const { return m_guid; }
 	const char *GetNotes() const { return m_notes.Get(); }
 	int GetNotesLength() const { return m_notes.GetLength(); }
 	void SetNotes(const char *notes) { m_notes.Set(notes); }
@@ -89,6 +90,7 @@ public:
 	}
 
 	int GetId() const { return m_id; }
+	int GetKey() const { return m_id; }
 	bool IsValid() const { return GetMarkerRegionIndexFromId(m_project, m_id) >= 0; }
 	const char *GetNotes() const { return m_notes.Get(); }
 	int GetNotesLength() const { return m_notes.GetLength(); }
@@ -100,6 +102,52 @@ private:
 	WDL_FastString m_notes;
 };
 
+// Owns notes in insertion (i.e. saving) order + index by key (track GUID, marker/region ID)
+// Adding notes for an existing key updates the existing notes
+template <class KEY, class NOTES> class SNM_NotesList
+{
+public:
+	SNM_NotesList(int (*_keycmp)(KEY*, KEY*)) : m_index(_keycmp) {}
+	int GetSize() const { return m_notes.GetSize(); }
+	NOTES* Get(int _i) const { return m_notes.Get(_i); }
+	NOTES* Find(KEY _key) { return m_index.Get(_key, NULL); }
+	NOTES* Add(NOTES* _notes)
+	{
+		if (NOTES* n = Find(_notes->GetKey())) {
+			n->SetNotes(_notes->GetNotes());
+			delete _notes;
+			return n;
+		}
+		m_index.Insert(_notes->GetKey(), _notes);
+		return m_notes.Add(_notes);
+	}
+	void Delete(int _i)
+	{
+		if (NOTES* n = m_notes.Get(_i)) {
+			m_index.Delete(n->GetKey());
+			m_notes.Delete(_i, true);
+		}
+	}
+	void Empty() { m_index.DeleteAll(); m_notes.Empty(true); }
+private:
+	WDL_PtrList_DOD<NOTES> m_notes;
+	WDL_AssocArray<KEY, NOTES*> m_index;
+};
+
+class SNM_TrackNotesList : public SNM_NotesList<GUID, SNM_TrackNotes> {
+public:
+	SNM_TrackNotesList() : SNM_NotesList(CompareGuids) {}
+private:
+	static int CompareGuids(GUID* _a, GUID* _b) { return memcmp(_a, _b, sizeof(GUID)); }
+};
+
+class SNM_RegionSubtitleList : public SNM_NotesList<int, SNM_RegionSubtitle> {
+public:
+	SNM_RegionSubtitleList() : SNM_NotesList(CompareIds) {}
+private:
+	static int CompareIds(int* _a, int* _b) { return *_a < *_b ? -1 : *_a > *_b ? 1 : 0; }
+};
+
 class NotesUpdateJob : public ScheduledJob {
 public:
 	NotesUpdateJob(int _approxMs) : ScheduledJob(SNM_SCHEDJOB_NOTES_UPDATE, _approxMs) {}
@@ -210,6 +258,8 @@ void NF_SetSWSTrackNotes(MediaTrack*, const char* buf);
 
 const char* NFDoGetSWSMarkerRegionSub(int mkrRgnIdx);
 bool NFDoSetSWSMarkerRegionSub(const char* mkrRgnSubIn, int mkrRgnIdx);
+int NFDoGetSWSMarkerRegionSubs(WDL_FastString* mkrRgnSubsOut);
+int NFDoSetSWSMarkerRegionSubs(const char* mkrRgnSubsIn);
 void NF_DoUpdateSWSMarkerRegionSubWindow();
 
 const char* JB_GetSWSExtraProjectNotes(ReaProject* project);
@@ -36,7 +36,9 @@ PlaylistIconManager* PlaylistIconManager::s_instance = NULL;
 ///////////////////////////////////////////////////////////////////////////////
 
 PlaylistIconManager::PlaylistIconManager()
+    : m_useCounter(0)
 {
+    memset(m_iconCache, 0, sizeof(m_iconCache));
 }
 
 PlaylistIconManager::~PlaylistIconManager()
@@ -60,7 +62,7 @@ void PlaylistIconManager::DestroyInstance()
     }
 }
 
-LICE_IBitmap* PlaylistIconManager::GetIcon(IconType type, int size)
+LICE_IBitmap* PlaylistIconManager::GetIcon(IconType type, int size, int color, int dpiScale)
 {
     // TASK 11.2: Validate icon type
     if (type < 0 || type >= ICON_TYPE_COUNT) {
@@ -77,44 +79,37 @@ LICE_IBitmap* PlaylistIconManager::GetIcon(IconType type, int size)
         #endif
         size = 16; // Default to 16x16
     }
+    if (dpiScale < 128 || dpiScale > 1024) {
+        dpiScale = 256; // 100%
+    }
 
-    // Check cache
-    int key = GetCacheKey(type, size);
-
-    // TASK 11.1: Validate cache entries before accessing
-    for (int i = 0; i < m_iconCache.GetSize(); i++) {
-        CacheEntry* entry = m_iconCache.Get(i);
-        if (entry && entry->key == key && entry->bitmap) {
+    // Check cache: O(1), only the ways of the key's set are searched
+    CacheEntry* set = m_iconCache[GetCacheSet(type, size, color, dpiScale)];
+    CacheEntry* lru = &set[0];
+    for (int i = 0; i < CACHE_WAYS; i++) {
+        CacheEntry* entry = &set[i];
+        if (entry->bitmap && entry->type == type && entry->size == size &&
+            entry->color == color && entry->dpiScale == dpiScale)
+        {
+            entry->lastUse = ++m_useCounter;
             return entry->bitmap;
         }
+        if (!entry->bitmap || (lru->bitmap && entry->lastUse < lru->lastUse)) {
+            lru = entry;
+        }
     }
 
     // TASK 11.3: Handle icon generation failure gracefully
-    // Generate icon if not in cache
-    LICE_IBitmap* icon = GenerateIcon(type, size);
+    // Generate icon if not in cache, evicting the least recently used one of the set
+    LICE_IBitmap* icon = GenerateIcon(type, (size * dpiScale) >> 8, color);
     if (icon) {
-        // TASK 11.3: Handle cache entry creation failure
-        #ifdef _DEBUG
-        try {
-        #endif
-            CacheEntry* entry = new CacheEntry();
-            if (entry) {
-                entry->key = key;
-                entry->bitmap = icon;
-                m_iconCache.Add(entry);
-            } else {
-                #ifdef _DEBUG
-                OutputDebugString("PlaylistIconManager::GetIcon - Failed to create cache entry\n");
-                #endif
-                // Still return the icon even if caching failed
-            }
-        #ifdef _DEBUG
-        }
-        catch (...) {
-            OutputDebugString("PlaylistIconManager::GetIcon - Exception during cache entry creation\n");
-            // Still return the icon even if caching failed
-        }
-        #endif
+        delete lru->bitmap;
+        lru->type = type;
+        lru->size = size;
+        lru->color = color;
+        lru->dpiScale = dpiScale;
+        lru->lastUse = ++m_useCounter;
+        lru->bitmap = icon;
     } else {
         #ifdef _DEBUG
         OutputDebugString("PlaylistIconManager::GetIcon - Failed to generate icon\n");
@@ -124,7 +119,7 @@ LICE_IBitmap* PlaylistIconManager::GetIcon(IconType type, int size)
     return icon;
 }
 
-void PlaylistIconManager::DrawIcon(LICE_IBitmap* dest, IconType type, int x, int y, int size, int color)
+void PlaylistIconManager::DrawIcon(LICE_IBitmap* dest, IconType type, int x, int y, int size, int color, int dpiScale)
 {
     // TASK 11.1: Null pointer check
     if (!dest) {
@@ -135,16 +130,10 @@ void PlaylistIconManager::DrawIcon(LICE_IBitmap* dest, IconType type, int x, int
     }
 
     // TASK 11.1: Check if icon is available
-    LICE_IBitmap* icon = GetIcon(type, size);
+    // Icons are cached in their final color and size: a straight alpha blit
+    LICE_IBitmap* icon = GetIcon(type, size, color, dpiScale);
     if (icon) {
-        if (color == -1) {
-            // Use original icon colors
-            LICE_Blit(dest, icon, x, y, 0, 0, size, size, 1.0f, LICE_BLIT_MODE_COPY | LICE_BLIT_USE_ALPHA);
-        } else {
-            // Apply color tint
-            LICE_Blit(dest, icon, x, y, 0, 0, size, size, 1.0f, LICE_BLIT_MODE_COPY | LICE_BLIT_USE_ALPHA);
-            // TODO: Implement color tinting if needed
-        }
+        LICE_Blit(dest, icon, x, y, 0, 0, icon->getWidth(), icon->getHeight(), 1.0f, LICE_BLIT_MODE_COPY | LICE_BLIT_USE_ALPHA);
     } else {
         #ifdef _DEBUG
         OutputDebugString("PlaylistIconManager::DrawIcon - Failed to get icon\n");
@@ -157,19 +146,16 @@ void PlaylistIconManager::DrawIcon(LICE_IBitmap* dest, IconType type, int x, int
 
 void PlaylistIconManager::ClearCache()
 {
-    for (int i = 0; i < m_iconCache.GetSize(); i++) {
-        CacheEntry* entry = m_iconCache.Get(i);
-        if (entry) {
-            if (entry->bitmap) {
-                delete entry->bitmap;
-            }
-            delete entry;
+    for (int i = 0; i < CACHE_SETS; i++) {
+        for (int j = 0; j < CACHE_WAYS; j++) {
+            delete m_iconCache[i][j].bitmap;
         }
     }
-    m_iconCache.Empty();
+    memset(m_iconCache, 0, sizeof(m_iconCache));
+    m_useCounter = 0;
 }
 
-LICE_IBitmap* PlaylistIconManager::GenerateIcon(IconType type, int size)
+LICE_IBitmap* PlaylistIconManager::GenerateIcon(IconType type, int size, int color)
 {
     // TASK 11.3: Handle bitmap creation failure
     LICE_IBitmap* bm = new LICE_MemBitmap(size, size);
@@ -188,7 +174,9 @@ LICE_IBitmap* PlaylistIconManager::GenerateIcon(IconType type, int size)
         LICE_Clear(bm, LICE_RGBA(0, 0, 0, 0));
 
         // Default color (white)
-        int color = LICE_RGBA(255, 255, 255, 255);
+        if (color == -1) {
+            color = LICE_RGBA(255, 255, 255, 255);
+        }
 
         // Generate specific icon
         switch (type) {
@@ -387,7 +375,11 @@ void PlaylistIconManager::GenerateSyncLossIcon(LICE_IBitmap* bm, int size, int c
     }
 }
 
-int PlaylistIconManager::GetCacheKey(IconType type, int size) const
+int PlaylistIconManager::GetCacheSet(IconType type, int size, int color, int dpiScale) const
 {
-    return (type << 16) | size;
+    unsigned int h = (unsigned int)type * 0x9E3779B1u;
+    h = (h ^ (unsigned int)size) * 0x85EBCA6Bu;
+    h = (h ^ (unsigned int)color) * 0xC2B2AE35u;
+    h = (h ^ (unsigned int)dpiScale) * 0x27D4EB2Fu;
+    return (int)((h >> 16) % CACHE_SETS);
 }
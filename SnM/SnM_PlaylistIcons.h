@@ -47,14 +47,18 @@
  * - ICON_SYNC_LOSS: Red X in circle
  *
  * CACHING:
- * Icons are cached by type and size. Cache is cleared when:
+ * Icons are cached by type, size, color and DPI scale, in their final
+ * color and pixel size. The cache has a fixed size (CACHE_SETS x CACHE_WAYS
+ * set-associative, least recently used icon of a set is evicted).
+ * Cache is cleared when:
  * - Theme changes (to regenerate with new colors)
  * - Explicitly requested via ClearCache()
  *
  * PERFORMANCE:
  * - Icon caching eliminates repeated generation (Task 9.1)
- * - Fast lookup by cache key (type << 16 | size)
- * - Minimal memory overhead (only generated sizes are cached)
+ * - O(1) lookup: hashed set, CACHE_WAYS entries compared at most
+ * - Drawing is a single alpha blit, no tinting nor scaling
+ * - Bounded memory, whatever the number of colors/sizes/DPI scales used
  *
  * REQUIREMENTS:
  * Satisfies requirements 2.1-2.5 from the specification.
@@ -133,16 +137,20 @@ public:
     /**
      * GetIcon - Retrieves or generates an icon
      * @param type Icon type to get
-     * @param size Icon size in pixels (8-128 range, default 16)
+     * @param size Icon size (8-128 range, default 16)
+     * @param color Icon color (-1 for original colors)
+     * @param dpiScale DPI scale, 256 = 100% (the bitmap is size*dpiScale/256 pixels)
      * @return Pointer to icon bitmap, or NULL if generation failed
      *
      * Returns cached icon if available, otherwise generates and caches it.
      * Validates type and size parameters.
+     * The returned bitmap is owned by the cache and may be evicted by the
+     * next GetIcon() call: do not keep it.
      *
      * PERFORMANCE: Cached icons are returned immediately (Task 9.1)
      * REQUIREMENTS: Satisfies Req 2.1, 2.2, 2.3, 2.5
      */
-    LICE_IBitmap* GetIcon(IconType type, int size = 16);
+    LICE_IBitmap* GetIcon(IconType type, int size = 16, int color = -1, int dpiScale = 256);
 
     /**
      * DrawIcon - Draws an icon to a bitmap
@@ -150,15 +158,16 @@ public:
      * @param type Icon type to draw
      * @param x X coordinate
      * @param y Y coordinate
-     * @param size Icon size in pixels (8-128 range, default 16)
-     * @param color Optional color tint (-1 for original colors)
+     * @param size Icon size (8-128 range, default 16)
+     * @param color Optional color (-1 for original colors)
+     * @param dpiScale DPI scale, 256 = 100%
      *
      * Convenience method that gets the icon and blits it to the destination.
      * Falls back to simple placeholder if icon is unavailable.
      *
      * REQUIREMENTS: Satisfies Req 2.1, 2.2, 2.3, 2.5
      */
-    void DrawIcon(LICE_IBitmap* dest, IconType type, int x, int y, int size = 16, int color = -1);
+    void DrawIcon(LICE_IBitmap* dest, IconType type, int x, int y, int size = 16, int color = -1, int dpiScale = 256);
 
     /**
      * ClearCache - Clears all cached icons
@@ -193,12 +202,13 @@ private:
      * GenerateIcon - Generates an icon bitmap
      * @param type Icon type to generate
      * @param size Icon size in pixels
+     * @param color Icon color (-1 for original colors)
      * @return Pointer to generated bitmap, or NULL if generation failed
      *
      * Creates a new bitmap and calls the appropriate generation method.
      * Handles bitmap creation failures gracefully.
      */
-    LICE_IBitmap* GenerateIcon(IconType type, int size);
+    LICE_IBitmap* GenerateIcon(IconType type, int size, int color);
 
     /**
      * GeneratePlayIcon - Generates play icon (triangle)
@@ -266,28 +276,29 @@ private:
     void GenerateSyncLossIcon(LICE_IBitmap* bm, int size, int color);
 
     /**
-     * GetCacheKey - Generates cache key from type and size
-     * @param type Icon type
-     * @param size Icon size
-     * @return Cache key (type << 16 | size)
-     *
-     * Combines type and size into a single integer key for fast lookup.
+     * GetCacheSet - Returns the cache set of an icon
+     * @return Set index (hash of type, size, color and DPI scale)
      */
-    int GetCacheKey(IconType type, int size) const;
+    int GetCacheSet(IconType type, int size, int color, int dpiScale) const;
+
+    enum { CACHE_SETS = 16, CACHE_WAYS = 4 };
 
     /**
      * CacheEntry
      *
-     * Represents a cached icon bitmap.
-     * - key: Cache key (type << 16 | size)
-     * - bitmap: Generated icon bitmap
+     * Represents a cached icon bitmap, in its final color and pixel size.
+     * - type, size, color, dpiScale: Cache key
+     * - lastUse: Use counter value of the last lookup (LRU eviction)
+     * - bitmap: Generated icon bitmap, NULL for free entries
      */
     struct CacheEntry {
-        int key;                // Cache key for lookup
-        LICE_IBitmap* bitmap;   // Cached icon bitmap
+        int type, size, color, dpiScale;
+        unsigned int lastUse;
+        LICE_IBitmap* bitmap;
     };
 
-    WDL_PtrList<CacheEntry> m_iconCache;  // Icon cache (Task 9.1)
+    CacheEntry m_iconCache[CACHE_SETS][CACHE_WAYS];  // Icon cache (Task 9.1)
+    unsigned int m_useCounter;
 
     static PlaylistIconManager* s_instance;  // Singleton instance
 };
@@ -28,6 +28,7 @@
 #include "stdafx.h"
 #include "SnM_PlaylistTheme.h"
 #include "SnM_PlaylistIcons.h"
+#include "SnM_ModernPlaylistUI.h"
 #include "SnM_Dlg.h"
 
 // Static instance
@@ -448,6 +449,9 @@ void PlaylistTheme::InitializeFontsWithSizes(const FontSizes& sizes)
 
 void PlaylistTheme::CleanupFonts()
 {
+    // Cached text layouts and glyphs are keyed by font
+    PlaylistTextCache::OnFontsDeleted();
+
     // TASK 11.3: Safe cleanup with try-catch
     #ifdef _DEBUG
     try {
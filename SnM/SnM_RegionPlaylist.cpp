@@ -2513,6 +2513,7 @@ void RegionPlaylistExit()
 
 	DELETE_NULL(g_osc);
 	g_rgnplWndMgr.Delete();
+	PlaylistTextCache::DestroyInstance();
 }
 
 void OpenRegionPlaylist(COMMAND_T*)
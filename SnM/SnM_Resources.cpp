@@ -54,6 +54,7 @@
 #define RES_INI_SEC					"Resources"
 
 #define RES_TIE_TAG					" [x]" //UTF8_BULLET
+#define RES_INDEX_REFRESH_MS		5000 // ReaScript: min. delay between content index refreshes
 
 
 enum {
@@ -82,6 +83,7 @@ enum {
   FILTER_BY_NAME_MSG,
   FILTER_BY_PATH_MSG,
   FILTER_BY_COMMENT_MSG,
+  FILTER_BY_CONTENT_MSG,
   RENAME_MSG,
   TIE_ACTIONS_MSG,
   TIE_PROJECT_MSG,
@@ -215,7 +217,7 @@ int g_resType = -1; // current type (user selection)
 int g_tiedSlotActions[SNM_NUM_DEFAULT_SLOTS]; // slot actions of default type/idx are tied to type/value
 int g_dblClickPrefs[SNM_MAX_SLOT_TYPES];
 WDL_FastString g_filter; // see init + localization in ResourcesInit()
-int g_filterPref = 1; // bitmask: &1 = filter by name, &2 = filter by path, &4 = filter by comment
+int g_filterPref = 1; // bitmask: &1 = filter by name, &2 = filter by path, &4 = filter by comment, &8 = filter by content
 WDL_PtrList_DOD<WDL_FastString> g_autoSaveDirs;
 WDL_PtrList_DOD<WDL_FastString> g_autoFillDirs;
 WDL_PtrList_DOD<WDL_FastString> g_tiedProjects;
@@ -238,6 +240,11 @@ ReaProject* g_curProject = NULL;
 // for next/prev project actions
 int g_prjCurSlot = -1; // 0-based
 
+// content index, see below
+void ResourceContentIndexRefresh();
+void ResourceContentIndexUpdate();
+void SearchResourceContent(const char* _query, WDL_StringKeyedArray<bool>* _filesOut);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Helpers
@@ -387,7 +394,7 @@ void UntieAllResFileFromProject(ReaProject* _prj, const char* _prjPath, int _typ
 ///////////////////////////////////////////////////////////////////////////////
 
 ResourceList::ResourceList(const char* _resDir, const char* _name, const char* _ext, int _flags)
-	: m_name(_name), m_ext(_ext), m_flags(_flags), WDL_PtrList<ResourceItem>()
+	: m_name(_name), m_ext(_ext), m_flags(_flags), m_pathIdx(false), m_pathIdxOk(false), WDL_PtrList<ResourceItem>()
 {
 	char tmp[512]="";
 
@@ -433,14 +440,24 @@ ResourceList::ResourceList(const char* _resDir, const char* _name, const char* _
 }
 
 // _path: short resource path or full path
+// note: the only slot update that keeps the path index in sync
 ResourceItem* ResourceList::AddSlot(const char* _path, const char* _desc)
 {
-	return Add(new ResourceItem(GetShortResourcePath(m_resDir.Get(), _path), _desc));
+	ResourceItem* item = Add(new ResourceItem(GetShortResourcePath(m_resDir.Get(), _path), _desc));
+	if (m_pathIdxOk && item && !item->IsDefault())
+	{
+		char fullpath[SNM_MAX_PATH];
+		GetFullResourcePath(m_resDir.Get(), item->m_shortPath.Get(), fullpath, sizeof(fullpath));
+		if (!m_pathIdx.Exists(fullpath))
+			m_pathIdx.Insert(fullpath, GetSize()-1);
+	}
+	return item;
 }
 
 // _path: short resource path or full path
 ResourceItem* ResourceList::InsertSlot(int _slot, const char* _path, const char* _desc)
 {
+	ReleasePathIndex();
 	ResourceItem* item = NULL;
 	const char* shortPath = GetShortResourcePath(m_resDir.Get(), _path);
 	if (_slot >=0 && _slot < GetSize())
@@ -452,6 +469,9 @@ ResourceItem* ResourceList::InsertSlot(int _slot, const char* _path, const char*
 
 int ResourceList::FindByPath(const char* _fullPath)
 {
+	if (m_pathIdxOk)
+		return _fullPath ? m_pathIdx.Get(_fullPath, -1) : -1;
+
 	char fullpath[SNM_MAX_PATH];
 	if (_fullPath)
 		for (int i=0; i<GetSize(); i++)
@@ -461,6 +481,23 @@ int ResourceList::FindByPath(const char* _fullPath)
 	return -1;
 }
 
+// indexes slots by full path so that FindByPath() is not a linear search
+// anymore, for batch updates (e.g. auto-fill of large directories)
+// important: the index is only kept in sync by AddSlot(), i.e. callers must 
+// call ReleasePathIndex() when done with their batch (slots are updated from 
+// many places and lots of them do not go through ResourceList's methods)
+void ResourceList::BuildPathIndex()
+{
+	m_pathIdx.DeleteAll();
+
+	char fullpath[SNM_MAX_PATH];
+	for (int i=0; i<GetSize(); i++)
+		if (!Get(i)->IsDefault() && GetFullPath(i, fullpath, sizeof(fullpath)))
+			m_pathIdx.AddUnsorted(fullpath, i);
+	m_pathIdx.Resort(); // note: with duplicated slots, any of them can be returned
+	m_pathIdxOk = true;
+}
+
 bool ResourceList::GetFullPath(int _slot, char* _fullFn, int _fullFnSz)
 {
 	if (ResourceItem* item = Get(_slot)) {
@@ -472,6 +509,7 @@ bool ResourceList::GetFullPath(int _slot, char* _fullFn, int _fullFnSz)
 
 bool ResourceList::SetFromFullPath(int _slot, const char* _fullPath)
 {
+	ReleasePathIndex();
 	if (ResourceItem* item = Get(_slot))
 	{
 		item->m_shortPath.Set(GetShortResourcePath(m_resDir.Get(), _fullPath));
@@ -579,6 +617,7 @@ void ResourceList::GetFileFilter(char* _filter, size_t _filterSz, bool _dblNull)
 
 bool ResourceList::ClearSlot(int _slot)
 {
+	ReleasePathIndex();
 	if (_slot>=0 && _slot<GetSize()) {
 		Get(_slot)->Clear();
 		return true;
@@ -705,6 +744,8 @@ void ResourcesView::SetItemText(SWS_ListItem* item, int iCol, const char* str)
 						{
 							UntieResFileFromProject(fn, g_resType);
 							TieResFileToProject(newFn, g_resType);
+							if (fl->IsText())
+								ResourceContentIndexUpdate();
 
 							ListView_SetItemText(m_hwndList, GetEditingItem(), DisplayToDataCol(2), (LPSTR)pItem->m_shortPath.Get());
 							// ^^ direct GUI update because Update() is no-op when editing
@@ -738,11 +779,16 @@ void ResourcesView::GetItemList(SWS_ListItemList* pList)
 		LineParser lp(false);
 		if (!lp.parse(g_filter.Get()))
 		{
+			WDL_StringKeyedArray<bool> contentMatches(false);
+			if ((g_filterPref&8) && fl->IsText())
+				SearchResourceContent(g_filter.Get(), &contentMatches);
+
 			for (int i=0; i < fl->GetSize(); i++)
 			{
 				if (ResourceItem* item = fl->Get(i))
 				{
-					bool match = false;
+					bool match = contentMatches.GetSize() && !item->IsDefault() &&
+						fl->GetFullPath(i, buf, sizeof(buf)) && contentMatches.Exists(buf);
 					for (int j=0; !match && j < lp.getnumtokens(); j++)
 					{
 						if (g_filterPref&1) // name
@@ -1403,23 +1449,31 @@ void ResourcesWnd::OnCommand(WPARAM wParam, LPARAM lParam)
 			break;
 		// text filter mode
 		case FILTER_BY_NAME_MSG:
-			if (g_filterPref&1) g_filterPref &= 6; // 110
+			if (g_filterPref&1) g_filterPref &= ~1; // 1110
 			else g_filterPref |= 1;
 			Update();
 //			SetFocus(GetDlgItem(m_hwnd, IDC_FILTER));
 			break;
 		case FILTER_BY_PATH_MSG:
-			if (g_filterPref&2) g_filterPref &= 5; // 101
+			if (g_filterPref&2) g_filterPref &= ~2; // 1101
 			else g_filterPref |= 2;
 			Update();
 //			SetFocus(GetDlgItem(m_hwnd, IDC_FILTER));
 			break;
 		case FILTER_BY_COMMENT_MSG:
-			if (g_filterPref&4) g_filterPref &= 3; // 011
+			if (g_filterPref&4) g_filterPref &= ~4; // 1011
 			else g_filterPref |= 4;
 			Update();
 //			SetFocus(GetDlgItem(m_hwnd, IDC_FILTER));
 			break;
+		case FILTER_BY_CONTENT_MSG:
+			if (g_filterPref&8) g_filterPref &= ~8; // 0111
+			else {
+				g_filterPref |= 8;
+				ResourceContentIndexRefresh();
+			}
+			Update();
+			break;
 		case RENAME_MSG:
 			if (item)
 			{
@@ -1529,6 +1583,7 @@ void ResourcesWnd::OnCommand(WPARAM wParam, LPARAM lParam)
 					}
 			}
 			if (startSlot != fl->GetSize()) {
+				ResourceContentIndexUpdate();
 				Update();
 				SelectBySlot(startSlot, fl->GetSize());
 			}
@@ -1919,6 +1974,7 @@ HMENU ResourcesWnd::OnContextMenu(int _x, int _y, bool* _wantDefaultItems)
 		AddToMenu(hFilterSubMenu, __LOCALIZE("Name","sws_DLG_150"), FILTER_BY_NAME_MSG, -1, false, (g_filterPref&1) ? MFS_CHECKED : MFS_UNCHECKED);
 		AddToMenu(hFilterSubMenu, __LOCALIZE("Path","sws_DLG_150"), FILTER_BY_PATH_MSG, -1, false, (g_filterPref&2) ? MFS_CHECKED : MFS_UNCHECKED);
 		AddToMenu(hFilterSubMenu, __LOCALIZE("Comment","sws_DLG_150"), FILTER_BY_COMMENT_MSG, -1, false, (g_filterPref&4) ? MFS_CHECKED : MFS_UNCHECKED);
+		AddToMenu(hFilterSubMenu, __LOCALIZE("Content (plugins, track names, media files)","sws_DLG_150"), FILTER_BY_CONTENT_MSG, -1, false, (g_filterPref&8) ? MFS_CHECKED : MFS_UNCHECKED);
 	}
 	return hMenu;
 }
@@ -2096,6 +2152,8 @@ void ResourcesWnd::OnDroppedFiles(HDROP _h)
 					fl->Delete(j, false);
 				}
 
+		if (fl->IsText())
+			ResourceContentIndexUpdate();
 		Update();
 
 		// Select item at drop point
@@ -2509,6 +2567,9 @@ void AutoSave(int _type, bool _ow, int _flags)
 
 	if (saved)
 	{
+		if (g_SNM_ResSlots.Get(_type)->IsText())
+			ResourceContentIndexUpdate();
+
 		if (resWnd && g_resType==_type)
 		{
 			resWnd->Update();
@@ -2538,7 +2599,627 @@ void AutoSave(int _type, bool _ow, int _flags)
 	}
 }
 
-// recursive from auto-fill path
+///////////////////////////////////////////////////////////////////////////////
+// Content index
+// Optional inverted index of text resource files (FX chains, track templates,
+// projects): plugin names, track/FX names and media file paths -> files.
+// Built/updated by file mtime in a background thread, persisted in
+// SNM_RES_INDEX_FILE, used by "Filter on > Content" and ReaScript.
+///////////////////////////////////////////////////////////////////////////////
+
+class ResourceContentIndex
+{
+public:
+	ResourceContentIndex() : m_files(false, freeFileEntry), m_terms(false), m_dirty(false) {}
+	~ResourceContentIndex() { m_termList.Empty(true); }
+
+	// returns true if _fn is indexed and unchanged
+	bool IsIndexed(const char* _fn, time_t _mtime)
+	{
+		SWS_SectionLock lock(&m_mutex);
+		FileEntry* e = m_files.Get(_fn, NULL);
+		return e && e->m_mtime == _mtime;
+	}
+
+	// _mtime==0 or _terms==NULL: removes _fn from the index
+	void SetFile(const char* _fn, time_t _mtime, WDL_PtrList<WDL_FastString>* _terms)
+	{
+		SWS_SectionLock lock(&m_mutex);
+		if (FileEntry* e = m_files.Get(_fn, NULL))
+		{
+			for (int i=0; i<e->m_terms.GetSize(); i++)
+				if (Term* t = m_termList.Get(e->m_terms.Get()[i]))
+					t->m_files.Delete(t->m_files.Find(e));
+			m_files.Delete(_fn);
+		}
+
+		if (_mtime && _terms)
+		{
+			FileEntry* e = new FileEntry(_fn, _mtime);
+			WDL_StringKeyedArray<bool> dups(false);
+			for (int i=0; i<_terms->GetSize(); i++)
+			{
+				const char* term = _terms->Get(i)->Get();
+				if (dups.Exists(term))
+					continue;
+				dups.Insert(term, true);
+
+				int id = m_terms.Get(term, -1);
+				if (id < 0) {
+					id = m_termList.GetSize();
+					m_termList.Add(new Term(term));
+					m_terms.Insert(term, id);
+				}
+				m_termList.Get(id)->m_files.Add(e);
+				e->m_terms.Add(id);
+			}
+			m_files.Insert(_fn, e);
+		}
+		m_dirty = true;
+	}
+
+	// adds files whose terms contain _word (case insensitive) to _filesOut
+	// note: _filesOut is not sorted, it is up to the caller to Resort() it
+	void Search(const char* _word, WDL_StringKeyedArray<bool>* _filesOut)
+	{
+		if (!_word || !*_word || !_filesOut)
+			return;
+		SWS_SectionLock lock(&m_mutex);
+		const char* term;
+		for (int i=0; i<m_terms.GetSize(); i++)
+		{
+			int id = m_terms.Enumerate(i, &term);
+			if (stristr(term, _word))
+				if (Term* t = m_termList.Get(id))
+					for (int j=0; j<t->m_files.GetSize(); j++)
+						_filesOut->AddUnsorted(t->m_files.Get(j)->m_path.Get(), true);
+		}
+	}
+
+	void Load(const char* _fn)
+	{
+		FILE* f = fopenUTF8(_fn, "r");
+		if (!f)
+			return;
+
+		char line[SNM_MAX_CHUNK_LINE_LENGTH]="";
+		WDL_FastString fn;
+		time_t mtime = 0;
+		WDL_PtrList_DeleteOnDestroy<WDL_FastString> terms;
+		while (fgets(line, sizeof(line), f))
+		{
+			ShortenStringToFirstRN(line);
+			if (line[0]=='F' && line[1]=='\t') // "F<tab>mtime<tab>path"
+			{
+				if (fn.GetLength())
+					SetFile(fn.Get(), mtime, &terms);
+
+				char* p = line+2;
+				mtime = (time_t)strtoll(p, &p, 10);
+				fn.Set(*p=='\t' ? p+1 : "");
+				terms.Empty(true);
+			}
+			else if (line[0]=='T' && line[1]=='\t' && line[2]) // "T<tab>term"
+				terms.Add(new WDL_FastString(line+2));
+		}
+		if (fn.GetLength())
+			SetFile(fn.Get(), mtime, &terms);
+		fclose(f);
+
+		SWS_SectionLock lock(&m_mutex);
+		m_dirty = false;
+	}
+
+	void Save(const char* _fn)
+	{
+		SWS_SectionLock lock(&m_mutex);
+		if (!m_dirty)
+			return;
+		if (FILE* f = fopenUTF8(_fn, "w"))
+		{
+			for (int i=0; i<m_files.GetSize(); i++)
+			{
+				FileEntry* e = m_files.Enumerate(i);
+				fprintf(f, "F\t%lld\t%s\n", (long long)e->m_mtime, e->m_path.Get());
+				for (int j=0; j<e->m_terms.GetSize(); j++)
+					if (Term* t = m_termList.Get(e->m_terms.Get()[j]))
+						fprintf(f, "T\t%s\n", t->m_str.Get());
+			}
+			fclose(f);
+			m_dirty = false;
+		}
+	}
+
+private:
+	class FileEntry {
+	public:
+		FileEntry(const char* _path, time_t _mtime) : m_path(_path), m_mtime(_mtime) {}
+		WDL_FastString m_path;
+		time_t m_mtime;
+		WDL_TypedBuf<int> m_terms; // term ids
+	};
+	static void freeFileEntry(FileEntry* _e) { delete _e; }
+	class Term {
+	public:
+		Term(const char* _str) : m_str(_str) {}
+		WDL_FastString m_str;
+		WDL_PtrList<FileEntry> m_files;
+	};
+
+	WDL_StringKeyedArray<FileEntry*> m_files;	// full path -> file
+	WDL_StringKeyedArray<int> m_terms;			// term -> term id
+	WDL_PtrList<Term> m_termList;				// term id -> term, files
+	bool m_dirty;
+	SWS_Mutex m_mutex;
+};
+
+ResourceContentIndex g_resContentIdx;
+bool g_resContentIdxLoaded = false;
+
+void GetResourceContentIndexFn(char* _fn, int _fnSz) {
+	snprintf(_fn, _fnSz, SNM_RES_INDEX_FILE, GetResourcePath());
+}
+
+// extracts plugin names, track/FX names and media file paths from a chunk
+// (expects chunks trimmed by LoadChunk(), i.e. lines start with their 1st token)
+void GetChunkSearchTerms(const char* _chunk, WDL_PtrList<WDL_FastString>* _termsOut)
+{
+	LineParser lp(false);
+	char line[SNM_MAX_CHUNK_LINE_LENGTH];
+	const char* p = _chunk;
+	while (p && *p)
+	{
+		const char* eol = strchr(p, '\n');
+		int len = eol ? (int)(eol-p) : (int)strlen(p);
+
+		// quick check first, most lines are base64 data, fx params, etc..
+		if (*p=='<' || !strncmp(p, "NAME ", 5) || !strncmp(p, "FILE ", 5))
+		{
+			lstrcpyn(line, p, len+1 > (int)sizeof(line) ? (int)sizeof(line) : len+1);
+			if (!lp.parse(line) && lp.getnumtokens() > 1)
+			{
+				const char* tok = lp.gettoken_str(0);
+				if (!strcmp(tok, "NAME") || !strcmp(tok, "FILE") ||
+					!strcmp(tok, "<VST") || !strcmp(tok, "<AU") || !strcmp(tok, "<JS") ||
+					!strcmp(tok, "<CLAP") || !strcmp(tok, "<LV2") || !strcmp(tok, "<DX"))
+				{
+					if (*lp.gettoken_str(1))
+						_termsOut->Add(new WDL_FastString(lp.gettoken_str(1)));
+				}
+			}
+		}
+		p = eol ? eol+1 : NULL;
+	}
+}
+
+
+class ResourceContentIndexer
+{
+public:
+	// _files: full paths, ownership transferred
+	// _load: load the persisted index first
+	ResourceContentIndexer(WDL_PtrList<WDL_FastString>* _files, bool _load) : m_load(_load), m_done(false), m_kill(false)
+	{
+		for (int i=0; i<_files->GetSize(); i++)
+			m_files.Add(_files->Get(i));
+		_files->Empty(false);
+		m_thread = (HANDLE)_beginthreadex(NULL, 0, IndexThread, (void*)this, 0, NULL);
+	}
+	~ResourceContentIndexer()
+	{
+		if (m_thread)
+		{
+			SetKillFlag();
+			WaitForSingleObject(m_thread, INFINITE);
+			CloseHandle(m_thread);
+		}
+		m_files.Empty(true);
+	}
+	bool IsDone() { SWS_SectionLock lock(&m_mutex); return m_done; }
+	void Wait() { if (m_thread) WaitForSingleObject(m_thread, INFINITE); }
+
+private:
+	static unsigned WINAPI IndexThread(void* _indexer)
+	{
+		ResourceContentIndexer* _this = (ResourceContentIndexer*)_indexer;
+
+		if (_this->m_load) {
+			char fn[SNM_MAX_PATH]="";
+			GetResourceContentIndexFn(fn, sizeof(fn));
+			g_resContentIdx.Load(fn);
+		}
+
+		WDL_FastString chunk;
+		for (int i=0; i<_this->m_files.GetSize() && !_this->GetKillFlag(); i++)
+		{
+			const char* fn = _this->m_files.Get(i)->Get();
+			time_t mtime = GetFileOrDirMTime(fn);
+			if (g_resContentIdx.IsIndexed(fn, mtime))
+				continue;
+
+			WDL_PtrList_DeleteOnDestroy<WDL_FastString> terms;
+			if (mtime && LoadChunk(fn, &chunk))
+			{
+				GetChunkSearchTerms(chunk.Get(), &terms);
+				g_resContentIdx.SetFile(fn, mtime, &terms);
+			}
+			else
+				g_resContentIdx.SetFile(fn, 0, NULL); // file removed
+		}
+
+		SWS_SectionLock lock(&_this->m_mutex);
+		_this->m_done = true;
+		return 0;
+	}
+	bool GetKillFlag() { SWS_SectionLock lock(&m_mutex); return m_kill; }
+	void SetKillFlag() { SWS_SectionLock lock(&m_mutex); m_kill = true; }
+
+	WDL_PtrList<WDL_FastString> m_files;
+	bool m_load, m_done, m_kill;
+	HANDLE m_thread;
+	SWS_Mutex m_mutex;
+};
+
+ResourceContentIndexer* g_resContentIndexer = NULL;
+bool g_resContentIdxRefreshPending = false;
+DWORD g_resContentIdxLastRefresh = 0;
+
+bool IsContentFiltered() {
+	return (g_filterPref&8) && IsFiltered();
+}
+
+// (re)indexes all text slot files, only changed files are parsed
+void ResourceContentIndexRefresh()
+{
+	if (g_resContentIndexer) {
+		g_resContentIdxRefreshPending = true; // see ResourceContentIndexRun()
+		return;
+	}
+
+	WDL_PtrList<WDL_FastString> files;
+	char fullPath[SNM_MAX_PATH]="";
+	for (int i=0; i<g_SNM_ResSlots.GetSize(); i++)
+	{
+		ResourceList* fl = g_SNM_ResSlots.Get(i);
+		if (fl && fl->IsText())
+			for (int j=0; j<fl->GetSize(); j++)
+				if (!fl->Get(j)->IsDefault() && fl->GetFullPath(j, fullPath, sizeof(fullPath)))
+					files.Add(new WDL_FastString(fullPath));
+	}
+	g_resContentIndexer = new ResourceContentIndexer(&files, !g_resContentIdxLoaded);
+	g_resContentIdxLoaded = true;
+	g_resContentIdxRefreshPending = false;
+	g_resContentIdxLastRefresh = GetTickCount();
+}
+
+// to call when slots are added/edited: no-op until the index is used
+// (content filter or ReaScript), see SearchResourceContent()
+void ResourceContentIndexUpdate()
+{
+	if (g_resContentIdxLoaded)
+		ResourceContentIndexRefresh();
+}
+
+// polled from the main thread via ResourcesRun()
+void ResourceContentIndexRun()
+{
+	if (!g_resContentIndexer || !g_resContentIndexer->IsDone())
+		return;
+
+	DELETE_NULL(g_resContentIndexer);
+
+	char fn[SNM_MAX_PATH]="";
+	GetResourceContentIndexFn(fn, sizeof(fn));
+	g_resContentIdx.Save(fn);
+
+	if (IsContentFiltered())
+		if (ResourcesWnd* w = g_resWndMgr.Get())
+			w->Update();
+
+	if (g_resContentIdxRefreshPending)
+		ResourceContentIndexRefresh();
+}
+
+// blocks until the running indexer (if any) is done
+void ResourceContentIndexWait()
+{
+	if (g_resContentIndexer)
+	{
+		g_resContentIndexer->Wait();
+		ResourceContentIndexRun();
+	}
+}
+
+// fills _filesOut with files matching any word of _query (space separated)
+// note: lazy init, the index is built asynchronously on first call
+void SearchResourceContent(const char* _query, WDL_StringKeyedArray<bool>* _filesOut)
+{
+	if (!g_resContentIdxLoaded)
+		ResourceContentIndexRefresh();
+
+	LineParser lp(false);
+	if (_query && !lp.parse(_query))
+		for (int i=0; i<lp.getnumtokens(); i++)
+			g_resContentIdx.Search(lp.gettoken_str(i), _filesOut);
+	_filesOut->Resort();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Auto-fill
+// Directories are scanned in a background thread, found files are added to
+// slot lists by batches from the main thread, see AutoFillRun().
+// Directory listings are cached by modification time (and persisted in
+// SNM_AUTOFILL_CACHE_FILE), unchanged directories are not listed again:
+// adding/removing/renaming a file updates the mtime of its parent directory.
+///////////////////////////////////////////////////////////////////////////////
+
+#define AUTOFILL_BATCH_SIZE		500 // max nb of slots added per timer tick
+
+class AutoFillDirCache
+{
+public:
+	AutoFillDirCache(time_t _mtime) : m_mtime(_mtime) {}
+	void CopyFrom(AutoFillDirCache* _c)
+	{
+		m_mtime = _c->m_mtime;
+		for (int i=0; i<_c->m_files.GetSize(); i++) m_files.Add(new WDL_FastString(_c->m_files.Get(i)->Get()));
+		for (int i=0; i<_c->m_subdirs.GetSize(); i++) m_subdirs.Add(new WDL_FastString(_c->m_subdirs.Get(i)->Get()));
+	}
+	time_t m_mtime;
+	WDL_PtrList_DeleteOnDestroy<WDL_FastString> m_files, m_subdirs; // names only
+};
+
+static void freeAutoFillDirCache(AutoFillDirCache* _c) { delete _c; }
+
+// directory full path -> listing, shared by all scan threads
+WDL_StringKeyedArray<AutoFillDirCache*> g_autoFillCache(true, freeAutoFillDirCache);
+SWS_Mutex g_autoFillCacheMutex;
+bool g_autoFillCacheLoaded = false;
+bool g_autoFillCacheDirty = false;
+
+// main thread only, i.e. no scan running yet
+void LoadAutoFillCache()
+{
+	if (g_autoFillCacheLoaded)
+		return;
+	g_autoFillCacheLoaded = true;
+
+	char fn[SNM_MAX_PATH]="";
+	if (snprintfStrict(fn, sizeof(fn), SNM_AUTOFILL_CACHE_FILE, GetResourcePath()) <= 0)
+		return;
+
+	if (FILE* f = fopenUTF8(fn, "r"))
+	{
+		char line[SNM_MAX_PATH+64];
+		AutoFillDirCache* cur = NULL;
+		while (fgets(line, sizeof(line), f))
+		{
+			ShortenStringToFirstRN(line);
+			if (line[0] && line[1] == '\t')
+			{
+				switch (line[0])
+				{
+					case 'D': // "D<tab>mtime<tab>dir"
+					{
+						char* p = line+2;
+						time_t mtime = (time_t)strtoll(p, &p, 10);
+						cur = NULL;
+						if (*p == '\t' && p[1]) {
+							cur = new AutoFillDirCache(mtime);
+							g_autoFillCache.AddUnsorted(p+1, cur);
+						}
+						break;
+					}
+					case 'F':
+						if (cur) cur->m_files.Add(new WDL_FastString(line+2));
+						break;
+					case 'S':
+						if (cur) cur->m_subdirs.Add(new WDL_FastString(line+2));
+						break;
+				}
+			}
+		}
+		fclose(f);
+		g_autoFillCache.Resort();
+	}
+}
+
+void SaveAutoFillCache()
+{
+	SWS_SectionLock lock(&g_autoFillCacheMutex);
+	if (!g_autoFillCacheDirty)
+		return;
+
+	char fn[SNM_MAX_PATH]="";
+	if (snprintfStrict(fn, sizeof(fn), SNM_AUTOFILL_CACHE_FILE, GetResourcePath()) <= 0)
+		return;
+
+	if (FILE* f = fopenUTF8(fn, "w"))
+	{
+		const char* dir;
+		for (int i=0; i<g_autoFillCache.GetSize(); i++)
+		{
+			if (AutoFillDirCache* c = g_autoFillCache.Enumerate(i, &dir))
+			{
+				fprintf(f, "D\t%lld\t%s\n", (long long)c->m_mtime, dir);
+				for (int j=0; j<c->m_files.GetSize(); j++)
+					fprintf(f, "F\t%s\n", c->m_files.Get(j)->Get());
+				for (int j=0; j<c->m_subdirs.GetSize(); j++)
+					fprintf(f, "S\t%s\n", c->m_subdirs.Get(j)->Get());
+			}
+		}
+		fclose(f);
+		g_autoFillCacheDirty = false;
+	}
+}
+
+
+class AutoFillScanner
+{
+public:
+	AutoFillScanner(ResourceList* _fl, const char* _dir, const char* _filterList)
+		: m_fl(_fl), m_dir(_dir), m_filterList(_filterList), m_firstAdded(NULL),
+		  m_pendingPos(0), m_done(false), m_kill(false)
+	{
+		m_thread = (HANDLE)_beginthreadex(NULL, 0, ScanThread, (void*)this, 0, NULL);
+	}
+	~AutoFillScanner()
+	{
+		if (m_thread)
+		{
+			SetKillFlag();
+			WaitForSingleObject(m_thread, INFINITE);
+			CloseHandle(m_thread);
+		}
+		m_found.Empty(true);
+		m_pending.Empty(true);
+	}
+	ResourceList* GetList() { return m_fl; }
+	const char* GetDir() { return m_dir.Get(); }
+	ResourceItem* GetFirstAddedSlot() { return m_firstAdded; }
+	bool IsDone() { SWS_SectionLock lock(&m_mutex); return m_done; }
+	bool HasPendingFiles() { SWS_SectionLock lock(&m_mutex); return m_found.GetSize() || m_pendingPos<m_pending.GetSize(); }
+	int AddSlots(int _type, int _max);
+
+private:
+	static unsigned WINAPI ScanThread(void* _scanner);
+	void Scan(const char* _dir);
+	bool GetKillFlag() { SWS_SectionLock lock(&m_mutex); return m_kill; }
+	void SetKillFlag() { SWS_SectionLock lock(&m_mutex); m_kill = true; }
+
+	ResourceList* m_fl; // only accessed from the main thread
+	WDL_FastString m_dir, m_filterList;
+	ResourceItem* m_firstAdded;
+	WDL_PtrList<WDL_String> m_found; // scan thread -> main thread, guarded by m_mutex
+	WDL_PtrList<WDL_String> m_pending; // main thread only
+	int m_pendingPos;
+	bool m_done, m_kill;
+	HANDLE m_thread;
+	SWS_Mutex m_mutex;
+};
+
+unsigned WINAPI AutoFillScanner::ScanThread(void* _scanner)
+{
+	AutoFillScanner* _this = (AutoFillScanner*)_scanner;
+	_this->Scan(_this->m_dir.Get());
+
+	SWS_SectionLock lock(&_this->m_mutex);
+	_this->m_done = true;
+	return 0;
+}
+
+// recursive, scan thread
+void AutoFillScanner::Scan(const char* _dir)
+{
+	if (GetKillFlag())
+		return;
+
+	// stat before listing: a dir updated while being listed will be re-listed next time
+	AutoFillDirCache listing(GetFileOrDirMTime(_dir));
+
+	bool cached = false;
+	{
+		SWS_SectionLock lock(&g_autoFillCacheMutex);
+		AutoFillDirCache* c = g_autoFillCache.Get(_dir, NULL);
+		if (c && listing.m_mtime && c->m_mtime == listing.m_mtime) {
+			listing.CopyFrom(c);
+			cached = true;
+		}
+	}
+
+	if (!cached)
+	{
+		WDL_DirScan ds;
+		if (!ds.First(_dir))
+		{
+			do
+			{
+				const char* fn = ds.GetCurrentFN();
+				if (!strcmp(fn, ".") || !strcmp(fn, ".."))
+					continue;
+				if (IsDirNoRecurse(ds)) listing.m_subdirs.Add(new WDL_FastString(fn));
+				else listing.m_files.Add(new WDL_FastString(fn));
+			}
+			while (!ds.Next() && !GetKillFlag());
+		}
+
+		if (listing.m_mtime && !GetKillFlag()) // partial listings are not cached
+		{
+			AutoFillDirCache* c = new AutoFillDirCache(0);
+			c->CopyFrom(&listing);
+			SWS_SectionLock lock(&g_autoFillCacheMutex);
+			g_autoFillCache.Insert(_dir, c);
+			g_autoFillCacheDirty = true;
+		}
+	}
+
+	WDL_PtrList<WDL_String> found;
+	for (int i=0; i<listing.m_files.GetSize(); i++)
+	{
+		const char* fn = listing.m_files.Get(i)->Get();
+		if (MatchFileFilter(fn, m_filterList.Get()))
+		{
+			WDL_String* path = new WDL_String(_dir);
+			path->Append(WDL_DIRCHAR_STR);
+			path->Append(fn);
+			found.Add(path);
+		}
+	}
+	if (found.GetSize())
+	{
+		SWS_SectionLock lock(&m_mutex);
+		for (int i=0; i<found.GetSize(); i++)
+			m_found.Add(found.Get(i));
+	}
+
+	WDL_FastString subdir;
+	for (int i=0; i<listing.m_subdirs.GetSize() && !GetKillFlag(); i++)
+	{
+		subdir.Set(_dir);
+		subdir.Append(WDL_DIRCHAR_STR);
+		subdir.Append(listing.m_subdirs.Get(i)->Get());
+		Scan(subdir.Get());
+	}
+}
+
+// main thread, adds at most _max slots, returns the number of added slots
+int AutoFillScanner::AddSlots(int _type, int _max)
+{
+	if (m_pendingPos >= m_pending.GetSize())
+	{
+		m_pending.Empty(true);
+		m_pendingPos = 0;
+
+		SWS_SectionLock lock(&m_mutex);
+		for (int i=0; i<m_found.GetSize(); i++)
+			m_pending.Add(m_found.Get(i));
+		m_found.Empty(false);
+	}
+
+	int added = 0;
+	if (m_pendingPos < m_pending.GetSize())
+	{
+		m_fl->BuildPathIndex();
+		while (m_pendingPos < m_pending.GetSize() && added < _max)
+		{
+			const char* fn = m_pending.Get(m_pendingPos++)->Get();
+			if (m_fl->FindByPath(fn) < 0) // skip if already present
+			{
+				TieResFileToProject(fn, _type);
+				ResourceItem* item = m_fl->AddSlot(fn);
+				if (!m_firstAdded)
+					m_firstAdded = item;
+				added++;
+			}
+		}
+		m_fl->ReleasePathIndex(); // slots can be updated from anywhere between 2 batches
+	}
+	return added;
+}
+
+WDL_PtrList_DOD<AutoFillScanner> g_autoFillScanners;
+
+// recursive from auto-fill path, asynchronous: see AutoFillRun()
 void AutoFill(int _type)
 {
 	ResourceList* fl = g_SNM_ResSlots.Get(_type);
@@ -2548,39 +3229,76 @@ void AutoFill(int _type)
 	if (!CheckSetAutoDirectory(__LOCALIZE("Auto-fill","sws_DLG_150"), _type, false))
 		return;
 
-	int startSlot = g_SNM_ResSlots.Get(_type)->GetSize();
+	// already auto-filling this list?
+	for (int i=0; i<g_autoFillScanners.GetSize(); i++)
+		if (g_autoFillScanners.Get(i)->GetList() == fl)
+			return;
+
+	LoadAutoFillCache();
 
 	char fileFilter[2048] = ""; // filters need some room!
 	fl->GetFileFilter(fileFilter, sizeof(fileFilter), false);
+	g_autoFillScanners.Add(new AutoFillScanner(fl, GetAutoFillDir(_type), fileFilter));
+}
 
-	WDL_PtrList_DeleteOnDestroy<WDL_String> files; 
-	ScanFiles(&files, GetAutoFillDir(_type), fileFilter, true);
-	if (int sz = files.GetSize())
-		for (int i=0; i<sz; i++)
-			if (fl->FindByPath(files.Get(i)->Get()) < 0) { // skip if already present
-				TieResFileToProject(files.Get(i)->Get(), _type);
-				fl->AddSlot(files.Get(i)->Get());
-			}
-
-	if (startSlot != fl->GetSize())
+// polled from the main thread via ResourcesRun()
+void AutoFillRun()
+{
+	for (int i=g_autoFillScanners.GetSize()-1; i>=0; i--)
 	{
-		if (g_resType==_type)
-			if (ResourcesWnd* w = g_resWndMgr.Get()) {
+		AutoFillScanner* scan = g_autoFillScanners.Get(i);
+
+		// bookmark deleted in the meantime?
+		int type = g_SNM_ResSlots.Find(scan->GetList());
+		if (type < 0) {
+			g_autoFillScanners.Delete(i, true);
+			continue;
+		}
+
+		bool done = scan->IsDone(); // before AddSlots(), not to miss the last found files
+		if (scan->AddSlots(type, AUTOFILL_BATCH_SIZE) && g_resType==type)
+			if (ResourcesWnd* w = g_resWndMgr.Get())
 				w->Update();
-				w->SelectBySlot(startSlot, g_SNM_ResSlots.Get(_type)->GetSize());
-			}
-	}
-	else
-	{
-		const char* path = GetAutoFillDir(_type);
-		char msg[SNM_MAX_PATH]="";
-		if (path && *path) snprintf(msg, sizeof(msg), __LOCALIZE_VERFMT("No slot added from: %s\n%s","sws_DLG_150"), path, AUTOFILL_ERR_STR);
-		else snprintf(msg, sizeof(msg), __LOCALIZE_VERFMT("No slot added!\n%s","sws_DLG_150"), AUTOFILL_ERR_STR);
-		MessageBox(g_resWndMgr.GetMsgHWND(), msg, __LOCALIZE("S&M - Warning","sws_DLG_150"), MB_OK);
+
+		if (!done || scan->HasPendingFiles())
+			continue;
+
+		// scan over
+		ResourceList* fl = scan->GetList();
+		ResourceItem* firstAdded = scan->GetFirstAddedSlot();
+		WDL_FastString dir(scan->GetDir());
+		g_autoFillScanners.Delete(i, true); // before any modal box (re-entrance)
+
+		if (firstAdded)
+		{
+			int startSlot = fl->Find(firstAdded);
+			if (startSlot>=0 && g_resType==type)
+				if (ResourcesWnd* w = g_resWndMgr.Get())
+					w->SelectBySlot(startSlot, fl->GetSize());
+		}
+		else
+		{
+			char msg[SNM_MAX_PATH]="";
+			if (dir.GetLength()) snprintf(msg, sizeof(msg), __LOCALIZE_VERFMT("No slot added from: %s\n%s","sws_DLG_150"), dir.Get(), AUTOFILL_ERR_STR);
+			else snprintf(msg, sizeof(msg), __LOCALIZE_VERFMT("No slot added!\n%s","sws_DLG_150"), AUTOFILL_ERR_STR);
+			MessageBox(g_resWndMgr.GetMsgHWND(), msg, __LOCALIZE("S&M - Warning","sws_DLG_150"), MB_OK);
+		}
+		SaveAutoFillCache();
+		if (firstAdded && fl->IsText())
+			ResourceContentIndexUpdate();
+		return; // other scans (if any) will be processed on next tick
 	}
 }
 
 
+// polled from the main thread via SNM_CSurfRun()
+void ResourcesRun()
+{
+	AutoFillRun();
+	ResourceContentIndexRun();
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Get, load, clear, delete slots/files
 ///////////////////////////////////////////////////////////////////////////////
@@ -2619,6 +3337,8 @@ bool BrowseSlot(int _type, int _slot, bool _tieUntiePrj, char* _fn, int _fnSz, b
 							UntieResFileFromProject(untiePath, _type);
 							TieResFileToProject(fn, _type);
 						}
+						if (fl->IsText())
+							ResourceContentIndexUpdate();
 					}
 				}
 				else
@@ -3293,6 +4013,16 @@ void ResourcesExit()
 {
 	plugin_register("-projectconfig", &s_projectconfig);
 
+	g_autoFillScanners.Empty(true); // stops scan threads
+	SaveAutoFillCache();
+	if (g_resContentIndexer)
+	{
+		DELETE_NULL(g_resContentIndexer); // stops the index thread
+		char fn[SNM_MAX_PATH]="";
+		GetResourceContentIndexFn(fn, sizeof(fn));
+		g_resContentIdx.Save(fn);
+	}
+
 	WDL_PtrList_DeleteOnDestroy<WDL_FastString> iniSections;
 	GetIniSectionNames(&iniSections);
 
@@ -4413,6 +5143,46 @@ int SNM_SelectResourceBookmark(const char* _name)
 	return -1;
 }
 
+int SNM_SearchResourceContent(int _bookmarkId, const char* _query, char* _slotsOut, int _slotsOut_sz)
+{
+	if (_slotsOut && _slotsOut_sz>0)
+		*_slotsOut = '\0';
+
+	ResourceList* fl = g_SNM_ResSlots.Get(_bookmarkId);
+	if (!fl || !fl->IsText())
+		return 0;
+
+	// 1st call: waits for the index (persisted one + new/modified files)
+	// next calls: catch up with files edited out of the Resources window, at most
+	// every RES_INDEX_REFRESH_MS (re-indexed in the background, so such a call can
+	// still return the previous results)
+	if (!g_resContentIdxLoaded)
+	{
+		ResourceContentIndexRefresh();
+		ResourceContentIndexWait();
+	}
+	else if (GetTickCount()-g_resContentIdxLastRefresh > RES_INDEX_REFRESH_MS)
+		ResourceContentIndexRefresh();
+
+	WDL_StringKeyedArray<bool> matches(false);
+	SearchResourceContent(_query, &matches);
+
+	int cnt = 0;
+	WDL_FastString slots;
+	char fullPath[SNM_MAX_PATH]="";
+	for (int i=0; matches.GetSize() && i<fl->GetSize(); i++)
+	{
+		if (!fl->Get(i)->IsDefault() && fl->GetFullPath(i, fullPath, sizeof(fullPath)) && matches.Exists(fullPath))
+		{
+			slots.AppendFormatted(16, cnt ? ",%d" : "%d", i+1);
+			cnt++;
+		}
+	}
+	if (_slotsOut && _slotsOut_sz>0)
+		lstrcpyn(_slotsOut, slots.Get(), _slotsOut_sz);
+	return cnt;
+}
+
 void SNM_TieResourceSlotActions(int _bookmarkId)
 {
 	int typeForUser = _bookmarkId>=0 ? GetTypeForUser(_bookmarkId) : -1;
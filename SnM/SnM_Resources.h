@@ -80,6 +80,8 @@ class ResourceList : public WDL_PtrList<ResourceItem>
 	ResourceItem* AddSlot(const char* _path="", const char* _desc="");
 	ResourceItem* InsertSlot(int _slot, const char* _path="", const char* _desc="");
 	int FindByPath(const char* _fullPath);
+	void BuildPathIndex();
+	void ReleasePathIndex() { m_pathIdx.DeleteAll(); m_pathIdxOk = false; }
 	bool GetFullPath(int _slot, char* _fullFn, int _fullFnSz);
 	bool SetFromFullPath(int _slot, const char* _fullPath);
 	bool ClearSlot(int _slot);
@@ -102,6 +104,8 @@ protected:
 	int m_flags;						// see bitmask definition above
 private:
 	WDL_PtrList<WDL_FastString> m_exts;	// split file extensions
+	WDL_StringKeyedArray<int> m_pathIdx;	// full path -> slot, see BuildPathIndex()
+	bool m_pathIdxOk;
 };
 
 
@@ -185,6 +189,7 @@ bool AutoSaveSlot(int _slotType, const char* _dirPath,
 				bool (*SaveSlot)(const void*, const char*)=NULL, const void* _obj=NULL);
 void AutoSave(int _type, bool _ow, int _flags = 0);
 void AutoFill(int _type);
+void ResourcesRun();
 
 bool BrowseSlot(int _type, int _slot, bool _tieUntiePrj, char* _fn = NULL, int _fnSz = 0, bool* _updatedList = NULL);
 WDL_FastString* GetOrPromptOrBrowseSlot(int _type, int* _slot);
@@ -321,6 +326,7 @@ void LoadThemeSlot(COMMAND_T*);
 
 // reascript export
 int SNM_SelectResourceBookmark(const char* _name);
+int SNM_SearchResourceContent(int _bookmarkId, const char* _query, char* _slotsOut, int _slotsOut_sz);
 void SNM_TieResourceSlotActions(int _bookmarkId);
 
 #endif
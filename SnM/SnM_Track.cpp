@@ -1608,6 +1608,21 @@ bool SNM_AddTCPFXParm(MediaTrack* _tr, int _fxId, int _prmId)
 	return updated;
 }
 
+// track indexes are 0-based (like GetTrack()), -1 if none (or master track)
+int SNM_GetTrackFolderInfo(MediaTrack* _tr, int* _parentOut, int* _firstChildOut, int* _nextSiblingOut, int* _lastDescendantOut)
+{
+	*_parentOut = *_firstChildOut = *_nextSiblingOut = *_lastDescendantOut = -1;
+	const SWS_FolderTree* ft = GetFolderTree();
+	const SWS_FolderNode* node = _tr ? ft->Get(_tr) : NULL;
+	if (!node)
+		return -1;
+	*_parentOut = node->parent > 0 ? node->parent-1 : -1;
+	*_firstChildOut = node->firstChild > 0 ? node->firstChild-1 : -1;
+	*_nextSiblingOut = node->nextSibling > 0 ? node->nextSibling-1 : -1;
+	*_lastDescendantOut = node->lastDescendant > 0 ? node->lastDescendant-1 : -1;
+	return node->depth;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Misc. track helpers/actions
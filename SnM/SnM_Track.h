@@ -82,6 +82,7 @@ bool SendAllNotesOff(MediaTrack* _tr, int _cc_flags = 1|2);
 void SendAllNotesOff(COMMAND_T*);
 
 bool SNM_AddTCPFXParm(MediaTrack* _tr, int _fxId, int _prmId);
+int SNM_GetTrackFolderInfo(MediaTrack* _tr, int* _parentOut, int* _firstChildOut, int* _nextSiblingOut, int* _lastDescendantOut);
 
 void ScrollSelTrack(bool _tcp, bool _mcp);
 void ScrollSelTrack(COMMAND_T*);
@@ -137,6 +137,25 @@ bool FileOrDirExists(const char* _fn)
 	return false;
 }
 
+// returns the last modification time of a file or directory, 0 if not found
+time_t GetFileOrDirMTime(const char* _fn)
+{
+	if (_fn && *_fn)
+	{
+		WDL_FastString fn(_fn);
+		fn.remove_trailing_dirchars();
+
+		struct stat s;
+#ifdef _WIN32
+		if (statUTF8(fn.Get(), &s) == 0)
+#else
+		if (stat(fn.Get(), &s) == 0)
+#endif
+			return s.st_mtime;
+	}
+	return 0;
+}
+
 // FileOrDirExists() and FileOrDirExistsErrMsg() are intentionally not merged
 // (would impact other project members' code...)
 bool FileOrDirExistsErrMsg(const char* _fn, bool _errMsg)
@@ -457,6 +476,24 @@ bool IsDirNoRecurse(const WDL_DirScan &ds)
 	return (ds.GetCurrentIsDirectory() & (IsDir | IsDirSymlink)) != 0;
 }
 
+// _filterList: file extensions without null separators, ex: "*.ext1 *.ext2" ("*" == all files)
+bool MatchFileFilter(const char* _fn, const char* _filterList)
+{
+	if (!_fn || !_filterList)
+		return false;
+	if (!strcmp("*", _filterList)) // || !strcmp("*.*", _filterList))
+		return true;
+
+	const char* ext = GetFileExtension(_fn);
+	if (*ext)
+	{
+		char buf[64];
+		snprintf(buf, sizeof(buf), "*.%s", ext);
+		return (stristr(_filterList, buf) != NULL);
+	}
+	return false;
+}
+
 // fills a list of filenames matching extensions defined in _filterList
 // _filterList: file extensions without null separators, ex: "*.ext1 *.ext2" ("*" == all files)
 // note: it is up to the caller to free _files (use WDL_PtrList_DeleteOnDestroy)
@@ -466,8 +503,7 @@ void ScanFiles(WDL_PtrList<WDL_String>* _files, const char* _initDir, const char
 	if (_files && _initDir && !ds.First(_initDir))
 	{
 		const char* curFn;
-		const char* curfnExt;
-		WDL_FastString fn, ext;
+		WDL_FastString fn;
 		do 
 		{
 			curFn = ds.GetCurrentFN();
@@ -481,25 +517,10 @@ void ScanFiles(WDL_PtrList<WDL_String>* _files, const char* _initDir, const char
 					ScanFiles(_files, fn.Get(), _filterList, true);
 				}
 			}
-			else
+			else if (MatchFileFilter(curFn, _filterList))
 			{
-				if (!strcmp("*", _filterList)) // || !strcmp("*.*", _filterList))
-				{
-					ds.GetCurrentFullFN(&fn);
-					_files->Add(new WDL_String(fn.Get()));
-				}
-				else
-				{
-					curfnExt = GetFileExtension(curFn);
-					if (*curfnExt)
-					{
-						ext.SetFormatted(64, "*.%s", curfnExt);
-						if (stristr(_filterList, ext.Get())) {
-							ds.GetCurrentFullFN(&fn);
-							_files->Add(new WDL_String(fn.Get()));
-						}
-					}
-				}
+				ds.GetCurrentFullFN(&fn);
+				_files->Add(new WDL_String(fn.Get()));
 			}
 		}
 		while(!ds.Next());
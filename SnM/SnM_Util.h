@@ -39,6 +39,7 @@ const char* GetFilenameWithExt(const char* _fullFn);
 bool Filenamize(char* _fnInOut, bool _checkOnly = false);
 bool IsValidFilenameErrMsg(const char* _fn, bool _errMsg);
 bool FileOrDirExists(const char* _fn);
+time_t GetFileOrDirMTime(const char* _fn);
 bool FileOrDirExistsErrMsg(const char* _fn, bool _errMsg = true);
 bool SNM_DeleteFile(const char* _filename, bool _recycleBin);
 bool SNM_DeletePeakFile(const char* _fn, bool _recycleBin);
@@ -57,6 +58,7 @@ bool TranscodeFileToFile64(const char* _outFn, const char* _inFn);
 #endif
 WDL_HeapBuf* TranscodeStr64ToHeapBuf(const char* _str64);
 bool GenerateFilename(const char* _dir, const char* _name, const char* _ext, char* _updatedFn, int _updatedSz);
+bool MatchFileFilter(const char* _fn, const char* _filterList);
 void ScanFiles(WDL_PtrList<WDL_String>* _files, const char* _initDir, const char* _filterList, bool _subdirs);
 bool IsDirNoRecurse(const WDL_DirScan &);
 void StringToExtensionConfig(WDL_FastString* _str, ProjectStateContext* _ctx);
@@ -26,156 +26,445 @@
 ******************************************************************************/
 
 #include "stdafx.h"
-#include <stdlib.h>
-#include <string.h>
 #include "Base64.h"
 
-// This following Base64 code adapted from http://base64.sourceforge.net/b64.c
+#if defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define BASE64_NEON
+#elif defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  include <tmmintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#    define BASE64_SSSE3_FUNC
+#  else
+#    define BASE64_SSSE3_FUNC __attribute__((target("ssse3")))
+#  endif
+#  define BASE64_SSSE3
+#endif
+
+// Originally adapted from http://base64.sourceforge.net/b64.c
 // Copyright (c) 2001 Bob Trower, Trantor Standard Systems Inc.
 // Visit above link for full license info or to get original source.
-// Modified so that the '=' char returns zero for compat with other base64 systems.
+// Rewritten with table driven scalar loops and SSSE3 (x86, detected at runtime)
+// or NEON (AArch64) block loops, scalar code handles leftovers and errors.
 static const char cb64[]="ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-static const char cd64[]="|$$$}rstuvwxyz{$$$>$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+
+// ASCII -> 6-bit value, 0xFF: not part of the alphabet (including '=')
+#define XX 0xFF
+static const unsigned char cd64[256] =
+{
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,62,XX,XX,XX,63,
+	52,53,54,55,56,57,58,59,60,61,XX,XX,XX,XX,XX,XX,
+	XX, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+	15,16,17,18,19,20,21,22,23,24,25,XX,XX,XX,XX,XX,
+	XX,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+	41,42,43,44,45,46,47,48,49,50,51,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+	XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,
+};
+#undef XX
 
 //////////////////////////////////////////////////////////////////////
-// Construction/Destruction
+// Block loops
+// Encode: whole groups of 3 bytes, returns the number of bytes consumed
+// Decode: whole groups of 4 chars, returns the number of chars consumed,
+//         stops before the first block that contains '=' or an invalid char
 //////////////////////////////////////////////////////////////////////
 
-Base64::Base64()
+#ifdef BASE64_SSSE3
+
+static bool HasSSSE3()
 {
-	m_pEncodedBuf = NULL;
-	m_pDecodedBuf = NULL;
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+#else
+	__builtin_cpu_init(); // we may run before constructors
+	return __builtin_cpu_supports("ssse3") != 0;
+#endif
 }
 
-Base64::~Base64()
+static const bool g_hasSSSE3 = HasSSSE3();
+
+// 12 bytes -> 16 chars per iteration (16 bytes are loaded)
+// See http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+BASE64_SSSE3_FUNC static int EncodeBlocksSSSE3(const unsigned char* pIn, int iLen, char* pOut)
 {
-	delete [] m_pEncodedBuf;
-	delete [] m_pDecodedBuf;
+	const __m128i shuf = _mm_setr_epi8(1,0,2,1, 4,3,5,4, 7,6,8,7, 10,9,11,10);
+	const __m128i shiftLUT = _mm_setr_epi8('a'-26, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52,
+	                                       '0'-52, '0'-52, '0'-52, '0'-52, '+'-62, '/'-63, 'A', 0, 0);
+	int i = 0;
+	for (; i + 16 <= iLen; i += 12, pOut += 16)
+	{
+		__m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pIn + i)), shuf);
+
+		// split each 3 bytes group into 4 6-bit indexes
+		const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+		const __m128i idx = _mm_or_si128(t0, t1);
+
+		// indexes -> ASCII
+		__m128i lut = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		lut = _mm_or_si128(lut, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+		_mm_storeu_si128((__m128i*)pOut, _mm_add_epi8(idx, _mm_shuffle_epi8(shiftLUT, lut)));
+	}
+	return i;
 }
 
-//////////////////////////////////////////////////////////////////////
-// Public Member Functions
-//////////////////////////////////////////////////////////////////////
-char* Base64::Encode(const char* pInput, int iInputLen, const bool pad)
+// 16 chars -> 12 bytes per iteration (16 bytes are stored, hence the margin)
+// See https://github.com/aklomp/base64 (BSD license)
+BASE64_SSSE3_FUNC static int DecodeBlocksSSSE3(const char* pIn, int iLen, unsigned char* pOut)
+{
+	const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i mask2F = _mm_set1_epi8(0x2F);
+	const __m128i pack = _mm_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -1,-1,-1,-1);
+
+	int i = 0;
+	for (; i + 24 <= iLen; i += 16, pOut += 12)
+	{
+		__m128i in = _mm_loadu_si128((const __m128i*)(pIn + i));
+
+		// validate
+		const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+		const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+		const __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(in, mask2F));
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())))
+			break;
+
+		// ASCII -> 6-bit values
+		const __m128i eq2F = _mm_cmpeq_epi8(in, mask2F);
+		in = _mm_add_epi8(in, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles)));
+
+		// pack 4x6 bits into 3 bytes
+		const __m128i merged = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+		const __m128i out = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128((__m128i*)pOut, _mm_shuffle_epi8(out, pack));
+	}
+	return i;
+}
+
+static int EncodeBlocks(const unsigned char* pIn, int iLen, char* pOut)
 {
-	int iLen = iInputLen;
-	int iEncodedLen;
-	
-	//calculate encoded buffer size
-	if (pad)
-		iEncodedLen = static_cast<int>(4 * ceil(iLen / 3.f));
-	else
-		iEncodedLen = static_cast<int>(ceil(4 * iLen / 3.f));
-
-	// allocate:
-	if (m_pEncodedBuf != NULL)
-		free (m_pEncodedBuf);
-	m_pEncodedBuf = new char[iEncodedLen + 1];
-	char* pOutput = m_pEncodedBuf;
-
-	//let's step through the buffer (in groups of three bytes) and encode it...
-	while (iLen >= 3)
+	return g_hasSSSE3 ? EncodeBlocksSSSE3(pIn, iLen, pOut) : 0;
+}
+
+static int DecodeBlocks(const char* pIn, int iLen, unsigned char* pOut)
+{
+	return g_hasSSSE3 ? DecodeBlocksSSSE3(pIn, iLen, pOut) : 0;
+}
+
+#elif defined(BASE64_NEON)
+
+// 48 bytes -> 64 chars per iteration
+static int EncodeBlocks(const unsigned char* pIn, int iLen, char* pOut)
+{
+	uint8x16x4_t lut;
+	for (int j = 0; j < 4; j++)
+		lut.val[j] = vld1q_u8((const uint8_t*)cb64 + j*16);
+	const uint8x16_t mask = vdupq_n_u8(0x3F);
+
+	int i = 0;
+	for (; i + 48 <= iLen; i += 48, pOut += 64)
 	{
-		*(pOutput++) = cb64[(unsigned char)pInput[0] >> 2];
-		*(pOutput++) = cb64[(((unsigned char)pInput[0] & 0x03) << 4) | (((unsigned char)pInput[1] & 0xF0) >> 4)];
-		*(pOutput++) = cb64[(((unsigned char)pInput[1] & 0x0F) << 2) | (((unsigned char)pInput[2] & 0xC0) >> 6)];
-		*(pOutput++) = cb64[(unsigned char)pInput[2] & 0x3F];
-		iLen -= 3;
-		pInput += 3;
+		const uint8x16x3_t in = vld3q_u8(pIn + i);
+		uint8x16x4_t out;
+		out.val[0] = vshrq_n_u8(in.val[0], 2);
+		out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+		out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+		out.val[3] = vandq_u8(in.val[2], mask);
+		for (int j = 0; j < 4; j++)
+			out.val[j] = vqtbl4q_u8(lut, out.val[j]);
+		vst4q_u8((uint8_t*)pOut, out);
 	}
+	return i;
+}
 
-	//do we have some chars left?
-	if (iLen != 0)
+// 64 chars -> 48 bytes per iteration
+static int DecodeBlocks(const char* pIn, int iLen, unsigned char* pOut)
+{
+	// cd64[0..127], out of range lookups return 0 (chars >= 0x80 are rejected below)
+	uint8x16x4_t lutLo, lutHi;
+	for (int j = 0; j < 4; j++)
 	{
-		*(pOutput++) = cb64[(unsigned char)pInput[0] >> 2];
+		lutLo.val[j] = vld1q_u8(cd64 + j*16);
+		lutHi.val[j] = vld1q_u8(cd64 + 64 + j*16);
+	}
+	const uint8x16_t offset = vdupq_n_u8(64);
 
-		if (iLen == 1)
+	int i = 0;
+	for (; i + 64 <= iLen; i += 64, pOut += 48)
+	{
+		uint8x16x4_t in = vld4q_u8((const uint8_t*)pIn + i);
+		uint8x16_t err = vdupq_n_u8(0);
+		for (int j = 0; j < 4; j++)
 		{
-			*(pOutput++) = cb64[((unsigned char)pInput[0] & 0x03) << 4];
+			const uint8x16_t c = in.val[j];
+			in.val[j] = vorrq_u8(vqtbl4q_u8(lutLo, c), vqtbl4q_u8(lutHi, vsubq_u8(c, offset)));
+			err = vorrq_u8(err, vorrq_u8(in.val[j], c)); // bit 7: invalid char (0xFF) or non-ASCII
 		}
-		else // iLen == 2
+		if (vmaxvq_u8(err) & 0x80)
+			break;
+
+		uint8x16x3_t out;
+		out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+		out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+		out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+		vst3q_u8(pOut, out);
+	}
+	return i;
+}
+
+#else
+
+static int EncodeBlocks(const unsigned char*, int, char*) { return 0; }
+static int DecodeBlocks(const char*, int, unsigned char*) { return 0; }
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// Base64Encoder
+//////////////////////////////////////////////////////////////////////
+
+static inline void EncodeGroup(const unsigned char* pIn, char* pOut)
+{
+	pOut[0] = cb64[pIn[0] >> 2];
+	pOut[1] = cb64[((pIn[0] & 0x03) << 4) | (pIn[1] >> 4)];
+	pOut[2] = cb64[((pIn[1] & 0x0F) << 2) | (pIn[2] >> 6)];
+	pOut[3] = cb64[pIn[2] & 0x3F];
+}
+
+int Base64Encoder::Write(const char* pInput, int iLen, char* pOutput)
+{
+	const unsigned char* pIn = (const unsigned char*)pInput;
+	char* pOut = pOutput;
+
+	// complete the pending group first
+	while (m_nbPending && iLen > 0)
+	{
+		m_pending[m_nbPending++] = *pIn++;
+		iLen--;
+		if (m_nbPending == 3)
 		{
-			*(pOutput++) = cb64[(((unsigned char)pInput[0] & 0x03) << 4) | (((unsigned char)pInput[1] & 0xF0) >> 4)];
-			*(pOutput++) = cb64[(((unsigned char)pInput[1] & 0x0F) << 2)];
+			EncodeGroup(m_pending, pOut);
+			pOut += 4;
+			m_nbPending = 0;
 		}
 	}
 
-	while (pad && pOutput < m_pEncodedBuf + iEncodedLen)
-		*(pOutput++) = '=';
+	const int iBlocks = EncodeBlocks(pIn, iLen, pOut);
+	pIn += iBlocks;
+	pOut += iBlocks / 3 * 4;
+	iLen -= iBlocks;
+
+	for (; iLen >= 3; iLen -= 3, pIn += 3, pOut += 4)
+		EncodeGroup(pIn, pOut);
 
-	// Null terminate
-	*pOutput = 0;
-	
-	return m_pEncodedBuf;
+	// keep the last 0-2 bytes for the next Write() or Finish()
+	for (; iLen > 0; iLen--)
+		m_pending[m_nbPending++] = *pIn++;
+
+	return (int)(pOut - pOutput);
 }
 
-// Decode a base64 string to a binary buffer
-// Encoded string must be null terminated
-char* Base64::Decode(const char* pEncodedBuf, int *iOutLen)
+int Base64Encoder::Finish(char* pOutput)
 {
-	int iDecodedLen;
-	int iLen, iBlock, i;
-	if (iOutLen)
-		*iOutLen = 0;
+	char* pOut = pOutput;
+	if (m_nbPending)
+	{
+		*(pOut++) = cb64[m_pending[0] >> 2];
+		if (m_nbPending == 1)
+		{
+			*(pOut++) = cb64[(m_pending[0] & 0x03) << 4];
+		}
+		else // m_nbPending == 2
+		{
+			*(pOut++) = cb64[((m_pending[0] & 0x03) << 4) | (m_pending[1] >> 4)];
+			*(pOut++) = cb64[(m_pending[1] & 0x0F) << 2];
+		}
+
+		while (m_pad && pOut < pOutput + 4)
+			*(pOut++) = '=';
+	}
+	m_nbPending = 0;
+	return (int)(pOut - pOutput);
+}
 
-	// allocate buffer to hold the decoded string:
-	const int iEncodedLen = strlen(pEncodedBuf);
-	iDecodedLen = static_cast<int>(3 * (iEncodedLen / 4.f));
+//////////////////////////////////////////////////////////////////////
+// Base64Decoder
+//////////////////////////////////////////////////////////////////////
 
-	// remove padding from decoded length
-	for(int i = iEncodedLen - 1; i >= 0 && pEncodedBuf[i] == '='; --i, --iDecodedLen);
+static inline void DecodeGroup(const unsigned char* pIn, unsigned char* pOut)
+{
+	pOut[0] = (unsigned char)(pIn[0] << 2 | pIn[1] >> 4);
+	pOut[1] = (unsigned char)(pIn[1] << 4 | pIn[2] >> 2);
+	pOut[2] = (unsigned char)(pIn[2] << 6 | pIn[3]);
+}
 
-	if (m_pDecodedBuf != NULL)
-		free (m_pDecodedBuf);
-	m_pDecodedBuf = new char[iDecodedLen];
+int Base64Decoder::Write(const char* pInput, int iLen, char* pOutput)
+{
+	if (m_error)
+		return -1;
 
-	// allocate a local scratch buffer for decoding - work with BYTE's to avoid fatal sign extensions by compiler:
-	char* pInput = new char[iEncodedLen+1];
-	strcpy(pInput, pEncodedBuf);
+	const char* pIn = pInput;
+	const char* pEnd = pInput + iLen;
+	unsigned char* pOut = (unsigned char*)pOutput;
+	m_nbChars += iLen;
 
-	// Loop for each byte of input:
-	iLen = iBlock = i = 0;
-	while (pInput[iBlock+i])
+	while (pIn < pEnd)
 	{
-		if ((unsigned char)pInput[iBlock+i] < 0x2B || (unsigned char)pInput[iBlock+i] > 0x7A)
+		// fast path: whole groups, no pending values, no padding seen yet
+		if (!m_nbPending && !m_nbPadding)
 		{
-			delete [] pInput;
-			return NULL;
+			const int iBlocks = DecodeBlocks(pIn, (int)(pEnd - pIn), pOut);
+			pIn += iBlocks;
+			pOut += iBlocks / 4 * 3;
+
+			for (; pEnd - pIn >= 4; pIn += 4, pOut += 3)
+			{
+				const unsigned char v[4] = { cd64[(unsigned char)pIn[0]], cd64[(unsigned char)pIn[1]],
+				                             cd64[(unsigned char)pIn[2]], cd64[(unsigned char)pIn[3]] };
+				if ((v[0] | v[1] | v[2] | v[3]) == 0xFF)
+					break; // '=' or invalid, see below
+				DecodeGroup(v, pOut);
+			}
+			if (pIn >= pEnd)
+				break;
 		}
-		if (pInput[iBlock+i] == '=')
-			break;
-		pInput[iBlock+i] = cd64[(unsigned char)pInput[iBlock+i] - 0x2B];
-		if (pInput[iBlock+i] == '$')
+
+		// slow path, char by char
+		const unsigned char c = (unsigned char)*pIn++;
+		if (c == '=')
 		{
-			delete [] pInput;
-			return NULL;
+			m_nbPadding++;
 		}
-		pInput[iBlock+i] -= 0x3E;
-
-		switch(i++)
+		else if (m_nbPadding || cd64[c] == 0xFF)
 		{
-			// case 0: no data to copy yet!
-		case 1:
-			m_pDecodedBuf[iLen++] = ((unsigned char)pInput[iBlock+0] << 2 | (unsigned char)pInput[iBlock+1] >> 4);
-			break;
-		case 2:
-			m_pDecodedBuf[iLen++] = ((unsigned char)pInput[iBlock+1] << 4 | (unsigned char)pInput[iBlock+2] >> 2);
-			break;
-		case 3:
-			m_pDecodedBuf[iLen++] = ((((unsigned char)pInput[iBlock+2] << 6) & 0xC0) | (unsigned char)pInput[iBlock+3]);
-			i = 0;
-			iBlock += 4;
-			break;
+			m_error = true; // data after padding or invalid char
+			return -1;
+		}
+		else
+		{
+			m_pending[m_nbPending++] = cd64[c];
+			if (m_nbPending == 4)
+			{
+				DecodeGroup(m_pending, pOut);
+				pOut += 3;
+				m_nbPending = 0;
+			}
 		}
 	}
 
-	// clean and check:
-	delete [] pInput;
-	if (iLen != iDecodedLen)
+	m_nbBytes += pOut - (unsigned char*)pOutput;
+	return (int)(pOut - (unsigned char*)pOutput);
+}
+
+int Base64Decoder::Finish(char* pOutput)
+{
+	if (m_error)
+		return -1;
+
+	// last partial group: 2 chars -> 1 byte, 3 chars -> 2 bytes, a lone char is ignored
+	unsigned char group[4] = { m_pending[0], m_pending[1], m_pending[2], 0 }, out[3];
+	const int iLen = m_nbPending > 1 ? m_nbPending - 1 : 0;
+	DecodeGroup(group, out);
+	memcpy(pOutput, out, iLen);
+	m_nbBytes += iLen;
+	m_nbPending = 0;
+
+	// the decoded length must match the encoded one minus padding
+	if (m_nbBytes != m_nbChars * 3 / 4 - m_nbPadding)
+	{
+		m_error = true;
+		return -1;
+	}
+	return iLen;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+Base64::Base64()
+{
+}
+
+Base64::~Base64()
+{
+}
+
+//////////////////////////////////////////////////////////////////////
+// Public Member Functions
+//////////////////////////////////////////////////////////////////////
+
+int Base64::EncodedLength(int iLen, bool pad)
+{
+	return pad ? (iLen + 2) / 3 * 4 : (int)(((long long)iLen * 4 + 2) / 3);
+}
+
+int Base64::DecodedMaxLength(int iLen)
+{
+	return Base64Decoder::MaxOutput(iLen);
+}
+
+int Base64::EncodeTo(const char* pInput, int iLen, char* pOutput, bool pad)
+{
+	Base64Encoder encoder(pad);
+	const int iOutLen = encoder.Write(pInput, iLen, pOutput);
+	return iOutLen + encoder.Finish(pOutput + iOutLen);
+}
+
+int Base64::DecodeTo(const char* pInput, int iLen, char* pOutput)
+{
+	Base64Decoder decoder;
+	const int iOutLen = decoder.Write(pInput, iLen, pOutput);
+	if (iOutLen < 0)
+		return -1;
+	const int iTailLen = decoder.Finish(pOutput + iOutLen);
+	return iTailLen < 0 ? -1 : iOutLen + iTailLen;
+}
+
+// The returned buffer is owned by this object, it is reused by the next call
+char* Base64::Encode(const char* pInput, int iInputLen, const bool pad)
+{
+	const int iEncodedLen = EncodedLength(iInputLen, pad);
+	m_encodedBuf.Resize(iEncodedLen + 1, false);
+	if (m_encodedBuf.GetSize() != iEncodedLen + 1)
+		return NULL;
+
+	char* pOutput = m_encodedBuf.Get();
+	pOutput[EncodeTo(pInput, iInputLen, pOutput, pad)] = 0;
+	return pOutput;
+}
+
+// Decode a base64 string to a binary buffer
+// Encoded string must be null terminated
+char* Base64::Decode(const char* pEncodedBuf, int *iOutLen)
+{
+	if (iOutLen)
+		*iOutLen = 0;
+
+	const int iEncodedLen = (int)strlen(pEncodedBuf);
+	const int iMaxLen = DecodedMaxLength(iEncodedLen);
+	m_decodedBuf.Resize(max(iMaxLen, 1), false);
+	if (m_decodedBuf.GetSize() < iMaxLen)
+		return NULL;
+
+	const int iLen = DecodeTo(pEncodedBuf, iEncodedLen, m_decodedBuf.Get());
+	if (iLen < 0)
 		return NULL;
 
-	// done:
 	if (iOutLen)
 		*iOutLen = iLen;
-	return m_pDecodedBuf;
+	return m_decodedBuf.Get();
 }
@@ -35,6 +35,53 @@ class Base64
 
 		char* Decode(const char* pInput, int *bufsize);	//bufsize holds the decoded length
 		char* Encode(const char* pEncodedBuf, int iLen, bool pad = false);
-		char* m_pEncodedBuf;
-		char* m_pDecodedBuf;
+
+		// Caller-supplied buffers (no allocation, no null terminator), pOutput must hold
+		// EncodedLength() chars or DecodedMaxLength() bytes
+		static int EncodedLength(int iLen, bool pad);
+		static int DecodedMaxLength(int iLen);
+		static int EncodeTo(const char* pInput, int iLen, char* pOutput, bool pad = false); // returns EncodedLength()
+		static int DecodeTo(const char* pInput, int iLen, char* pOutput); // returns the decoded length, -1 if invalid
+
+	private:
+		WDL_TypedBuf<char> m_encodedBuf;
+		WDL_TypedBuf<char> m_decodedBuf;
+};
+
+// Streaming encoder: input can be written in chunks of any size
+// pOutput must hold at least MaxOutput(iLen) chars for each Write(), 4 chars for Finish()
+class Base64Encoder
+{
+	public:
+		Base64Encoder(bool pad = false) : m_pad(pad), m_nbPending(0) {}
+
+		static int MaxOutput(int iLen) { return (iLen + 2) / 3 * 4; }
+		int Write(const char* pInput, int iLen, char* pOutput); // returns the number of chars written
+		int Finish(char* pOutput); // flushes the last 0-2 bytes, returns the number of chars written
+		void Reset() { m_nbPending = 0; }
+
+	private:
+		bool m_pad;
+		int m_nbPending;
+		unsigned char m_pending[3];
+};
+
+// Streaming decoder, same rules as Base64::Decode(): '=' padding is optional but
+// only allowed at the end, any other char outside of the base64 alphabet is an error
+// pOutput must hold at least MaxOutput(iLen) bytes for each Write(), 3 bytes for Finish()
+class Base64Decoder
+{
+	public:
+		Base64Decoder() { Reset(); }
+
+		static int MaxOutput(int iLen) { return (iLen + 3) / 4 * 3; }
+		int Write(const char* pInput, int iLen, char* pOutput); // returns the number of bytes written, -1 on error
+		int Finish(char* pOutput); // returns the number of bytes written, -1 on error
+		void Reset() { m_nbPending = m_nbChars = m_nbPadding = 0; m_nbBytes = 0; m_error = false; }
+
+	private:
+		int m_nbPending, m_nbPadding;
+		long long m_nbChars, m_nbBytes; // totals, to check the padding in Finish()
+		bool m_error;
+		unsigned char m_pending[4]; // decoded 6-bit values
 };
@@ -28,6 +28,7 @@
 #include "stdafx.h"
 
 #include "../SnM/SnM_Dlg.h"
+#include "../SnM/SnM_MediaMeta.h"
 #include "Parameters.h"
 
 #include <WDL/localize/localize.h>
@@ -51,11 +52,48 @@ void SanitizeString(char *StringToSanitize)
 
 }
 
+// file of a take source, section sources resolved
+static const char* GetSourceFileName(PCM_source* pSrc)
+{
+	if (pSrc && !strcmp(pSrc->GetType(), "SECTION") && pSrc->GetSource())
+		pSrc = pSrc->GetSource();
+	return pSrc ? pSrc->GetFileName() : NULL;
+}
+
+// BWF description from the (cached, header-only) media file metadata when possible,
+// from the source itself otherwise
+static bool GetSourceBWAVDesc(PCM_source* pSrc, char* buf, int bufSz)
+{
+	WDL_FastString desc;
+	const char* fn = GetSourceFileName(pSrc);
+	if (fn && *fn && SNM_GetMediaFileMetadata(fn, "desc", &desc))
+	{
+		lstrcpyn(buf, desc.Get(), bufSz);
+		return true;
+	}
+	int sz = pSrc->Extended(PCM_SOURCE_EXT_GETMETADATA, (void*)"DESC", buf, (void*)(INT_PTR)bufSz);
+	return sz > 0 && buf[0];
+}
+
 void DoRenameTakesWithBWAVDesc(COMMAND_T* ct)
 {
 	WDL_TypedBuf<MediaItem*> selectedItems;
 	SWS_GetSelectedMediaItems(&selectedItems);
-	
+
+	// read all descriptions at once (in parallel), the loop below only hits the cache
+	WDL_PtrList<const char> fileNames;
+	for (int i = 0; i < selectedItems.GetSize(); i++)
+	{
+		for (int iTake = 0; iTake < GetMediaItemNumTakes(selectedItems.Get()[i]); iTake++)
+		{
+			PCM_source* pSrc = (PCM_source*)GetSetMediaItemTakeInfo(GetMediaItemTake(selectedItems.Get()[i], iTake), "P_SOURCE", NULL);
+			if (const char* fn = GetSourceFileName(pSrc))
+				fileNames.Add(fn);
+		}
+	}
+	SNM_PrefetchMediaFilesMetadata(&fileNames);
+
+	bool missingDesc = false;
 	for (int i = 0; i < selectedItems.GetSize(); i++)
 	{
 		for (int iTake = 0; iTake < GetMediaItemNumTakes(selectedItems.Get()[i]); iTake++)
@@ -66,18 +104,20 @@ void DoRenameTakesWithBWAVDesc(COMMAND_T* ct)
 				break;
 			
 			char buf[8192];
-			int sz = pSrc->Extended(PCM_SOURCE_EXT_GETMETADATA, (void*)"DESC", buf, (void*)(INT_PTR)(int)sizeof(buf));
-			if (sz > 0 && buf[0])
+			if (GetSourceBWAVDesc(pSrc, buf, sizeof(buf)))
 			{
 				SanitizeString(buf);
 				GetSetMediaItemTakeInfo(curTake, "P_NAME", buf);
 			}
 			else
-				MessageBox(g_hwndParent, __LOCALIZE("Take source media has no Broadcast Info Description","sws_mbox"), __LOCALIZE("Xenakios - Error","sws_mbox"),MB_OK);
+				missingDesc = true;
 		}
 	}	
 	Undo_OnStateChangeEx(SWS_CMD_SHORTNAME(ct), UNDO_STATE_ITEMS, -1);
 	UpdateTimeline();
+
+	if (missingDesc)
+		MessageBox(g_hwndParent, __LOCALIZE("Take source media has no Broadcast Info Description","sws_mbox"), __LOCALIZE("Xenakios - Error","sws_mbox"),MB_OK);
 }
 
 HWND h_renameDialog;
@@ -305,8 +345,7 @@ void DoOpenRPPofBWAVdesc(COMMAND_T*)
 	if (pSrc)
 	{
 		char buf[8192];
-		int sz = pSrc->Extended(PCM_SOURCE_EXT_GETMETADATA, (void*)"DESC", buf, (void*)(INT_PTR)(int)sizeof(buf));
-		if (sz > 0 && buf[0])
+		if (GetSourceBWAVDesc(pSrc, buf, sizeof(buf)))
 		{
 			string RPPFileName;
 			string RPPdesc;
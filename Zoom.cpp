@@ -676,49 +676,158 @@ void TogZoomHoriz(COMMAND_T* ct)			{ TogZoom((int)ct->user, 0, true); }
 void SaveCurrentArrangeViewSlot(COMMAND_T* ct)	{ g_stdAS[(int)ct->user].Get()->Save(true, true); }
 void RestoreArrangeViewSlot(COMMAND_T* ct)      { g_stdAS[(int)ct->user].Get()->Restore(); }
 
-// Returns the track at a point on the track view window
-// Point is in client coords
-MediaTrack* TrackAtPoint(HWND hTrackView, int iY, int* iOffset, int* iYMin, int* iYMax)
+// Cached track view geometry for TrackAtPoint()/ItemAtPoint() hit testing:
+// - track Y extents (unscrolled) as prefix sums of the track heights
+// - per track item start/end arrays, built on demand
+// Invalidated when the project, the track count, the vertical zoom, the total
+// height (scroll range) or the project state change count differ.
+class TrackViewGeometry
 {
-	SCROLLINFO si = { sizeof(SCROLLINFO), };
-	si.fMask = SIF_ALL;
-	CoolSB_GetScrollInfo(hTrackView, SB_VERT, &si);
+public:
+	TrackViewGeometry() : m_proj(NULL), m_stateCount(-1), m_scrollMax(-1), m_fVZoom(-1.f) {}
 
-	int iVPos = -si.nPos; // Account for current scroll pos
-	int iTrack = 0;
-	int iTrackH = 0;
+	// Returns the track id at iY (unscrolled), GetNumTracks()+1 when past the last track
+	int TrackAt(int iY, int iScrollMax, int* iYMin, int* iYMax)
+	{
+		Validate(iScrollMax);
+		const int nbTracks = m_bottoms.GetSize();
+		const int* bottoms = m_bottoms.Get();
+		const int iTrack = (int)(std::upper_bound(bottoms, bottoms + nbTracks, iY) - bottoms);
+		if (iYMin) *iYMin = m_tops.Get()[iTrack];
+		if (iYMax) *iYMax = iTrack < nbTracks ? bottoms[iTrack] : m_tops.Get()[iTrack];
+		return iTrack;
+	}
 
-	// Find the current track #
-	while (iTrack <= GetNumTracks())
+	// Returns the index of the first item of the track containing dPos, -1 if none
+	int ItemAt(int iTrack, double dPos)
 	{
-		MediaTrack* track = CSurf_TrackFromID(iTrack, false);
-		iTrackH = *(int*)GetSetMediaTrackInfo(track, "I_WNDH", NULL);
-		iTrackH += GetTrackSpacerSize(track);
-		if (iVPos + iTrackH > iY)
-			break;
-		if (iTrack == 0 && TcpVis(track) && iTrackH != 0)
-			iTrackH += GetMasterTcpGap();
-		iVPos += iTrackH;
-		iTrack++;
+		TrackItems* ti = m_items.Get(iTrack);
+		if (!ti)
+			return -1;
+		if (!ti->m_bBuilt)
+			ti->Build(CSurf_TrackFromID(iTrack, false));
+
+		const int nbItems = ti->m_starts.GetSize();
+		const double* starts = ti->m_starts.Get();
+		const double* maxEnds = ti->m_maxEnds.Get();
+		if (!ti->m_bSorted)
+		{
+			for (int i = 0; i < nbItems; i++)
+				if (dPos >= starts[i] && dPos <= ti->m_ends.Get()[i])
+					return i;
+			return -1;
+		}
+
+		// items [0, k[ start before dPos, the 1st one ending after dPos is found via the running max. of item ends
+		const int k = (int)(std::upper_bound(starts, starts + nbItems, dPos) - starts);
+		const int i = (int)(std::lower_bound(maxEnds, maxEnds + k, dPos) - maxEnds);
+		return i < k ? i : -1;
 	}
 
-	// Set extents if outside of std region
+	void GetItemExtents(int iTrack, int iItem, double* dStart, double* dEnd)
+	{
+		TrackItems* ti = m_items.Get(iTrack);
+		*dStart = ti->m_starts.Get()[iItem];
+		*dEnd = ti->m_ends.Get()[iItem];
+	}
+
+private:
+	class TrackItems
+	{
+	public:
+		TrackItems() : m_bBuilt(false), m_bSorted(true) {}
+		void Build(MediaTrack* tr)
+		{
+			const int nbItems = GetTrackNumMediaItems(tr);
+			double* starts = m_starts.Resize(nbItems, false);
+			double* ends = m_ends.Resize(nbItems, false);
+			double* maxEnds = m_maxEnds.Resize(nbItems, false);
+			for (int i = 0; i < nbItems; i++)
+			{
+				MediaItem* mi = GetTrackMediaItem(tr, i);
+				starts[i] = *(double*)GetSetMediaItemInfo(mi, "D_POSITION", NULL);
+				ends[i]   = *(double*)GetSetMediaItemInfo(mi, "D_LENGTH", NULL) + starts[i];
+				maxEnds[i] = i ? max(maxEnds[i-1], ends[i]) : ends[i];
+				if (i && starts[i] < starts[i-1])
+					m_bSorted = false;
+			}
+			m_bBuilt = true;
+		}
+		WDL_TypedBuf<double> m_starts, m_ends, m_maxEnds;
+		bool m_bBuilt, m_bSorted;
+	};
+
+	void Validate(int iScrollMax)
+	{
+		ReaProject* proj = EnumProjects(-1, NULL, 0);
+		const int nbTracks = GetNumTracks() + 1; // +1 for master
+		const int stateCount = GetProjectStateChangeCount(NULL);
+		const float fVZoom = get_reaper_vzoom();
+		if (proj == m_proj && nbTracks == m_bottoms.GetSize() && stateCount == m_stateCount && iScrollMax == m_scrollMax && fVZoom == m_fVZoom)
+			return;
+
+		int* tops = m_tops.Resize(nbTracks + 1, false);
+		int* bottoms = m_bottoms.Resize(nbTracks, false);
+		int iVPos = 0;
+		for (int i = 0; i < nbTracks; i++)
+		{
+			MediaTrack* track = CSurf_TrackFromID(i, false);
+			int iTrackH = *(int*)GetSetMediaTrackInfo(track, "I_WNDH", NULL);
+			iTrackH += GetTrackSpacerSize(track);
+			tops[i] = iVPos;
+			bottoms[i] = iVPos + iTrackH;
+			if (i == 0 && TcpVis(track) && iTrackH != 0)
+				iTrackH += GetMasterTcpGap();
+			iVPos += iTrackH;
+		}
+		tops[nbTracks] = iVPos;
+
+		m_items.Empty(true);
+		for (int i = 0; i < nbTracks; i++)
+			m_items.Add(new TrackItems);
+
+		m_proj = proj;
+		m_stateCount = stateCount;
+		m_scrollMax = iScrollMax;
+		m_fVZoom = fVZoom;
+	}
+
+	WDL_TypedBuf<int> m_tops, m_bottoms;
+	WDL_PtrList_DeleteOnDestroy<TrackItems> m_items;
+	ReaProject* m_proj;
+	int m_stateCount, m_scrollMax;
+	float m_fVZoom;
+};
+
+static TrackViewGeometry g_trackViewGeom;
+
+// Returns the track id at a point on the track view window, GetNumTracks()+1 if none
+// Point is in client coords
+static int TrackIdAtPoint(HWND hTrackView, int iY, int* iOffset, int* iYMin, int* iYMax)
+{
+	SCROLLINFO si = { sizeof(SCROLLINFO), };
+	si.fMask = SIF_ALL;
+	CoolSB_GetScrollInfo(hTrackView, SB_VERT, &si);
+
+	// Account for current scroll pos
+	int iVPos;
+	const int iTrack = g_trackViewGeom.TrackAt(iY + si.nPos, si.nMax, &iVPos, iYMax);
+	iVPos -= si.nPos;
 	if (iYMin)
 		*iYMin = iVPos;
 	if (iYMax)
-		*iYMax = iVPos;
+		*iYMax -= si.nPos;
+	if (iOffset && iTrack <= GetNumTracks())
+		*iOffset = iY - iVPos;
+	return iTrack;
+}
 
-	if (iTrack <= GetNumTracks())
-	{
-		if (iYMin)
-			*iYMin = iVPos;
-		if (iYMax)
-			*iYMax = iVPos + iTrackH;
-		if (iOffset)
-			*iOffset = iY - iVPos;
-		return CSurf_TrackFromID(iTrack, false);
-	}
-	return NULL;
+// Returns the track at a point on the track view window
+// Point is in client coords
+MediaTrack* TrackAtPoint(HWND hTrackView, int iY, int* iOffset, int* iYMin, int* iYMax)
+{
+	const int iTrack = TrackIdAtPoint(hTrackView, iY, iOffset, iYMin, iYMax);
+	return iTrack <= GetNumTracks() ? CSurf_TrackFromID(iTrack, false) : NULL;
 }
 
 // Returns the (first) item at the point p in the trackview.
@@ -729,7 +838,8 @@ MediaItem* ItemAtPoint(HWND hTrackView, POINT p, RECT* rExtents, MediaTrack** pT
 
 	// First get the track
 	int iY1, iY2;
-	MediaTrack* tr = TrackAtPoint(hTrackView, p.y, NULL, &iY1, &iY2);
+	const int iTrack = TrackIdAtPoint(hTrackView, p.y, NULL, &iY1, &iY2);
+	MediaTrack* tr = iTrack <= GetNumTracks() ? CSurf_TrackFromID(iTrack, false) : NULL;
 	if (pTr)
 		*pTr = tr;
 	if (rExtents)
@@ -744,27 +854,21 @@ MediaItem* ItemAtPoint(HWND hTrackView, POINT p, RECT* rExtents, MediaTrack** pT
 	SCROLLINFO si = { sizeof(SCROLLINFO), };
 	si.fMask = SIF_ALL;
 	CoolSB_GetScrollInfo(hTrackView, SB_HORZ, &si); // Get the current scroll pos
-	RECT r;
-	GetClientRect(hTrackView, &r);	// Get the window width
 	double dPos = (p.x + si.nPos) / GetHZoomLevel();
 
 	// Then, maybe find an item
-	for (int i = 0; i < GetTrackNumMediaItems(tr); i++)
+	const int iItem = g_trackViewGeom.ItemAt(iTrack, dPos);
+	if (iItem < 0)
+		return NULL;
+
+	if (rExtents)
 	{
-		MediaItem* mi = GetTrackMediaItem(tr, i);
-		double dStart = *(double*)GetSetMediaItemInfo(mi, "D_POSITION", NULL);
-		double dEnd   = *(double*)GetSetMediaItemInfo(mi, "D_LENGTH", NULL) + dStart;
-		if (dPos >= dStart && dPos <= dEnd)
-		{
-			if (rExtents)
-			{
-				rExtents->left  = (int)(GetHZoomLevel() * dStart + 0.5) - si.nPos;
-				rExtents->right = (int)(GetHZoomLevel() * dEnd + 0.5) - si.nPos;
-			}
-			return mi;
-		}
+		double dStart, dEnd;
+		g_trackViewGeom.GetItemExtents(iTrack, iItem, &dStart, &dEnd);
+		rExtents->left  = (int)(GetHZoomLevel() * dStart + 0.5) - si.nPos;
+		rExtents->right = (int)(GetHZoomLevel() * dEnd + 0.5) - si.nPos;
 	}
-	return NULL;
+	return GetTrackMediaItem(tr, iItem);
 }
 
 // Class for saving/restoring the zoom state.  This is a lighter-weight version
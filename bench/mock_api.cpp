@@ -0,0 +1,643 @@
+/******************************************************************************
+/ mock_api.cpp
+/
+/ Copyright (c) 2026 and later SWS Extension Authors
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#include "stdafx.h"
+
+#include "mock_api.h"
+#include "../Breeder/BR_Util.h"
+
+#include <chrono>
+
+// from reaper_plugin_functions.h (REAPERAPI_IMPLEMENT, see reaper/reaper.cpp)
+int REAPERAPI_LoadAPI(void* (*getAPI)(const char*));
+
+extern "C" int SWELL_dllMain(HINSTANCE hInst, DWORD callMode, LPVOID _GetFunc); // swell-modstub-generic.cpp
+extern "C" void* SWELLAPI_GetFunc(const char* name);                            // swell-appstub-generic.cpp
+
+namespace {
+
+struct MockTrack;
+struct MockItem;
+
+struct MockPoint
+{
+	double time, value, tension;
+	int shape;
+	bool selected;
+
+	bool operator< (const MockPoint& other) const { return time < other.time; }
+};
+
+struct MockEnvelope
+{
+	MockTrack* track;
+	WDL_FastString name;
+	std::vector<MockPoint> points;
+};
+
+struct MockTake
+{
+	MockItem* item;
+	GUID guid;
+	PCM_source* source;
+	int chanMode;
+	double vol, pan, playrate;
+};
+
+struct MockItem
+{
+	MockTrack* track;
+	double position, length, vol;
+	WDL_PtrList<MockTake> takes;
+};
+
+struct MockTrack
+{
+	GUID guid;
+	WDL_FastString chunk;
+	double vol;
+	int nchan;
+	WDL_PtrList<MockEnvelope> envelopes;
+};
+
+struct MockAccessor
+{
+	MockTake* take;
+};
+
+// Looped 1 second tone (one integer frequency per channel, so the loop is seamless)
+class MockPCMSource : public PCM_source
+{
+public:
+	MockPCMSource(double length, int samplerate, int channels)
+		: m_length(length), m_samplerate(samplerate), m_channels(channels)
+	{
+		m_loop.Resize(samplerate * channels, false);
+		for (int i = 0; i < samplerate; ++i)
+			for (int ch = 0; ch < channels; ++ch)
+				m_loop.Get()[i * channels + ch] = 0.25 * sin(2.0 * M_PI * (440.0 + 220.0 * ch) * i / samplerate);
+	}
+
+	PCM_source *Duplicate() override { return new MockPCMSource(m_length, m_samplerate, m_channels); }
+	bool   IsAvailable() override { return true; }
+	const char *GetType() override { return "SWS_BENCH"; }
+	bool   SetFileName(const char *) override { return false; }
+	int    GetNumChannels() override { return m_channels; }
+	double GetSampleRate() override { return m_samplerate; }
+	double GetLength() override { return m_length; }
+	int    PropertiesWindow(HWND) override { return 0; }
+
+	void GetSamples(PCM_source_transfer_t *block) override
+	{
+		const INT64 start = (INT64)floor(block->time_s * m_samplerate + 0.5);
+		const INT64 total = (INT64)(m_length * m_samplerate);
+		const int count = start < 0 || start >= total ? 0 : (int)min((INT64)block->length, total - start);
+
+		for (int i = 0; i < count; ++i)
+		{
+			const ReaSample* frame = m_loop.Get() + ((start + i) % m_samplerate) * m_channels;
+			for (int ch = 0; ch < block->nch; ++ch)
+				block->samples[i * block->nch + ch] = ch < m_channels ? frame[ch] : 0.0;
+		}
+		block->samples_out = count;
+	}
+
+	void   GetPeakInfo(PCM_source_peaktransfer_t *) override {}
+	void   SaveState(ProjectStateContext *) override {}
+	int    LoadState(const char *, ProjectStateContext *) override { return -1; }
+	void   Peaks_Clear(bool) override {}
+	int    PeaksBuild_Begin() override { return 0; }
+	int    PeaksBuild_Run() override { return 0; }
+	void   PeaksBuild_Finish() override {}
+
+private:
+	double m_length;
+	int m_samplerate, m_channels;
+	WDL_TypedBuf<ReaSample> m_loop;
+};
+
+}
+
+static WDL_PtrList_DOD<MockTrack>    g_tracks;
+static WDL_PtrList_DOD<MockItem>     g_items;
+static WDL_PtrList_DOD<MockTake>     g_takes;
+static WDL_PtrList_DOD<MockEnvelope> g_envelopes;
+static WDL_PtrList_DOD<PCM_source>   g_sources;
+static MockTrack                     g_master;
+static char                          g_project; // only its address is used
+static WDL_FastString                g_resourcePath, g_iniFile;
+static unsigned int                  g_guidCounter = 0;
+
+static MockTrack*    ToMock(MediaTrack* tr)         { return reinterpret_cast<MockTrack*>(tr); }
+static MockItem*     ToMock(MediaItem* item)        { return reinterpret_cast<MockItem*>(item); }
+static MockTake*     ToMock(MediaItem_Take* take)   { return reinterpret_cast<MockTake*>(take); }
+static MockEnvelope* ToMock(TrackEnvelope* env)     { return reinterpret_cast<MockEnvelope*>(env); }
+static MockAccessor* ToMock(AudioAccessor* acc)     { return reinterpret_cast<MockAccessor*>(acc); }
+
+static void NewGuid(GUID* guid)
+{
+	memset(guid, 0, sizeof(GUID));
+	++g_guidCounter;
+	memcpy(guid, &g_guidCounter, sizeof(g_guidCounter));
+}
+
+static void SortPoints(MockEnvelope* env)
+{
+	std::stable_sort(env->points.begin(), env->points.end());
+}
+
+static void GetEnvelopeChunk(MockEnvelope* env, WDL_FastString* chunk)
+{
+	chunk->Set("<");
+	chunk->Append(!strcmp(env->name.Get(), "Volume") ? "VOLENV2" : "PARMENV");
+	chunk->Append("\nACT 1 -1\nVIS 1 1 1\nLANEHEIGHT 0 0\nARM 0\nDEFSHAPE 0 -1 -1\n");
+	for (const MockPoint& pt : env->points)
+		chunk->AppendFormatted(256, "PT %.12f %.10f %d 0 %d 0 %.8f\n", pt.time, pt.value, pt.shape, pt.selected ? 1 : 0, pt.tension);
+	chunk->Append(">\n");
+}
+
+static void SetEnvelopeChunk(MockEnvelope* env, const char* chunk)
+{
+	env->points.clear();
+	LineParser lp(false);
+	WDL_FastString line;
+	for (const char* p = chunk; *p; )
+	{
+		const char* eol = strchr(p, '\n');
+		line.Set(p, eol ? (int)(eol - p) : (int)strlen(p));
+		if (!lp.parse(line.Get()) && !strcmp(lp.gettoken_str(0), "PT"))
+		{
+			MockPoint pt = { lp.gettoken_float(1), lp.gettoken_float(2), lp.gettoken_float(7), lp.gettoken_int(3), (lp.gettoken_int(5) & 1) == 1 };
+			env->points.push_back(pt);
+		}
+		if (!eol)
+			break;
+		p = eol + 1;
+	}
+}
+
+/******************************************************************************
+* Mocked API functions                                                        *
+******************************************************************************/
+static double Mock_time_precise()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char* Mock_GetResourcePath() { return g_resourcePath.Get(); }
+static const char* Mock_get_ini_file()    { return g_iniFile.Get(); }
+
+static void* Mock_get_config_var(const char* name, int* szOut)                 { if (szOut) *szOut = 0; return NULL; }
+static int   Mock_projectconfig_var_getoffs(const char* name, int* szOut)      { if (szOut) *szOut = 0; return 0; }
+static void* Mock_projectconfig_var_addr(ReaProject* proj, int idx)            { return NULL; }
+
+static ReaProject* Mock_EnumProjects(int idx, char* projfnOutOptional, int projfnOutOptional_sz)
+{
+	if (projfnOutOptional && projfnOutOptional_sz > 0)
+		*projfnOutOptional = '\0';
+	return idx <= 0 ? reinterpret_cast<ReaProject*>(&g_project) : NULL;
+}
+
+static int  Mock_GetPlayStateEx(ReaProject* proj)      { return 0; }
+static void Mock_PreventUIRefresh(int prevent_count)   {}
+static void Mock_UpdateArrange()                       {}
+static void Mock_UpdateTimeline()                      {}
+
+static double Mock_parse_timestr_len(const char* buf, double offset, int modeoverride)
+{
+	// only used by SWS to get the project sample rate (mode 4: samples)
+	return modeoverride == 4 ? atof(buf) / 48000.0 : atof(buf);
+}
+
+static bool Mock_ValidatePtr(void* pointer, const char* ctypename)
+{
+	if (!strcmp(ctypename, "MediaTrack*"))      return pointer == &g_master || g_tracks.Find((MockTrack*)pointer) >= 0;
+	if (!strcmp(ctypename, "MediaItem*"))       return g_items.Find((MockItem*)pointer) >= 0;
+	if (!strcmp(ctypename, "MediaItem_Take*"))  return g_takes.Find((MockTake*)pointer) >= 0;
+	if (!strcmp(ctypename, "TrackEnvelope*"))   return g_envelopes.Find((MockEnvelope*)pointer) >= 0;
+	return false;
+}
+
+static int         Mock_CountTracks(ReaProject* proj)              { return g_tracks.GetSize(); }
+static int         Mock_GetNumTracks()                             { return g_tracks.GetSize(); }
+static MediaTrack* Mock_GetTrack(ReaProject* proj, int trackidx)   { return reinterpret_cast<MediaTrack*>(g_tracks.Get(trackidx)); }
+static MediaTrack* Mock_GetMasterTrack(ReaProject* proj)           { return reinterpret_cast<MediaTrack*>(&g_master); }
+
+static MediaTrack* Mock_CSurf_TrackFromID(int idx, bool mcpView)
+{
+	return reinterpret_cast<MediaTrack*>(idx ? g_tracks.Get(idx - 1) : &g_master);
+}
+
+static void* Mock_GetSetMediaTrackInfo(MediaTrack* tr, const char* parmname, void* setNewValue)
+{
+	MockTrack* track = ToMock(tr);
+	if (!track) return NULL;
+	if (!strcmp(parmname, "GUID"))    return &track->guid;
+	if (!strcmp(parmname, "D_VOL"))   return &track->vol;
+	if (!strcmp(parmname, "I_NCHAN")) return &track->nchan;
+	return NULL;
+}
+
+static double Mock_GetMediaTrackInfo_Value(MediaTrack* tr, const char* parmname)
+{
+	MockTrack* track = ToMock(tr);
+	if (!track) return 0.0;
+	if (!strcmp(parmname, "D_VOL"))   return track->vol;
+	if (!strcmp(parmname, "I_NCHAN")) return track->nchan;
+	return 0.0;
+}
+
+static char* Mock_GetSetObjectState(void* obj, const char* str)
+{
+	WDL_FastString chunk;
+	if (g_envelopes.Find((MockEnvelope*)obj) >= 0)
+	{
+		if (str && *str)
+		{
+			SetEnvelopeChunk((MockEnvelope*)obj, str);
+			return NULL;
+		}
+		GetEnvelopeChunk((MockEnvelope*)obj, &chunk);
+	}
+	else if (g_tracks.Find((MockTrack*)obj) >= 0)
+	{
+		if (str && *str)
+		{
+			((MockTrack*)obj)->chunk.Set(str);
+			return NULL;
+		}
+		chunk.Set(&((MockTrack*)obj)->chunk);
+	}
+	else
+		return NULL;
+
+	char* state = (char*)malloc(chunk.GetLength() + 1);
+	if (state)
+		memcpy(state, chunk.Get(), chunk.GetLength() + 1);
+	return state;
+}
+
+static void Mock_FreeHeapPtr(void* ptr)
+{
+	free(ptr);
+}
+
+static int Mock_CountTrackEnvelopes(MediaTrack* track)
+{
+	return ToMock(track) ? ToMock(track)->envelopes.GetSize() : 0;
+}
+
+static TrackEnvelope* Mock_GetTrackEnvelope(MediaTrack* track, int envidx)
+{
+	return ToMock(track) ? reinterpret_cast<TrackEnvelope*>(ToMock(track)->envelopes.Get(envidx)) : NULL;
+}
+
+static TrackEnvelope* Mock_GetTrackEnvelopeByName(MediaTrack* track, const char* envname)
+{
+	if (MockTrack* tr = ToMock(track))
+		for (int i = 0; i < tr->envelopes.GetSize(); ++i)
+			if (!strcmp(tr->envelopes.Get(i)->name.Get(), envname))
+				return reinterpret_cast<TrackEnvelope*>(tr->envelopes.Get(i));
+	return NULL;
+}
+
+static int Mock_GetEnvelopeScalingMode(TrackEnvelope* env) { return 0; }
+static int Mock_CountEnvelopePoints(TrackEnvelope* envelope) { return (int)ToMock(envelope)->points.size(); }
+
+static bool Mock_GetEnvelopePoint(TrackEnvelope* envelope, int ptidx, double* timeOut, double* valueOut, int* shapeOut, double* tensionOut, bool* selectedOut)
+{
+	MockEnvelope* env = ToMock(envelope);
+	if (ptidx < 0 || ptidx >= (int)env->points.size())
+		return false;
+
+	const MockPoint& pt = env->points[ptidx];
+	WritePtr(timeOut, pt.time);
+	WritePtr(valueOut, pt.value);
+	WritePtr(shapeOut, pt.shape);
+	WritePtr(tensionOut, pt.tension);
+	WritePtr(selectedOut, pt.selected);
+	return true;
+}
+
+static bool Mock_SetEnvelopePoint(TrackEnvelope* envelope, int ptidx, double* timeInOptional, double* valueInOptional, int* shapeInOptional, double* tensionInOptional, bool* selectedInOptional, bool* noSortInOptional)
+{
+	MockEnvelope* env = ToMock(envelope);
+	if (ptidx < 0 || ptidx >= (int)env->points.size())
+		return false;
+
+	MockPoint& pt = env->points[ptidx];
+	ReadPtr(timeInOptional, pt.time);
+	ReadPtr(valueInOptional, pt.value);
+	ReadPtr(shapeInOptional, pt.shape);
+	ReadPtr(tensionInOptional, pt.tension);
+	ReadPtr(selectedInOptional, pt.selected);
+	if (!noSortInOptional || !*noSortInOptional)
+		SortPoints(env);
+	return true;
+}
+
+static bool Mock_InsertEnvelopePoint(TrackEnvelope* envelope, double time, double value, int shape, double tension, bool selected, bool* noSortInOptional)
+{
+	MockEnvelope* env = ToMock(envelope);
+	MockPoint pt = { time, value, tension, shape, selected };
+	env->points.push_back(pt);
+	if (!noSortInOptional || !*noSortInOptional)
+		SortPoints(env);
+	return true;
+}
+
+static bool Mock_DeleteEnvelopePointRange(TrackEnvelope* envelope, double time_start, double time_end)
+{
+	std::vector<MockPoint>& points = ToMock(envelope)->points;
+	points.erase(std::remove_if(points.begin(), points.end(), [=] (const MockPoint& pt) {
+		return pt.time >= time_start && pt.time < time_end;
+	}), points.end());
+	return true;
+}
+
+static bool Mock_Envelope_SortPoints(TrackEnvelope* envelope)
+{
+	SortPoints(ToMock(envelope));
+	return true;
+}
+
+static int       Mock_CountMediaItems(ReaProject* proj)                 { return g_items.GetSize(); }
+static MediaItem* Mock_GetMediaItem(ReaProject* proj, int itemidx)      { return reinterpret_cast<MediaItem*>(g_items.Get(itemidx)); }
+static int       Mock_CountTakes(MediaItem* item)                       { return ToMock(item)->takes.GetSize(); }
+static int       Mock_GetMediaItemNumTakes(MediaItem* item)             { return ToMock(item)->takes.GetSize(); }
+static MediaItem_Take* Mock_GetTake(MediaItem* item, int takeidx)       { return reinterpret_cast<MediaItem_Take*>(ToMock(item)->takes.Get(takeidx)); }
+static MediaItem_Take* Mock_GetMediaItemTake(MediaItem* item, int tk)   { return reinterpret_cast<MediaItem_Take*>(ToMock(item)->takes.Get(tk < 0 ? 0 : tk)); }
+static MediaItem* Mock_GetMediaItemTake_Item(MediaItem_Take* take)      { return reinterpret_cast<MediaItem*>(ToMock(take)->item); }
+static PCM_source* Mock_GetMediaItemTake_Source(MediaItem_Take* take)   { return ToMock(take)->source; }
+static int       Mock_CountTakeEnvelopes(MediaItem_Take* take)          { return 0; }
+static TrackEnvelope* Mock_GetTakeEnvelope(MediaItem_Take* take, int envidx)              { return NULL; }
+static TrackEnvelope* Mock_GetTakeEnvelopeByName(MediaItem_Take* take, const char* envname) { return NULL; }
+
+static MediaItem_Take* Mock_GetMediaItemTakeByGUID(ReaProject* project, const GUID* guid)
+{
+	for (int i = 0; i < g_takes.GetSize(); ++i)
+		if (!memcmp(&g_takes.Get(i)->guid, guid, sizeof(GUID)))
+			return reinterpret_cast<MediaItem_Take*>(g_takes.Get(i));
+	return NULL;
+}
+
+static void* Mock_GetSetMediaItemInfo(MediaItem* item, const char* parmname, void* setNewValue)
+{
+	MockItem* it = ToMock(item);
+	if (!strcmp(parmname, "D_POSITION")) return &it->position;
+	if (!strcmp(parmname, "D_LENGTH"))   return &it->length;
+	if (!strcmp(parmname, "D_VOL"))      return &it->vol;
+	if (!strcmp(parmname, "P_TRACK"))    return it->track;
+	return NULL;
+}
+
+static double Mock_GetMediaItemInfo_Value(MediaItem* item, const char* parmname)
+{
+	MockItem* it = ToMock(item);
+	if (!strcmp(parmname, "D_POSITION")) return it->position;
+	if (!strcmp(parmname, "D_LENGTH"))   return it->length;
+	if (!strcmp(parmname, "D_VOL"))      return it->vol;
+	return 0.0;
+}
+
+static void* Mock_GetSetMediaItemTakeInfo(MediaItem_Take* tk, const char* parmname, void* setNewValue)
+{
+	MockTake* take = ToMock(tk);
+	if (!strcmp(parmname, "GUID"))       return &take->guid;
+	if (!strcmp(parmname, "I_CHANMODE")) return &take->chanMode;
+	if (!strcmp(parmname, "D_VOL"))      return &take->vol;
+	if (!strcmp(parmname, "D_PAN"))      return &take->pan;
+	if (!strcmp(parmname, "D_PLAYRATE")) return &take->playrate;
+	if (!strcmp(parmname, "P_ITEM"))     return take->item;
+	if (!strcmp(parmname, "P_SOURCE"))   return take->source;
+	return NULL;
+}
+
+static double Mock_GetMediaItemTakeInfo_Value(MediaItem_Take* tk, const char* parmname)
+{
+	MockTake* take = ToMock(tk);
+	if (!strcmp(parmname, "I_CHANMODE")) return take->chanMode;
+	if (!strcmp(parmname, "D_VOL"))      return take->vol;
+	if (!strcmp(parmname, "D_PAN"))      return take->pan;
+	if (!strcmp(parmname, "D_PLAYRATE")) return take->playrate;
+	return 0.0;
+}
+
+static bool Mock_TakeIsMIDI(MediaItem_Take* take) { return false; }
+
+static AudioAccessor* Mock_CreateTakeAudioAccessor(MediaItem_Take* take)
+{
+	MockAccessor* accessor = new MockAccessor;
+	accessor->take = ToMock(take);
+	return reinterpret_cast<AudioAccessor*>(accessor);
+}
+
+static void Mock_DestroyAudioAccessor(AudioAccessor* accessor)
+{
+	delete ToMock(accessor);
+}
+
+static bool   Mock_AudioAccessorValidateState(AudioAccessor* accessor)  { return false; }
+static double Mock_GetAudioAccessorStartTime(AudioAccessor* accessor)   { return 0.0; }
+static double Mock_GetAudioAccessorEndTime(AudioAccessor* accessor)     { return ToMock(accessor) ? ToMock(accessor)->take->item->length : 0.0; }
+
+static void Mock_GetAudioAccessorHash(AudioAccessor* accessor, char* hashNeed128)
+{
+	snprintf(hashNeed128, 128, "%p", (void*)accessor);
+}
+
+static int Mock_GetAudioAccessorSamples(AudioAccessor* accessor, int samplerate, int numchannels, double starttime_sec, int numsamplesperchannel, double* samplebuffer)
+{
+	MockAccessor* acc = ToMock(accessor);
+	memset(samplebuffer, 0, sizeof(double) * numchannels * numsamplesperchannel);
+
+	PCM_source_transfer_t t = {0,};
+	t.time_s = starttime_sec;
+	t.samplerate = samplerate;
+	t.nch = numchannels;
+	t.length = numsamplesperchannel;
+	t.samples = samplebuffer;
+	acc->take->source->GetSamples(&t);
+	return t.samples_out > 0 ? 1 : 0;
+}
+
+#define MOCK_FUNC(name) { #name, (void*)&Mock_##name }
+
+static const struct { const char* name; void* func; } g_mockFuncs[] =
+{
+	MOCK_FUNC(AudioAccessorValidateState),
+	MOCK_FUNC(CountEnvelopePoints),
+	MOCK_FUNC(CountMediaItems),
+	MOCK_FUNC(CountTakeEnvelopes),
+	MOCK_FUNC(CountTakes),
+	MOCK_FUNC(CountTrackEnvelopes),
+	MOCK_FUNC(CountTracks),
+	MOCK_FUNC(CreateTakeAudioAccessor),
+	MOCK_FUNC(CSurf_TrackFromID),
+	MOCK_FUNC(DeleteEnvelopePointRange),
+	MOCK_FUNC(DestroyAudioAccessor),
+	MOCK_FUNC(EnumProjects),
+	MOCK_FUNC(Envelope_SortPoints),
+	MOCK_FUNC(FreeHeapPtr),
+	MOCK_FUNC(get_config_var),
+	MOCK_FUNC(get_ini_file),
+	MOCK_FUNC(GetAudioAccessorEndTime),
+	MOCK_FUNC(GetAudioAccessorHash),
+	MOCK_FUNC(GetAudioAccessorSamples),
+	MOCK_FUNC(GetAudioAccessorStartTime),
+	MOCK_FUNC(GetEnvelopePoint),
+	MOCK_FUNC(GetEnvelopeScalingMode),
+	MOCK_FUNC(GetMasterTrack),
+	MOCK_FUNC(GetMediaItem),
+	MOCK_FUNC(GetMediaItemInfo_Value),
+	MOCK_FUNC(GetMediaItemNumTakes),
+	MOCK_FUNC(GetMediaItemTake),
+	MOCK_FUNC(GetMediaItemTake_Item),
+	MOCK_FUNC(GetMediaItemTake_Source),
+	MOCK_FUNC(GetMediaItemTakeByGUID),
+	MOCK_FUNC(GetMediaItemTakeInfo_Value),
+	MOCK_FUNC(GetMediaTrackInfo_Value),
+	MOCK_FUNC(GetNumTracks),
+	MOCK_FUNC(GetPlayStateEx),
+	MOCK_FUNC(GetResourcePath),
+	MOCK_FUNC(GetSetMediaItemInfo),
+	MOCK_FUNC(GetSetMediaItemTakeInfo),
+	MOCK_FUNC(GetSetMediaTrackInfo),
+	MOCK_FUNC(GetSetObjectState),
+	MOCK_FUNC(GetTake),
+	MOCK_FUNC(GetTakeEnvelope),
+	MOCK_FUNC(GetTakeEnvelopeByName),
+	MOCK_FUNC(GetTrack),
+	MOCK_FUNC(GetTrackEnvelope),
+	MOCK_FUNC(GetTrackEnvelopeByName),
+	MOCK_FUNC(InsertEnvelopePoint),
+	MOCK_FUNC(parse_timestr_len),
+	MOCK_FUNC(PreventUIRefresh),
+	MOCK_FUNC(projectconfig_var_addr),
+	MOCK_FUNC(projectconfig_var_getoffs),
+	MOCK_FUNC(SetEnvelopePoint),
+	MOCK_FUNC(TakeIsMIDI),
+	MOCK_FUNC(time_precise),
+	MOCK_FUNC(UpdateArrange),
+	MOCK_FUNC(UpdateTimeline),
+	MOCK_FUNC(ValidatePtr),
+};
+
+static void* MockAPI_GetFunc(const char* name)
+{
+	for (size_t i = 0; i < sizeof(g_mockFuncs) / sizeof(g_mockFuncs[0]); ++i)
+		if (!strcmp(g_mockFuncs[i].name, name))
+			return g_mockFuncs[i].func;
+	return NULL;
+}
+
+/******************************************************************************
+* Mock project                                                                *
+******************************************************************************/
+bool MockAPI_Init(const char* tempDir)
+{
+	g_resourcePath.Set(tempDir);
+	g_iniFile.SetFormatted(4096, "%s%creaper.ini", tempDir, PATH_SLASH_CHAR);
+
+	NewGuid(&g_master.guid);
+	g_master.vol = 1.0;
+	g_master.nchan = 2;
+
+	if (!SWELL_dllMain(g_hInst, DLL_PROCESS_ATTACH, (LPVOID)SWELLAPI_GetFunc))
+		return false;
+
+	// most of the API is intentionally missing, see mock_api.h
+	REAPERAPI_LoadAPI(MockAPI_GetFunc);
+	return CountTracks && GetSetObjectState && GetAudioAccessorSamples;
+}
+
+void MockAPI_Reset()
+{
+	g_envelopes.Empty(true);
+	g_takes.Empty(true);
+	g_items.Empty(true);
+	g_tracks.Empty(true);
+	g_sources.Empty(true);
+}
+
+MediaTrack* MockAPI_AddTrack(const char* chunk)
+{
+	MockTrack* track = new MockTrack;
+	NewGuid(&track->guid);
+	track->vol = 1.0;
+	track->nchan = 2;
+	if (chunk)
+		track->chunk.Set(chunk);
+	else
+		track->chunk.SetFormatted(256, "<TRACK\nNAME \"Track %d\"\nPEAKCOL 16576\nBEAT -1\nAUTOMODE 0\nVOLPAN 1 0 -1 -1 1\nMUTESOLO 0 0 0\nIPHASE 0\nISBUS 0 0\nBUSCOMP 0 0 0 0 0\nSHOWINMIX 1 0.6667 0.5 1 0.5 0 0 0\nFREEMODE 0\nSEL 0\nREC 0 0 1 0 0 0 0 0\nVU 2\nTRACKHEIGHT 0 0 0 0 0 0\nINQ 0 0 0 0.5 100 0 0 100\nNCHAN 2\nFX 1\nPERF 0\nMIDIOUT -1\nMAINSEND 1 0\n>\n", g_tracks.GetSize() + 1);
+	g_tracks.Add(track);
+	return reinterpret_cast<MediaTrack*>(track);
+}
+
+TrackEnvelope* MockAPI_AddEnvelope(MediaTrack* tr, const char* name, int pointCount)
+{
+	MockEnvelope* env = new MockEnvelope;
+	env->track = ToMock(tr);
+	env->name.Set(name);
+	env->points.reserve(pointCount);
+	for (int i = 0; i < pointCount; ++i)
+	{
+		MockPoint pt = { i * 0.01, (i % 2) ? 0.5 : 1.0, 0.0, 0, false };
+		env->points.push_back(pt);
+	}
+	ToMock(tr)->envelopes.Add(env);
+	g_envelopes.Add(env);
+	return reinterpret_cast<TrackEnvelope*>(env);
+}
+
+PCM_source* MockAPI_CreateAudioSource(double length, int samplerate, int channels)
+{
+	return new MockPCMSource(length, samplerate, channels);
+}
+
+MediaItem_Take* MockAPI_AddAudioItem(MediaTrack* tr, double length, int samplerate, int channels)
+{
+	MockItem* item = new MockItem;
+	item->track = ToMock(tr);
+	item->position = 0.0;
+	item->length = length;
+	item->vol = 1.0;
+
+	MockTake* take = new MockTake;
+	take->item = item;
+	NewGuid(&take->guid);
+	take->source = g_sources.Add(MockAPI_CreateAudioSource(length, samplerate, channels));
+	take->chanMode = 0;
+	take->vol = 1.0;
+	take->pan = 0.0;
+	take->playrate = 1.0;
+
+	item->takes.Add(take);
+	g_items.Add(item);
+	g_takes.Add(take);
+	return reinterpret_cast<MediaItem_Take*>(take);
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+/ mock_api.h
+/
+/ Copyright (c) 2026 and later SWS Extension Authors
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+#pragma once
+
+// Headless stand-in for REAPER, used by sws_bench.
+//
+// A single in-memory project made of synthetic tracks (with their state
+// chunks), track envelopes, items and takes. Takes play a looped 1 second
+// tone, so hours of audio cost no memory. Only the API functions reached by
+// the benchmarked code paths are implemented: anything else is left NULL on
+// purpose (a benchmark that starts using a new API function crashes on the
+// first call instead of silently measuring a stub).
+//
+// MockAPI_Init() binds both the REAPER API (through REAPERAPI_LoadAPI(), as
+// the extension would get it from reaper_plugin_info_t::GetFunc) and SWELL
+// (from the headless SWELL build linked into the benchmark, through the same
+// SWELL_dllMain() entry point REAPER calls when loading the extension).
+
+bool MockAPI_Init(const char* tempDir);
+void MockAPI_Reset(); // deletes all tracks, items, envelopes and sources
+
+MediaTrack* MockAPI_AddTrack(const char* chunk); // NULL chunk: minimal track
+TrackEnvelope* MockAPI_AddEnvelope(MediaTrack* track, const char* name, int pointCount);
+MediaItem_Take* MockAPI_AddAudioItem(MediaTrack* track, double length, int samplerate, int channels);
+PCM_source* MockAPI_CreateAudioSource(double length, int samplerate, int channels); // caller owns
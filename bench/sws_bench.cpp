@@ -0,0 +1,564 @@
+/******************************************************************************
+/ sws_bench.cpp
+/
+/ Copyright (c) 2026 and later SWS Extension Authors
+/
+/
+/ Permission is hereby granted, free of charge, to any person obtaining a copy
+/ of this software and associated documentation files (the "Software"), to deal
+/ in the Software without restriction, including without limitation the rights to
+/ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+/ of the Software, and to permit persons to whom the Software is furnished to
+/ do so, subject to the following conditions:
+/
+/ The above copyright notice and this permission notice shall be included in all
+/ copies or substantial portions of the Software.
+/
+/ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+/ EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+/ OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+/ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+/ HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+/ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+/ FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+/ OTHER DEALINGS IN THE SOFTWARE.
+/
+******************************************************************************/
+
+// Headless benchmark of SWS hot paths, see mock_api.h for the REAPER side.
+//
+// Usage: sws_bench [--runs N] [--filter TEXT] [-o results.json]
+//
+// Every case runs at fixed scales, N times (default: 5). Progress and a
+// summary table go to stderr, results (min/median/max per case and the SWS
+// internal profiler scopes) are written as JSON to stdout or to the -o file.
+// No user input is ever requested. Before the Base64 cases, the codec is
+// checked against the previous implementation (base64_ref.cpp): any mismatch
+// makes sws_bench fail.
+
+#include "stdafx.h"
+
+#include "base64_ref.h"
+#include "mock_api.h"
+#include "../Breeder/BR_EnvelopeUtil.h"
+#include "../Breeder/BR_Loudness.h"
+#include "../Breeder/BR_Util.h"
+#include "../Misc/Analysis.h"
+#include "../Utility/Base64.h"
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+static const int    SCALES_TRACKS[]     = {100, 1000, 10000};
+static const int    SCALES_CHUNK_MB[]   = {1, 10};
+static const int    SCALES_ENV_POINTS[] = {10000, 100000};
+static const double AUDIO_LENGTH        = 3600.0; // seconds
+static const int    AUDIO_SAMPLERATE    = 48000;
+
+struct BenchResult
+{
+	WDL_FastString name, scale;
+	double min, median, max;
+};
+
+static int                 g_runs = 5;
+static const char*         g_filter = NULL;
+static vector<BenchResult> g_results;
+
+static void Bench(const char* name, const char* scale, const std::function<void()>& func, const std::function<void()>& setup = nullptr)
+{
+	if (g_filter && !stristr(name, g_filter))
+		return;
+
+	vector<double> times;
+	for (int run = 0; run < g_runs; ++run)
+	{
+		if (setup)
+			setup();
+
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	sort(times.begin(), times.end());
+
+	BenchResult res;
+	res.name.Set(name);
+	res.scale.Set(scale);
+	res.min = times.front();
+	res.median = times[(times.size() - 1) / 2];
+	res.max = times.back();
+	g_results.push_back(res);
+
+	fprintf(stderr, "%-52s %-12s min %10.3f ms   median %10.3f ms   max %10.3f ms\n", name, scale, res.min, res.median, res.max);
+}
+
+static void AppendJsonString(WDL_FastString* json, const char* str)
+{
+	json->Append("\"");
+	for (; *str; ++str)
+	{
+		if (*str == '"' || *str == '\\')
+			json->Append("\\");
+		json->Append(str, 1);
+	}
+	json->Append("\"");
+}
+
+/******************************************************************************
+* Chunk parser (SNM_ChunkParserPatcher)                                       *
+******************************************************************************/
+static void BenchTrackChunks()
+{
+	for (int n : SCALES_TRACKS)
+	{
+		MockAPI_Reset();
+		for (int i = 0; i < n; ++i)
+			MockAPI_AddTrack(NULL);
+
+		char scale[64];
+		snprintf(scale, sizeof(scale), "%d tracks", n);
+
+		Bench("SNM_ChunkParserPatcher get (all tracks)", scale, [n] {
+			char name[256];
+			for (int i = 0; i < n; ++i)
+			{
+				SNM_ChunkParserPatcher p(CSurf_TrackFromID(i + 1, false), false);
+				p.Parse(SNM_GET_CHUNK_CHAR, 1, "TRACK", "NAME", 0, 1, name);
+			}
+		});
+
+		int run = 0;
+		Bench("SNM_ChunkParserPatcher set (all tracks)", scale, [n, &run] {
+			const char* height = (++run % 2) ? "40" : "0"; // always a real update
+			for (int i = 0; i < n; ++i)
+			{
+				SNM_ChunkParserPatcher p(CSurf_TrackFromID(i + 1, false));
+				p.ParsePatch(SNM_SET_CHUNK_CHAR, 1, "TRACK", "TRACKHEIGHT", 0, 1, (void*)height);
+			}
+		});
+	}
+
+	for (int mb : SCALES_CHUNK_MB)
+	{
+		MockAPI_Reset();
+
+		WDL_FastString chunk;
+		chunk.Set("<TRACK\nNAME bench\n");
+		for (int pos = 0; chunk.GetLength() < mb * 1024 * 1024; ++pos)
+			chunk.AppendFormatted(256, "<ITEM\nPOSITION %d.000\nLENGTH 1\nNAME \"bench item %d\"\n>\n", pos, pos);
+		chunk.Append(">\n");
+		MediaTrack* tr = MockAPI_AddTrack(chunk.Get());
+
+		char scale[64];
+		snprintf(scale, sizeof(scale), "%d MB", mb);
+
+		Bench("SNM_ChunkParserPatcher get (count items)", scale, [tr] {
+			SNM_ChunkParserPatcher p(tr, false);
+			p.Parse(SNM_COUNT_KEYWORD, 2, "ITEM", "POSITION");
+		});
+
+		int run = 0;
+		Bench("SNM_ChunkParserPatcher set (all item lengths)", scale, [tr, &run] {
+			SNM_ChunkParserPatcher p(tr);
+			p.ParsePatch(SNM_SET_CHUNK_CHAR, 2, "ITEM", "LENGTH", -1, 1, (void*)((++run % 2) ? "2" : "1"));
+		});
+	}
+}
+
+/******************************************************************************
+* Envelopes (BR_Envelope)                                                     *
+******************************************************************************/
+static void BenchEnvelopes()
+{
+	for (int n : SCALES_ENV_POINTS)
+	{
+		MockAPI_Reset();
+		TrackEnvelope* env = MockAPI_AddEnvelope(MockAPI_AddTrack(NULL), "Volume", n);
+
+		char scale[64];
+		snprintf(scale, sizeof(scale), "%d points", n);
+
+		Bench("BR_Envelope build + GetPoint (all points)", scale, [env] {
+			BR_Envelope envelope(env);
+			double position, value;
+			for (int i = 0; i < envelope.CountPoints(); ++i)
+				envelope.GetPoint(i, &position, &value, NULL, NULL);
+		});
+
+		int run = 0;
+		Bench("BR_Envelope SetPoint (all points) + Commit", scale, [env, &run] {
+			BR_Envelope envelope(env);
+			const double offset = (++run % 2) ? 0.1 : -0.1;
+			for (int i = 0; i < envelope.CountPoints(); ++i)
+			{
+				double value;
+				envelope.GetPoint(i, NULL, &value, NULL, NULL);
+				value += offset;
+				envelope.SetPoint(i, NULL, &value, NULL, NULL);
+			}
+			envelope.Commit();
+		});
+	}
+}
+
+/******************************************************************************
+* Audio analysis (BR_LoudnessObject/libebur128, AnalyzePCMSource)             *
+******************************************************************************/
+static void AnalyzeLoudness(MediaItem_Take* take, bool integratedOnly, bool doTruePeak)
+{
+	BR_LoudnessObject loudness(take);
+	if (loudness.Analyze(integratedOnly, doTruePeak, false, true))
+		while (loudness.IsRunning())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+static void AnalyzeSource(PCM_source* source, double windowSize)
+{
+	double peaks[2], rms[2];
+	INT64 peakSamples[2], peakRMSsamples[2];
+
+	ANALYZE_PCM a;
+	memset(&a, 0, sizeof(a));
+	a.pcm = source;
+	a.iChannels = 2;
+	a.dPeakVals = peaks;
+	a.dRMSs = rms;
+	a.peakSamples = peakSamples;
+	a.peakRMSsamples = peakRMSsamples;
+	a.dWindowSize = windowSize;
+	AnalyzePCMSource(&a);
+}
+
+static void BenchAudio()
+{
+	MockAPI_Reset();
+	MediaItem_Take* take = MockAPI_AddAudioItem(MockAPI_AddTrack(NULL), AUDIO_LENGTH, AUDIO_SAMPLERATE, 2);
+	PCM_source* source = MockAPI_CreateAudioSource(AUDIO_LENGTH, AUDIO_SAMPLERATE, 2);
+
+	char scale[64];
+	snprintf(scale, sizeof(scale), "%g h", AUDIO_LENGTH / 3600.0);
+
+	Bench("BR_LoudnessObject (integrated only)", scale, [take] { AnalyzeLoudness(take, true, false); });
+	Bench("BR_LoudnessObject (all + true peak)", scale, [take] { AnalyzeLoudness(take, false, true); });
+	Bench("AnalyzePCMSource (peak/RMS)", scale, [source] { AnalyzeSource(source, 0.0); });
+	Bench("AnalyzePCMSource (windowed RMS)", scale, [source] { AnalyzeSource(source, 0.4); });
+
+	delete source;
+}
+
+/******************************************************************************
+* List views (SWS_ListView)                                                   *
+******************************************************************************/
+static int g_listGeneration = 0; // bumped to change every item text
+
+static SWS_LVColumn g_benchCols[] = { {50, 0, "#", 0}, {150, 0, "Name", 1}, {80, 0, "Volume", 2} };
+
+class BenchListView : public SWS_ListView
+{
+public:
+	BenchListView(HWND hwndList)
+	: SWS_ListView(hwndList, NULL, 3, g_benchCols, "SWS bench list", false, NULL) {}
+
+protected:
+	void GetItemText(SWS_ListItem* item, int iCol, char* str, int iStrMax)
+	{
+		MediaTrack* tr = (MediaTrack*)item;
+		const unsigned int id = ((GUID*)GetSetMediaTrackInfo(tr, "GUID", NULL))->Data1;
+		switch (iCol)
+		{
+			case 0: snprintf(str, iStrMax, "%u", id); break;
+			case 1: snprintf(str, iStrMax, "Track %u (%d)", id, g_listGeneration); break;
+			case 2: snprintf(str, iStrMax, "%.2f dB", VAL2DB(GetMediaTrackInfo_Value(tr, "D_VOL"))); break;
+			default: *str = '\0'; break;
+		}
+	}
+
+	void GetItemList(SWS_ListItemList* pList)
+	{
+		for (int i = 0; i < CountTracks(NULL); ++i)
+			pList->Add((SWS_ListItem*)GetTrack(NULL, i));
+	}
+};
+
+static WDL_DLGRET BenchDlgProc(HWND hwndDlg, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	return 0;
+}
+
+static void BenchListViews()
+{
+	// any SWS dialog with a report list view does, its resources are built in
+	HWND hwnd = CreateDialog(g_hInst, MAKEINTRESOURCE(IDD_PROJLIST), NULL, BenchDlgProc);
+	HWND hwndList = hwnd ? GetDlgItem(hwnd, IDC_LIST) : NULL;
+	if (!hwndList)
+	{
+		fprintf(stderr, "SWS_ListView: could not create the list view, skipped\n");
+		return;
+	}
+
+	for (int n : SCALES_TRACKS)
+	{
+		MockAPI_Reset();
+		for (int i = 0; i < n; ++i)
+			MockAPI_AddTrack(NULL);
+
+		char scale[64];
+		snprintf(scale, sizeof(scale), "%d tracks", n);
+
+		BenchListView lv(hwndList);
+		Bench("SWS_ListView::Update (fill)", scale, [&lv] { lv.Update(); }, [hwndList] { ListView_DeleteAllItems(hwndList); });
+		Bench("SWS_ListView::Update (unchanged)", scale, [&lv] { lv.Update(); });
+		Bench("SWS_ListView::Update (all texts changed)", scale, [&lv] { lv.Update(); }, [] { ++g_listGeneration; });
+
+		ListView_DeleteAllItems(hwndList);
+	}
+
+	DestroyWindow(hwnd);
+}
+
+/******************************************************************************
+* Base64 (Utility/Base64 against the previous implementation, base64_ref.cpp) *
+******************************************************************************/
+static const int SCALES_BASE64_MB[] = {1, 10};
+
+static int g_base64Mismatches = 0;
+
+static void Base64Mismatch(const char* what, const string& input)
+{
+	if (++g_base64Mismatches <= 10)
+		fprintf(stderr, "Base64 mismatch: %s (input length %d)\n", what, (int)input.size());
+}
+
+// Compares all decoders with the reference, valid or not
+static void CheckBase64Decode(const string& encoded, std::mt19937& rng)
+{
+	Base64Ref ref;
+	int refLen = 0;
+	const char* refOut = ref.Decode(encoded.c_str(), &refLen);
+
+	Base64 b64;
+	int len = 0;
+	const char* out = b64.Decode(encoded.c_str(), &len);
+	if (!refOut != !out || (refOut && (refLen != len || memcmp(refOut, out, len))))
+		Base64Mismatch("Decode()", encoded);
+
+	vector<char> buf(Base64::DecodedMaxLength((int)encoded.size()) + 1);
+	len = Base64::DecodeTo(encoded.data(), (int)encoded.size(), buf.data());
+	if (!refOut != (len < 0) || (refOut && (refLen != len || memcmp(refOut, buf.data(), len))))
+		Base64Mismatch("DecodeTo()", encoded);
+
+	// streaming, in chunks of random sizes
+	Base64Decoder dec;
+	string streamed;
+	bool error = false;
+	for (size_t pos = 0; pos < encoded.size() && !error;)
+	{
+		const int n = (int)(rng() % (encoded.size() - pos + 1));
+		buf.resize(Base64Decoder::MaxOutput(n) + 3);
+		const int written = dec.Write(encoded.data() + pos, n, buf.data());
+		if (written < 0)
+			error = true;
+		else
+			streamed.append(buf.data(), written);
+		pos += n;
+	}
+	if (!error)
+	{
+		const int written = dec.Finish(buf.data());
+		if (written < 0)
+			error = true;
+		else
+			streamed.append(buf.data(), written);
+	}
+	if (!refOut != error || (refOut && (refLen != (int)streamed.size() || memcmp(refOut, streamed.data(), refLen))))
+		Base64Mismatch("Base64Decoder", encoded);
+}
+
+static void CheckBase64Encode(const string& input, bool pad, std::mt19937& rng)
+{
+	Base64Ref ref;
+	const string expected = ref.Encode(input.data(), (int)input.size(), pad);
+
+	Base64 b64;
+	if (expected != b64.Encode(input.data(), (int)input.size(), pad))
+		Base64Mismatch(pad ? "Encode(pad)" : "Encode()", input);
+
+	vector<char> buf(Base64::EncodedLength((int)input.size(), pad) + 4);
+	const int len = Base64::EncodeTo(input.data(), (int)input.size(), buf.data(), pad);
+	if (expected != string(buf.data(), len))
+		Base64Mismatch(pad ? "EncodeTo(pad)" : "EncodeTo()", input);
+
+	Base64Encoder enc(pad);
+	string streamed;
+	for (size_t pos = 0; pos < input.size();)
+	{
+		const int n = (int)(rng() % (input.size() - pos + 1));
+		buf.resize(Base64Encoder::MaxOutput(n) + 4);
+		streamed.append(buf.data(), enc.Write(input.data() + pos, n, buf.data()));
+		pos += n;
+	}
+	buf.resize(4);
+	streamed.append(buf.data(), enc.Finish(buf.data()));
+	if (expected != streamed)
+		Base64Mismatch(pad ? "Base64Encoder(pad)" : "Base64Encoder", input);
+}
+
+// Equivalence with the reference on random, truncated and corrupted inputs,
+// returns false on any mismatch
+static bool CheckBase64()
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::mt19937 rng(1);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		string input(rng() % (i < 10000 ? 40 : 400), '\0');
+		for (char& c : input)
+			c = (char)(rng() & 0xFF);
+
+		for (int pad = 0; pad < 2; ++pad)
+		{
+			CheckBase64Encode(input, !!pad, rng);
+
+			Base64Ref ref;
+			const string encoded = ref.Encode(input.data(), (int)input.size(), !!pad);
+			CheckBase64Decode(encoded, rng);
+
+			// truncated
+			CheckBase64Decode(encoded.substr(0, rng() % (encoded.size() + 1)), rng);
+
+			// corrupted: one char replaced by any non-null byte
+			if (!encoded.empty())
+			{
+				string corrupted = encoded;
+				corrupted[rng() % corrupted.size()] = (char)(rng() % 255 + 1);
+				CheckBase64Decode(corrupted, rng);
+			}
+
+			// random base64 chars, with '=' anywhere
+			string random(rng() % 100, '\0');
+			for (char& c : random)
+				c = (rng() % 8) ? alphabet[rng() % 64] : '=';
+			CheckBase64Decode(random, rng);
+		}
+	}
+
+	// every byte value at various offsets of a long valid string (SIMD validation)
+	for (int c = 1; c < 256; ++c)
+	{
+		for (int pos = 0; pos < 100; pos += 7)
+		{
+			string encoded(100, 'A');
+			encoded[pos] = (char)c;
+			CheckBase64Decode(encoded, rng);
+		}
+	}
+
+	fprintf(stderr, "Base64: %d mismatches with the reference implementation\n", g_base64Mismatches);
+	return !g_base64Mismatches;
+}
+
+static void BenchBase64()
+{
+	std::mt19937 rng(1);
+	for (int mb : SCALES_BASE64_MB)
+	{
+		string input((size_t)mb << 20, '\0');
+		for (char& c : input)
+			c = (char)(rng() & 0xFF);
+
+		Base64Ref ref;
+		const string encoded = ref.Encode(input.data(), (int)input.size(), true);
+
+		char scale[64];
+		snprintf(scale, sizeof(scale), "%d MB", mb);
+
+		// fresh objects each run, as the reference allocates on every call anyway
+		Bench("Base64 encode (reference)", scale, [&input] { Base64Ref b; b.Encode(input.data(), (int)input.size(), true); });
+		Bench("Base64 encode", scale, [&input] { Base64 b; b.Encode(input.data(), (int)input.size(), true); });
+		Bench("Base64 decode (reference)", scale, [&encoded] { int len; Base64Ref b; b.Decode(encoded.c_str(), &len); });
+		Bench("Base64 decode", scale, [&encoded] { int len; Base64 b; b.Decode(encoded.c_str(), &len); });
+	}
+}
+
+/******************************************************************************
+* Main                                                                        *
+******************************************************************************/
+int main(int argc, char* argv[])
+{
+	const char* output = NULL;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--runs") && i + 1 < argc)
+			g_runs = max(1, atoi(argv[++i]));
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			g_filter = argv[++i];
+		else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+			output = argv[++i];
+		else
+		{
+			fprintf(stderr, "Usage: %s [--runs N] [--filter TEXT] [-o results.json]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	char tempDir[] = "/tmp/sws_bench.XXXXXX";
+	if (!mkdtemp(tempDir) || !MockAPI_Init(tempDir))
+	{
+		fprintf(stderr, "Could not initialize the mock REAPER API\n");
+		return 1;
+	}
+
+	if ((!g_filter || stristr("Base64", g_filter)) && !CheckBase64())
+		return 1;
+
+	BR_ProfilerEnable(true, true);
+
+	BenchTrackChunks();
+	BenchEnvelopes();
+	BenchAudio();
+	BenchListViews();
+	BenchBase64();
+
+	MockAPI_Reset();
+
+	WDL_FastString json;
+	json.AppendFormatted(64, "{\n\"runs\": %d,\n\"results\": [\n", g_runs);
+	for (size_t i = 0; i < g_results.size(); ++i)
+	{
+		const BenchResult& res = g_results[i];
+		json.Append("  {\"name\":");
+		AppendJsonString(&json, res.name.Get());
+		json.Append(",\"scale\":");
+		AppendJsonString(&json, res.scale.Get());
+		json.AppendFormatted(256, ",\"min_ms\":%.3f,\"median_ms\":%.3f,\"max_ms\":%.3f}%s\n", res.min, res.median, res.max, i + 1 < g_results.size() ? "," : "");
+	}
+	json.Append("],\n\"scopes\": [\n");
+
+	const char* name;
+	int count;
+	double totalMs, maxMs;
+	for (int i = 0; BR_ProfilerGetStats(i, &name, &count, &totalMs, &maxMs, NULL); ++i)
+	{
+		json.Append(i ? ",\n  {\"name\":" : "  {\"name\":");
+		AppendJsonString(&json, name);
+		json.AppendFormatted(256, ",\"count\":%d,\"total_ms\":%.3f,\"max_ms\":%.3f}", count, totalMs, maxMs);
+	}
+	json.Append("\n]\n}\n");
+
+	BR_ProfilerEnable(false, true);
+
+	FILE* f = output ? fopen(output, "w") : stdout;
+	if (!f)
+	{
+		fprintf(stderr, "Could not write %s\n", output);
+		return 1;
+	}
+	fputs(json.Get(), f);
+	if (output)
+		fclose(f);
+	return 0;
+}
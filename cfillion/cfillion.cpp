@@ -686,12 +686,14 @@ CF_Preview *CF_CreatePreview(PCM_source *source)
   if(!source)
     return nullptr;
 
-  return new CF_Preview { source };
+  CF_Preview *preview { CF_Preview::create(source) };
+  return preview ? preview->handle() : nullptr;
 }
 
-bool CF_Preview_GetValue(CF_Preview *preview, const char *name, double *valueOut)
+bool CF_Preview_GetValue(CF_Preview *handle, const char *name, double *valueOut)
 {
-  if(!name || !valueOut || !CF_Preview::isValid(preview))
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  if(!name || !valueOut || !preview)
     return false;
 
   for(const auto &param : PREVIEW_PARAMS) {
@@ -702,17 +704,19 @@ bool CF_Preview_GetValue(CF_Preview *preview, const char *name, double *valueOut
   return false;
 }
 
-bool CF_Preview_GetPeak(CF_Preview *preview, const int channel, double *peakvolOut)
+bool CF_Preview_GetPeak(CF_Preview *handle, const int channel, double *peakvolOut)
 {
-  if(!peakvolOut || !CF_Preview::isValid(preview))
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  if(!peakvolOut || !preview)
     return false;
 
   return preview->getPeak(channel, peakvolOut);
 }
 
-bool CF_Preview_SetValue(CF_Preview *preview, const char *name, double newValue)
+bool CF_Preview_SetValue(CF_Preview *handle, const char *name, double newValue)
 {
-  if(!name || !CF_Preview::isValid(preview))
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  if(!name || !preview)
     return false;
 
   for(const auto &param : PREVIEW_PARAMS) {
@@ -723,29 +727,33 @@ bool CF_Preview_SetValue(CF_Preview *preview, const char *name, double newValue)
   return false;
 }
 
-MediaTrack *CF_Preview_GetOutputTrack(CF_Preview *preview)
+MediaTrack *CF_Preview_GetOutputTrack(CF_Preview *handle)
 {
-  return CF_Preview::isValid(preview) ? preview->getOutputTrack() : nullptr;
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  return preview ? preview->getOutputTrack() : nullptr;
 }
 
 // the ReaProject argument is there only to satisfy REAPER's argument validator
-bool CF_Preview_SetOutputTrack(CF_Preview *preview, ReaProject *, MediaTrack *track)
+bool CF_Preview_SetOutputTrack(CF_Preview *handle, ReaProject *, MediaTrack *track)
 {
-  if(!track || !CF_Preview::isValid(preview))
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  if(!track || !preview)
     return false;
 
   preview->setOutput(track);
   return true;
 }
 
-bool CF_Preview_Play(CF_Preview *preview)
+bool CF_Preview_Play(CF_Preview *handle)
 {
-  return CF_Preview::isValid(preview) ? preview->play() : false;
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  return preview ? preview->play() : false;
 }
 
-bool CF_Preview_Stop(CF_Preview *preview)
+bool CF_Preview_Stop(CF_Preview *handle)
 {
-  if(!CF_Preview::isValid(preview))
+  CF_Preview *preview { CF_Preview::fromHandle(handle) };
+  if(!preview)
     return false;
 
   // The internal API returns false if the stop request triggers a fade-out or
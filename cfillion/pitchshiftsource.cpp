@@ -6,30 +6,101 @@
 
 PitchShiftSource *PitchShiftSource::create(PCM_source *src)
 {
-  if(GetSourceType(src) == SourceType::MIDI) // "MIDI" or "MIDIPOOL"
+  if(isMIDI(src))
     return new PitchShiftSource_MIDI(src);
   else
     return new PitchShiftSource_Audio(src);
 }
 
+bool PitchShiftSource::isMIDI(PCM_source *src)
+{
+  return GetSourceType(src) == SourceType::MIDI; // "MIDI" or "MIDIPOOL"
+}
+
 PitchShiftSource::PitchShiftSource(PCM_source *src)
-  : m_pitch { 0.0 }, m_rate { 1.0 }, m_volume { 1.0 }, m_pan { 0.0 },
-    m_fadeInLen { 0.0 }, m_fadeOutLen { 0.0 }, m_flags { PreservePitch },
-    m_mode { -1 }, m_src { src->Duplicate() },
+  : m_flags { 0 }, m_src { src->Duplicate() },
     m_playTime { 0.0 }, m_writeTime { 0.0 }, m_fadeOutEnd { 0.0 }
 {
+  resetParams();
 }
 
 PitchShiftSource::~PitchShiftSource()
 {
-  PCM_Source_Destroy(m_src);
+  if(m_src)
+    PCM_Source_Destroy(m_src);
+}
+
+void PitchShiftSource::reset(PCM_source *src)
+{
+  WDL_MutexLockExclusive lock { &m_mutex };
+
+  if(m_src)
+    PCM_Source_Destroy(m_src);
+  m_src = src ? src->Duplicate() : nullptr;
+
+  resetParams();
+  m_flags = 0;
+  m_playTime = m_writeTime = m_fadeOutEnd = 0.0;
+
+  if(m_src)
+    resetState();
+}
+
+void PitchShiftSource_Audio::resetState()
+{
+  m_readTime = 0.0;
+  m_ps->Reset();
+  updateTempoShift(m_params);
+  m_peaks.assign(GetNumChannels(), {});
+}
+
+void PitchShiftSource_MIDI::resetState()
+{
+  updateTempoShift(m_params);
+  m_peaks.assign(16, {});
+}
+
+// not while playing: both sides of the triple buffer are reset
+void PitchShiftSource::resetParams()
+{
+  m_params = { 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, -1, true };
+  m_rate = m_params.rate;
+  for(Params &params : m_paramSlots)
+    params = m_params;
+  m_writeSlot = 0;
+  m_freshSlot = 1;
+  m_readSlot = 2;
+  m_curVolume = m_params.volume;
+  m_curPan = m_params.pan;
+}
+
+void PitchShiftSource::publishParams()
+{
+  m_rate = m_params.rate;
+  m_paramSlots[m_writeSlot] = m_params;
+  m_writeSlot = m_freshSlot.exchange(m_writeSlot | FreshParams) & SlotMask;
+}
+
+const PitchShiftSource::Params &PitchShiftSource::pullParams()
+{
+  if(m_freshSlot.load() & FreshParams) {
+    const Params previous { m_paramSlots[m_readSlot] };
+    m_readSlot = m_freshSlot.exchange(m_readSlot) & SlotMask;
+
+    const Params &params { m_paramSlots[m_readSlot] };
+    if(params.rate != previous.rate || params.pitch != previous.pitch ||
+        params.preservePitch != previous.preservePitch || params.mode != previous.mode)
+      updateTempoShift(params);
+  }
+
+  return m_paramSlots[m_readSlot];
 }
 
 PitchShiftSource_Audio::PitchShiftSource_Audio(PCM_source *src)
   : PitchShiftSource { src }, m_readTime { 0.0 },
     m_ps { ReaperGetPitchShiftAPI(REAPER_PITCHSHIFT_API_VER) }
 {
-  updateTempoShift();
+  updateTempoShift(m_params);
   m_peaks.resize(GetNumChannels());
 }
 
@@ -41,7 +112,7 @@ PitchShiftSource_Audio::~PitchShiftSource_Audio()
 PitchShiftSource_MIDI::PitchShiftSource_MIDI(PCM_source *src)
   : PitchShiftSource { src }
 {
-  updateTempoShift();
+  updateTempoShift(m_params);
   m_peaks.resize(16);
 }
 
@@ -59,18 +130,18 @@ int PitchShiftSource::GetNumChannels()
 
 double PitchShiftSource::GetLength()
 {
-  // Returning a truncated length (m_fadeOutLen) here would cause
+  // Returning a truncated length (fade-out length) here would cause
   // a 1 buffer glitch when it kicks in.
   WDL_MutexLockShared lock { &m_mutex };
-  return sourceLength();
+  return sourceLength(m_rate);
 }
 
-double PitchShiftSource_Audio::sourceLength() const
+double PitchShiftSource_Audio::sourceLength(const double rate) const
 {
-  return m_src->GetLength() / m_rate;
+  return m_src->GetLength() / rate;
 }
 
-double PitchShiftSource_MIDI::sourceLength() const
+double PitchShiftSource_MIDI::sourceLength(double) const
 {
   return m_src->GetLength();
 }
@@ -78,7 +149,7 @@ double PitchShiftSource_MIDI::sourceLength() const
 bool PitchShiftSource::isPastEnd(const double position)
 {
   WDL_MutexLockShared lock { &m_mutex };
-  const double length { m_fadeOutEnd ? m_fadeOutEnd : sourceLength() };
+  const double length { m_fadeOutEnd ? m_fadeOutEnd : sourceLength(m_rate) };
   return position >= length || m_flags & StopServiced;
 }
 
@@ -101,11 +172,13 @@ void PitchShiftSource::GetSamples(PCM_source_transfer_t *tx)
 
   {
     WDL_MutexLockShared lock { &m_mutex };
-    const double effectiveLength = m_fadeOutEnd ? m_fadeOutEnd : sourceLength();
-    block.fadeOutStart = effectiveLength - m_fadeOutLen;
+    const Params &params { pullParams() };
+    const double effectiveLength = m_fadeOutEnd ? m_fadeOutEnd : sourceLength(params.rate);
+    block.params = &params;
+    block.fadeOutStart = effectiveLength - params.fadeOutLen;
     block.isSeek = m_writeTime != tx->time_s;
     if(block.isSeek && tx->time_s == 0.0 && !(m_flags & (ManualSeek | Looping)))
-      m_flags |= WrappedAround;
+      m_flags.fetch_or(WrappedAround);
     writeSamples(block);
   }
 
@@ -133,37 +206,57 @@ void PitchShiftSource::GetSamples(PCM_source_transfer_t *tx)
 double PitchShiftSource::computeGain(const Block &block,
   const double time, const int samplesUntilNextCall)
 {
+  const Params &params { *block.params };
   const double
-    fadeIn { m_playTime < m_fadeInLen ? m_playTime / m_fadeInLen : 1.0 },
-    timeInFadeOut { m_fadeOutLen ? time - block.fadeOutStart : 0.0 },
-    fadeOut { timeInFadeOut > 0 ? 1 - (timeInFadeOut / m_fadeOutLen) : 1.0 };
+    fadeIn { m_playTime < params.fadeInLen ? m_playTime / params.fadeInLen : 1.0 },
+    timeInFadeOut { params.fadeOutLen ? time - block.fadeOutStart : 0.0 },
+    fadeOut { timeInFadeOut > 0 ? 1 - (timeInFadeOut / params.fadeOutLen) : 1.0 };
   m_playTime += samplesUntilNextCall * block.sampleTime;
-  return m_volume * std::max(0.0, fadeIn * fadeOut);
+  return std::max(0.0, fadeIn * fadeOut); // volume not included
 }
 
 void PitchShiftSource_Audio::writeSamples(const Block &block)
 {
-  if(m_rate == 1.0 && m_pitch == 0.0) {
+  const Params &params { *block.params };
+  if(params.rate == 1.0 && params.pitch == 0.0) {
     m_src->GetSamples(block.tx);
     m_readTime = 0;
   }
   else
     getShiftedSamples(block);
 
-  // no pan law
-  const double pan[] {
-    m_pan > 0 ? 1.0 - m_pan : 1.0, // left
-    m_pan < 0 ? m_pan + 1.0 : 1.0, // right
-  };
+  // ramp volume and pan changes over the block (but jump on seeks and on the
+  // first block, parameters set before playback starts apply right away)
+  if(block.isSeek || !m_playTime) {
+    m_curVolume = params.volume;
+    m_curPan = params.pan;
+  }
+  const int samples { block.tx->samples_out };
+  const double
+    volumeStep { samples ? (params.volume - m_curVolume) / samples : 0.0 },
+    panStep    { samples ? (params.pan - m_curPan) / samples : 0.0 };
 
   ReaSample *sample { block.tx->samples },
             *lastSample { sample + (block.tx->samples_out * block.tx->nch) };
   for(double time { block.tx->time_s }; sample < lastSample; sample += block.tx->nch) {
-    const double gain { computeGain(block, time, 1) };
+    m_curVolume += volumeStep;
+    m_curPan += panStep;
+
+    // no pan law
+    const double pan[] {
+      m_curPan > 0 ? 1.0 - m_curPan : 1.0, // left
+      m_curPan < 0 ? m_curPan + 1.0 : 1.0, // right
+    };
+
+    const double gain { computeGain(block, time, 1) * m_curVolume };
     for(int i {}; i < block.tx->nch; ++i)
       sample[i] *= gain * pan[i & 1];
     time += block.sampleTime;
   }
+
+  // no accumulated rounding errors
+  m_curVolume = params.volume;
+  m_curPan = params.pan;
 }
 
 void PitchShiftSource_Audio::getShiftedSamples(const Block &block)
@@ -171,14 +264,15 @@ void PitchShiftSource_Audio::getShiftedSamples(const Block &block)
   m_ps->set_srate(block.tx->samplerate);
   m_ps->set_nch(block.tx->nch);
 
-  const double bufSizeMul { m_rate > 1.0 ? m_rate : 1.0 };
+  const double rate { block.params->rate };
+  const double bufSizeMul { rate > 1.0 ? rate : 1.0 };
   PCM_source_transfer_t sourceBlock {};
   sourceBlock.samplerate = block.tx->samplerate;
   sourceBlock.nch = block.tx->nch;
   sourceBlock.length = static_cast<int>(block.tx->length * bufSizeMul);
 
   if(block.isSeek || !m_readTime) {
-    m_readTime  = block.tx->time_s * m_rate;
+    m_readTime  = block.tx->time_s * rate;
     m_ps->Reset(); // to give immediate feedback with very slow play rates
   }
 
@@ -219,10 +313,11 @@ void PitchShiftSource_MIDI::writeSamples(const Block &block)
 
   m_src->GetSamples(block.tx);
 
-  const double gain { computeGain(block, block.tx->time_s, block.tx->length) };
+  const Params &params { *block.params };
+  const double gain { computeGain(block, block.tx->time_s, block.tx->length) * params.volume };
   for(int i = 0; MIDI_event_t *event { block.tx->midi_events->EnumItems(&i) };) {
     if(event->is_note())
-      event->midi_message[1] = clamp7b(event->midi_message[1] + static_cast<int>(m_pitch));
+      event->midi_message[1] = clamp7b(event->midi_message[1] + static_cast<int>(params.pitch));
     if(event->is_note_on())
       event->midi_message[2] = clamp7b(static_cast<int>(event->midi_message[2] * gain));
   }
@@ -262,116 +357,112 @@ void PitchShiftSource_MIDI::writePeaks(const PCM_source_transfer_t *block)
   }
 }
 
-void PitchShiftSource_Audio::updateTempoShift()
+// called from the audio thread when new parameters are pulled (or when not playing),
+// only touches audio thread state or atomics: only the shared lock may be held
+void PitchShiftSource_Audio::updateTempoShift(const Params &params)
 {
-  double shift { pow(2.0, m_pitch / 12.0) };
-  if(!(m_flags & PreservePitch))
-    shift *= m_rate;
+  double shift { pow(2.0, params.pitch / 12.0) };
+  if(!params.preservePitch)
+    shift *= params.rate;
 
-  m_ps->SetQualityParameter(m_mode);
-  m_ps->set_tempo(m_rate);
+  m_ps->SetQualityParameter(params.mode);
+  m_ps->set_tempo(params.rate);
   m_ps->set_shift(shift);
 
   // to have getShiftedSamples reset m_readTime and m_ps next time it's used
-  if(m_rate == 1.0 && m_pitch == 0.0)
-    m_writeTime = 0.0;
+  if(params.rate == 1.0 && params.pitch == 0.0)
+    m_readTime = 0.0;
 }
 
-void PitchShiftSource_MIDI::updateTempoShift()
+void PitchShiftSource_MIDI::updateTempoShift(const Params &params)
 {
-  m_flags |= AllNotesOff;
+  m_flags.fetch_or(AllNotesOff);
 
-  double tempo { 120 * m_rate };
+  double tempo { 120 * params.rate };
   m_src->Extended(PCM_SOURCE_EXT_SETPREVIEWTEMPO, &tempo, nullptr, nullptr);
 }
 
+// setters are only called from the main thread, they never lock: see publishParams()
 void PitchShiftSource::setVolume(const double volume)
 {
-  // OK to read unlocked: only called/modified from the main thread
-  if(volume == m_volume || volume < 0)
-    return; // don't exclusively lock the mutex for no reason
+  if(volume == m_params.volume || volume < 0)
+    return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_volume = volume;
+  m_params.volume = volume;
+  publishParams();
 }
 
 void PitchShiftSource::setPan(const double pan)
 {
-  if(pan == m_pan || pan < -1 || pan > 1)
+  if(pan == m_params.pan || pan < -1 || pan > 1)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_pan = pan;
+  m_params.pan = pan;
+  publishParams();
 }
 
 void PitchShiftSource::setPlayRate(const double playRate)
 {
   // rubberband crashes at rates < 0.005 and preserving pitch
-  if(playRate < 0.01 || playRate > 100 || playRate == m_rate)
+  if(playRate < 0.01 || playRate > 100 || playRate == m_params.rate)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_rate = playRate;
-  updateTempoShift();
+  m_params.rate = playRate;
+  publishParams();
 }
 
 void PitchShiftSource::setPitch(const double pitch)
 {
-  if(pitch == m_pitch)
+  if(pitch == m_params.pitch)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_pitch = pitch;
-  updateTempoShift();
+  m_params.pitch = pitch;
+  publishParams();
 }
 
 void PitchShiftSource::setPreservePitch(const bool preservePitch)
 {
-  if(preservePitch == !!(m_flags & PreservePitch))
+  if(preservePitch == m_params.preservePitch)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_flags &= ~PreservePitch;
-  if(preservePitch)
-    m_flags |= PreservePitch;
-  updateTempoShift();
+  m_params.preservePitch = preservePitch;
+  publishParams();
 }
 
 void PitchShiftSource::setMode(const int mode)
 {
-  if(mode == m_mode)
+  if(mode == m_params.mode)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_mode = mode;
-  updateTempoShift();
+  m_params.mode = mode;
+  publishParams();
 }
 
 void PitchShiftSource::setFadeInLen(const double len)
 {
-  if(len == m_fadeInLen)
+  if(len == m_params.fadeInLen)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_fadeInLen = len;
+  m_params.fadeInLen = len;
+  publishParams();
 }
 
 void PitchShiftSource::setFadeOutLen(const double len)
 {
-  if(len == m_fadeOutLen)
+  if(len == m_params.fadeOutLen)
     return;
 
-  WDL_MutexLockExclusive lock { &m_mutex };
-  m_fadeOutLen = len;
+  m_params.fadeOutLen = len;
+  publishParams();
 }
 
 bool PitchShiftSource::startFadeOut()
 {
-  if(!m_fadeOutLen)
+  if(!m_params.fadeOutLen)
     return false;
 
   WDL_MutexLockExclusive lock { &m_mutex };
-  m_fadeOutEnd = m_writeTime + m_fadeOutLen;
+  m_fadeOutEnd = m_writeTime + m_params.fadeOutLen;
   return true;
 }
 
@@ -27,12 +27,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <WDL/mutex.h>
 
 class PitchShiftSource : public PCM_source {
 public:
   static PitchShiftSource *create(PCM_source *src);
+  static bool isMIDI(PCM_source *src);
 
   PitchShiftSource(PCM_source *src);
   ~PitchShiftSource();
@@ -55,22 +57,24 @@ public:
   void   PeaksBuild_Finish() override {}
 
   // only safe to call from the main thread
+  virtual bool isMIDI() const = 0;
+  void   reset(PCM_source *src); // restart from defaults with a new source (or none)
   bool   isPastEnd(double position);
-  double getVolume() { return m_volume; }
+  double getVolume() { return m_params.volume; }
   void   setVolume(double v);
-  double getPan() { return m_pan; }
+  double getPan() { return m_params.pan; }
   void   setPan(double p);
-  double getPlayRate() { return m_rate; }
+  double getPlayRate() { return m_params.rate; }
   void   setPlayRate(double);
-  double getPitch() { return m_pitch; }
+  double getPitch() { return m_params.pitch; }
   void   setPitch(double);
-  bool   getPreservePitch() { return m_flags & PreservePitch; }
+  bool   getPreservePitch() { return m_params.preservePitch; }
   void   setPreservePitch(bool);
-  int    getMode() { return m_mode; }
+  int    getMode() { return m_params.mode; }
   void   setMode(int);
-  double getFadeInLen() { return m_fadeInLen; }
+  double getFadeInLen() { return m_params.fadeInLen; }
   void   setFadeInLen(double);
-  double getFadeOutLen() { return m_fadeOutLen; }
+  double getFadeOutLen() { return m_params.fadeOutLen; }
   void   setFadeOutLen(double);
   bool   startFadeOut();
   bool   readPeak(size_t, double *);
@@ -78,8 +82,14 @@ public:
   void seekOrLoop(bool isSeek, bool looping);
 
 protected:
+  struct Params {
+    double pitch, rate, volume, pan, fadeInLen, fadeOutLen;
+    int mode;
+    bool preservePitch;
+  };
   struct Block {
     PCM_source_transfer_t *tx;
+    const Params *params;
     double sampleTime, fadeOutStart;
     bool isSeek;
   };
@@ -88,7 +98,6 @@ protected:
     double max;
   };
   enum Flags {
-    PreservePitch = 1<<0,
     AllNotesOff   = 1<<1,
     StopRequest   = 1<<2,
     StopServiced  = 1<<3,
@@ -98,14 +107,28 @@ protected:
   };
 
   // must lock m_mutex before using these
-  virtual double sourceLength() const = 0;
+  virtual double sourceLength(double rate) const = 0;
   virtual void writeSamples(const Block &) = 0;
   virtual void writePeaks(const PCM_source_transfer_t *) = 0;
-  virtual void updateTempoShift() = 0;
+  virtual void updateTempoShift(const Params &) = 0;
+  virtual void resetState() = 0;
   double computeGain(const Block &, double time, int samplesUntilNextCall);
 
-  double m_pitch, m_rate, m_volume, m_pan, m_fadeInLen, m_fadeOutLen;
-  int m_flags, m_mode;
+  // Parameters are set from the main thread (m_params) and handed to the
+  // audio thread through a triple buffer, neither side waits for the other.
+  // Volume and pan changes are smoothed over the next block.
+  enum { SlotMask = 3, FreshParams = 4 };
+  void resetParams();
+  void publishParams();          // main thread
+  const Params &pullParams();    // audio thread
+  Params m_params;
+  std::atomic<double> m_rate;    // m_params.rate, for GetLength() on any thread
+  Params m_paramSlots[3];
+  int m_writeSlot, m_readSlot;
+  std::atomic<int> m_freshSlot;  // slot index | FreshParams
+  double m_curVolume, m_curPan;  // audio thread, smoothed
+
+  std::atomic<int> m_flags; // also set from the audio thread under the shared lock
 
   WDL_SharedMutex m_mutex;
   PCM_source *m_src;
@@ -122,11 +145,14 @@ public:
 
   const char *GetType() override { return "SWS_PITCHSHIFT_AUDIO"; }
 
+  bool isMIDI() const override { return false; }
+
 protected:
-  double sourceLength() const override;
+  double sourceLength(double rate) const override;
   void writeSamples(const Block &) override;
   void writePeaks(const PCM_source_transfer_t *) override;
-  void updateTempoShift() override;
+  void updateTempoShift(const Params &) override;
+  void resetState() override;
 
 private:
   void getShiftedSamples(const Block &);
@@ -141,13 +167,15 @@ public:
 
   const char *GetType() override { return "SWS_PITCHSHIFT_MIDI"; }
 
+  bool isMIDI() const override { return true; }
   bool requestStop() override;
 
 protected:
-  double sourceLength() const override;
+  double sourceLength(double rate) const override;
   void writeSamples(const Block &) override;
   void writePeaks(const PCM_source_transfer_t *) override;
-  void updateTempoShift() override;
+  void updateTempoShift(const Params &) override;
+  void resetState() override;
 
 private:
   void addCCAllChans(MIDI_eventlist *events, unsigned char cc, unsigned char val);
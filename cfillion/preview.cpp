@@ -1,7 +1,24 @@
 #include "stdafx.h"
 #include "preview.hpp"
 
-WDL_PtrList_DOD<CF_Preview> g_previews;
+#include <memory>
+
+// handle = generation << SLOT_BITS | (slot + 1)
+constexpr int SLOT_BITS { sizeof(void *) > 4 ? 32 : 16 };
+constexpr uintptr_t SLOT_MASK { (uintptr_t { 1 } << SLOT_BITS) - 1 },
+                    GEN_MASK  { ~uintptr_t {} >> SLOT_BITS };
+constexpr size_t MAX_POOLED { 32 }; // idle previews kept for reuse, per source kind
+
+struct PoolSlot {
+  std::unique_ptr<CF_Preview> preview;
+  unsigned int generation;
+};
+
+static std::vector<PoolSlot> g_slots;
+static std::vector<size_t> g_freeSlots;       // slots without a preview instance
+static std::vector<CF_Preview *> g_pooled[2]; // idle previews (audio, MIDI)
+static WDL_PtrList<CF_Preview> g_previews;    // live previews
+static bool g_stopWatchRegistered;
 
 enum Flags {
   Buffered  = 1,
@@ -35,29 +52,80 @@ private:
 
 void CF_Preview::stopWatch()
 {
+  // release() moves the last live preview (already visited) into slot i
   for(int i { g_previews.GetSize() - 1 }; i >= 0; --i) {
     CF_Preview *preview { g_previews.Get(i) };
     if(preview->isDangling() && preview->stop(false))
-      delete preview;
+      preview->release();
     else
       preview->asyncTick();
   }
 }
 
-bool CF_Preview::isValid(CF_Preview *preview)
+CF_Preview *CF_Preview::create(PCM_source *source)
 {
-  if(g_previews.Find(preview) < 0)
-    return false;
+  std::vector<CF_Preview *> &pooled { g_pooled[PitchShiftSource::isMIDI(source)] };
+
+  CF_Preview *preview;
+  if(!pooled.empty()) {
+    preview = pooled.back();
+    pooled.pop_back();
+    preview->reuse(source);
+  }
+  else {
+    size_t slot;
+    if(!g_freeSlots.empty()) {
+      slot = g_freeSlots.back();
+      g_freeSlots.pop_back();
+    }
+    else if(g_slots.size() < SLOT_MASK) {
+      slot = g_slots.size();
+      g_slots.push_back({ nullptr, 0 });
+    }
+    else
+      return nullptr;
+
+    g_slots[slot].preview.reset(new CF_Preview { slot, source });
+    preview = g_slots[slot].preview.get();
+  }
+
+  preview->m_live = g_previews.GetSize();
+  g_previews.Add(preview);
+
+  // registered once: rapid-fire previews shouldn't (un)register it every time
+  if(!g_stopWatchRegistered)
+    g_stopWatchRegistered = !!plugin_register("timer", reinterpret_cast<void *>(&stopWatch));
+
+  return preview;
+}
+
+CF_Preview *CF_Preview::fromHandle(CF_Preview *handle)
+{
+  const uintptr_t value { reinterpret_cast<uintptr_t>(handle) };
+  const size_t slot { static_cast<size_t>(value & SLOT_MASK) - 1 }; // wraps if 0
+  if(slot >= g_slots.size())
+    return nullptr;
+
+  CF_Preview *preview { g_slots[slot].preview.get() };
+  if(!preview || preview->m_live < 0 ||
+      (value >> SLOT_BITS) != (g_slots[slot].generation & GEN_MASK))
+    return nullptr;
 
   switch(preview->m_state) {
   case FadeOut:
   case AsyncStop:
-    return false;
+    return nullptr;
   default:
-    return true;
+    return preview;
   }
 }
 
+CF_Preview *CF_Preview::handle() const
+{
+  const uintptr_t generation { g_slots[m_slot].generation & GEN_MASK };
+  return reinterpret_cast<CF_Preview *>(generation << SLOT_BITS | (m_slot + 1));
+}
+
 void CF_Preview::stopAll()
 {
   for(int i { g_previews.GetSize() - 1 }; i >= 0; --i)
@@ -69,8 +137,20 @@ CF_Preview::PreviewInst::PreviewInst(PitchShiftSource *src)
 {
 }
 
-CF_Preview::CF_Preview(PCM_source *source)
-  : m_state { Idle }, m_measureAlign { 0.0 },
+void CF_Preview::PreviewInst::reset(PitchShiftSource *newSrc)
+{
+  src           = newSrc;
+  m_out_chan    = 0;
+  curpos        = 0.0;
+  loop          = false;
+  volume        = 1.0;
+  peakvol[0]    = peakvol[1] = 0.0;
+  preview_track = nullptr;
+  project       = nullptr;
+}
+
+CF_Preview::CF_Preview(const size_t slot, PCM_source *source)
+  : m_slot { slot }, m_live { -1 }, m_state { Idle }, m_measureAlign { 0.0 },
     m_src { PitchShiftSource::create(source) },
     m_reg { m_src }, m_async { nullptr }
 {
@@ -79,20 +159,10 @@ CF_Preview::CF_Preview(PCM_source *source)
 #else
   pthread_mutex_init(&m_reg.mutex, nullptr);
 #endif
-
-  g_previews.Add(this);
-
-  if(g_previews.GetSize() == 1)
-    plugin_register("timer", reinterpret_cast<void *>(&stopWatch));
 }
 
 CF_Preview::~CF_Preview()
 {
-  g_previews.Delete(g_previews.Find(this), false);
-
-  if(g_previews.GetSize() == 0)
-    plugin_register("-timer", reinterpret_cast<void *>(&stopWatch));
-
   stop(false, false);
 
 #ifdef _WIN32
@@ -104,6 +174,39 @@ CF_Preview::~CF_Preview()
   delete m_src;
 }
 
+// reuse a pooled instance: the preview register (and its mutex) and the
+// pitch shifter are kept, everything else starts over from defaults
+void CF_Preview::reuse(PCM_source *source)
+{
+  m_src->reset(source);
+  m_reg.reset(m_src);
+  m_async.reset(nullptr);
+  m_state = Idle;
+  m_measureAlign = 0.0;
+}
+
+// back to the pool once stopped, invalidates the handle
+void CF_Preview::release()
+{
+  CF_Preview *last { g_previews.Get(g_previews.GetSize() - 1) };
+  g_previews.Set(m_live, last);
+  last->m_live = m_live;
+  g_previews.Delete(g_previews.GetSize() - 1, false);
+  m_live = -1;
+
+  ++g_slots[m_slot].generation;
+
+  std::vector<CF_Preview *> &pooled { g_pooled[m_src->isMIDI()] };
+  if(pooled.size() < MAX_POOLED) {
+    m_src->reset(nullptr); // don't keep the user's source alive
+    pooled.push_back(this);
+  }
+  else {
+    g_freeSlots.push_back(m_slot);
+    g_slots[m_slot].preview.reset(); // deletes this
+  }
+}
+
 bool CF_Preview::isDangling()
 {
   switch(m_state) {
@@ -31,12 +31,18 @@
 
 class CF_Preview {
 public:
-  static bool isValid(CF_Preview *);
+  // Previews are pooled: handles given to the API encode a pool slot and a
+  // generation number so they can be validated in constant time and don't
+  // alias the next preview reusing the same instance.
+  static CF_Preview *create(PCM_source *);
+  static CF_Preview *fromHandle(CF_Preview *handle); // nullptr if not valid
   static void stopAll();
 
-  CF_Preview(PCM_source *);
+  CF_Preview(size_t slot, PCM_source *);
   ~CF_Preview();
 
+  CF_Preview *handle() const;
+
   double getPosition();
   void   setPosition(double);
   bool   getPeak(int chan, double *out) { return m_src->readPeak(chan, out); }
@@ -79,13 +85,18 @@ private:
   struct PreviewInst : preview_register_t {
     PreviewInst(PitchShiftSource *);
     PreviewInst(const PreviewInst &) = delete; // don't copy mutex/cs
+    void reset(PitchShiftSource *); // keeps the mutex/cs
     ReaProject *project;
   };
 
   static void stopWatch();
+  void reuse(PCM_source *);
+  void release();
   void asyncTick();
   PreviewInst &writableInst();
 
+  size_t m_slot;
+  int m_live; // index in the list of live previews, -1 when pooled
   State m_state;
   double m_measureAlign;
   PitchShiftSource *m_src;
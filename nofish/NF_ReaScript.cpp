@@ -29,7 +29,6 @@
 #include "stdafx.h"
 #include "NF_ReaScript.h"
 
-#include <taglib/fileref.h>
 #ifdef _WIN32
 #  include <cstdint> // uint32_t
 #endif
@@ -38,6 +37,7 @@
 #include "../Breeder/BR_Misc.h" // GetProjectTrackSelectionAction
 #include "../Misc/Analysis.h"
 #include "../SnM/SnM.h" // ScheduledJob
+#include "../SnM/SnM_MediaMeta.h" // SNM_GetMediaFileBitrate
 #include "../SnM/SnM_Dlg.h"   // SNM_GetIconTheme
 #include "../SnM/SnM_Chunk.h" // SNM_FXSummaryParser
 #include "../SnM/SnM_Notes.h"
@@ -312,6 +312,24 @@ void NF_UpdateSWSMarkerRegionSubWindow()
 	NF_DoUpdateSWSMarkerRegionSubWindow();
 }
 
+int NF_GetSWSMarkerRegionSubs(char* subsOut, int subsOut_sz)
+{
+	WDL_FastString subs;
+	int count = NFDoGetSWSMarkerRegionSubs(&subs);
+
+	if (realloc_cmd_ptr(&subsOut, &subsOut_sz, subs.GetLength()))
+		memcpy(subsOut, subs.Get(), subs.GetLength());
+	else if (subsOut && subsOut_sz > 0)
+		lstrcpyn(subsOut, subs.Get(), subsOut_sz);
+
+	return count;
+}
+
+int NF_SetSWSMarkerRegionSubs(const char* subs)
+{
+	return NFDoSetSWSMarkerRegionSubs(subs);
+}
+
 bool NF_TakeFX_GetFXModuleName(MediaItem * item, int fx, char * nameOut, int nameOutSz)
 {
 	WDL_FastString module;
@@ -336,31 +354,10 @@ int NF_Win32_GetSystemMetrics(int nIndex)
 	return GetSystemMetrics(nIndex);
 }
 
-// get taglib audio properties (bitrate only currently)
-enum class TagLibAudioProperties {
-	bitrate = 0
-};
-
-int GetTagLibAudioProperty(const char* fn, TagLibAudioProperties property)
-{
-	if (!fn || !*fn)
-		return 0;
-	TagLib::FileRef f(fn); 
-	if (!f.isNull() && f.audioProperties()) 
-	{
-		switch (property) 
-		{
-			case TagLibAudioProperties::bitrate: 
-				return f.audioProperties()->bitrate();	
-		}		
-	}
-
-	return 0;
-}
-
+// TagLib audio properties, cached by SnM_MediaMeta
 int NF_ReadAudioFileBitrate(const char* fn)
 {
-	return GetTagLibAudioProperty(fn, TagLibAudioProperties::bitrate);
+	return SNM_GetMediaFileBitrate(fn);
 }
 
 
@@ -498,6 +495,21 @@ void NF_Base64_Encode(const char* str, int str_sz, const bool usePadding, char*
 		--str_sz; // ignore the null terminator
 	else
 		str_sz = strlen(str);
+
+	// Encode straight into the output buffer when possible
+	const int encodedSize = Base64::EncodedLength(str_sz, usePadding);
+	if (encodedSize < encodedStrOut_sz)
+	{
+		encodedStrOut[Base64::EncodeTo(str, str_sz, encodedStrOut, usePadding)] = 0;
+		return;
+	}
+	int newSize{};
+	if (realloc_cmd_ptr(&encodedStrOut, &newSize, encodedSize) && newSize == encodedSize)
+	{
+		Base64::EncodeTo(str, str_sz, encodedStrOut, usePadding); // no null terminator after realloc_cmd_ptr
+		return;
+	}
+
 	Base64 b64;
 	const char* encoded = b64.Encode(str, str_sz, usePadding);
 	CopyToBuffer(encoded, encodedStrOut, encodedStrOut_sz);
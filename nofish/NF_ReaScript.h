@@ -48,6 +48,8 @@ bool            NF_AnalyzeTakeLoudness2(MediaItem_Take* take, bool analyzeTruePe
 const char*    NF_GetSWSMarkerRegionSub(int mkrRgnIdx);
 bool           NF_SetSWSMarkerRegionSub(const char* mkrRgnSub, int mkrRgnIdx);
 void           NF_UpdateSWSMarkerRegionSubWindow();
+int            NF_GetSWSMarkerRegionSubs(char* subsOut, int subsOut_sz);
+int            NF_SetSWSMarkerRegionSubs(const char* subs);
 
 bool           NF_TakeFX_GetFXModuleName(MediaItem* item, int fx, char* nameOut, int nameOutSz);
 int            NF_Win32_GetSystemMetrics(int nIndex);
@@ -0,0 +1,207 @@
+-- SWS hot paths benchmark, against a live REAPER session
+-- (see bench/ for the headless sws_bench executable, which also covers
+-- SWS_ListView::Update and runs without REAPER, e.g. in CI).
+-- Run from REAPER (Actions > ReaScript: Run...), ideally with no other
+-- project open. Everything is created in a new project tab that can be
+-- closed without saving when done. No user input is requested.
+-- Results are printed to the console and written as JSON to
+-- <resource path>/sws_bench.json, SWS internal scopes (BR_Profiler_*) are
+-- also dumped as Chrome trace JSON to <resource path>/sws_bench_trace.json.
+
+local SCALES_TRACKS = {100, 1000, 10000}
+local SCALES_CHUNK_MB = {1, 10}
+local SCALES_ENV_POINTS = {10000, 100000}
+local SCALES_BASE64_MB = {1, 10}
+local AUDIO_LENGTH = 3600 -- seconds, the source file is looped
+local RUNS = 5
+
+local results = {}
+
+local function bench(name, scale, func)
+  local times = {}
+  for run = 1, RUNS do
+    local t0 = reaper.time_precise()
+    func()
+    times[run] = (reaper.time_precise() - t0) * 1000
+  end
+  table.sort(times)
+  local res = {name=name, scale=scale, min=times[1], median=times[math.floor((RUNS+1)/2)], max=times[RUNS]}
+  results[#results+1] = res
+  reaper.ShowConsoleMsg(string.format("%-40s %-10s min %10.3f ms   median %10.3f ms   max %10.3f ms\n", name, scale, res.min, res.median, res.max))
+end
+
+local function removeAllTracks()
+  for i = reaper.CountTracks(0)-1, 0, -1 do
+    reaper.DeleteTrack(reaper.GetTrack(0, i))
+  end
+end
+
+reaper.ShowConsoleMsg("")
+reaper.Main_OnCommand(40859, 0) -- New project tab
+reaper.BR_Profiler_Enable(true, true)
+reaper.PreventUIRefresh(1)
+
+local state = reaper.SNM_CreateFastString("")
+
+-- tracks: chunk parser (SNM_ChunkParserPatcher) on every track
+for _, n in ipairs(SCALES_TRACKS) do
+  removeAllTracks()
+  for i = 0, n-1 do
+    reaper.InsertTrackAtIndex(i, false)
+  end
+  bench("SNM_GetSetObjectState (all tracks)", n .. " tracks", function()
+    for i = 0, n-1 do
+      reaper.SNM_GetSetObjectState(reaper.GetTrack(0, i), state, false, false)
+    end
+  end)
+  bench("SNM_GetTrackFolderInfo (all tracks)", n .. " tracks", function()
+    for i = 0, n-1 do
+      reaper.SNM_GetTrackFolderInfo(reaper.GetTrack(0, i))
+    end
+  end)
+end
+
+-- big chunks: get (parse) and set (patch) a track with lots of items
+for _, mb in ipairs(SCALES_CHUNK_MB) do
+  removeAllTracks()
+  reaper.InsertTrackAtIndex(0, false)
+  local tr = reaper.GetTrack(0, 0)
+
+  local parts, size, pos = {"<TRACK\nNAME bench\n"}, 0, 0
+  while size < mb * 1024 * 1024 do
+    local item = string.format("<ITEM\nPOSITION %.3f\nLENGTH 1\nNAME \"bench item %d\"\n>\n", pos, pos)
+    parts[#parts+1] = item
+    size = size + #item
+    pos = pos + 1
+  end
+  parts[#parts+1] = ">\n"
+  reaper.SetTrackStateChunk(tr, table.concat(parts), false)
+
+  reaper.SNM_GetSetObjectState(tr, state, false, false)
+  local chunk = reaper.SNM_GetFastString(state)
+  bench("SNM_GetSetObjectState (get)", mb .. " MB", function()
+    reaper.SNM_GetSetObjectState(tr, state, false, false)
+  end)
+  bench("SNM_GetSetObjectState (set)", mb .. " MB", function()
+    reaper.SNM_SetFastString(state, chunk)
+    reaper.SNM_GetSetObjectState(tr, state, true, false)
+  end)
+end
+
+-- Base64 codec (binary payloads, e.g. plugin states)
+for _, mb in ipairs(SCALES_BASE64_MB) do
+  local bytes = {}
+  for i = 1, 1024 do
+    bytes[i] = string.char(math.random(0, 255))
+  end
+  local data = string.rep(table.concat(bytes), mb * 1024)
+  local encoded = reaper.NF_Base64_Encode(data, true)
+
+  bench("NF_Base64_Encode", mb .. " MB", function()
+    reaper.NF_Base64_Encode(data, true)
+  end)
+  bench("NF_Base64_Decode", mb .. " MB", function()
+    reaper.NF_Base64_Decode(encoded)
+  end)
+end
+
+-- envelopes (BR_Envelope)
+for _, n in ipairs(SCALES_ENV_POINTS) do
+  removeAllTracks()
+  reaper.InsertTrackAtIndex(0, false)
+  local tr = reaper.GetTrack(0, 0)
+  reaper.SetOnlyTrackSelected(tr)
+  reaper.Main_OnCommand(40406, 0) -- Track: Toggle track volume envelope visible
+  local env = reaper.GetTrackEnvelopeByName(tr, "Volume")
+  if env then
+    for i = 0, n-1 do
+      reaper.InsertEnvelopePoint(env, i * 0.01, (i % 2 == 0) and 1 or 0.5, 0, 0, false, true)
+    end
+    reaper.Envelope_SortPoints(env)
+
+    bench("BR_EnvAlloc/BR_EnvGetPoint/BR_EnvFree", n .. " points", function()
+      local brEnv = reaper.BR_EnvAlloc(env, false)
+      for i = 0, reaper.BR_EnvCountPoints(brEnv)-1 do
+        reaper.BR_EnvGetPoint(brEnv, i)
+      end
+      reaper.BR_EnvFree(brEnv, false)
+    end)
+    bench("BR_EnvAlloc/BR_EnvFree (commit)", n .. " points", function()
+      reaper.BR_EnvFree(reaper.BR_EnvAlloc(env, false), true)
+    end)
+  end
+end
+
+-- audio analysis (BR_LoudnessObject/libebur128, AnalyzePCMSource)
+-- on a generated 1 s tone (16-bit stereo WAV), looped
+local function writeToneFile(fn, samplerate)
+  local frames = {}
+  for i = 0, samplerate-1 do
+    local l = math.floor(0.25 * 32767 * math.sin(2 * math.pi * 440 * i / samplerate))
+    local r = math.floor(0.25 * 32767 * math.sin(2 * math.pi * 660 * i / samplerate))
+    frames[#frames+1] = string.pack("<i2i2", l, r)
+  end
+  local data = table.concat(frames)
+  local f = io.open(fn, "wb")
+  if not f then return false end
+  f:write("RIFF", string.pack("<I4", 36 + #data), "WAVE")
+  f:write("fmt ", string.pack("<I4I2I2I4I4I2I2", 16, 1, 2, samplerate, samplerate * 4, 4, 16))
+  f:write("data", string.pack("<I4", #data), data)
+  f:close()
+  return true
+end
+
+local toneFile = reaper.GetResourcePath() .. "/sws_bench_tone.wav"
+if writeToneFile(toneFile, 48000) then
+  removeAllTracks()
+  reaper.InsertTrackAtIndex(0, false)
+  local tr = reaper.GetTrack(0, 0)
+  local item = reaper.AddMediaItemToTrack(tr)
+  local take = reaper.AddTakeToMediaItem(item)
+  reaper.SetMediaItemTake_Source(take, reaper.PCM_Source_CreateFromFile(toneFile))
+  reaper.SetMediaItemInfo_Value(item, "B_LOOPSRC", 1)
+  reaper.SetMediaItemInfo_Value(item, "D_LENGTH", AUDIO_LENGTH)
+
+  local scale = (AUDIO_LENGTH / 3600) .. " h"
+  bench("NF_AnalyzeTakeLoudness_IntegratedOnly", scale, function()
+    reaper.NF_AnalyzeTakeLoudness_IntegratedOnly(take)
+  end)
+  bench("NF_AnalyzeTakeLoudness (true peak)", scale, function()
+    reaper.NF_AnalyzeTakeLoudness(take, true)
+  end)
+  bench("NF_GetMediaItemMaxPeak", scale, function()
+    reaper.NF_GetMediaItemMaxPeak(item)
+  end)
+else
+  reaper.ShowConsoleMsg("Could not write " .. toneFile .. ", audio benchmarks skipped\n")
+end
+
+removeAllTracks()
+reaper.SNM_DeleteFastString(state)
+reaper.PreventUIRefresh(-1)
+
+-- SWS internal scopes
+reaper.ShowConsoleMsg("\nSWS scopes:\n")
+local idx = 0
+while true do
+  local ok, name, count, totalMs, maxMs = reaper.BR_Profiler_GetStats(idx)
+  if not ok then break end
+  reaper.ShowConsoleMsg(string.format("%-40s count %8d   total %10.3f ms   max %10.3f ms\n", name, count, totalMs, maxMs))
+  idx = idx + 1
+end
+
+local path = reaper.GetResourcePath()
+reaper.BR_Profiler_DumpChromeTrace(path .. "/sws_bench_trace.json")
+reaper.BR_Profiler_Enable(false, true)
+
+local json = {}
+for i, res in ipairs(results) do
+  json[i] = string.format("  {\"name\":\"%s\",\"scale\":\"%s\",\"runs\":%d,\"min_ms\":%.3f,\"median_ms\":%.3f,\"max_ms\":%.3f}",
+    res.name, res.scale, RUNS, res.min, res.median, res.max)
+end
+local f = io.open(path .. "/sws_bench.json", "w")
+if f then
+  f:write("[\n" .. table.concat(json, ",\n") .. "\n]\n")
+  f:close()
+  reaper.ShowConsoleMsg("\nResults written to " .. path .. "/sws_bench.json\n")
+end
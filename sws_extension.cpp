@@ -75,10 +75,82 @@ static WDL_IntKeyedArray<COMMAND_T*> g_commands; // no valdispose (cmds can be a
 static int g_iFirstCommand;
 static int g_iLastCommand;
 
-bool hookCommandProc(int iCmd, int flag)
+// Dense dispatch table indexed by cmdId-g_iFirstCommand: the command, its
+// reentrancy flags (one per hook) and its cached toggle state in one place
+enum { REENTRANT_CMD=1, REENTRANT_CMD2=2, REENTRANT_TOGGLE=4 };
+struct SWSCmdSlot
+{
+	COMMAND_T* cmd;
+	int reentrant;
+	int toggleState;
+	unsigned int toggleGen; // valid if == g_toggleGen
+};
+static WDL_TypedBuf<SWSCmdSlot> g_cmdSlots;
+static int g_iCmdSlotsBase; // g_iFirstCommand when g_cmdSlots was (re)built
+
+// Toggle states are polled continuously by toolbars and menus: they are
+// cached until something that may change them happens (action, project or
+// control surface notification, see SWSInvalidateToggleStates()), or
+// TOGGLE_STATE_CACHE_MS at most (for states like window visibility)
+#define TOGGLE_STATE_CACHE_MS 250
+static unsigned int g_toggleGen = 1;
+
+static SWSCmdSlot* GetCmdSlot(int cmdId)
+{
+	int i = cmdId - g_iCmdSlotsBase;
+	if (cmdId >= g_iFirstCommand && i >= 0 && i < g_cmdSlots.GetSize())
+		return g_cmdSlots.Get() + i;
+	return NULL;
+}
+
+// Call *after* g_iFirstCommand/g_iLastCommand are updated
+static void SetCmdSlot(int cmdId, COMMAND_T* cmd)
+{
+	int oldSize = g_cmdSlots.GetSize(), size = g_iLastCommand - g_iFirstCommand + 1;
+	if (g_iCmdSlotsBase != g_iFirstCommand)
+	{
+		// first command moved down (rare): rebase existing slots, not to lose the
+		// reentrancy flags of running commands (that may be the ones registering)
+		const int shift = g_iCmdSlotsBase - g_iFirstCommand;
+		if (oldSize && shift > 0)
+		{
+			g_cmdSlots.Resize(oldSize + shift, false);
+			memmove(g_cmdSlots.Get() + shift, g_cmdSlots.Get(), oldSize * sizeof(SWSCmdSlot));
+			memset(g_cmdSlots.Get(), 0, shift * sizeof(SWSCmdSlot));
+			oldSize += shift;
+		}
+		else
+		{
+			g_cmdSlots.Resize(0);
+			oldSize = 0;
+		}
+		g_iCmdSlotsBase = g_iFirstCommand;
+	}
+
+	if (size > oldSize)
+	{
+		g_cmdSlots.Resize(size, false);
+		memset(g_cmdSlots.Get() + oldSize, 0, (size - oldSize) * sizeof(SWSCmdSlot));
+		if (!oldSize)
+			for (int i=0; i<g_commands.GetSize(); i++)
+				if (COMMAND_T* c = g_commands.Enumerate(i, NULL, NULL))
+					g_cmdSlots.Get()[c->cmdId - g_iCmdSlotsBase].cmd = c;
+	}
+
+	if (SWSCmdSlot* slot = GetCmdSlot(cmdId))
+	{
+		slot->cmd = cmd;
+		slot->toggleGen = 0;
+	}
+}
+
+void SWSInvalidateToggleStates()
 {
-	static WDL_PtrList<const char> sReentrantCmds;
+	if (!++g_toggleGen) g_toggleGen = 1; // 0 is reserved for "not cached"
+}
 
+bool hookCommandProc(int iCmd, int flag)
+{
 	// for Xen extensions
 	g_KeyUpUndoHandler=0;
 
@@ -103,16 +175,20 @@ bool hookCommandProc(int iCmd, int flag)
 
 		if (!cmd->uniqueSectionId && cmd->cmdId == iCmd && cmd->doCommand)
 		{
-			if (sReentrantCmds.Find(cmd->id)<0)
+			if (!(GetCmdSlot(iCmd)->reentrant & REENTRANT_CMD))
 			{
-				sReentrantCmds.Add(cmd->id);
+				GetCmdSlot(iCmd)->reentrant |= REENTRANT_CMD;
+				BR_ProfilerScope profile(cmd->id);
 				cmd->fakeToggle = !cmd->fakeToggle;
 #ifndef BR_DEBUG_PERFORMANCE_ACTIONS
 				cmd->doCommand(cmd);
 #else
 				CommandTimer(cmd);
 #endif
-				sReentrantCmds.Delete(sReentrantCmds.Find(cmd->id));
+				// no slot pointer kept across the call: the table can be reallocated meanwhile
+				if (SWSCmdSlot* slot = GetCmdSlot(iCmd))
+					slot->reentrant &= ~REENTRANT_CMD;
+				SWSInvalidateToggleStates();
 				return true;
 			}
 #ifdef _SWS_DEBUG
@@ -130,8 +206,6 @@ bool hookCommandProc(int iCmd, int flag)
 
 bool hookCommandProc2(KbdSectionInfo* sec, int cmdId, int val, int valhw, int relmode, HWND hwnd)
 {
-	static WDL_PtrList<const char> sReentrantCmds;
-
 	if (osara_isShortcutHelpEnabled && osara_isShortcutHelpEnabled())
 		return false; // let OSARA handle the command if it was loaded after SWS
 	else if (BR_GlobalActionHook(cmdId, val, valhw, relmode, hwnd))
@@ -159,9 +233,10 @@ bool hookCommandProc2(KbdSectionInfo* sec, int cmdId, int val, int valhw, int re
 				if (BR_SwsActionHook(cmd, relmode, hwnd))
 					return true;
 
-				if (sReentrantCmds.Find(cmd->id)<0)
+				if (!(GetCmdSlot(cmdId)->reentrant & REENTRANT_CMD2))
 				{
-					sReentrantCmds.Add(cmd->id);
+					GetCmdSlot(cmdId)->reentrant |= REENTRANT_CMD2;
+					BR_ProfilerScope profile(cmd->id);
 					cmd->fakeToggle = !cmd->fakeToggle;
 
 #ifndef BR_DEBUG_PERFORMANCE_ACTIONS
@@ -169,7 +244,9 @@ bool hookCommandProc2(KbdSectionInfo* sec, int cmdId, int val, int valhw, int re
 #else
 					CommandTimer(cmd, val, valhw, relmode, hwnd, true);
 #endif
-					sReentrantCmds.Delete(sReentrantCmds.Find(cmd->id));
+					if (SWSCmdSlot* slot = GetCmdSlot(cmdId))
+						slot->reentrant &= ~REENTRANT_CMD2;
+					SWSInvalidateToggleStates();
 					return true;
 				}
 #ifdef _SWS_DEBUG
@@ -200,16 +277,40 @@ void hookPostCommandProc(int iCmd, int flag)
 //  1 = action belongs to this extension and is currently set to "on"
 int toggleActionHook(int iCmd)
 {
-	static WDL_PtrList<const char> sReentrantCmds;
-	if (COMMAND_T* cmd = SWSGetCommandByID(iCmd))
+	SWSCmdSlot* slot = GetCmdSlot(iCmd);
+	COMMAND_T* cmd = slot ? slot->cmd : NULL;
+	if (cmd)
 	{
 		if (cmd->cmdId==iCmd && cmd->getEnabled)
 		{
-			if (sReentrantCmds.Find(cmd->id) == -1)
+			// expire cached states on project changes and after a while
+			static int sStateCount = 0;
+			static ReaProject* sProj = NULL;
+			static DWORD sTime = 0;
+			int stateCount = GetProjectStateChangeCount(NULL);
+			ReaProject* proj = EnumProjects(-1, NULL, 0);
+			DWORD now = GetTickCount();
+			if (stateCount != sStateCount || proj != sProj || now-sTime >= TOGGLE_STATE_CACHE_MS)
+			{
+				sStateCount = stateCount;
+				sProj = proj;
+				sTime = now;
+				SWSInvalidateToggleStates();
+			}
+
+			if (slot->toggleGen == g_toggleGen)
+				return slot->toggleState;
+
+			if (!(slot->reentrant & REENTRANT_TOGGLE))
 			{
-				sReentrantCmds.Add(cmd->id);
+				slot->reentrant |= REENTRANT_TOGGLE;
 				int state = cmd->getEnabled(cmd);
-				sReentrantCmds.Delete(sReentrantCmds.Find(cmd->id));
+				if ((slot = GetCmdSlot(iCmd)))
+				{
+					slot->reentrant &= ~REENTRANT_TOGGLE;
+					slot->toggleState = state;
+					slot->toggleGen = g_toggleGen;
+				}
 				return state;
 			}
 #ifdef _SWS_DEBUG
@@ -266,6 +367,7 @@ int SWSRegisterCmd(COMMAND_T* pCommand, const char* cFile, int cmdId, bool local
 	if (cmdId > g_iLastCommand) g_iLastCommand = cmdId;
 
 	g_commands.Insert(cmdId, pCommand);
+	SetCmdSlot(cmdId, pCommand);
 #ifdef ACTION_DEBUG
 	g_cmdFiles.Insert(cmdId, new WDL_String(cFile));
 #endif
@@ -334,6 +436,11 @@ COMMAND_T* SWSUnregisterCmd(int id)
 	{
 		SWSUnregisterCmdImpl(ct);
 		g_commands.Delete(id);
+		if (SWSCmdSlot* slot = GetCmdSlot(id))
+		{
+			slot->cmd = NULL;
+			slot->toggleGen = 0;
+		}
 #ifdef ACTION_DEBUG
 		g_cmdFiles.Delete(id);
 #endif
@@ -347,6 +454,7 @@ void UnregisterAllCmds() {
 		SWSUnregisterCmdImpl(*g_commands.EnumeratePtr(i));
 	}
 	g_commands.DeleteAll();
+	g_cmdSlots.Resize(0);
 }
 
 #ifdef ACTION_DEBUG
@@ -403,8 +511,8 @@ int SWSGetCommandID(void (*cmdFunc)(COMMAND_T*), INT_PTR user, const char** pMen
 }
 
 COMMAND_T* SWSGetCommandByID(int cmdId) {
-	if (cmdId >= g_iFirstCommand && cmdId <= g_iLastCommand) // not enough to ensure it is a SWS action
-		return g_commands.Get(cmdId, NULL);
+	if (SWSCmdSlot* slot = GetCmdSlot(cmdId)) // range check is not enough to ensure it is a SWS action
+		return slot->cmd;
 	return NULL;
 }
 
@@ -503,12 +611,14 @@ public:
 
 	void Run() // BR: Removed some stuff from here and made it use plugin_register("timer"/"-timer") - it's the same thing as this but it enables us to remove unused stuff completely
 	{          // I guess we could do the rest too (and add user options to enable where needed)...
-		SNM_CSurfRun();
-		ZoomSlice();
-		MiscSlice();
+		BR_ProfilerScope profile("SWSTimeSlice::Run");
+		{ BR_ProfilerScope profile("SNM_CSurfRun"); SNM_CSurfRun(); }
+		{ BR_ProfilerScope profile("ZoomSlice");    ZoomSlice();    }
+		{ BR_ProfilerScope profile("MiscSlice");    MiscSlice();    }
 
 		if (m_bChanged)
 		{
+			BR_ProfilerScope profile("SWSTimeSlice::Run - track list change");
 			m_bChanged = false;
 			ScheduleTracklistUpdate();
 			g_pMarkerList->Update();
@@ -521,6 +631,7 @@ public:
 		// Applying the AutoColor rules asynchronously on the next timer cycle (now).
 		if (m_bAutoColorTrackAsync)
 		{
+			BR_ProfilerScope profile("AutoColorTrack");
 			AutoColorTrack(false);
 			m_bAutoColorTrackAsync = false;
 		}
@@ -528,6 +639,7 @@ public:
 
 	void SetPlayState(bool play, bool pause, bool rec)
 	{
+		SWSInvalidateToggleStates();
 		SNM_CSurfSetPlayState(play, pause, rec);
 		AWDoAutoGroup(rec);
 		ItemPreviewPlayState(play, rec);
@@ -537,10 +649,12 @@ public:
 	// This is our only notification of active project tab change, so update everything
 	void SetTrackListChange()
 	{
+		SWSInvalidateToggleStates();
 		m_bChanged = true;
 		m_bAutoColorTrackAsync = true;
 		AutoColorMarkerRegion(false);
 		SNM_CSurfSetTrackListChange();
+		InvalidateFolderTree();
 		m_iACIgnore = GetNumTracks() + 1;
 	}
 	// For every SetTrackListChange we get NumTracks+1 SetTrackTitle calls, but we only
@@ -552,7 +666,7 @@ public:
 		if (!m_iACIgnore)
 		{
 			m_bAutoColorTrackAsync = true;
-			SNM_CSurfSetTrackTitle();
+			SNM_CSurfSetTrackTitle(tr);
 		}
 		else
 			m_iACIgnore--;
@@ -572,12 +686,13 @@ public:
 		BR_CSurf_OnTrackSelection(tr);
 	}
 
-	void SetSurfaceSelected(MediaTrack *tr, bool bSel)	{ ScheduleTracklistUpdate(); UpdateSnapshotsDialog(true); }
-	void SetSurfaceMute(MediaTrack *tr, bool mute)		{ ScheduleTracklistUpdate(); UpdateTrackMute(); }
-	void SetSurfaceSolo(MediaTrack *tr, bool solo)		{ ScheduleTracklistUpdate(); UpdateTrackSolo(); }
-	void SetSurfaceRecArm(MediaTrack *tr, bool arm)		{ ScheduleTracklistUpdate(); UpdateTrackArm(); }
+	void SetSurfaceSelected(MediaTrack *tr, bool bSel)	{ ScheduleTracklistUpdate(); UpdateSnapshotsDialog(true); SWSInvalidateToggleStates(); }
+	void SetSurfaceMute(MediaTrack *tr, bool mute)		{ ScheduleTracklistUpdate(); UpdateTrackMute(); SWSInvalidateToggleStates(); }
+	void SetSurfaceSolo(MediaTrack *tr, bool solo)		{ ScheduleTracklistUpdate(); UpdateTrackSolo(); SWSInvalidateToggleStates(); }
+	void SetSurfaceRecArm(MediaTrack *tr, bool arm)		{ ScheduleTracklistUpdate(); UpdateTrackArm(); SWSInvalidateToggleStates(); }
 	int Extended(int call, void *parm1, void *parm2, void *parm3)
 	{
+		SWSInvalidateToggleStates();
 		BR_CSurf_Extended(call, parm1, parm2, parm3);
 		SNM_CSurfExtended(call, parm1, parm2, parm3);
 
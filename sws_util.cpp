@@ -432,6 +432,90 @@ int GetFolderDepth(MediaTrack* tr, int* iType, MediaTrack** nextTr) // iType: 0=
 	return -1;
 }
 
+bool SWS_FolderTree::IsValid()
+{
+	if (!m_bValid || m_proj != EnumProjects(-1, NULL, 0) ||
+		m_stateCount != GetProjectStateChangeCount(NULL) || (int)m_nodes.size() != GetNumTracks() + 1)
+		return false;
+
+	// Tracks and folder depths can be changed with no undo point (ReaScript, other
+	// extensions), before the track list change notification if any: check that
+	// each node still refers to the same track, with the same folder depth
+	for (int i = 1; i < (int)m_nodes.size(); i++)
+	{
+		MediaTrack* tr = m_nodes[i].tr;
+		if (CSurf_TrackFromID(i, false) != tr || (int)GetMediaTrackInfo_Value(tr, "I_FOLDERDEPTH") != m_nodes[i].type)
+			return false;
+	}
+	return true;
+}
+
+void SWS_FolderTree::Build()
+{
+	const int nbTracks = GetNumTracks();
+	m_nodes.resize(nbTracks + 1);
+
+	// Master is the root, at '-1' depth
+	SWS_FolderNode* master = &m_nodes[0];
+	master->tr = CSurf_TrackFromID(0, false);
+	master->parent = master->firstChild = master->nextSibling = -1;
+	master->depth = -1;
+	master->type = 1;
+
+	// Open folders and their last child so far
+	std::vector<int> parents(1, 0), lastChildren(1, -1);
+	for (int i = 1; i <= nbTracks; i++)
+	{
+		SWS_FolderNode* node = &m_nodes[i];
+		node->tr = CSurf_TrackFromID(i, false);
+		node->type = *(int*)GetSetMediaTrackInfo(node->tr, "I_FOLDERDEPTH", NULL);
+		node->depth = (int)parents.size() - 1;
+		node->parent = parents.back();
+		node->firstChild = node->nextSibling = -1;
+		node->lastDescendant = i;
+
+		if (lastChildren.back() >= 0)
+			m_nodes[lastChildren.back()].nextSibling = i;
+		else
+			m_nodes[node->parent].firstChild = i;
+		lastChildren.back() = i;
+
+		if (node->type == 1)
+		{
+			parents.push_back(i);
+			lastChildren.push_back(-1);
+		}
+		else for (int j = node->type; j < 0 && parents.size() > 1; j++)
+		{
+			m_nodes[parents.back()].lastDescendant = i;
+			parents.pop_back();
+			lastChildren.pop_back();
+		}
+	}
+
+	// Master and unclosed folders
+	for (int id : parents)
+		m_nodes[id].lastDescendant = nbTracks;
+
+	m_proj = EnumProjects(-1, NULL, 0);
+	m_stateCount = GetProjectStateChangeCount(NULL);
+	m_bValid = true;
+}
+
+static SWS_FolderTree g_folderTree;
+
+const SWS_FolderTree* GetFolderTree()
+{
+	if (!g_folderTree.IsValid())
+		g_folderTree.Build();
+	return &g_folderTree;
+}
+
+void InvalidateFolderTree()
+{
+	g_folderTree.Invalidate();
+}
+
 int GetTrackVis(MediaTrack* tr) // &1 == mcp, &2 == tcp
 {
 	int iTrack = CSurf_TrackToID(tr, false);
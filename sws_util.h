@@ -216,6 +216,7 @@ void ActionsList(COMMAND_T*);
 int SWSGetCommandID(void (*cmdFunc)(COMMAND_T*), INT_PTR user = 0, const char** pMenuText = NULL);
 COMMAND_T** SWSGetCommand(int index);
 COMMAND_T* SWSGetCommandByID(int cmdId);
+void SWSInvalidateToggleStates(); // cached toggle states (see toggleActionHook) must be re-evaluated
 int IsSwsAction(const char* _actionName);
 
 HMENU SWSCreateMenuFromCommandTable(COMMAND_T pCommands[], HMENU hMenu = NULL, int* iIndex = NULL);;
@@ -231,6 +232,38 @@ void SaveSelected();
 void RestoreSelected();
 void ClearSelected();
 int GetFolderDepth(MediaTrack* tr, int* iType, MediaTrack** nextTr);
+
+// Folder hierarchy of the current project, built in one pass over the track list.
+// Nodes are indexed by track id (0 = master, 1..n as CSurf_TrackFromID), links are -1 if none.
+// The master track is the root: parent of top level tracks, depth -1.
+struct SWS_FolderNode
+{
+	MediaTrack* tr;
+	int parent, depth, type; // type: I_FOLDERDEPTH, like GetFolderDepth()
+	int firstChild, nextSibling;
+	int lastDescendant; // subtree = [id, lastDescendant]
+};
+
+class SWS_FolderTree
+{
+public:
+	SWS_FolderTree() : m_proj(NULL), m_stateCount(-1), m_bValid(false) {}
+	void Invalidate() { m_bValid = false; }
+	bool IsValid();
+	void Build();
+	int GetSize() const { return (int)m_nodes.size(); }
+	const SWS_FolderNode* Get(int id) const { return id >= 0 && id < (int)m_nodes.size() ? &m_nodes[id] : NULL; }
+	const SWS_FolderNode* Get(MediaTrack* tr) const { return Get(CSurf_TrackToID(tr, false)); }
+private:
+	std::vector<SWS_FolderNode> m_nodes;
+	ReaProject* m_proj;
+	int m_stateCount;
+	bool m_bValid;
+};
+
+// Returns the folder tree of the current project, rebuilt if the project has changed since last call
+const SWS_FolderTree* GetFolderTree();
+void InvalidateFolderTree(); // on track list changes, or after folder depth changes with no undo point
 int GetTrackVis(MediaTrack* tr); // &1 == mcp, &2 == tcp
 void SetTrackVis(MediaTrack* tr, int vis); // &1 == mcp, &2 == tcp
 int AboutBoxInit(); // Not worth its own .h
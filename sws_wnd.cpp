@@ -1158,6 +1158,10 @@ void SWS_ListView::Update(const bool reassign)
 	// Fill in the data by pulling it from the derived class
 	if (m_iEditingItem == -1 && !m_bDisableUpdates)
 	{
+		WDL_FastString profileName;
+		if (g_brProfilerEnabled)
+			profileName.SetFormatted(256, "SWS_ListView::Update - %s", m_cINIKey ? m_cINIKey : "");
+		BR_ProfilerScope profile(g_brProfilerEnabled ? profileName.Get() : NULL);
 		m_bDisableUpdates = true;
 		SendMessage(m_hwndList, WM_SETREDRAW, 0, 0);
 